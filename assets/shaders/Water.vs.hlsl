@@ -11,6 +11,13 @@ struct VSInput {
     float3 Normal : ATTRIB1;
     float4 Color  : ATTRIB2;
     float2 UV     : ATTRIB3;
+#ifdef MOON_INSTANCED
+    // 实例化绘制：逐实例世界矩阵的四行（此时 g_WorldViewProj 只含 ViewProj）
+    float4 WorldRow0 : ATTRIB4;
+    float4 WorldRow1 : ATTRIB5;
+    float4 WorldRow2 : ATTRIB6;
+    float4 WorldRow3 : ATTRIB7;
+#endif
 };
 
 struct PSInput {
@@ -34,10 +41,17 @@ void main(in VSInput i, out PSInput o)
     float3 localPos = i.Pos;
     localPos.y += ComputeWaveOffset(i.Pos.xz, g_TimeSeconds, g_WindStrength);
 
-    float4 worldPos4 = mul(float4(localPos, 1.0), g_World);
+#ifdef MOON_INSTANCED
+    float4x4 world = float4x4(i.WorldRow0, i.WorldRow1, i.WorldRow2, i.WorldRow3);
+    float4 worldPos4 = mul(float4(localPos, 1.0), world);
+    o.Pos = mul(worldPos4, g_WorldViewProj);
+#else
+    float4x4 world = g_World;
+    float4 worldPos4 = mul(float4(localPos, 1.0), world);
     o.Pos = mul(float4(localPos, 1.0), g_WorldViewProj);
+#endif
     o.WorldPos = worldPos4.xyz;
-    o.NormalWS = normalize(mul((float3x3)g_World, i.Normal));
+    o.NormalWS = normalize(mul((float3x3)world, i.Normal));
     o.Color = i.Color;
     o.UV = i.UV;
 }
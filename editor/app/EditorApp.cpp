@@ -405,12 +405,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
                 if (objectID != 0) {
                     // 查找对应的 SceneNode
                     Moon::Scene* scene = g_Engine->GetScene();
-                    g_SelectedObject = nullptr;
-                    scene->Traverse([objectID](Moon::SceneNode* node) {
-                        if (node->GetID() == objectID) {
-                            g_SelectedObject = node;
-                        }
-                    });
+                    g_SelectedObject = scene->FindNodeByID(objectID);
 
                     if (g_SelectedObject) {
                         MOON_LOG_INFO("EditorApp", "Selected object: %s (ID=%u)",
@@ -37,12 +37,7 @@ void Handle3DScenePicking(UINT msg, WPARAM wParam, LPARAM lParam)
             if (objectID != 0) {
                 // 查找对应的 SceneNode
                 Moon::Scene* scene = g_Engine->GetScene();
-                g_SelectedObject = nullptr;
-                scene->Traverse([objectID](Moon::SceneNode* node) {
-                    if (node->GetID() == objectID) {
-                        g_SelectedObject = node;
-                    }
-                });
+                g_SelectedObject = scene->FindNodeByID(objectID);
 
                 if (g_SelectedObject) {
                     MOON_LOG_INFO("EditorApp", "Selected object: %s (ID=%u)",
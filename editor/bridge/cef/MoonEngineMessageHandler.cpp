@@ -305,16 +305,20 @@ namespace {
         bounds.max.z = std::max(bounds.max.z, point.z);
     }
 
-    Bounds3 ComputePreviewBounds(const Moon::Massing::MassBuildResult& buildResult) {
+    Bounds3 ComputePreviewBounds(const std::vector<Moon::Massing::MassMeshPlacement>& placements) {
         Bounds3 bounds;
 
-        for (const Moon::Massing::MassBuildItem& item : buildResult.items) {
-            if (!item.mesh) {
+        for (const Moon::Massing::MassMeshPlacement& placement : placements) {
+            if (!placement.mesh) {
                 continue;
             }
 
-            for (const Moon::Vertex& vertex : item.mesh->GetVertices()) {
-                ExpandBounds(bounds, vertex.position);
+            for (const Moon::Vertex& vertex : placement.mesh->GetVertices()) {
+                const Moon::Vector3 scaled(
+                    vertex.position.x * placement.scale.x,
+                    vertex.position.y * placement.scale.y,
+                    vertex.position.z * placement.scale.z);
+                ExpandBounds(bounds, placement.rotation * scaled + placement.position);
             }
         }
 
@@ -658,19 +662,14 @@ namespace {
     bool BuildGeneratedBuildingPreviewResult(const Moon::Building::GeneratedBuilding& building,
                                              Moon::CSG::BuildResult& outBuildResult,
                                              std::string& outError) {
-        const std::string blueprintJson = Moon::Building::BuildingToObjectBlueprintConverter::Convert(building);
-
         Moon::Object::BlueprintDatabase database;
         if (!LoadObjectDatabase(database, outError)) {
             outError = "Failed to load CSG index: " + outError;
             return false;
         }
 
-        auto generatedBlueprint = Moon::Object::BlueprintLoader::ParseFromString(blueprintJson, outError);
-        if (!generatedBlueprint) {
-            outError = "Failed to parse building blueprint: " + outError;
-            return false;
-        }
+        // Build the blueprint tree directly; the JSON form is only needed for export
+        auto generatedBlueprint = Moon::Building::BuildingToObjectBlueprintConverter::ConvertToBlueprint(building);
 
         Moon::CSG::CSGBuilder builder;
         builder.SetBlueprintDatabase(&database);
@@ -1879,37 +1878,46 @@ namespace CommandHandlers {
             return CreateErrorResponse("Failed to parse massing rules: " + parseError);
         }
 
+        // Array copies stay as one shared prototype mesh per node; the render queue draws them instanced
+        Moon::Massing::MassBuildOptions buildOptions;
+        buildOptions.instancedArrays = true;
         Moon::Massing::MassBuildResult buildResult;
         std::string buildError;
-        if (!Moon::Massing::MassMeshBuilder::Build(ruleSet, buildResult, buildError)) {
+        if (!Moon::Massing::MassMeshBuilder::Build(ruleSet, buildOptions, buildResult, buildError)) {
             return CreateErrorResponse("Failed to build massing preview: " + buildError);
         }
 
+        std::vector<Moon::Massing::MassMeshPlacement> placements;
+        Moon::Massing::MassMeshBuilder::CollectPlacements(buildResult.items, placements);
+
         ClearMassingPreviewNodes(scene);
 
         Moon::SceneNode* previewRoot = scene->CreateNode("__MassingPreview");
 
-        for (size_t i = 0; i < buildResult.items.size(); ++i) {
-            const Moon::Massing::MassBuildItem& item = buildResult.items[i];
-            const std::string childName = item.name.empty() ? ("MassingPart_" + std::to_string(i)) : item.name;
+        for (size_t i = 0; i < placements.size(); ++i) {
+            const Moon::Massing::MassMeshPlacement& placement = placements[i];
+            const std::string childName = placement.name.empty() ? ("MassingPart_" + std::to_string(i)) : placement.name;
 
             Moon::SceneNode* childNode = scene->CreateNode(childName);
             childNode->SetParent(previewRoot, false);
+            childNode->GetTransform()->SetLocalPosition(placement.position);
+            childNode->GetTransform()->SetLocalRotation(placement.rotation);
+            childNode->GetTransform()->SetLocalScale(placement.scale);
 
             Moon::MeshRenderer* renderer = childNode->AddComponent<Moon::MeshRenderer>();
-            renderer->SetMesh(item.mesh);
-            AddMassingMaterial(childNode, item.material);
+            renderer->SetMesh(placement.mesh);
+            AddMassingMaterial(childNode, placement.material);
         }
 
         const bool focusCamera = req.value("focusCamera", false);
         if (focusCamera) {
-            FrameCameraToBounds(handler, ComputePreviewBounds(buildResult));
+            FrameCameraToBounds(handler, ComputePreviewBounds(placements));
         }
 
         json response;
         response["success"] = true;
         response["rootNodeId"] = previewRoot->GetID();
-        response["meshCount"] = buildResult.items.size();
+        response["meshCount"] = placements.size();
         response["warnings"] = buildResult.warnings;
         return response.dump();
     }
@@ -0,0 +1,500 @@
+#include "BuildingChangeTracker.h"
+#include "../core/Mesh/Mesh.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+
+namespace {
+
+/**
+ * @brief FNV-1a accumulator over definition fields
+ */
+class ContentHasher {
+public:
+    void Add(const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            m_hash ^= bytes[i];
+            m_hash *= 1099511628211ull;
+        }
+    }
+
+    void Add(int value) { Add(&value, sizeof(value)); }
+    void Add(bool value) { Add(value ? 1 : 0); }
+    void Add(size_t value) { Add(&value, sizeof(value)); }
+
+    void Add(float value) {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        Add(&bits, sizeof(bits));
+    }
+
+    void Add(const std::string& value) {
+        Add(value.size());
+        Add(value.data(), value.size());
+    }
+
+    void Add(const Moon::Building::GridPos2D& value) {
+        Add(value[0]);
+        Add(value[1]);
+    }
+
+    void Add(const Moon::Building::Rect& rect) {
+        Add(rect.rectId);
+        Add(rect.origin);
+        Add(rect.size);
+    }
+
+    uint64_t Get() const { return m_hash; }
+
+private:
+    uint64_t m_hash = 14695981039346656037ull;
+};
+
+uint64_t HashSpace(const Moon::Building::Space& space) {
+    ContentHasher hasher;
+    hasher.Add(space.spaceId);
+    hasher.Add(space.rects.size());
+    for (const auto& rect : space.rects) {
+        hasher.Add(rect);
+    }
+    hasher.Add(static_cast<int>(space.properties.usage));
+    hasher.Add(space.properties.isOutdoor);
+    hasher.Add(space.properties.hasStairs);
+    hasher.Add(space.properties.ceilingHeight);
+    hasher.Add(space.anchors.size());
+    for (const auto& anchor : space.anchors) {
+        hasher.Add(anchor.name);
+        hasher.Add(anchor.position);
+        hasher.Add(static_cast<int>(anchor.type));
+        hasher.Add(anchor.rotation);
+        hasher.Add(anchor.metadata);
+    }
+    // Stair config is only meaningful (and only initialized) for stair spaces
+    if (space.properties.hasStairs) {
+        hasher.Add(static_cast<int>(space.stairsConfig.type));
+        hasher.Add(space.stairsConfig.connectToLevel);
+        hasher.Add(space.stairsConfig.position);
+        hasher.Add(space.stairsConfig.width);
+        hasher.Add(space.stairsConfig.rotationDegrees);
+        hasher.Add(space.stairsConfig.footprintRect);
+    }
+    return hasher.Get();
+}
+
+uint64_t HashStyle(const Moon::Building::BuildingDefinition& definition) {
+    ContentHasher hasher;
+    hasher.Add(definition.schema);
+    hasher.Add(definition.grid);
+    hasher.Add(definition.style.category);
+    hasher.Add(definition.style.facade);
+    hasher.Add(definition.style.roof);
+    hasher.Add(definition.style.windowStyle);
+    hasher.Add(definition.style.material);
+    hasher.Add(definition.style.facadeOffset);
+    return hasher.Get();
+}
+
+uint64_t HashMasses(const Moon::Building::BuildingDefinition& definition) {
+    ContentHasher hasher;
+    hasher.Add(definition.masses.size());
+    for (const auto& mass : definition.masses) {
+        hasher.Add(mass.massId);
+        hasher.Add(mass.origin);
+        hasher.Add(mass.size);
+        hasher.Add(mass.floors);
+        hasher.Add(mass.massingRuleAsset);
+    }
+    return hasher.Get();
+}
+
+uint64_t HashFloorStack(const Moon::Building::BuildingDefinition& definition) {
+    ContentHasher hasher;
+    hasher.Add(definition.floors.size());
+    for (const auto& floor : definition.floors) {
+        hasher.Add(floor.level);
+        hasher.Add(floor.massId);
+        hasher.Add(floor.floorHeight);
+    }
+    return hasher.Get();
+}
+
+uint64_t HashVerticalTransports(const Moon::Building::BuildingDefinition& definition) {
+    ContentHasher hasher;
+    hasher.Add(definition.verticalTransports.size());
+    for (const auto& transport : definition.verticalTransports) {
+        hasher.Add(transport.transportId);
+        hasher.Add(static_cast<int>(transport.type));
+        hasher.Add(transport.shaftRect);
+        hasher.Add(transport.openingRect);
+        hasher.Add(transport.floorFrom);
+        hasher.Add(transport.floorTo);
+        hasher.Add(transport.sourceFloorLevel);
+        hasher.Add(transport.continuousShaft);
+        hasher.Add(transport.enclosed);
+        hasher.Add(transport.external);
+        hasher.Add(static_cast<int>(transport.stairType));
+        hasher.Add(transport.width);
+        hasher.Add(transport.position);
+        hasher.Add(transport.rotationDegrees);
+    }
+    return hasher.Get();
+}
+
+/**
+ * @brief Per-level space hashes in definition order
+ */
+struct LevelContent {
+    std::vector<std::pair<int, uint64_t>> spaces;  // (spaceId, content hash)
+};
+
+std::map<int, LevelContent> CollectLevelContent(const Moon::Building::BuildingDefinition& definition) {
+    std::map<int, LevelContent> levels;
+    for (const auto& floor : definition.floors) {
+        LevelContent& level = levels[floor.level];
+        for (const auto& space : floor.spaces) {
+            level.spaces.emplace_back(space.spaceId, HashSpace(space));
+        }
+    }
+    return levels;
+}
+
+void CollectChangedSpaces(const LevelContent* previous,
+                          const LevelContent* current,
+                          std::vector<int>& outSpaceIds) {
+    std::unordered_map<int, uint64_t> previousHashes;
+    if (previous) {
+        for (const auto& entry : previous->spaces) {
+            previousHashes[entry.first] = entry.second;
+        }
+    }
+
+    if (current) {
+        for (const auto& entry : current->spaces) {
+            auto it = previousHashes.find(entry.first);
+            if (it == previousHashes.end() || it->second != entry.second) {
+                outSpaceIds.push_back(entry.first);
+            }
+            if (it != previousHashes.end()) {
+                previousHashes.erase(it);
+            }
+        }
+    }
+
+    for (const auto& entry : previousHashes) {
+        outSpaceIds.push_back(entry.first);
+    }
+}
+
+bool SameMeshContent(const std::shared_ptr<Moon::Mesh>& a, const std::shared_ptr<Moon::Mesh>& b) {
+    if (a == b) {
+        return true;
+    }
+    if (!a || !b) {
+        return false;
+    }
+
+    const auto& verticesA = a->GetVertices();
+    const auto& verticesB = b->GetVertices();
+    if (verticesA.size() != verticesB.size() || a->GetIndices() != b->GetIndices()) {
+        return false;
+    }
+    for (size_t i = 0; i < verticesA.size(); ++i) {
+        const Moon::Vector3& pa = verticesA[i].position;
+        const Moon::Vector3& pb = verticesB[i].position;
+        if (pa.x != pb.x || pa.y != pb.y || pa.z != pb.z) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int ParseFloorPlateMeshLevel(const std::string& partId) {
+    constexpr const char* prefix = "floor_plate_mesh_";
+    if (partId.rfind(prefix, 0) != 0) {
+        return 0;
+    }
+    return std::atoi(partId.c_str() + std::char_traits<char>::length(prefix));
+}
+
+/**
+ * @brief Keyed view of the walls, doors and windows on a set of floor levels
+ */
+struct PartIndex {
+    std::unordered_map<std::string, size_t> walls;
+    std::unordered_map<std::string, size_t> doors;
+    std::unordered_map<std::string, size_t> windows;
+    std::vector<std::string> wallKeys;      // Parallel to building.walls (empty when level skipped)
+    std::vector<std::string> doorKeys;
+    std::vector<std::string> windowKeys;
+    std::unordered_map<int, size_t> wallById;
+};
+
+PartIndex BuildPartIndex(const Moon::Building::GeneratedBuilding& building,
+                         const Moon::Building::BuildingDefinitionChanges& changes) {
+    using Moon::Building::BuildingChangeTracker;
+
+    auto included = [&changes](int floorLevel) {
+        return changes.requiresFullRebuild || changes.IsFloorLevelDirty(floorLevel);
+    };
+
+    PartIndex index;
+    index.wallKeys.resize(building.walls.size());
+    for (size_t i = 0; i < building.walls.size(); ++i) {
+        const auto& wall = building.walls[i];
+        index.wallById[wall.wallId] = i;
+        if (!included(wall.floorLevel)) {
+            continue;
+        }
+        index.wallKeys[i] = BuildingChangeTracker::MakeWallKey(wall);
+        index.walls[index.wallKeys[i]] = i;
+    }
+
+    index.doorKeys.resize(building.doors.size());
+    for (size_t i = 0; i < building.doors.size(); ++i) {
+        if (!included(building.doors[i].floorLevel)) {
+            continue;
+        }
+        index.doorKeys[i] = BuildingChangeTracker::MakeDoorKey(building.doors[i]);
+        index.doors[index.doorKeys[i]] = i;
+    }
+
+    // Windows are keyed by host wall plus their order along that wall
+    std::unordered_map<int, int> windowsPerWall;
+    index.windowKeys.resize(building.windows.size());
+    for (size_t i = 0; i < building.windows.size(); ++i) {
+        const auto& window = building.windows[i];
+        if (!included(window.floorLevel)) {
+            continue;
+        }
+        auto hostIt = index.wallById.find(window.wallId);
+        const std::string hostKey = hostIt != index.wallById.end()
+            ? BuildingChangeTracker::MakeWallKey(building.walls[hostIt->second])
+            : "unhosted_L" + std::to_string(window.floorLevel);
+        index.windowKeys[i] = hostKey + "#window" + std::to_string(windowsPerWall[window.wallId]++);
+        index.windows[index.windowKeys[i]] = i;
+    }
+    return index;
+}
+
+std::string HostWallKey(const Moon::Building::GeneratedBuilding& building, const PartIndex& index, int wallId) {
+    auto it = index.wallById.find(wallId);
+    return it != index.wallById.end()
+        ? Moon::Building::BuildingChangeTracker::MakeWallKey(building.walls[it->second])
+        : std::string();
+}
+
+/**
+ * @brief Emit Added/Modified for current parts and Removed for previous parts
+ */
+template <typename SameContent>
+void DiffKeyedParts(Moon::Building::BuildingPartType type,
+                    const std::vector<std::string>& previousKeys,
+                    const std::unordered_map<std::string, size_t>& previousByKey,
+                    const std::vector<std::string>& currentKeys,
+                    const std::unordered_map<std::string, size_t>& currentByKey,
+                    const std::vector<int>& previousLevels,
+                    const std::vector<int>& currentLevels,
+                    SameContent sameContent,
+                    std::vector<Moon::Building::BuildingPartChange>& outChanges) {
+    using Moon::Building::BuildingPartChange;
+    using Moon::Building::BuildingPartChangeType;
+
+    for (size_t i = 0; i < currentKeys.size(); ++i) {
+        if (currentKeys[i].empty()) {
+            continue;
+        }
+        auto it = previousByKey.find(currentKeys[i]);
+        if (it != previousByKey.end() && sameContent(it->second, i)) {
+            continue;
+        }
+
+        BuildingPartChange change;
+        change.change = it == previousByKey.end() ? BuildingPartChangeType::Added : BuildingPartChangeType::Modified;
+        change.type = type;
+        change.key = currentKeys[i];
+        change.floorLevel = currentLevels[i];
+        change.index = i;
+        outChanges.push_back(std::move(change));
+    }
+
+    for (size_t i = 0; i < previousKeys.size(); ++i) {
+        if (previousKeys[i].empty() || currentByKey.count(previousKeys[i]) > 0) {
+            continue;
+        }
+
+        BuildingPartChange change;
+        change.change = BuildingPartChangeType::Removed;
+        change.type = type;
+        change.key = previousKeys[i];
+        change.floorLevel = previousLevels[i];
+        change.index = i;
+        outChanges.push_back(std::move(change));
+    }
+}
+
+template <typename T>
+std::vector<int> CollectFloorLevels(const std::vector<T>& parts) {
+    std::vector<int> levels;
+    levels.reserve(parts.size());
+    for (const auto& part : parts) {
+        levels.push_back(part.floorLevel);
+    }
+    return levels;
+}
+
+} // namespace
+
+namespace Moon {
+namespace Building {
+
+bool BuildingDefinitionChanges::IsFloorLevelDirty(int floorLevel) const {
+    return std::binary_search(dirtyFloorLevels.begin(), dirtyFloorLevels.end(), floorLevel);
+}
+
+size_t BuildingDelta::Count(BuildingPartType type, BuildingPartChangeType change) const {
+    return static_cast<size_t>(std::count_if(parts.begin(), parts.end(), [&](const BuildingPartChange& part) {
+        return part.type == type && part.change == change;
+    }));
+}
+
+BuildingDefinitionChanges BuildingChangeTracker::DiffDefinitions(const BuildingDefinition& previous,
+                                                                 const BuildingDefinition& current) {
+    BuildingDefinitionChanges changes;
+
+    // Building-wide inputs feed structure, envelope and stairs on every level
+    if (HashStyle(previous) != HashStyle(current)) {
+        changes.fullRebuildReason = "grid or style changed";
+    } else if (HashMasses(previous) != HashMasses(current)) {
+        changes.fullRebuildReason = "masses changed";
+    } else if (HashFloorStack(previous) != HashFloorStack(current)) {
+        changes.fullRebuildReason = "floor stack changed";
+    } else if (HashVerticalTransports(previous) != HashVerticalTransports(current)) {
+        changes.fullRebuildReason = "vertical transports changed";
+    }
+    changes.requiresFullRebuild = !changes.fullRebuildReason.empty();
+
+    const std::map<int, LevelContent> previousLevels = CollectLevelContent(previous);
+    const std::map<int, LevelContent> currentLevels = CollectLevelContent(current);
+
+    std::vector<int> allLevels;
+    for (const auto& entry : previousLevels) {
+        allLevels.push_back(entry.first);
+    }
+    for (const auto& entry : currentLevels) {
+        allLevels.push_back(entry.first);
+    }
+    std::sort(allLevels.begin(), allLevels.end());
+    allLevels.erase(std::unique(allLevels.begin(), allLevels.end()), allLevels.end());
+
+    for (int level : allLevels) {
+        auto previousIt = previousLevels.find(level);
+        auto currentIt = currentLevels.find(level);
+        const LevelContent* previousLevel = previousIt != previousLevels.end() ? &previousIt->second : nullptr;
+        const LevelContent* currentLevel = currentIt != currentLevels.end() ? &currentIt->second : nullptr;
+
+        // Space order matters too: it decides edge order and therefore wall ownership
+        if (previousLevel && currentLevel && previousLevel->spaces == currentLevel->spaces) {
+            continue;
+        }
+
+        changes.dirtyFloorLevels.push_back(level);
+        CollectChangedSpaces(previousLevel, currentLevel, changes.changedSpaceIds);
+    }
+
+    std::sort(changes.changedSpaceIds.begin(), changes.changedSpaceIds.end());
+    changes.changedSpaceIds.erase(
+        std::unique(changes.changedSpaceIds.begin(), changes.changedSpaceIds.end()),
+        changes.changedSpaceIds.end());
+    return changes;
+}
+
+void BuildingChangeTracker::DiffParts(const GeneratedBuilding& previous,
+                                      const GeneratedBuilding& current,
+                                      const BuildingDefinitionChanges& changes,
+                                      std::vector<BuildingPartChange>& outChanges) {
+    const PartIndex previousIndex = BuildPartIndex(previous, changes);
+    const PartIndex currentIndex = BuildPartIndex(current, changes);
+
+    DiffKeyedParts(BuildingPartType::Wall,
+        previousIndex.wallKeys, previousIndex.walls, currentIndex.wallKeys, currentIndex.walls,
+        CollectFloorLevels(previous.walls), CollectFloorLevels(current.walls),
+        [&](size_t previousIdx, size_t currentIdx) {
+            const WallSegment& a = previous.walls[previousIdx];
+            const WallSegment& b = current.walls[currentIdx];
+            return a.type == b.type && a.spaceId == b.spaceId && a.neighborSpaceId == b.neighborSpaceId &&
+                   a.height == b.height && a.thickness == b.thickness;
+        },
+        outChanges);
+
+    DiffKeyedParts(BuildingPartType::Door,
+        previousIndex.doorKeys, previousIndex.doors, currentIndex.doorKeys, currentIndex.doors,
+        CollectFloorLevels(previous.doors), CollectFloorLevels(current.doors),
+        [&](size_t previousIdx, size_t currentIdx) {
+            const Door& a = previous.doors[previousIdx];
+            const Door& b = current.doors[currentIdx];
+            return a.position == b.position && a.rotation == b.rotation && a.type == b.type &&
+                   a.width == b.width && a.height == b.height &&
+                   HostWallKey(previous, previousIndex, a.wallId) == HostWallKey(current, currentIndex, b.wallId);
+        },
+        outChanges);
+
+    DiffKeyedParts(BuildingPartType::Window,
+        previousIndex.windowKeys, previousIndex.windows, currentIndex.windowKeys, currentIndex.windows,
+        CollectFloorLevels(previous.windows), CollectFloorLevels(current.windows),
+        [&](size_t previousIdx, size_t currentIdx) {
+            const Window& a = previous.windows[previousIdx];
+            const Window& b = current.windows[currentIdx];
+            return a.position == b.position && a.rotation == b.rotation && a.width == b.width &&
+                   a.height == b.height && a.sillHeight == b.sillHeight && a.spaceId == b.spaceId;
+        },
+        outChanges);
+
+    // Plate meshes come from the building-wide structural plan; compare all of them
+    std::vector<std::string> previousMeshKeys;
+    std::vector<std::string> currentMeshKeys;
+    std::vector<int> previousMeshLevels;
+    std::vector<int> currentMeshLevels;
+    std::unordered_map<std::string, size_t> previousMeshes;
+    std::unordered_map<std::string, size_t> currentMeshes;
+    for (size_t i = 0; i < previous.floorPlateMeshes.size(); ++i) {
+        previousMeshKeys.push_back(previous.floorPlateMeshes[i].partId);
+        previousMeshLevels.push_back(ParseFloorPlateMeshLevel(previous.floorPlateMeshes[i].partId));
+        previousMeshes[previousMeshKeys.back()] = i;
+    }
+    for (size_t i = 0; i < current.floorPlateMeshes.size(); ++i) {
+        currentMeshKeys.push_back(current.floorPlateMeshes[i].partId);
+        currentMeshLevels.push_back(ParseFloorPlateMeshLevel(current.floorPlateMeshes[i].partId));
+        currentMeshes[currentMeshKeys.back()] = i;
+    }
+    DiffKeyedParts(BuildingPartType::FloorPlateMesh,
+        previousMeshKeys, previousMeshes, currentMeshKeys, currentMeshes,
+        previousMeshLevels, currentMeshLevels,
+        [&](size_t previousIdx, size_t currentIdx) {
+            const GeneratedMeshPart& a = previous.floorPlateMeshes[previousIdx];
+            const GeneratedMeshPart& b = current.floorPlateMeshes[currentIdx];
+            return a.material == b.material && SameMeshContent(a.mesh, b.mesh);
+        },
+        outChanges);
+}
+
+std::string BuildingChangeTracker::MakeWallKey(const WallSegment& wall) {
+    char buffer[128];
+    std::snprintf(buffer, sizeof(buffer), "wall_L%d_%.3f_%.3f_%.3f_%.3f",
+        wall.floorLevel, wall.start[0], wall.start[1], wall.end[0], wall.end[1]);
+    return buffer;
+}
+
+std::string BuildingChangeTracker::MakeDoorKey(const Door& door) {
+    return "door_L" + std::to_string(door.floorLevel) + "_" +
+        std::to_string(std::min(door.spaceA, door.spaceB)) + "_" +
+        std::to_string(std::max(door.spaceA, door.spaceB));
+}
+
+} // namespace Building
+} // namespace Moon
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "BuildingTypes.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Moon {
+namespace Building {
+
+/**
+ * @brief Result of diffing two building definitions
+ * Floor levels are the unit of regeneration: walls, doors and windows of a level
+ * depend only on that level's spaces plus building-wide settings.
+ */
+struct BuildingDefinitionChanges {
+    bool requiresFullRebuild = false;   // Building-wide input changed (grid, style, masses, floors, transports)
+    std::string fullRebuildReason;      // Which building-wide input changed
+    std::vector<int> dirtyFloorLevels;  // Sorted levels whose spaces changed
+    std::vector<int> changedSpaceIds;   // Sorted ids of added, removed or modified spaces
+
+    bool HasChanges() const { return requiresFullRebuild || !dirtyFloorLevels.empty(); }
+    bool IsFloorLevelDirty(int floorLevel) const;
+};
+
+enum class BuildingPartType {
+    Wall,
+    Door,
+    Window,
+    FloorPlateMesh
+};
+
+enum class BuildingPartChangeType {
+    Added,
+    Removed,
+    Modified
+};
+
+/**
+ * @brief One generated part that differs between two builds
+ * Keys are stable across rebuilds (derived from geometry and space ids, not
+ * from wall ids or vector positions), so the editor can match scene nodes.
+ */
+struct BuildingPartChange {
+    BuildingPartChangeType change = BuildingPartChangeType::Modified;
+    BuildingPartType type = BuildingPartType::Wall;
+    std::string key;
+    int floorLevel = 0;
+    size_t index = 0;   // Index in the new building (Added/Modified) or previous building (Removed)
+};
+
+/**
+ * @brief Changes produced by BuildingPipeline::RebuildBuilding
+ */
+struct BuildingDelta {
+    BuildingDefinitionChanges definitionChanges;
+    std::vector<BuildingPartChange> parts;
+    std::vector<int> regeneratedFloorLevels;  // Levels whose walls/doors/windows were regenerated
+
+    bool IsEmpty() const { return parts.empty(); }
+    size_t Count(BuildingPartType type, BuildingPartChangeType change) const;
+};
+
+/**
+ * @brief Change tracking for incremental building rebuilds
+ */
+class BuildingChangeTracker {
+public:
+    /**
+     * @brief Diff two definitions per floor level and per space
+     * @param previous Definition of the existing build
+     * @param current Edited definition
+     * @return Dirty floor levels, changed spaces, or a full-rebuild request
+     */
+    static BuildingDefinitionChanges DiffDefinitions(const BuildingDefinition& previous,
+                                                     const BuildingDefinition& current);
+
+    /**
+     * @brief Collect parts that differ between two builds
+     * Walls, doors and windows are compared on dirty floor levels only (all levels
+     * when a full rebuild was required); floor plate meshes are always compared.
+     * @param previous Existing build
+     * @param current New build
+     * @param changes Definition diff that produced current
+     * @param outChanges Output part changes (appended)
+     */
+    static void DiffParts(const GeneratedBuilding& previous,
+                          const GeneratedBuilding& current,
+                          const BuildingDefinitionChanges& changes,
+                          std::vector<BuildingPartChange>& outChanges);
+
+    /**
+     * @brief Stable part keys
+     */
+    static std::string MakeWallKey(const WallSegment& wall);
+    static std::string MakeDoorKey(const Door& door);
+};
+
+} // namespace Building
+} // namespace Moon
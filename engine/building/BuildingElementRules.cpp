@@ -1,6 +1,7 @@
 #include "BuildingElementRules.h"
 
 #include "BuildingGeometryUtils.h"
+#include "BuildingIndex.h"
 
 #include <algorithm>
 #include <cmath>
@@ -65,32 +66,52 @@ float DistanceAlongSegment(const GridPos2D& point, const WallSegment& wall) {
     return std::sqrt(segmentLengthSquared) * t;
 }
 
-float GetTopOfFloor(const BuildingDefinition& definition, int floorLevel) {
-    const float base = GetFloorBaseHeight(definition, floorLevel);
-    for (const auto& floor : definition.floors) {
-        if (floor.level == floorLevel) {
-            return base + floor.floorHeight;
-        }
-    }
-    return base;
-}
-
 float GetRenderedSlabThickness(const GeneratedBuilding& building) {
     return building.floorPlates.empty() ? 0.05f : 0.18f;
 }
 
-float GetWallBaseHeight(const GeneratedBuilding& building, int floorLevel) {
-    return GetFloorBaseHeight(building.definition, floorLevel) + GetRenderedSlabThickness(building);
-}
+/**
+ * @brief Clear height between the slab top and the floor top, per floor level
+ * Base heights are accumulated once in level order (same sums as
+ * GetFloorBaseHeight) instead of rescanning the floors for every element.
+ */
+class ClearStoryHeights {
+public:
+    explicit ClearStoryHeights(const GeneratedBuilding& building) {
+        const BuildingDefinition& definition = building.definition;
+        std::unordered_map<int, float> heightByLevel;
+        int maxLevel = 0;
+        for (const auto& floor : definition.floors) {
+            heightByLevel.emplace(floor.level, floor.floorHeight);
+            maxLevel = std::max(maxLevel, floor.level);
+        }
 
-const WallSegment* FindWallById(const GeneratedBuilding& building, int wallId) {
-    for (const auto& wall : building.walls) {
-        if (wall.wallId == wallId) {
-            return &wall;
+        const float slabThickness = GetRenderedSlabThickness(building);
+        float base = 0.0f;
+        for (int level = 0; level <= maxLevel; ++level) {
+            auto it = heightByLevel.find(level);
+            if (it != heightByLevel.end()) {
+                const float top = base + it->second;
+                m_clearHeights[level] = std::max(0.0f, top - (base + slabThickness));
+                base += it->second;
+            }
+        }
+        for (const auto& pair : heightByLevel) {
+            if (pair.first < 0) {
+                m_clearHeights[pair.first] = std::max(0.0f, pair.second - slabThickness);
+            }
         }
     }
-    return nullptr;
-}
+
+    // Levels without a floor have no clear story (the height checks are skipped)
+    float Get(int floorLevel) const {
+        auto it = m_clearHeights.find(floorLevel);
+        return it != m_clearHeights.end() ? it->second : 0.0f;
+    }
+
+private:
+    std::unordered_map<int, float> m_clearHeights;
+};
 
 void CheckWallGeometry(const GeneratedBuilding& building, BuildingQualityReport& report) {
     for (const auto& wall : building.walls) {
@@ -118,9 +139,12 @@ void CheckWallGeometry(const GeneratedBuilding& building, BuildingQualityReport&
     }
 }
 
-void CheckDoorRules(const GeneratedBuilding& building, BuildingQualityReport& report) {
+void CheckDoorRules(const GeneratedBuilding& building,
+                    const BuildingIndex& index,
+                    const ClearStoryHeights& clearHeights,
+                    BuildingQualityReport& report) {
     for (const auto& door : building.doors) {
-        const WallSegment* wall = FindWallById(building, door.wallId);
+        const WallSegment* wall = index.GetWallById(door.wallId);
         if (!wall) {
             continue;
         }
@@ -147,7 +171,7 @@ void CheckDoorRules(const GeneratedBuilding& building, BuildingQualityReport& re
                      door.floorLevel);
         }
 
-        const float clearStoryHeight = std::max(0.0f, GetTopOfFloor(building.definition, door.floorLevel) - GetWallBaseHeight(building, door.floorLevel));
+        const float clearStoryHeight = clearHeights.Get(door.floorLevel);
         if (clearStoryHeight > 0.0f && door.height > clearStoryHeight + kAlignmentEpsilon) {
             AddError(report,
                      "door_exceeds_story_height",
@@ -157,9 +181,12 @@ void CheckDoorRules(const GeneratedBuilding& building, BuildingQualityReport& re
     }
 }
 
-void CheckWindowRules(const GeneratedBuilding& building, BuildingQualityReport& report) {
+void CheckWindowRules(const GeneratedBuilding& building,
+                      const BuildingIndex& index,
+                      const ClearStoryHeights& clearHeights,
+                      BuildingQualityReport& report) {
     for (const auto& window : building.windows) {
-        const WallSegment* wall = FindWallById(building, window.wallId);
+        const WallSegment* wall = index.GetWallById(window.wallId);
         if (!wall) {
             continue;
         }
@@ -201,7 +228,7 @@ void CheckWindowRules(const GeneratedBuilding& building, BuildingQualityReport&
                      window.floorLevel);
         }
 
-        const float clearStoryHeight = std::max(0.0f, GetTopOfFloor(building.definition, window.floorLevel) - GetWallBaseHeight(building, window.floorLevel));
+        const float clearStoryHeight = clearHeights.Get(window.floorLevel);
         if (clearStoryHeight > 0.0f &&
             window.sillHeight + window.height > clearStoryHeight + kAlignmentEpsilon) {
             AddError(report,
@@ -216,9 +243,18 @@ void CheckWindowRules(const GeneratedBuilding& building, BuildingQualityReport&
 
 void AppendElementRuleViolations(const GeneratedBuilding& building,
                                  BuildingQualityReport& report) {
+    BuildingIndex index;
+    index.Build(building.definition, nullptr, &building.walls);
+    AppendElementRuleViolations(building, index, report);
+}
+
+void AppendElementRuleViolations(const GeneratedBuilding& building,
+                                 const BuildingIndex& index,
+                                 BuildingQualityReport& report) {
+    const ClearStoryHeights clearHeights(building);
     CheckWallGeometry(building, report);
-    CheckDoorRules(building, report);
-    CheckWindowRules(building, report);
+    CheckDoorRules(building, index, clearHeights, report);
+    CheckWindowRules(building, index, clearHeights, report);
 }
 
 } // namespace Building
@@ -5,7 +5,17 @@
 namespace Moon {
 namespace Building {
 
+class BuildingIndex;
+
+void AppendElementRuleViolations(const GeneratedBuilding& building,
+                                 BuildingQualityReport& report);
+
+/**
+ * @brief Same checks, resolving host walls through a prebuilt index
+ * @param index Built from building.definition with building.walls
+ */
 void AppendElementRuleViolations(const GeneratedBuilding& building,
+                                 const BuildingIndex& index,
                                  BuildingQualityReport& report);
 
 } // namespace Building
@@ -1,6 +1,9 @@
 #include "BuildingIndex.h"
 #include "SpaceGraphBuilder.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace Moon {
 namespace Building {
 
@@ -18,6 +21,7 @@ void BuildingIndex::Build(const BuildingDefinition& definition,
     m_wallMap.clear();
     m_adjacencyMap.clear();
     m_spaceToWalls.clear();
+    m_wallById.clear();
     
     // Build mass lookup
     for (const auto& mass : definition.masses) {
@@ -43,6 +47,8 @@ void BuildingIndex::Build(const BuildingDefinition& definition,
                 m_wallMap[key] = &wall;
             }
             
+            m_wallById.emplace(wall.wallId, &wall);
+
             // Build space-to-walls mapping
             m_spaceToWalls[wall.spaceId].push_back(&wall);
             if (wall.neighborSpaceId >= 0) {
@@ -98,5 +104,157 @@ std::vector<const WallSegment*> BuildingIndex::GetWallsForSpace(int spaceId) con
     return (it != m_spaceToWalls.end()) ? it->second : std::vector<const WallSegment*>{};
 }
 
+const WallSegment* BuildingIndex::GetWallById(int wallId) const {
+    auto it = m_wallById.find(wallId);
+    return (it != m_wallById.end()) ? it->second : nullptr;
+}
+
+namespace {
+
+// Query boxes are widened by this much so touching rects stay candidates; rects
+// are inserted slightly inset, so a rect whose edge sits on a cell boundary only
+// lands in the cells its interior covers
+constexpr float kRectQueryEpsilon = 0.001f;
+constexpr float kRectInsertInset = kRectQueryEpsilon * 0.5f;
+// Keeps a floor with a few huge and many tiny rects from allocating a huge grid
+constexpr int kMaxCellsPerFloorAxis = 1024;
+
+} // namespace
+
+void BuildingIndex::BuildFloorRectIndex(const BuildingDefinition& definition) {
+    m_floorRectGrids.clear();
+    m_indexedFloorLevels.clear();
+
+    for (const auto& floor : definition.floors) {
+        auto inserted = m_floorRectGrids.emplace(floor.level, FloorRectGrid());
+        if (inserted.second) {
+            m_indexedFloorLevels.push_back(floor.level);
+        }
+        auto& entries = inserted.first->second.entries;
+        for (const auto& space : floor.spaces) {
+            for (const auto& rect : space.rects) {
+                entries.push_back({&rect, space.spaceId});
+            }
+        }
+    }
+
+    for (auto& pair : m_floorRectGrids) {
+        FloorRectGrid& grid = pair.second;
+        if (grid.entries.empty()) {
+            continue;
+        }
+
+        float minX = grid.entries[0].rect->origin[0];
+        float minY = grid.entries[0].rect->origin[1];
+        float maxX = minX;
+        float maxY = minY;
+        double extentSum = 0.0;
+        for (const auto& entry : grid.entries) {
+            const Rect& rect = *entry.rect;
+            minX = std::min(minX, rect.origin[0]);
+            minY = std::min(minY, rect.origin[1]);
+            maxX = std::max(maxX, rect.origin[0] + rect.size[0]);
+            maxY = std::max(maxY, rect.origin[1] + rect.size[1]);
+            extentSum += std::max(std::abs(rect.size[0]), std::abs(rect.size[1]));
+        }
+
+        // Cell size ~ average rect extent, so each rect lands in a handful of cells
+        const float width = std::max(maxX - minX, kRectQueryEpsilon);
+        const float depth = std::max(maxY - minY, kRectQueryEpsilon);
+        float cellSize = std::max(static_cast<float>(extentSum / grid.entries.size()), 0.1f);
+        cellSize = std::max(cellSize, std::max(width, depth) / static_cast<float>(kMaxCellsPerFloorAxis));
+
+        grid.origin = {minX, minY};
+        grid.cellSize = cellSize;
+        grid.cellsX = std::max(1, static_cast<int>(std::ceil(width / cellSize)));
+        grid.cellsY = std::max(1, static_cast<int>(std::ceil(depth / cellSize)));
+
+        // Two passes (count, then fill) keep every cell list in one contiguous array
+        const size_t cellCount = static_cast<size_t>(grid.cellsX) * static_cast<size_t>(grid.cellsY);
+        grid.cellStart.assign(cellCount + 1, 0);
+        for (int pass = 0; pass < 2; ++pass) {
+            std::vector<uint32_t> cursor;
+            if (pass == 1) {
+                for (size_t c = 0; c < cellCount; ++c) {
+                    grid.cellStart[c + 1] += grid.cellStart[c];
+                }
+                grid.cellEntries.resize(grid.cellStart[cellCount]);
+                cursor.assign(grid.cellStart.begin(), grid.cellStart.end() - 1);
+            }
+
+            for (uint32_t i = 0; i < grid.entries.size(); ++i) {
+                const Rect& rect = *grid.entries[i].rect;
+                int x0, y0, x1, y1;
+                CellRange(grid, rect.origin[0], rect.origin[1],
+                          rect.origin[0] + rect.size[0], rect.origin[1] + rect.size[1],
+                          -kRectInsertInset, x0, y0, x1, y1);
+                for (int y = y0; y <= y1; ++y) {
+                    for (int x = x0; x <= x1; ++x) {
+                        const size_t cell = static_cast<size_t>(y) * grid.cellsX + x;
+                        if (pass == 0) {
+                            ++grid.cellStart[cell + 1];
+                        } else {
+                            grid.cellEntries[cursor[cell]++] = i;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+const std::vector<FloorRectEntry>& BuildingIndex::GetFloorRects(int floorLevel) const {
+    static const std::vector<FloorRectEntry> kEmpty;
+    auto it = m_floorRectGrids.find(floorLevel);
+    return (it != m_floorRectGrids.end()) ? it->second.entries : kEmpty;
+}
+
+void BuildingIndex::CellRange(const FloorRectGrid& grid, float minX, float minY, float maxX, float maxY,
+                              float pad, int& x0, int& y0, int& x1, int& y1) const {
+    auto toCell = [&](float value, float origin, int cells) {
+        const float cell = std::floor((value - origin) / grid.cellSize);
+        return static_cast<int>(std::max(0.0f, std::min(cell, static_cast<float>(cells - 1))));
+    };
+    auto padRange = [pad](float a, float b, float& lo, float& hi) {
+        lo = std::min(a, b) - pad;
+        hi = std::max(a, b) + pad;
+        if (lo > hi) {
+            lo = hi = (a + b) * 0.5f;
+        }
+    };
+    float loX, hiX, loY, hiY;
+    padRange(minX, maxX, loX, hiX);
+    padRange(minY, maxY, loY, hiY);
+    x0 = toCell(loX, grid.origin[0], grid.cellsX);
+    y0 = toCell(loY, grid.origin[1], grid.cellsY);
+    x1 = toCell(hiX, grid.origin[0], grid.cellsX);
+    y1 = toCell(hiY, grid.origin[1], grid.cellsY);
+}
+
+void BuildingIndex::QueryFloorRects(int floorLevel,
+                                    const GridPos2D& minCorner,
+                                    const GridPos2D& maxCorner,
+                                    std::vector<uint32_t>& outIndices) const {
+    outIndices.clear();
+    auto it = m_floorRectGrids.find(floorLevel);
+    if (it == m_floorRectGrids.end() || it->second.entries.empty()) {
+        return;
+    }
+
+    const FloorRectGrid& grid = it->second;
+    int x0, y0, x1, y1;
+    CellRange(grid, minCorner[0], minCorner[1], maxCorner[0], maxCorner[1], kRectQueryEpsilon, x0, y0, x1, y1);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            const size_t cell = static_cast<size_t>(y) * grid.cellsX + x;
+            outIndices.insert(outIndices.end(),
+                              grid.cellEntries.begin() + grid.cellStart[cell],
+                              grid.cellEntries.begin() + grid.cellStart[cell + 1]);
+        }
+    }
+    std::sort(outIndices.begin(), outIndices.end());
+    outIndices.erase(std::unique(outIndices.begin(), outIndices.end()), outIndices.end());
+}
+
 } // namespace Building
 } // namespace Moon
@@ -2,6 +2,7 @@
 
 #include "BuildingTypes.h"
 #include "SpaceGraphBuilder.h"
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -39,6 +40,14 @@ struct AdjacencyKeyHash {
     }
 };
 
+/**
+ * @brief Space rect stored in the per-floor spatial index
+ */
+struct FloorRectEntry {
+    const Rect* rect;
+    int spaceId;
+};
+
 /**
  * @brief Building Index
  * Unified lookup data structures for all building components.
@@ -106,7 +115,56 @@ public:
      */
     std::vector<const WallSegment*> GetWallsForSpace(int spaceId) const;
 
+    /**
+     * @brief Find wall by wall ID (O(1), requires walls passed to Build)
+     * @return Pointer to wall, or nullptr if not found
+     */
+    const WallSegment* GetWallById(int wallId) const;
+
+    /**
+     * @brief Build the per-floor uniform grid over space rects
+     * Kept separate from Build() because only the validators need it. Floors
+     * that share a level are indexed together.
+     */
+    void BuildFloorRectIndex(const BuildingDefinition& definition);
+
+    /**
+     * @brief Floor levels with indexed rects, in order of first appearance
+     */
+    const std::vector<int>& GetIndexedFloorLevels() const { return m_indexedFloorLevels; }
+
+    /**
+     * @brief All indexed rects on a floor level (empty if none)
+     */
+    const std::vector<FloorRectEntry>& GetFloorRects(int floorLevel) const;
+
+    /**
+     * @brief Indices (into GetFloorRects) of rects whose bounds touch the query box
+     * Candidates are conservative: callers apply their own exact overlap test.
+     * Results are sorted ascending and unique.
+     */
+    void QueryFloorRects(int floorLevel,
+                         const GridPos2D& minCorner,
+                         const GridPos2D& maxCorner,
+                         std::vector<uint32_t>& outIndices) const;
+
 private:
+    /**
+     * @brief Uniform grid over one floor's rects (CSR cell lists)
+     */
+    struct FloorRectGrid {
+        std::vector<FloorRectEntry> entries;
+        GridPos2D origin = {0.0f, 0.0f};
+        float cellSize = 1.0f;
+        int cellsX = 0;
+        int cellsY = 0;
+        std::vector<uint32_t> cellStart;    // cellsX * cellsY + 1 offsets into cellEntries
+        std::vector<uint32_t> cellEntries;
+    };
+
+    void CellRange(const FloorRectGrid& grid, float minX, float minY, float maxX, float maxY,
+                   float pad, int& x0, int& y0, int& x1, int& y1) const;
+
     // Space lookup: spaceId -> Space*
     std::unordered_map<int, const Space*> m_spaceMap;
     
@@ -128,6 +186,13 @@ private:
     
     // Space to walls: spaceId -> vector of WallSegment*
     std::unordered_map<int, std::vector<const WallSegment*>> m_spaceToWalls;
+
+    // Wall lookup by ID: wallId -> WallSegment*
+    std::unordered_map<int, const WallSegment*> m_wallById;
+
+    // Per-floor rect grids: floorLevel -> grid (built by BuildFloorRectIndex)
+    std::unordered_map<int, FloorRectGrid> m_floorRectGrids;
+    std::vector<int> m_indexedFloorLevels;
 };
 
 } // namespace Building
@@ -1,5 +1,6 @@
 #include "BuildingPipeline.h"
 #include "BuildingGeometryUtils.h"
+#include "BuildingTaskPool.h"
 #include "LayoutResolver.h"
 #include "../core/Assets/AssetPaths.h"
 #include "../core/Geometry/MeshGenerator.h"
@@ -7,11 +8,15 @@
 #include "../massing/MassRuleParser.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <map>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace {
@@ -165,6 +170,86 @@ void RemoveSolidFloorMeshesForVoidedPlates(Moon::Building::GeneratedBuilding& ge
         generated.floorPlateMeshes.end());
 }
 
+std::vector<int> CollectFloorLevels(const Moon::Building::BuildingDefinition& definition) {
+    std::vector<int> levels;
+    levels.reserve(definition.floors.size());
+    for (const auto& floor : definition.floors) {
+        levels.push_back(floor.level);
+    }
+    std::sort(levels.begin(), levels.end());
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+    return levels;
+}
+
+size_t FindFloorLevelSlot(const std::vector<int>& floorLevels, int level) {
+    return static_cast<size_t>(
+        std::lower_bound(floorLevels.begin(), floorLevels.end(), level) - floorLevels.begin());
+}
+
+Moon::Building::BuildingDefinition BuildLevelDefinition(const Moon::Building::BuildingDefinition& definition,
+                                                       int floorLevel) {
+    Moon::Building::BuildingDefinition levelDefinition;
+    levelDefinition.schema = definition.schema;
+    levelDefinition.grid = definition.grid;
+    levelDefinition.style = definition.style;
+    for (const auto& floor : definition.floors) {
+        if (floor.level == floorLevel) {
+            levelDefinition.floors.push_back(floor);
+        }
+    }
+    return levelDefinition;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool BuildMassEnvelope(const Moon::Building::Mass& mass,
+                       const Moon::Building::BuildingDefinition& definition,
+                       std::vector<Moon::Building::GeneratedMeshPart>& outParts,
+                       std::string& outError,
+                       size_t threadCount = 0) {
+    if (mass.massingRuleAsset.empty()) {
+        Moon::Building::GeneratedMeshPart part;
+        part.partId = mass.massId + "_envelope_box";
+        part.material = "envelope_shell";
+        part.mesh = CreateMassBoxMesh(mass, definition);
+        outParts.push_back(std::move(part));
+        return true;
+    }
+
+    const std::filesystem::path rulePath =
+        std::filesystem::path(Moon::Assets::BuildAssetPath("massing")) / mass.massingRuleAsset;
+    const std::string ruleJson = ReadTextFile(rulePath);
+    if (ruleJson.empty()) {
+        outError = "Failed to read massing envelope rule: " + rulePath.string();
+        return false;
+    }
+
+    Moon::Massing::RuleSet ruleSet;
+    if (!Moon::Massing::MassRuleParser::ParseFromString(ruleJson, ruleSet, outError)) {
+        outError = "Failed to parse massing envelope rule: " + outError;
+        return false;
+    }
+
+    Moon::Massing::MassBuildOptions buildOptions;
+    buildOptions.threadCount = threadCount;
+    Moon::Massing::MassBuildResult buildResult;
+    if (!Moon::Massing::MassMeshBuilder::Build(ruleSet, buildOptions, buildResult, outError)) {
+        outError = "Failed to build massing envelope mesh: " + outError;
+        return false;
+    }
+
+    for (size_t i = 0; i < buildResult.items.size(); ++i) {
+        Moon::Building::GeneratedMeshPart part;
+        part.partId = mass.massId + "_envelope_" + std::to_string(i);
+        part.material = "envelope_shell";
+        part.mesh = buildResult.items[i].mesh;
+        outParts.push_back(std::move(part));
+    }
+    return true;
+}
+
 } // namespace
 
 namespace Moon {
@@ -187,6 +272,30 @@ BuildingPipeline::BuildingPipeline() {
 
 BuildingPipeline::~BuildingPipeline() {}
 
+void BuildingPipeline::SetWorkerCount(size_t workerCount) {
+    if (workerCount != m_workerCount) {
+        m_workerCount = workerCount;
+        m_taskPool.reset();
+    }
+}
+
+void BuildingPipeline::RunFloorTasks(size_t taskCount, const std::function<void(size_t)>& task) {
+    if (m_executionMode == PipelineExecutionMode::FloorParallel) {
+        GetTaskPool()->Run(taskCount, task);
+        return;
+    }
+    for (size_t i = 0; i < taskCount; ++i) {
+        task(i);
+    }
+}
+
+BuildingTaskPool* BuildingPipeline::GetTaskPool() {
+    if (!m_taskPool) {
+        m_taskPool = std::make_unique<BuildingTaskPool>(m_workerCount);
+    }
+    return m_taskPool.get();
+}
+
 bool BuildingPipeline::ProcessBuilding(const std::string& jsonStr,
                                        GeneratedBuilding& outBuilding,
                                        std::string& outError) {
@@ -215,9 +324,17 @@ bool BuildingPipeline::ProcessBuildingInternal(const BuildingDefinition& definit
                                               const BuildingLayoutInput* layoutInput,
                                               GeneratedBuilding& outBuilding,
                                               std::string& outError) {
+    const auto totalStart = std::chrono::steady_clock::now();
+    BuildingPipelineStats& stats = outBuilding.pipelineStats;
+    stats = BuildingPipelineStats();
+    stats.floorParallel = m_executionMode == PipelineExecutionMode::FloorParallel;
+    stats.workerCount = stats.floorParallel ? GetTaskPool()->GetWorkerCount() : 1;
+
     BuildingDefinition workingDefinition = definition;
 
-    ValidationResult layoutResult = m_layoutValidator.Validate(workingDefinition);
+    auto stageStart = std::chrono::steady_clock::now();
+    ValidationResult layoutResult = m_layoutValidator.Validate(workingDefinition, stats.floorParallel ? GetTaskPool() : nullptr);
+    stats.validationMs = ElapsedMs(stageStart);
     if (!layoutResult.valid) {
         outError = FormatValidationErrors(layoutResult);
         return false;
@@ -231,47 +348,311 @@ bool BuildingPipeline::ProcessBuildingInternal(const BuildingDefinition& definit
         return false;
     }
 
-    if (!GenerateStructuralPlan(workingDefinition, outBuilding)) {
+    stageStart = std::chrono::steady_clock::now();
+    const bool structuralOk = GenerateStructuralPlan(workingDefinition, outBuilding);
+    stats.structuralMs = ElapsedMs(stageStart);
+    if (!structuralOk) {
         outError = "Structural planning failed";
         return false;
     }
 
-    if (!GenerateEnvelopeMeshes(workingDefinition, outBuilding, outError)) {
+    stageStart = std::chrono::steady_clock::now();
+    const bool envelopeOk = GenerateEnvelopeMeshes(workingDefinition, outBuilding, outError);
+    stats.envelopeMs = ElapsedMs(stageStart);
+    if (!envelopeOk) {
         return false;
     }
 
-    ApplyMassDrivenSemanticLayout(workingDefinition, formInput, layoutInput, outBuilding, outError);
+    stageStart = std::chrono::steady_clock::now();
+    ApplyMassDrivenSemanticLayout(workingDefinition, formInput, layoutInput, outBuilding,
+                                  stats.floorParallel ? GetTaskPool() : nullptr, outError);
+    stats.semanticLayoutMs = ElapsedMs(stageStart);
     if (!outError.empty()) {
         return false;
     }
     outBuilding.definition = workingDefinition;
     RemoveSolidFloorMeshesForVoidedPlates(outBuilding);
     
-    if (!BuildSpaceGraph(workingDefinition, outBuilding)) {
+    stageStart = std::chrono::steady_clock::now();
+    const bool spaceGraphOk = BuildSpaceGraph(workingDefinition, outBuilding);
+    stats.spaceGraphMs = ElapsedMs(stageStart);
+    if (!spaceGraphOk) {
         outError = "Space graph construction failed";
         return false;
     }
 
-    if (!GenerateWalls(workingDefinition, outBuilding)) {
+    // Floor levels never share walls, doors or windows, so these stages fan out per level
+    const std::vector<int> floorLevels = CollectFloorLevels(workingDefinition);
+    stats.floorLevelCount = floorLevels.size();
+
+    stageStart = std::chrono::steady_clock::now();
+    const bool wallsOk = stats.floorParallel
+        ? GenerateWallsPerFloor(workingDefinition, floorLevels, outBuilding)
+        : GenerateWalls(workingDefinition, outBuilding);
+    stats.wallsMs = ElapsedMs(stageStart);
+    if (!wallsOk) {
         outError = "Wall generation failed";
         return false;
     }
 
-    if (!GenerateDoors(workingDefinition, outBuilding)) {
+    stageStart = std::chrono::steady_clock::now();
+    const bool doorsOk = stats.floorParallel
+        ? GenerateDoorsPerFloor(workingDefinition, floorLevels, outBuilding)
+        : GenerateDoors(workingDefinition, outBuilding);
+    stats.doorsMs = ElapsedMs(stageStart);
+    if (!doorsOk) {
         outError = "Door generation failed";
         return false;
     }
 
-    if (!GenerateStairs(workingDefinition, outBuilding)) {
+    stageStart = std::chrono::steady_clock::now();
+    const bool stairsOk = GenerateStairs(workingDefinition, outBuilding);
+    stats.stairsMs = ElapsedMs(stageStart);
+    if (!stairsOk) {
         outError = "Stair generation failed";
         return false;
     }
 
-    if (!GenerateFacade(workingDefinition, outBuilding)) {
+    stageStart = std::chrono::steady_clock::now();
+    const bool facadeOk = stats.floorParallel
+        ? GenerateFacadePerFloor(workingDefinition, floorLevels, outBuilding)
+        : GenerateFacade(workingDefinition, outBuilding);
+    stats.facadeMs = ElapsedMs(stageStart);
+    if (!facadeOk) {
         outError = "Facade generation failed";
         return false;
     }
-    
+
+    stats.totalMs = ElapsedMs(totalStart);
+    return true;
+}
+
+bool BuildingPipeline::RebuildBuilding(const GeneratedBuilding& previous,
+                                       const BuildingDefinition& definition,
+                                       GeneratedBuilding& outBuilding,
+                                       BuildingDelta& outDelta,
+                                       std::string& outError) {
+    BuildingDelta delta;
+    delta.definitionChanges = BuildingChangeTracker::DiffDefinitions(previous.definition, definition);
+    const BuildingDefinitionChanges& changes = delta.definitionChanges;
+
+    if (!changes.HasChanges()) {
+        outBuilding = previous;
+        outDelta = std::move(delta);
+        return true;
+    }
+
+    // Build into a local so previous stays intact when it aliases outBuilding
+    GeneratedBuilding rebuilt;
+    if (changes.requiresFullRebuild) {
+        if (!ProcessBuilding(definition, rebuilt, outError)) {
+            return false;
+        }
+        delta.regeneratedFloorLevels = CollectFloorLevels(rebuilt.definition);
+    } else {
+        if (!RebuildChangedFloors(previous, definition, changes, rebuilt, outError)) {
+            return false;
+        }
+        delta.regeneratedFloorLevels = changes.dirtyFloorLevels;
+    }
+
+    BuildingChangeTracker::DiffParts(previous, rebuilt, changes, delta.parts);
+
+    // Share unchanged plate meshes so callers can keep their GPU buffers
+    std::unordered_set<std::string> changedMeshes;
+    for (const auto& part : delta.parts) {
+        if (part.type == BuildingPartType::FloorPlateMesh) {
+            changedMeshes.insert(part.key);
+        }
+    }
+    for (auto& part : rebuilt.floorPlateMeshes) {
+        if (changedMeshes.count(part.partId) > 0) {
+            continue;
+        }
+        for (const auto& previousPart : previous.floorPlateMeshes) {
+            if (previousPart.partId == part.partId) {
+                part.mesh = previousPart.mesh;
+                break;
+            }
+        }
+    }
+
+    outBuilding = std::move(rebuilt);
+    outDelta = std::move(delta);
+    return true;
+}
+
+bool BuildingPipeline::RebuildChangedFloors(const GeneratedBuilding& previous,
+                                            const BuildingDefinition& definition,
+                                            const BuildingDefinitionChanges& changes,
+                                            GeneratedBuilding& outBuilding,
+                                            std::string& outError) {
+    const auto totalStart = std::chrono::steady_clock::now();
+    BuildingPipelineStats& stats = outBuilding.pipelineStats;
+    stats = BuildingPipelineStats();
+    stats.floorParallel = m_executionMode == PipelineExecutionMode::FloorParallel;
+    stats.workerCount = stats.floorParallel ? GetTaskPool()->GetWorkerCount() : 1;
+
+    auto stageStart = std::chrono::steady_clock::now();
+    ValidationResult layoutResult = m_layoutValidator.Validate(definition, stats.floorParallel ? GetTaskPool() : nullptr);
+    stats.validationMs = ElapsedMs(stageStart);
+    if (!layoutResult.valid) {
+        outError = FormatValidationErrors(layoutResult);
+        return false;
+    }
+
+    outBuilding.definition = definition;
+    outBuilding.verticalTransports = definition.verticalTransports;
+
+    // Cores and columns span floors, so the structural plan is always recomputed
+    stageStart = std::chrono::steady_clock::now();
+    const bool structuralOk = GenerateStructuralPlan(definition, outBuilding);
+    stats.structuralMs = ElapsedMs(stageStart);
+    if (!structuralOk) {
+        outError = "Structural planning failed";
+        return false;
+    }
+    RemoveSolidFloorMeshesForVoidedPlates(outBuilding);
+
+    // Envelopes depend only on masses and floor heights, which are unchanged here
+    outBuilding.envelopeMeshes = previous.envelopeMeshes;
+
+    stageStart = std::chrono::steady_clock::now();
+    BuildSpaceGraph(definition, outBuilding);
+    stats.spaceGraphMs = ElapsedMs(stageStart);
+
+    const std::vector<int> floorLevels = CollectFloorLevels(definition);
+    stats.floorLevelCount = floorLevels.size();
+    std::vector<size_t> dirtySlots;
+    for (size_t slot = 0; slot < floorLevels.size(); ++slot) {
+        if (changes.IsFloorLevelDirty(floorLevels[slot])) {
+            dirtySlots.push_back(slot);
+        }
+    }
+    auto findSlot = [&floorLevels](int level) {
+        const size_t slot = FindFloorLevelSlot(floorLevels, level);
+        return slot < floorLevels.size() && floorLevels[slot] == level ? slot : floorLevels.size();
+    };
+
+    // Walls: regenerate dirty levels, keep clean levels, then renumber in level order
+    stageStart = std::chrono::steady_clock::now();
+    std::vector<std::vector<WallSegment>> levelWalls(floorLevels.size());
+    for (const auto& wall : previous.walls) {
+        const size_t slot = findSlot(wall.floorLevel);
+        if (slot < floorLevels.size() && !changes.IsFloorLevelDirty(wall.floorLevel)) {
+            levelWalls[slot].push_back(wall);
+        }
+    }
+    RunFloorTasks(dirtySlots.size(), [&](size_t i) {
+        const size_t slot = dirtySlots[i];
+        WallGenerator wallGenerator = m_wallGenerator;
+        wallGenerator.GenerateWalls(BuildLevelDefinition(definition, floorLevels[slot]),
+                                    m_spaceGraphBuilder, levelWalls[slot]);
+    });
+
+    std::unordered_map<int, int> reusedWallIds;  // previous wallId -> new wallId
+    outBuilding.walls.clear();
+    for (size_t slot = 0; slot < floorLevels.size(); ++slot) {
+        const bool reused = !changes.IsFloorLevelDirty(floorLevels[slot]);
+        for (auto& wall : levelWalls[slot]) {
+            const int wallId = static_cast<int>(outBuilding.walls.size());
+            if (reused) {
+                reusedWallIds[wall.wallId] = wallId;
+            }
+            wall.wallId = wallId;
+            outBuilding.walls.push_back(wall);
+        }
+    }
+    auto remapWallId = [&reusedWallIds](int wallId) {
+        auto it = reusedWallIds.find(wallId);
+        return it != reusedWallIds.end() ? it->second : -1;
+    };
+    stats.wallsMs = ElapsedMs(stageStart);
+
+    // Doors: clean levels replay their previous doors per space pair in adjacency order
+    stageStart = std::chrono::steady_clock::now();
+    BuildingIndex index;
+    index.Build(definition, &m_spaceGraphBuilder, &outBuilding.walls);
+
+    using DoorPairKey = std::tuple<int, int, int>;
+    auto makePairKey = [](int floorLevel, int spaceA, int spaceB) {
+        return DoorPairKey(floorLevel, std::min(spaceA, spaceB), std::max(spaceA, spaceB));
+    };
+    std::map<DoorPairKey, std::vector<size_t>> previousDoors;
+    for (size_t i = 0; i < previous.doors.size(); ++i) {
+        const Door& door = previous.doors[i];
+        if (!changes.IsFloorLevelDirty(door.floorLevel)) {
+            previousDoors[makePairKey(door.floorLevel, door.spaceA, door.spaceB)].push_back(i);
+        }
+    }
+    std::map<DoorPairKey, size_t> previousDoorCursor;
+
+    const auto& adjacencies = m_spaceGraphBuilder.GetAdjacencies();
+    std::vector<Door> doorSlots(adjacencies.size());
+    std::vector<char> placed(adjacencies.size(), 0);
+    std::vector<std::vector<size_t>> dirtyAdjacencies(floorLevels.size());
+    for (size_t i = 0; i < adjacencies.size(); ++i) {
+        const SpaceAdjacency& adjacency = adjacencies[i];
+        const size_t slot = findSlot(adjacency.floorLevel);
+        if (slot == floorLevels.size()) {
+            continue;
+        }
+        if (changes.IsFloorLevelDirty(adjacency.floorLevel)) {
+            dirtyAdjacencies[slot].push_back(i);
+            continue;
+        }
+
+        const DoorPairKey key = makePairKey(adjacency.floorLevel, adjacency.spaceA, adjacency.spaceB);
+        auto doorsIt = previousDoors.find(key);
+        size_t& cursor = previousDoorCursor[key];
+        if (doorsIt != previousDoors.end() && cursor < doorsIt->second.size()) {
+            doorSlots[i] = previous.doors[doorsIt->second[cursor++]];
+            doorSlots[i].wallId = remapWallId(doorSlots[i].wallId);
+            placed[i] = 1;
+        }
+    }
+    RunFloorTasks(dirtySlots.size(), [&](size_t i) {
+        for (size_t adjacencyIndex : dirtyAdjacencies[dirtySlots[i]]) {
+            placed[adjacencyIndex] =
+                m_doorGenerator.TryCreateDoor(adjacencies[adjacencyIndex], index, doorSlots[adjacencyIndex]) ? 1 : 0;
+        }
+    });
+
+    outBuilding.doors.clear();
+    for (size_t i = 0; i < adjacencies.size(); ++i) {
+        if (placed[i]) {
+            outBuilding.doors.push_back(doorSlots[i]);
+        }
+    }
+    stats.doorsMs = ElapsedMs(stageStart);
+
+    // Stair runs can connect a dirty level to a clean one; recompute them all
+    stageStart = std::chrono::steady_clock::now();
+    GenerateStairs(definition, outBuilding);
+    stats.stairsMs = ElapsedMs(stageStart);
+
+    // Windows: regenerate dirty levels from their new walls, reuse clean levels
+    stageStart = std::chrono::steady_clock::now();
+    std::vector<std::vector<Window>> levelWindows(floorLevels.size());
+    for (const auto& window : previous.windows) {
+        const size_t slot = findSlot(window.floorLevel);
+        if (slot < floorLevels.size() && !changes.IsFloorLevelDirty(window.floorLevel)) {
+            levelWindows[slot].push_back(window);
+            levelWindows[slot].back().wallId = remapWallId(window.wallId);
+        }
+    }
+    RunFloorTasks(dirtySlots.size(), [&](size_t i) {
+        const size_t slot = dirtySlots[i];
+        m_facadeGenerator.GenerateWindows(definition, levelWalls[slot], index, levelWindows[slot]);
+    });
+
+    outBuilding.windows.clear();
+    for (const auto& windows : levelWindows) {
+        outBuilding.windows.insert(outBuilding.windows.end(), windows.begin(), windows.end());
+    }
+    stats.facadeMs = ElapsedMs(stageStart);
+
+    stats.totalMs = ElapsedMs(totalStart);
     return true;
 }
 
@@ -287,7 +668,8 @@ bool BuildingPipeline::ValidateOnly(const std::string& jsonStr,
     }
     
     // Validate layout
-    outResult = m_layoutValidator.Validate(definition);
+    outResult = m_layoutValidator.Validate(
+        definition, m_executionMode == PipelineExecutionMode::FloorParallel ? GetTaskPool() : nullptr);
     return outResult.valid;
 }
 
@@ -307,6 +689,7 @@ void BuildingPipeline::ApplyMassDrivenSemanticLayout(BuildingDefinition& definit
                                                      const BuildingFormInput* formInput,
                                                      const BuildingLayoutInput* layoutInput,
                                                      GeneratedBuilding& generated,
+                                                     BuildingTaskPool* pool,
                                                      std::string& outError) const {
     if (generated.floorPlates.empty()) {
         return;
@@ -326,7 +709,9 @@ void BuildingPipeline::ApplyMassDrivenSemanticLayout(BuildingDefinition& definit
         definition.floors,
         &resolvedLayout,
         &generated.programBlocks,
-        outError);
+        outError,
+        pool,
+        &generated.pipelineStats.layoutSearch);
 
     if (!outError.empty()) {
         return;
@@ -395,45 +780,119 @@ bool BuildingPipeline::GenerateEnvelopeMeshes(const BuildingDefinition& definiti
                                               std::string& outError) {
     outBuilding.envelopeMeshes.clear();
 
-    for (const auto& mass : definition.masses) {
-        if (mass.massingRuleAsset.empty()) {
-            GeneratedMeshPart part;
-            part.partId = mass.massId + "_envelope_box";
-            part.material = "envelope_shell";
-            part.mesh = CreateMassBoxMesh(mass, definition);
-            outBuilding.envelopeMeshes.push_back(std::move(part));
-            continue;
+    if (m_executionMode != PipelineExecutionMode::FloorParallel) {
+        for (const auto& mass : definition.masses) {
+            if (!BuildMassEnvelope(mass, definition, outBuilding.envelopeMeshes, outError)) {
+                return false;
+            }
         }
+        return true;
+    }
 
-        const std::filesystem::path rulePath =
-            std::filesystem::path(Moon::Assets::BuildAssetPath("massing")) / mass.massingRuleAsset;
-        const std::string ruleJson = ReadTextFile(rulePath);
-        if (ruleJson.empty()) {
-            outError = "Failed to read massing envelope rule: " + rulePath.string();
+    // One task per mass; merge in mass order and report the first failing mass like the serial loop.
+    // The pool's workers are split between the masses so nested massing threads do not oversubscribe.
+    const size_t massCount = definition.masses.size();
+    const size_t threadsPerMass = std::max<size_t>(1, GetTaskPool()->GetWorkerCount() / std::max<size_t>(1, massCount));
+    std::vector<std::vector<GeneratedMeshPart>> massParts(massCount);
+    std::vector<std::string> massErrors(massCount);
+    std::vector<char> massOk(massCount, 0);
+    GetTaskPool()->Run(massCount, [&](size_t i) {
+        massOk[i] = BuildMassEnvelope(definition.masses[i], definition, massParts[i], massErrors[i], threadsPerMass) ? 1 : 0;
+    });
+
+    for (size_t i = 0; i < massCount; ++i) {
+        if (!massOk[i]) {
+            outError = massErrors[i];
             return false;
         }
+        for (auto& part : massParts[i]) {
+            outBuilding.envelopeMeshes.push_back(std::move(part));
+        }
+    }
+    return true;
+}
 
-        Moon::Massing::RuleSet ruleSet;
-        if (!Moon::Massing::MassRuleParser::ParseFromString(ruleJson, ruleSet, outError)) {
-            outError = "Failed to parse massing envelope rule: " + outError;
-            return false;
+bool BuildingPipeline::GenerateWallsPerFloor(const BuildingDefinition& definition,
+                                             const std::vector<int>& floorLevels,
+                                             GeneratedBuilding& outBuilding) {
+    // WallGenerator sorts by floor level first, so concatenating per-level results
+    // in level order reproduces the whole-building wall list
+    std::vector<std::vector<WallSegment>> levelWalls(floorLevels.size());
+    GetTaskPool()->Run(floorLevels.size(), [&](size_t slot) {
+        WallGenerator wallGenerator = m_wallGenerator;
+        wallGenerator.GenerateWalls(BuildLevelDefinition(definition, floorLevels[slot]),
+                                    m_spaceGraphBuilder, levelWalls[slot]);
+    });
+
+    outBuilding.walls.clear();
+    for (auto& walls : levelWalls) {
+        for (auto& wall : walls) {
+            wall.wallId = static_cast<int>(outBuilding.walls.size());
+            outBuilding.walls.push_back(wall);
         }
+    }
+    return true;
+}
 
-        Moon::Massing::MassBuildResult buildResult;
-        if (!Moon::Massing::MassMeshBuilder::Build(ruleSet, buildResult, outError)) {
-            outError = "Failed to build massing envelope mesh: " + outError;
-            return false;
+bool BuildingPipeline::GenerateDoorsPerFloor(const BuildingDefinition& definition,
+                                             const std::vector<int>& floorLevels,
+                                             GeneratedBuilding& outBuilding) {
+    BuildingIndex index;
+    index.Build(definition, &m_spaceGraphBuilder, &outBuilding.walls);
+
+    // Each level fills the door slots of its own adjacencies; gathering slots in
+    // adjacency order keeps the serial door order
+    const auto& adjacencies = m_spaceGraphBuilder.GetAdjacencies();
+    std::vector<std::vector<size_t>> levelAdjacencies(floorLevels.size());
+    for (size_t i = 0; i < adjacencies.size(); ++i) {
+        const size_t slot = FindFloorLevelSlot(floorLevels, adjacencies[i].floorLevel);
+        if (slot < floorLevels.size() && floorLevels[slot] == adjacencies[i].floorLevel) {
+            levelAdjacencies[slot].push_back(i);
         }
+    }
 
-        for (size_t i = 0; i < buildResult.items.size(); ++i) {
-            GeneratedMeshPart part;
-            part.partId = mass.massId + "_envelope_" + std::to_string(i);
-            part.material = "envelope_shell";
-            part.mesh = buildResult.items[i].mesh;
-            outBuilding.envelopeMeshes.push_back(std::move(part));
+    std::vector<Door> doorSlots(adjacencies.size());
+    std::vector<char> placed(adjacencies.size(), 0);
+    GetTaskPool()->Run(floorLevels.size(), [&](size_t slot) {
+        for (size_t adjacencyIndex : levelAdjacencies[slot]) {
+            placed[adjacencyIndex] =
+                m_doorGenerator.TryCreateDoor(adjacencies[adjacencyIndex], index, doorSlots[adjacencyIndex]) ? 1 : 0;
+        }
+    });
+
+    outBuilding.doors.clear();
+    for (size_t i = 0; i < adjacencies.size(); ++i) {
+        if (placed[i]) {
+            outBuilding.doors.push_back(doorSlots[i]);
         }
     }
+    return true;
+}
 
+bool BuildingPipeline::GenerateFacadePerFloor(const BuildingDefinition& definition,
+                                              const std::vector<int>& floorLevels,
+                                              GeneratedBuilding& outBuilding) {
+    BuildingIndex index;
+    index.Build(definition, &m_spaceGraphBuilder, &outBuilding.walls);
+
+    // Walls are grouped by floor level, so per-level windows concatenate in wall order
+    std::vector<std::vector<WallSegment>> levelWalls(floorLevels.size());
+    for (const auto& wall : outBuilding.walls) {
+        const size_t slot = FindFloorLevelSlot(floorLevels, wall.floorLevel);
+        if (slot < floorLevels.size() && floorLevels[slot] == wall.floorLevel) {
+            levelWalls[slot].push_back(wall);
+        }
+    }
+
+    std::vector<std::vector<Window>> levelWindows(floorLevels.size());
+    GetTaskPool()->Run(floorLevels.size(), [&](size_t slot) {
+        m_facadeGenerator.GenerateWindows(definition, levelWalls[slot], index, levelWindows[slot]);
+    });
+
+    outBuilding.windows.clear();
+    for (const auto& windows : levelWindows) {
+        outBuilding.windows.insert(outBuilding.windows.end(), windows.begin(), windows.end());
+    }
     return true;
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "BuildingChangeTracker.h"
 #include "BuildingGenerationInputs.h"
 #include "BuildingTypes.h"
 #include "SchemaValidator.h"
@@ -13,12 +14,25 @@
 #include "SemanticFloorLayoutGenerator.h"
 #include "StructuralPlanGenerator.h"
 #include "../massing/MassMeshBuilder.h"
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace Moon {
 namespace Building {
 
+class BuildingTaskPool;
+
+/**
+ * @brief How ProcessBuilding schedules generation stages
+ */
+enum class PipelineExecutionMode {
+    Serial,         // Every stage runs over the whole building on the calling thread
+    FloorParallel   // Envelope meshes fan out per mass; walls, doors and facade per floor level
+};
+
 /**
  * @brief Building Pipeline
  * Main class that orchestrates the entire building generation pipeline
@@ -64,6 +78,28 @@ public:
                         GeneratedBuilding& outBuilding,
                         std::string& outError);
 
+    /**
+     * @brief Regenerate a building after its definition was edited
+     * Walls, doors and windows are regenerated only on floor levels whose spaces
+     * changed; clean levels keep their previous parts (wall IDs are renumbered).
+     * Structural plan, space graph and stairs are recomputed building-wide, and
+     * unchanged floor plate and envelope meshes are shared with the previous build.
+     * Falls back to a full ProcessBuilding when grid, style, masses, the floor
+     * stack or vertical transports changed. The result always matches
+     * ProcessBuilding(definition). previous and outBuilding may be the same object.
+     * @param previous Building generated from the previous definition
+     * @param definition Edited building definition
+     * @param outBuilding Output generated building data
+     * @param outDelta Added, removed and modified parts relative to previous
+     * @param outError Error message if processing fails
+     * @return true if successful, false otherwise
+     */
+    bool RebuildBuilding(const GeneratedBuilding& previous,
+                         const BuildingDefinition& definition,
+                         GeneratedBuilding& outBuilding,
+                         BuildingDelta& outDelta,
+                         std::string& outError);
+
     /**
      * @brief Validate building definition without generating
      * @param jsonStr Input JSON string
@@ -73,6 +109,33 @@ public:
     bool ValidateOnly(const std::string& jsonStr,
                      ValidationResult& outResult);
 
+    /**
+     * @brief Set stage execution mode
+     * Both modes produce identical output; FloorParallel merges per-floor results
+     * in floor-level order and renumbers wall IDs to match the serial run.
+     */
+    void SetExecutionMode(PipelineExecutionMode mode) { m_executionMode = mode; }
+    PipelineExecutionMode GetExecutionMode() const { return m_executionMode; }
+
+    /**
+     * @brief Set thread count for FloorParallel mode (0 = hardware concurrency)
+     */
+    void SetWorkerCount(size_t workerCount);
+    size_t GetWorkerCount() const { return m_workerCount; }
+
+    /**
+     * @brief Search several placement orders per semantic floor and keep the best layout
+     * Off by default (candidateCount 1). Candidates run on the worker pool in
+     * FloorParallel mode; the chosen layout depends only on the options, never on
+     * the execution mode or worker count. Results land in pipelineStats.layoutSearch.
+     */
+    void SetLayoutSearchOptions(const FloorLayoutSearchOptions& options) {
+        m_semanticFloorLayoutGenerator.SetSearchOptions(options);
+    }
+    const FloorLayoutSearchOptions& GetLayoutSearchOptions() const {
+        return m_semanticFloorLayoutGenerator.GetSearchOptions();
+    }
+
     /**
      * @brief Get schema validator
      */
@@ -95,6 +158,7 @@ private:
                                        const BuildingFormInput* formInput,
                                        const BuildingLayoutInput* layoutInput,
                                        GeneratedBuilding& generated,
+                                       BuildingTaskPool* pool,
                                        std::string& outError) const;
     bool BuildSpaceGraph(const BuildingDefinition& definition,
                         GeneratedBuilding& outBuilding);
@@ -109,6 +173,22 @@ private:
     bool GenerateEnvelopeMeshes(const BuildingDefinition& definition,
                                 GeneratedBuilding& outBuilding,
                                 std::string& outError);
+    bool GenerateWallsPerFloor(const BuildingDefinition& definition,
+                               const std::vector<int>& floorLevels,
+                               GeneratedBuilding& outBuilding);
+    bool GenerateDoorsPerFloor(const BuildingDefinition& definition,
+                               const std::vector<int>& floorLevels,
+                               GeneratedBuilding& outBuilding);
+    bool GenerateFacadePerFloor(const BuildingDefinition& definition,
+                                const std::vector<int>& floorLevels,
+                                GeneratedBuilding& outBuilding);
+    bool RebuildChangedFloors(const GeneratedBuilding& previous,
+                              const BuildingDefinition& definition,
+                              const BuildingDefinitionChanges& changes,
+                              GeneratedBuilding& outBuilding,
+                              std::string& outError);
+    void RunFloorTasks(size_t taskCount, const std::function<void(size_t)>& task);
+    BuildingTaskPool* GetTaskPool();
 
     SchemaValidator m_schemaValidator;
     LayoutValidator m_layoutValidator;
@@ -120,6 +200,10 @@ private:
     MassFloorPlateGenerator m_massFloorPlateGenerator;
     StructuralPlanGenerator m_structuralPlanGenerator;
     SemanticFloorLayoutGenerator m_semanticFloorLayoutGenerator;
+
+    PipelineExecutionMode m_executionMode = PipelineExecutionMode::Serial;
+    size_t m_workerCount = 0;
+    std::unique_ptr<BuildingTaskPool> m_taskPool;  // Created on first FloorParallel run
 };
 
 } // namespace Building
@@ -2,10 +2,13 @@
 
 #include "BuildingElementRules.h"
 #include "BuildingGeometryUtils.h"
+#include "BuildingIndex.h"
+#include "BuildingTaskPool.h"
 #include "BuildingTypology.h"
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <queue>
 #include <unordered_map>
 #include <unordered_set>
@@ -49,23 +52,43 @@ float ComputeFloorPlateArea(const FloorPlate& plate) {
     return std::max(0.0f, area);
 }
 
-const FloorPlate* FindFloorPlate(const GeneratedBuilding& building, int floorLevel) {
-    for (const auto& plate : building.floorPlates) {
-        if (plate.floorLevel == floorLevel) {
-            return &plate;
+/**
+ * @brief Lookups shared by all checks, built once per evaluation
+ */
+struct QualityCheckContext {
+    explicit QualityCheckContext(const GeneratedBuilding& inBuilding)
+        : building(inBuilding) {
+        index.Build(building.definition, nullptr, &building.walls);
+        for (const auto& plate : building.floorPlates) {
+            platesByLevel.emplace(plate.floorLevel, &plate);
+        }
+        for (const auto& wall : building.walls) {
+            wallsByFloor[wall.floorLevel].push_back(&wall);
+        }
+        for (const auto& door : building.doors) {
+            doorsByFloor[door.floorLevel].push_back(&door);
         }
     }
-    return nullptr;
-}
 
-const Floor* FindFloor(const BuildingDefinition& definition, int floorLevel) {
-    for (const auto& floor : definition.floors) {
-        if (floor.level == floorLevel) {
-            return &floor;
-        }
+    const FloorPlate* FindFloorPlate(int floorLevel) const {
+        auto it = platesByLevel.find(floorLevel);
+        return it != platesByLevel.end() ? it->second : nullptr;
+    }
+
+    template <typename T>
+    static const std::vector<const T*>& ForFloor(const std::unordered_map<int, std::vector<const T*>>& byFloor,
+                                                 int floorLevel) {
+        static const std::vector<const T*> kEmpty;
+        auto it = byFloor.find(floorLevel);
+        return it != byFloor.end() ? it->second : kEmpty;
     }
-    return nullptr;
-}
+
+    const GeneratedBuilding& building;
+    BuildingIndex index;
+    std::unordered_map<int, const FloorPlate*> platesByLevel;     // First plate per level
+    std::unordered_map<int, std::vector<const WallSegment*>> wallsByFloor;
+    std::unordered_map<int, std::vector<const Door*>> doorsByFloor;
+};
 
 bool ContainsText(const std::string& haystack, const char* needle) {
     return haystack.find(needle) != std::string::npos;
@@ -87,9 +110,9 @@ bool IsSkippableConnectivityUsage(SpaceUsage usage) {
            usage == SpaceUsage::Terrace;
 }
 
-void CheckFloorPlates(const GeneratedBuilding& building, BuildingQualityReport& report) {
-    for (const auto& floor : building.definition.floors) {
-        const FloorPlate* plate = FindFloorPlate(building, floor.level);
+void CheckFloorPlates(const QualityCheckContext& context, BuildingQualityReport& report) {
+    for (const auto& floor : context.building.definition.floors) {
+        const FloorPlate* plate = context.FindFloorPlate(floor.level);
         if (!plate) {
             AddError(report,
                      "missing_floor_plate",
@@ -123,7 +146,8 @@ void CheckFloorPlates(const GeneratedBuilding& building, BuildingQualityReport&
     }
 }
 
-void CheckVerticalCirculation(const GeneratedBuilding& building, BuildingQualityReport& report) {
+void CheckVerticalCirculation(const QualityCheckContext& context, BuildingQualityReport& report) {
+    const GeneratedBuilding& building = context.building;
     int maxLevel = -1;
     for (const auto& floor : building.definition.floors) {
         maxLevel = std::max(maxLevel, floor.level);
@@ -132,24 +156,22 @@ void CheckVerticalCirculation(const GeneratedBuilding& building, BuildingQuality
         return;
     }
 
-    for (int level = 0; level < maxLevel; ++level) {
-        bool connected = false;
-        for (const auto& stair : building.stairs) {
-            if (stair.fromLevel <= level && stair.toLevel >= level + 1) {
-                connected = true;
-                break;
-            }
-        }
-        if (!connected) {
-            for (const auto& transport : building.verticalTransports) {
-                if (transport.floorFrom <= level && transport.floorTo >= level + 1) {
-                    connected = true;
-                    break;
-                }
-            }
+    // Mark each level -> level + 1 step covered by a stair or transport run
+    std::vector<char> connected(static_cast<size_t>(maxLevel), 0);
+    auto markSpan = [&](int from, int to) {
+        for (int level = std::max(from, 0); level < std::min(to, maxLevel); ++level) {
+            connected[static_cast<size_t>(level)] = 1;
         }
+    };
+    for (const auto& stair : building.stairs) {
+        markSpan(stair.fromLevel, stair.toLevel);
+    }
+    for (const auto& transport : building.verticalTransports) {
+        markSpan(transport.floorFrom, transport.floorTo);
+    }
 
-        if (!connected) {
+    for (int level = 0; level < maxLevel; ++level) {
+        if (!connected[static_cast<size_t>(level)]) {
             AddError(report,
                      "missing_vertical_circulation",
                      "No stair or vertical transport connects consecutive floors.",
@@ -158,7 +180,8 @@ void CheckVerticalCirculation(const GeneratedBuilding& building, BuildingQuality
     }
 }
 
-void CheckConnectivity(const GeneratedBuilding& building, BuildingQualityReport& report) {
+void CheckConnectivity(const QualityCheckContext& context, BuildingQualityReport& report) {
+    const GeneratedBuilding& building = context.building;
     std::unordered_map<int, int> degreeBySpace;
     for (const auto& connection : building.connections) {
         ++degreeBySpace[connection.spaceA];
@@ -188,21 +211,18 @@ void CheckConnectivity(const GeneratedBuilding& building, BuildingQualityReport&
         }
 
         bool hasPhysicalPartitions = false;
-        for (const auto& wall : building.walls) {
-            if (wall.floorLevel != floor.level || wall.neighborSpaceId < 0) {
+        for (const WallSegment* wall : QualityCheckContext::ForFloor(context.wallsByFloor, floor.level)) {
+            if (wall->neighborSpaceId < 0) {
                 continue;
             }
-            if (relevantSpaceIds.count(wall.spaceId) && relevantSpaceIds.count(wall.neighborSpaceId)) {
+            if (relevantSpaceIds.count(wall->spaceId) && relevantSpaceIds.count(wall->neighborSpaceId)) {
                 hasPhysicalPartitions = true;
                 break;
             }
         }
         if (!hasPhysicalPartitions) {
-            for (const auto& door : building.doors) {
-                if (door.floorLevel != floor.level) {
-                    continue;
-                }
-                if (relevantSpaceIds.count(door.spaceA) && relevantSpaceIds.count(door.spaceB)) {
+            for (const Door* door : QualityCheckContext::ForFloor(context.doorsByFloor, floor.level)) {
+                if (relevantSpaceIds.count(door->spaceA) && relevantSpaceIds.count(door->spaceB)) {
                     hasPhysicalPartitions = true;
                     break;
                 }
@@ -219,27 +239,20 @@ void CheckConnectivity(const GeneratedBuilding& building, BuildingQualityReport&
     }
 }
 
-void CheckWallDoorWindowReferences(const GeneratedBuilding& building, BuildingQualityReport& report) {
-    std::unordered_set<int> wallIds;
-    for (const auto& wall : building.walls) {
-        wallIds.insert(wall.wallId);
-    }
-
-    std::unordered_set<int> spaceIds;
-    for (const auto& floor : building.definition.floors) {
-        for (const auto& space : floor.spaces) {
-            spaceIds.insert(space.spaceId);
-        }
-    }
+void CheckWallDoorWindowReferences(const QualityCheckContext& context, BuildingQualityReport& report) {
+    const GeneratedBuilding& building = context.building;
+    const BuildingIndex& index = context.index;
+    auto hasWall = [&](int wallId) { return index.GetWallById(wallId) != nullptr; };
+    auto hasSpace = [&](int spaceId) { return index.GetSpace(spaceId) != nullptr; };
 
     for (const auto& door : building.doors) {
-        if (!wallIds.count(door.wallId)) {
+        if (!hasWall(door.wallId)) {
             AddError(report,
                      "door_missing_wall",
                      "Door references a missing wall.",
                      door.floorLevel);
         }
-        if (!spaceIds.count(door.spaceA) || (door.spaceB >= 0 && !spaceIds.count(door.spaceB))) {
+        if (!hasSpace(door.spaceA) || (door.spaceB >= 0 && !hasSpace(door.spaceB))) {
             AddError(report,
                      "door_missing_space",
                      "Door references a missing space.",
@@ -253,13 +266,13 @@ void CheckWallDoorWindowReferences(const GeneratedBuilding& building, BuildingQu
                      "window_missing_wall",
                      "Window is missing a host wall assignment.",
                      window.floorLevel);
-        } else if (!wallIds.count(window.wallId)) {
+        } else if (!hasWall(window.wallId)) {
             AddError(report,
                      "window_missing_wall",
                      "Window references a missing wall.",
                      window.floorLevel);
         }
-        if (!spaceIds.count(window.spaceId)) {
+        if (!hasSpace(window.spaceId)) {
             AddError(report,
                      "window_missing_space",
                      "Window references a missing space.",
@@ -268,7 +281,8 @@ void CheckWallDoorWindowReferences(const GeneratedBuilding& building, BuildingQu
     }
 }
 
-void CheckColumnsAgainstVerticalShafts(const GeneratedBuilding& building, BuildingQualityReport& report) {
+void CheckColumnsAgainstVerticalShafts(const QualityCheckContext& context, BuildingQualityReport& report) {
+    const GeneratedBuilding& building = context.building;
     for (const auto& column : building.supportColumns) {
         for (const auto& transport : building.verticalTransports) {
             if (column.floorTo < transport.floorFrom || column.floorFrom > transport.floorTo) {
@@ -336,7 +350,8 @@ BuildingTypology InferTypologyFromResolvedDefinition(const GeneratedBuilding& bu
     return BuildingTypology::Unknown;
 }
 
-void CheckTypologySpecificSignals(const GeneratedBuilding& building, BuildingQualityReport& report) {
+void CheckTypologySpecificSignals(const QualityCheckContext& context, BuildingQualityReport& report) {
+    const GeneratedBuilding& building = context.building;
     const BuildingTypology typology = InferTypologyFromResolvedDefinition(building);
 
     if (IsOfficeTypology(typology)) {
@@ -365,7 +380,7 @@ void CheckTypologySpecificSignals(const GeneratedBuilding& building, BuildingQua
                     hasCorridor = true;
                 }
             }
-            const FloorPlate* plate = FindFloorPlate(building, floor.level);
+            const FloorPlate* plate = context.FindFloorPlate(floor.level);
             hasVoidLikePlate = plate != nullptr && !plate->voids.empty();
 
             if (!hasCorridor) {
@@ -390,15 +405,37 @@ bool BuildingQualityReport::HasErrorCode(const std::string& code) const {
     });
 }
 
-BuildingQualityReport EvaluateBuildingQuality(const GeneratedBuilding& building) {
+BuildingQualityReport EvaluateBuildingQuality(const GeneratedBuilding& building, BuildingTaskPool* pool) {
+    const QualityCheckContext context(building);
+
+    // Checks only read the context; each fills its own report, merged in this order
+    const std::function<void(BuildingQualityReport&)> checks[] = {
+        [&](BuildingQualityReport& r) { CheckFloorPlates(context, r); },
+        [&](BuildingQualityReport& r) { CheckVerticalCirculation(context, r); },
+        [&](BuildingQualityReport& r) { CheckConnectivity(context, r); },
+        [&](BuildingQualityReport& r) { CheckWallDoorWindowReferences(context, r); },
+        [&](BuildingQualityReport& r) { AppendElementRuleViolations(building, context.index, r); },
+        [&](BuildingQualityReport& r) { CheckColumnsAgainstVerticalShafts(context, r); },
+        [&](BuildingQualityReport& r) { CheckTypologySpecificSignals(context, r); },
+    };
+    constexpr size_t kCheckCount = sizeof(checks) / sizeof(checks[0]);
+
+    BuildingQualityReport partial[kCheckCount];
+    auto runCheck = [&](size_t i) { checks[i](partial[i]); };
+    if (pool) {
+        pool->Run(kCheckCount, runCheck);
+    } else {
+        for (size_t i = 0; i < kCheckCount; ++i) {
+            runCheck(i);
+        }
+    }
+
     BuildingQualityReport report;
-    CheckFloorPlates(building, report);
-    CheckVerticalCirculation(building, report);
-    CheckConnectivity(building, report);
-    CheckWallDoorWindowReferences(building, report);
-    AppendElementRuleViolations(building, report);
-    CheckColumnsAgainstVerticalShafts(building, report);
-    CheckTypologySpecificSignals(building, report);
+    for (auto& part : partial) {
+        report.passed = report.passed && part.passed;
+        report.errors.insert(report.errors.end(), part.errors.begin(), part.errors.end());
+        report.warnings.insert(report.warnings.end(), part.warnings.begin(), part.warnings.end());
+    }
     return report;
 }
 
@@ -8,6 +8,8 @@
 namespace Moon {
 namespace Building {
 
+class BuildingTaskPool;
+
 struct BuildingQualityIssue {
     std::string code;
     std::string message;
@@ -22,7 +24,15 @@ struct BuildingQualityReport {
     bool HasErrorCode(const std::string& code) const;
 };
 
-BuildingQualityReport EvaluateBuildingQuality(const GeneratedBuilding& building);
+/**
+ * @brief Run all quality checks against a generated building
+ * Lookups (floors, plates, walls by id and by floor) are indexed once and
+ * shared by every check.
+ * @param pool Optional worker pool; when set, the independent checks run concurrently.
+ *             Issues are reported in the same order either way.
+ */
+BuildingQualityReport EvaluateBuildingQuality(const GeneratedBuilding& building,
+                                              BuildingTaskPool* pool = nullptr);
 
 } // namespace Building
 } // namespace Moon
@@ -0,0 +1,113 @@
+#include "BuildingTaskPool.h"
+
+namespace Moon {
+namespace Building {
+
+BuildingTaskPool::BuildingTaskPool(size_t workerCount) {
+    const size_t resolved = ResolveWorkerCount(workerCount);
+    m_threads.reserve(resolved - 1);
+    for (size_t i = 1; i < resolved; ++i) {
+        m_threads.emplace_back(&BuildingTaskPool::WorkerLoop, this);
+    }
+}
+
+BuildingTaskPool::~BuildingTaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+size_t BuildingTaskPool::ResolveWorkerCount(size_t requested) {
+    if (requested == 0) {
+        requested = std::thread::hardware_concurrency();
+    }
+    return requested > 0 ? requested : 1;
+}
+
+void BuildingTaskPool::Run(size_t taskCount, const std::function<void(size_t)>& task) {
+    if (taskCount == 0) {
+        return;
+    }
+
+    // Nothing to fan out: run inline without waking workers
+    if (m_threads.empty() || taskCount == 1) {
+        for (size_t i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_taskCount = taskCount;
+        m_nextTask.store(0);
+        m_busyWorkers = m_threads.size();
+        m_error = nullptr;
+        ++m_generation;
+    }
+    m_wakeCondition.notify_all();
+
+    DrainTasks(task, taskCount);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCondition.wait(lock, [this] { return m_busyWorkers == 0; });
+        m_task = nullptr;
+        error = m_error;
+        m_error = nullptr;
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void BuildingTaskPool::WorkerLoop() {
+    uint64_t seenGeneration = 0;
+    for (;;) {
+        const std::function<void(size_t)>* task = nullptr;
+        size_t taskCount = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [&] { return m_stopping || m_generation != seenGeneration; });
+            if (m_stopping) {
+                return;
+            }
+            seenGeneration = m_generation;
+            task = m_task;
+            taskCount = m_taskCount;
+        }
+
+        DrainTasks(*task, taskCount);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busyWorkers == 0) {
+                m_doneCondition.notify_all();
+            }
+        }
+    }
+}
+
+void BuildingTaskPool::DrainTasks(const std::function<void(size_t)>& task, size_t taskCount) {
+    for (size_t i = m_nextTask.fetch_add(1); i < taskCount; i = m_nextTask.fetch_add(1)) {
+        try {
+            task(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_error) {
+                m_error = std::current_exception();
+            }
+        }
+    }
+}
+
+} // namespace Building
+} // namespace Moon
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Moon {
+namespace Building {
+
+/**
+ * @brief Fixed-size worker pool for pipeline stages
+ * Run() hands out task indices [0, taskCount) to the worker threads and the
+ * calling thread, and returns once every task has finished.
+ *
+ * Tasks must only write to their own output slot; callers merge the slots in
+ * task-index order, so results never depend on scheduling.
+ */
+class BuildingTaskPool {
+public:
+    /**
+     * @brief Create pool
+     * @param workerCount Total threads including the caller (0 = hardware concurrency)
+     */
+    explicit BuildingTaskPool(size_t workerCount);
+    ~BuildingTaskPool();
+
+    BuildingTaskPool(const BuildingTaskPool&) = delete;
+    BuildingTaskPool& operator=(const BuildingTaskPool&) = delete;
+
+    /**
+     * @brief Total threads that execute tasks (workers + caller)
+     */
+    size_t GetWorkerCount() const { return m_threads.size() + 1; }
+
+    /**
+     * @brief Run task(i) for every i in [0, taskCount) and wait for completion
+     * The first exception thrown by a task is rethrown on the calling thread.
+     */
+    void Run(size_t taskCount, const std::function<void(size_t)>& task);
+
+    /**
+     * @brief Resolve a requested worker count (0 = hardware concurrency, at least 1)
+     */
+    static size_t ResolveWorkerCount(size_t requested);
+
+private:
+    void WorkerLoop();
+    void DrainTasks(const std::function<void(size_t)>& task, size_t taskCount);
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_doneCondition;
+    const std::function<void(size_t)>* m_task = nullptr;
+    size_t m_taskCount = 0;
+    std::atomic<size_t> m_nextTask{0};
+    size_t m_busyWorkers = 0;
+    uint64_t m_generation = 0;
+    bool m_stopping = false;
+    std::exception_ptr m_error;
+};
+
+} // namespace Building
+} // namespace Moon
@@ -1,10 +1,15 @@
 ﻿#include "BuildingToObjectBlueprintConverter.h"
+#include "../core/Object/Blueprint.h"
 #include "../../external/nlohmann/json.hpp"
 #include <cmath>
+#include <initializer_list>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -246,62 +251,265 @@ static inline bool DoesFloorNeedVerticalOpening(const VerticalTransport& transpo
     return floorLevel > transport.floorFrom && floorLevel <= transport.floorTo;
 }
 
-static json CreateCubeNode(const std::string& name,
-                           float centerX,
-                           float centerY,
-                           float centerZ,
-                           float sizeX,
-                           float sizeY,
-                           float sizeZ,
-                           const char* material,
-                           float rotationY = 0.0f)
-{
-    json node;
-    node["name"] = name;
-    node["type"] = "primitive";
-    node["primitive"] = "cube";
-    node["params"] = {
-        {"size_x", m2cm(sizeX)},
-        {"size_y", m2cm(sizeY)},
-        {"size_z", m2cm(sizeZ)}
-    };
-    node["transform"] = {
-        {"position", pos3(m2cm(centerX), m2cm(centerY), m2cm(centerZ))},
-        {"rotation", rot3(0.0f, rotationY, 0.0f)}
+// ---------------------------------------------------------------------------
+// Node emitters
+// ---------------------------------------------------------------------------
+// The conversion is written once against a small emitter interface and
+// instantiated twice: JsonNodeEmitter produces the blueprint JSON export, and
+// ObjectNodeEmitter builds the Object::Node tree that CSGBuilder consumes, so
+// the editor does not have to serialize and reparse the building.
+
+struct OverrideValue
+{
+    const char* key;
+    float value;
+};
+
+class JsonNodeEmitter
+{
+public:
+    using NodeT = json;
+
+    NodeT Cube(const std::string& name,
+               float centerX, float centerY, float centerZ,
+               float sizeX, float sizeY, float sizeZ,
+               const char* material,
+               float rotationY)
+    {
+        json node;
+        node["name"] = name;
+        node["type"] = "primitive";
+        node["primitive"] = "cube";
+        node["params"] = {
+            {"size_x", m2cm(sizeX)},
+            {"size_y", m2cm(sizeY)},
+            {"size_z", m2cm(sizeZ)}
+        };
+        node["transform"] = {
+            {"position", pos3(m2cm(centerX), m2cm(centerY), m2cm(centerZ))},
+            {"rotation", rot3(0.0f, rotationY, 0.0f)}
+        };
+        node["material"] = material;
+        return node;
+    }
+
+    // Position is in centimetres; an empty name leaves the node anonymous
+    NodeT Reference(const std::string& name,
+                    const char* refId,
+                    std::initializer_list<OverrideValue> overrides,
+                    float positionX, float positionY, float positionZ,
+                    const char* material = nullptr)
+    {
+        json node;
+        if (!name.empty()) {
+            node["name"] = name;
+        }
+        node["type"] = "reference";
+        node["ref"] = refId;
+        json& values = node["overrides"];
+        for (const auto& entry : overrides) {
+            values[entry.key] = entry.value;
+        }
+        node["transform"] = {
+            {"position", pos3(positionX, positionY, positionZ)}
+        };
+        if (material) {
+            node["material"] = material;
+        }
+        return node;
+    }
+
+    NodeT Subtract(NodeT base, NodeT hole)
+    {
+        json node;
+        node["type"]      = "csg";
+        node["operation"] = "subtract";
+        node["left"]      = std::move(base);
+        node["right"]     = std::move(hole);
+        return node;
+    }
+
+    NodeT SubtractAll(NodeT base, std::vector<NodeT> holes)
+    {
+        json operands = json::array();
+        operands.push_back(std::move(base));
+        for (auto& hole : holes) {
+            operands.push_back(std::move(hole));
+        }
+
+        json node;
+        node["type"]      = "csg";
+        node["operation"] = "subtract_all";
+        node["operands"]  = std::move(operands);
+        return node;
+    }
+
+    NodeT Group(const std::string& name, std::vector<NodeT> children)
+    {
+        json node;
+        node["name"] = name;
+        node["type"] = "group";
+        node["children"] = json::array();
+        for (auto& child : children) {
+            node["children"].push_back(std::move(child));
+        }
+        return node;
+    }
+
+    void SetName(NodeT& node, const std::string& name) { node["name"] = name; }
+
+    // Informational size in metres, not read back by BlueprintLoader
+    void SetSize(NodeT& node, float sizeX, float sizeY, float sizeZ)
+    {
+        node["size"] = json::array({sizeX, sizeY, sizeZ});
+    }
+};
+
+// Mirrors what BlueprintLoader::ParseFromString reads back from the JSON export:
+// node names only survive as group child names, reference materials and sizes
+// are dropped, and cube rotation is written under "rotation" while the loader
+// reads "rotation_euler", so it is left unset here as well.
+class ObjectNodeEmitter
+{
+public:
+    struct NodeT
+    {
+        std::string name;
+        std::unique_ptr<Object::Node> node;
     };
-    node["material"] = material;
-    return node;
+
+    NodeT Cube(const std::string& name,
+               float centerX, float centerY, float centerZ,
+               float sizeX, float sizeY, float sizeZ,
+               const char* material,
+               float /*rotationY*/)
+    {
+        auto node = std::make_unique<Object::Node>(Object::NodeType::Primitive);
+        Object::PrimitiveNode* primitive = node->AsPrimitive();
+        primitive->primitive = Object::PrimitiveType::Cube;
+        primitive->params["size_x"] = Object::ValueExpr::Constant(m2cm(sizeX));
+        primitive->params["size_y"] = Object::ValueExpr::Constant(m2cm(sizeY));
+        primitive->params["size_z"] = Object::ValueExpr::Constant(m2cm(sizeZ));
+        SetPosition(primitive->localTransform, m2cm(centerX), m2cm(centerY), m2cm(centerZ));
+        primitive->material = material;
+        return {name, std::move(node)};
+    }
+
+    NodeT Reference(const std::string& name,
+                    const char* refId,
+                    std::initializer_list<OverrideValue> overrides,
+                    float positionX, float positionY, float positionZ,
+                    const char* /*material*/ = nullptr)
+    {
+        auto node = std::make_unique<Object::Node>(Object::NodeType::Reference);
+        Object::RefNode* ref = node->AsRef();
+        ref->refId = refId;
+        for (const auto& entry : overrides) {
+            ref->overrides[entry.key] = Object::ValueExpr::Constant(entry.value);
+        }
+        SetPosition(ref->localTransform, positionX, positionY, positionZ);
+        return {name, std::move(node)};
+    }
+
+    NodeT Subtract(NodeT base, NodeT hole)
+    {
+        auto node = std::make_unique<Object::Node>(Object::NodeType::Csg);
+        Object::CsgNode* csg = node->AsCsg();
+        csg->operation = Object::CsgOp::Subtract;
+        csg->left = std::move(base.node);
+        csg->right = std::move(hole.node);
+        return {std::string(), std::move(node)};
+    }
+
+    NodeT SubtractAll(NodeT base, std::vector<NodeT> holes)
+    {
+        auto node = std::make_unique<Object::Node>(Object::NodeType::Csg);
+        Object::CsgNode* csg = node->AsCsg();
+        csg->operation = Object::CsgOp::SubtractAll;
+        csg->operands.reserve(holes.size() + 1);
+        csg->operands.push_back(std::move(base.node));
+        for (auto& hole : holes) {
+            csg->operands.push_back(std::move(hole.node));
+        }
+        return {std::string(), std::move(node)};
+    }
+
+    NodeT Group(const std::string& name, std::vector<NodeT> children)
+    {
+        return {name, MakeGroup(std::move(children))};
+    }
+
+    void SetName(NodeT& node, const std::string& name) { node.name = name; }
+    void SetSize(NodeT&, float, float, float) {}
+
+    static std::unique_ptr<Object::Node> MakeGroup(std::vector<NodeT> children)
+    {
+        auto node = std::make_unique<Object::Node>(Object::NodeType::Group);
+        Object::GroupNode* group = node->AsGroup();
+        group->children.reserve(children.size());
+        group->childNames.reserve(children.size());
+        for (auto& child : children) {
+            group->childNames.push_back(std::move(child.name));
+            group->children.push_back(std::move(child.node));
+        }
+        return node;
+    }
+
+private:
+    static void SetPosition(Object::TransformTRS& transform, float x, float y, float z)
+    {
+        transform.positionX = Object::ValueExpr::Constant(x);
+        transform.positionY = Object::ValueExpr::Constant(y);
+        transform.positionZ = Object::ValueExpr::Constant(z);
+    }
+};
+
+template <typename Emitter>
+static typename Emitter::NodeT CreateCubeNode(Emitter& emitter,
+                                              const std::string& name,
+                                              float centerX,
+                                              float centerY,
+                                              float centerZ,
+                                              float sizeX,
+                                              float sizeY,
+                                              float sizeZ,
+                                              const char* material,
+                                              float rotationY = 0.0f)
+{
+    return emitter.Cube(name, centerX, centerY, centerZ, sizeX, sizeY, sizeZ, material, rotationY);
 }
 
-static json CreateWallPanelReference(const std::string& name,
-                                     float centerX,
-                                     float baseY,
-                                     float centerZ,
-                                     float length,
-                                     float height,
-                                     float thickness,
-                                     float rotationDegrees,
-                                     const char* material)
-{
-    json wallNode;
-    wallNode["name"] = name;
-    wallNode["type"] = "reference";
-    wallNode["ref"] = "wall_panel_v1";
-    wallNode["size"] = json::array({length, height, thickness});
-    wallNode["overrides"] = {
-        {"w", m2cm(length)},
-        {"h", m2cm(height)},
-        {"t", m2cm(thickness)},
-        {"rotation_y", rotationDegrees}
-    };
-    wallNode["transform"] = {
-        {"position", pos3(m2cm(centerX), m2cm(baseY), m2cm(centerZ))}
-    };
-    wallNode["material"] = material;
+template <typename Emitter>
+static typename Emitter::NodeT CreateWallPanelReference(Emitter& emitter,
+                                                        const std::string& name,
+                                                        float centerX,
+                                                        float baseY,
+                                                        float centerZ,
+                                                        float length,
+                                                        float height,
+                                                        float thickness,
+                                                        float rotationDegrees,
+                                                        const char* material)
+{
+    auto wallNode = emitter.Reference(
+        name,
+        "wall_panel_v1",
+        {
+            {"w", m2cm(length)},
+            {"h", m2cm(height)},
+            {"t", m2cm(thickness)},
+            {"rotation_y", rotationDegrees}
+        },
+        m2cm(centerX), m2cm(baseY), m2cm(centerZ),
+        material);
+    emitter.SetSize(wallNode, length, height, thickness);
     return wallNode;
 }
 
-static json SubtractHoles(json base, const std::vector<json>& holes);
+template <typename Emitter>
+static typename Emitter::NodeT SubtractHoles(Emitter& emitter,
+                                             typename Emitter::NodeT base,
+                                             std::vector<typename Emitter::NodeT> holes);
 
 static const char* GetExteriorWallMaterial(const BuildingDefinition& definition)
 {
@@ -335,11 +543,13 @@ static float ComputeSignedArea(const std::vector<GridPos2D>& outline)
     return area * 0.5f;
 }
 
-static json BuildConvexOutlineClipNode(const std::string& name,
-                                       const std::vector<GridPos2D>& outline,
-                                       float baseY,
-                                       float slabThickness,
-                                       const char* material)
+template <typename Emitter>
+static typename Emitter::NodeT BuildConvexOutlineClipNode(Emitter& emitter,
+                                                          const std::string& name,
+                                                          const std::vector<GridPos2D>& outline,
+                                                          float baseY,
+                                                          float slabThickness,
+                                                          const char* material)
 {
     float minX = std::numeric_limits<float>::max();
     float minZ = std::numeric_limits<float>::max();
@@ -356,7 +566,8 @@ static json BuildConvexOutlineClipNode(const std::string& name,
     const float depth = std::max(0.1f, maxZ - minZ);
     const float centerX = (minX + maxX) * 0.5f;
     const float centerZ = (minZ + maxZ) * 0.5f;
-    json shape = CreateCubeNode(
+    auto shape = CreateCubeNode(
+        emitter,
         name + "_bbox",
         centerX,
         baseY + slabThickness * 0.5f,
@@ -372,7 +583,7 @@ static json BuildConvexOutlineClipNode(const std::string& name,
     const float cutDepth = std::max(span * 3.0f, 6.0f);
     const float tangentPadding = std::max(span * 2.0f, 6.0f);
     const float cutHeight = slabThickness + 0.04f;
-    std::vector<json> clipNodes;
+    std::vector<typename Emitter::NodeT> clipNodes;
 
     for (size_t i = 0; i < outline.size(); ++i) {
         const auto& a = outline[i];
@@ -394,6 +605,7 @@ static json BuildConvexOutlineClipNode(const std::string& name,
         const float rotationY = std::atan2(tangentZ, tangentX) * 180.0f / 3.14159265f;
 
         clipNodes.push_back(CreateCubeNode(
+            emitter,
             name + "_clip_" + std::to_string(i),
             clipCenterX,
             baseY + slabThickness * 0.5f,
@@ -405,20 +617,23 @@ static json BuildConvexOutlineClipNode(const std::string& name,
             rotationY));
     }
 
-    return SubtractHoles(shape, clipNodes);
+    return SubtractHoles(emitter, std::move(shape), std::move(clipNodes));
 }
 
-static json CreateFloorPlateNode(const std::string& name,
-                                 const FloorPlate& plate,
-                                 float baseY,
-                                 float slabThickness,
-                                 const char* material)
+template <typename Emitter>
+static typename Emitter::NodeT CreateFloorPlateNode(Emitter& emitter,
+                                                    const std::string& name,
+                                                    const FloorPlate& plate,
+                                                    float baseY,
+                                                    float slabThickness,
+                                                    const char* material)
 {
     const std::vector<GridPos2D>& slabOutline =
         plate.envelopeOutline.size() >= 3 ? plate.envelopeOutline : plate.outline;
-    json base;
+    typename Emitter::NodeT base;
     if (slabOutline.size() >= 3) {
         base = BuildConvexOutlineClipNode(
+            emitter,
             name + "_outline",
             slabOutline,
             baseY,
@@ -426,6 +641,7 @@ static json CreateFloorPlateNode(const std::string& name,
             material);
     } else {
         base = CreateCubeNode(
+            emitter,
             name + "_base",
             plate.origin[0] + plate.size[0] * 0.5f,
             baseY + slabThickness * 0.5f,
@@ -436,9 +652,10 @@ static json CreateFloorPlateNode(const std::string& name,
             material);
     }
 
-    std::vector<json> holes;
+    std::vector<typename Emitter::NodeT> holes;
     for (const auto& voidRect : plate.voids) {
         holes.push_back(CreateCubeNode(
+            emitter,
             name + "_void_" + voidRect.rectId,
             voidRect.origin[0] + voidRect.size[0] * 0.5f,
             baseY + slabThickness * 0.5f,
@@ -449,20 +666,23 @@ static json CreateFloorPlateNode(const std::string& name,
             "glass"));
     }
 
-    json node = SubtractHoles(base, holes);
-    node["name"] = name;
+    auto node = SubtractHoles(emitter, std::move(base), std::move(holes));
+    emitter.SetName(node, name);
     return node;
 }
 
-static json CreateFloorRectNode(const std::string& name,
-                                const Rect& rect,
-                                int floorLevel,
-                                float baseY,
-                                float slabThickness,
-                                const char* material,
-                                const std::vector<VerticalTransport>& verticalTransports)
+template <typename Emitter>
+static typename Emitter::NodeT CreateFloorRectNode(Emitter& emitter,
+                                                   const std::string& name,
+                                                   const Rect& rect,
+                                                   int floorLevel,
+                                                   float baseY,
+                                                   float slabThickness,
+                                                   const char* material,
+                                                   const std::vector<VerticalTransport>& verticalTransports)
 {
-    json base = CreateCubeNode(
+    auto base = CreateCubeNode(
+        emitter,
         name + "_base",
         rect.origin[0] + rect.size[0] * 0.5f,
         baseY + slabThickness * 0.5f,
@@ -472,7 +692,7 @@ static json CreateFloorRectNode(const std::string& name,
         rect.size[1],
         material);
 
-    std::vector<json> holes;
+    std::vector<typename Emitter::NodeT> holes;
     for (const auto& transport : verticalTransports) {
         if (!DoesFloorNeedVerticalOpening(transport, floorLevel)) {
             continue;
@@ -491,6 +711,7 @@ static json CreateFloorRectNode(const std::string& name,
         }
 
         holes.push_back(CreateCubeNode(
+            emitter,
             name + "_transport_void_" + transport.transportId,
             openingRect.origin[0] + openingRect.size[0] * 0.5f,
             baseY + slabThickness * 0.5f,
@@ -501,8 +722,8 @@ static json CreateFloorRectNode(const std::string& name,
             "glass"));
     }
 
-    json node = SubtractHoles(base, holes);
-    node["name"] = name;
+    auto node = SubtractHoles(emitter, std::move(base), std::move(holes));
+    emitter.SetName(node, name);
     return node;
 }
 
@@ -561,32 +782,39 @@ static bool IsDoorOnWall(const Door& door, const WallSegment& wall)
 }
 
 // Build a CSG subtract chain: base - holes[0] - holes[1] - ...
-static json SubtractHoles(json base, const std::vector<json>& holes)
+template <typename Emitter>
+static typename Emitter::NodeT SubtractHoles(Emitter& emitter,
+                                             typename Emitter::NodeT base,
+                                             std::vector<typename Emitter::NodeT> holes)
 {
-    for (const auto& hole : holes) {
-        json node;
-        node["type"]      = "csg";
-        node["operation"] = "subtract";
-        node["left"]      = std::move(base);
-        node["right"]     = hole;
-        base              = std::move(node);
+    for (auto& hole : holes) {
+        base = emitter.Subtract(std::move(base), std::move(hole));
     }
     return base;
 }
 
+// Build a single n-ary subtract: base - (holes[0] ∪ holes[1] ∪ ...)
+// The cutters are unioned in one batch and subtracted once, instead of one boolean per hole.
+template <typename Emitter>
+static typename Emitter::NodeT SubtractAllHoles(Emitter& emitter,
+                                                typename Emitter::NodeT base,
+                                                std::vector<typename Emitter::NodeT> holes)
+{
+    if (holes.empty()) {
+        return base;
+    }
+    return emitter.SubtractAll(std::move(base), std::move(holes));
+}
+
 // ---------------------------------------------------------------------------
-// BuildingToObjectBlueprintConverter::Convert
+// Building node emission (root group children, shared by both outputs)
 // ---------------------------------------------------------------------------
 
-std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding& building)
+template <typename Emitter>
+static std::vector<typename Emitter::NodeT> EmitBuildingNodes(Emitter& emitter,
+                                                              const GeneratedBuilding& building)
 {
-    json blueprint;
-    blueprint["schema_version"] = 1;
-    blueprint["name"]           = "generated_building";
-    blueprint["description"]    = "Auto-generated from the Moon semantic building system";
-    blueprint["version"]        = 1;
-
-    json children = json::array();
+    std::vector<typename Emitter::NodeT> children;
     const float wallThickness = 0.2f; // 20 cm walls
 
     // -----------------------------------------------------------------------
@@ -607,6 +835,7 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
             }
             const float floorBaseY = GetFloorBaseHeight(building.definition, plate.floorLevel);
             children.push_back(CreateFloorPlateNode(
+                emitter,
                 "floor_plate_" + std::to_string(plate.floorLevel),
                 plate,
                 floorBaseY,
@@ -631,7 +860,8 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
                     else if (usage == SpaceUsage::Kitchen)  material = "tile_ceramic";
                     else if (usage == SpaceUsage::Bedroom)  material = "carpet";
 
-                    json node = CreateFloorRectNode(
+                    auto node = CreateFloorRectNode(
+                        emitter,
                         "floor_" + std::to_string(space.spaceId) + "_" + rect.rectId,
                         rect,
                         floor.level,
@@ -640,7 +870,7 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
                         material,
                         building.verticalTransports);
 
-                    children.push_back(node);
+                    children.push_back(std::move(node));
                 }
             }
         }
@@ -661,6 +891,7 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
             const float topHeight = GetTopOfFloor(building.definition, transport.floorTo);
             const float height = std::max(0.1f, topHeight - baseHeight);
             children.push_back(CreateCubeNode(
+                emitter,
                 "elevator_shaft_" + std::to_string(transportIdx),
                 transport.shaftRect.origin[0] + transport.shaftRect.size[0] * 0.5f,
                 baseHeight + height * 0.5f,
@@ -672,23 +903,18 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
 
             const float servedFloorHeight =
                 std::max(2.3f, std::min(2.8f, GetTopOfFloor(building.definition, transport.floorFrom) - baseHeight - 0.3f));
-            json cabinNode;
-            cabinNode["name"] = "elevator_cabin_" + std::to_string(transportIdx);
-            cabinNode["type"] = "reference";
-            cabinNode["ref"] = "elevator_cabin_v1";
-            cabinNode["overrides"] = {
-                {"cabin_width", m2cm(std::max(1.4f, transport.shaftRect.size[0] - 0.28f))},
-                {"cabin_depth", m2cm(std::max(1.4f, transport.shaftRect.size[1] - 0.28f))},
-                {"cabin_height", m2cm(servedFloorHeight)},
-                {"door_width", m2cm(std::max(0.9f, std::min(1.3f, transport.shaftRect.size[0] * 0.45f)))}
-            };
-            cabinNode["transform"] = {
-                {"position", pos3(
-                    m2cm(transport.shaftRect.origin[0] + transport.shaftRect.size[0] * 0.5f),
-                    m2cm(baseHeight),
-                    m2cm(transport.shaftRect.origin[1] + transport.shaftRect.size[1] * 0.5f))}
-            };
-            children.push_back(std::move(cabinNode));
+            children.push_back(emitter.Reference(
+                "elevator_cabin_" + std::to_string(transportIdx),
+                "elevator_cabin_v1",
+                {
+                    {"cabin_width", m2cm(std::max(1.4f, transport.shaftRect.size[0] - 0.28f))},
+                    {"cabin_depth", m2cm(std::max(1.4f, transport.shaftRect.size[1] - 0.28f))},
+                    {"cabin_height", m2cm(servedFloorHeight)},
+                    {"door_width", m2cm(std::max(0.9f, std::min(1.3f, transport.shaftRect.size[0] * 0.45f)))}
+                },
+                m2cm(transport.shaftRect.origin[0] + transport.shaftRect.size[0] * 0.5f),
+                m2cm(baseHeight),
+                m2cm(transport.shaftRect.origin[1] + transport.shaftRect.size[1] * 0.5f)));
             ++transportIdx;
         }
     }
@@ -702,6 +928,7 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
             const float topHeight = GetTopOfFloor(building.definition, column.floorTo);
             const float height = std::max(0.1f, topHeight - baseHeight);
             children.push_back(CreateCubeNode(
+                emitter,
                 "support_column_" + column.columnId,
                 column.center[0],
                 baseHeight + height * 0.5f,
@@ -745,6 +972,7 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
                         }
 
                         children.push_back(CreateCubeNode(
+                            emitter,
                             "support_column_" + std::to_string(floor.level) + "_" + std::to_string(emittedSupportColumns.size()),
                             center[0],
                             floorBaseY * 0.5f,
@@ -804,7 +1032,8 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
 
         // Wall reference: use wall_panel_v1 component for proper UV mapping
         // Panel is created along X axis, then rotated via rotation_y parameter
-        json wallCube = CreateWallPanelReference(
+        auto wallCube = CreateWallPanelReference(
+            emitter,
             "wall_panel_" + std::to_string(wallIdx),
             centerX + wallPlacementOffset[0],
             wallBaseY,
@@ -816,7 +1045,7 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
             wallMaterial);
 
         // Hole cubes
-        std::vector<json> holes;
+        std::vector<typename Emitter::NodeT> holes;
 
         // Window holes - use opening_v1 component
         for (int wi : wallWindowIdx[wali]) {
@@ -825,19 +1054,16 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
             const float holeY = GetRenderableWindowBaseHeight(building, win);
             const float holeHeight = GetRenderableWindowHeight(building, win);
 
-            json hole;
-            hole["type"] = "reference";
-            hole["ref"]  = "opening_v1";
-            hole["overrides"] = {
-                {"w", m2cm(win.width) + 2.0f},           // +2 cm clearance
-                {"h", m2cm(holeHeight) + 2.0f},          // +2 cm clearance
-                {"t", m2cm(wall.thickness) + 2.0f},      // punch through
-                {"rotation_y", wallRotationY}
-            };
-            hole["transform"] = {
-                {"position", pos3(m2cm(win.position[0] + wallPlacementOffset[0]), m2cm(holeY), m2cm(win.position[1] + wallPlacementOffset[1]))}
-            };
-            holes.push_back(hole);
+            holes.push_back(emitter.Reference(
+                std::string(),
+                "opening_v1",
+                {
+                    {"w", m2cm(win.width) + 2.0f},           // +2 cm clearance
+                    {"h", m2cm(holeHeight) + 2.0f},          // +2 cm clearance
+                    {"t", m2cm(wall.thickness) + 2.0f},      // punch through
+                    {"rotation_y", wallRotationY}
+                },
+                m2cm(win.position[0] + wallPlacementOffset[0]), m2cm(holeY), m2cm(win.position[1] + wallPlacementOffset[1])));
         }
 
         // Door holes - use opening_v1 component
@@ -847,25 +1073,22 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
             const float holeY = GetRenderableDoorBaseHeight(building, door);
             const float holeHeight = GetRenderableDoorHeight(building, door);
 
-            json hole;
-            hole["type"] = "reference";
-            hole["ref"]  = "opening_v1";
-            hole["overrides"] = {
-                {"w", m2cm(door.width) + 2.0f},          // +2 cm clearance
-                {"h", m2cm(holeHeight) + 2.0f},         // +2 cm clearance
-                {"t", m2cm(wall.thickness) + 2.0f},      // punch through
-                {"rotation_y", wallRotationY}
-            };
-            hole["transform"] = {
-                {"position", pos3(m2cm(door.position[0] + wallPlacementOffset[0]), m2cm(holeY), m2cm(door.position[1] + wallPlacementOffset[1]))}
-            };
-            holes.push_back(hole);
+            holes.push_back(emitter.Reference(
+                std::string(),
+                "opening_v1",
+                {
+                    {"w", m2cm(door.width) + 2.0f},          // +2 cm clearance
+                    {"h", m2cm(holeHeight) + 2.0f},         // +2 cm clearance
+                    {"t", m2cm(wall.thickness) + 2.0f},      // punch through
+                    {"rotation_y", wallRotationY}
+                },
+                m2cm(door.position[0] + wallPlacementOffset[0]), m2cm(holeY), m2cm(door.position[1] + wallPlacementOffset[1])));
         }
 
-        json wallNode = SubtractHoles(wallCube, holes);
-        wallNode["name"] = "wall_" + std::to_string(wallIdx++);
-        wallNode["size"] = json::array({length, wallHeight, wall.thickness});
-        children.push_back(wallNode);
+        auto wallNode = SubtractAllHoles(emitter, std::move(wallCube), std::move(holes));
+        emitter.SetName(wallNode, "wall_" + std::to_string(wallIdx++));
+        emitter.SetSize(wallNode, length, wallHeight, wall.thickness);
+        children.push_back(std::move(wallNode));
     }
 
     // -----------------------------------------------------------------------
@@ -876,20 +1099,16 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
         const WallSegment* wall = FindWallById(building, door.wallId);
         const GridPos2D wallPlacementOffset = wall ? GetWallPlacementOffset(building, *wall) : GridPos2D{0.0f, 0.0f};
         // POSITIONING: door_v1 uses bottom-center convention (y=0 at ground)
-        json node;
-        node["name"] = "door_" + std::to_string(doorIdx++);
-        node["type"] = "reference";
-        node["ref"]  = "door_v1";
-        node["overrides"] = {
-            {"door_width",  m2cm(door.width)},
-            {"door_height", m2cm(door.height)},
-            {"door_thickness", 4.0f},  // Standard door thickness
-            {"rotation_y", door.rotation}
-        };
-        node["transform"] = {
-            {"position", pos3(m2cm(door.position[0] + wallPlacementOffset[0]), m2cm(GetRenderableDoorBaseHeight(building, door)), m2cm(door.position[1] + wallPlacementOffset[1]))}
-        };
-        children.push_back(node);
+        children.push_back(emitter.Reference(
+            "door_" + std::to_string(doorIdx++),
+            "door_v1",
+            {
+                {"door_width",  m2cm(door.width)},
+                {"door_height", m2cm(door.height)},
+                {"door_thickness", 4.0f},  // Standard door thickness
+                {"rotation_y", door.rotation}
+            },
+            m2cm(door.position[0] + wallPlacementOffset[0]), m2cm(GetRenderableDoorBaseHeight(building, door)), m2cm(door.position[1] + wallPlacementOffset[1])));
     }
 
     // -----------------------------------------------------------------------
@@ -902,20 +1121,16 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
         // POSITIONING: window_v1 uses bottom-center convention (y=0 at sill)
         const float winBaseY = GetRenderableWindowBaseHeight(building, window);
 
-        json node;
-        node["name"] = "window_" + std::to_string(windowIdx++);
-        node["type"] = "reference";
-        node["ref"]  = "window_v1";
-        node["overrides"] = {
-            {"w", m2cm(window.width)},
-            {"h", m2cm(GetRenderableWindowHeight(building, window))},
-            {"t", m2cm(wallThickness)},
-            {"rotation_y", window.rotation}
-        };
-        node["transform"] = {
-            {"position", pos3(m2cm(window.position[0] + wallPlacementOffset[0]), m2cm(winBaseY), m2cm(window.position[1] + wallPlacementOffset[1]))}
-        };
-        children.push_back(node);
+        children.push_back(emitter.Reference(
+            "window_" + std::to_string(windowIdx++),
+            "window_v1",
+            {
+                {"w", m2cm(window.width)},
+                {"h", m2cm(GetRenderableWindowHeight(building, window))},
+                {"t", m2cm(wallThickness)},
+                {"rotation_y", window.rotation}
+            },
+            m2cm(window.position[0] + wallPlacementOffset[0]), m2cm(winBaseY), m2cm(window.position[1] + wallPlacementOffset[1])));
     }
 
     // -----------------------------------------------------------------------
@@ -927,10 +1142,7 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
         const float treadDepth = std::max(0.1f, stair.stepDepth);
         const float stairWidth = std::max(0.8f, stair.stairWidth);
         const float baseHeight = GetFloorBaseHeight(building.definition, stair.fromLevel);
-        json stairGroup;
-        stairGroup["name"] = "stair_" + std::to_string(stairIdx);
-        stairGroup["type"] = "group";
-        stairGroup["children"] = json::array();
+        std::vector<typename Emitter::NodeT> stairParts;
 
         for (size_t stepIndex = 0; stepIndex < stair.steps.size(); ++stepIndex) {
             const auto& step = stair.steps[stepIndex];
@@ -938,7 +1150,8 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
             const float sizeX = quarterTurn ? treadDepth : stairWidth;
             const float sizeZ = quarterTurn ? stairWidth : treadDepth;
 
-            stairGroup["children"].push_back(CreateCubeNode(
+            stairParts.push_back(CreateCubeNode(
+                emitter,
                 "stair_" + std::to_string(stairIdx) + "_step_" + std::to_string(stepIndex),
                 step.position[0],
                 baseHeight + step.height + stepHeight * 0.5f,
@@ -955,7 +1168,8 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
             const float sizeX = quarterTurn ? landing.depth : landing.width;
             const float sizeZ = quarterTurn ? landing.width : landing.depth;
 
-            stairGroup["children"].push_back(CreateCubeNode(
+            stairParts.push_back(CreateCubeNode(
+                emitter,
                 "stair_" + std::to_string(stairIdx) + "_landing_" + std::to_string(landingIndex),
                 landing.position[0],
                 baseHeight + landing.height + stepHeight * 0.5f,
@@ -966,22 +1180,56 @@ std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding&
                 "concrete_floor"));
         }
 
-        children.push_back(std::move(stairGroup));
+        children.push_back(emitter.Group("stair_" + std::to_string(stairIdx), std::move(stairParts)));
         ++stairIdx;
     }
 
-    // -----------------------------------------------------------------------
-    // 6. Root group
-    // -----------------------------------------------------------------------
+    return children;
+}
+
+// ---------------------------------------------------------------------------
+// BuildingToObjectBlueprintConverter::Convert / ConvertToBlueprint
+// ---------------------------------------------------------------------------
+
+static constexpr const char* kGeneratedBlueprintName = "generated_building";
+
+std::string BuildingToObjectBlueprintConverter::Convert(const GeneratedBuilding& building)
+{
+    json blueprint;
+    blueprint["schema_version"] = 1;
+    blueprint["name"]           = kGeneratedBlueprintName;
+    blueprint["description"]    = "Auto-generated from the Moon semantic building system";
+    blueprint["version"]        = 1;
+
+    JsonNodeEmitter emitter;
+    json children = json::array();
+    for (auto& child : EmitBuildingNodes(emitter, building)) {
+        children.push_back(std::move(child));
+    }
+
     blueprint["root"] = {
         {"type",     "group"},
-        {"children", children},
+        {"children", std::move(children)},
         {"output",   {{"mode", "separate"}}}
     };
 
     return blueprint.dump(2);
 }
 
+std::unique_ptr<Object::Blueprint> BuildingToObjectBlueprintConverter::ConvertToBlueprint(const GeneratedBuilding& building)
+{
+    ObjectNodeEmitter emitter;
+    std::unique_ptr<Object::Node> root = ObjectNodeEmitter::MakeGroup(EmitBuildingNodes(emitter, building));
+    root->AsGroup()->outputMode = Object::GroupOutputMode::Separate;
+
+    // Same metadata BlueprintLoader derives from the JSON export (id falls back to "name")
+    auto blueprint = std::make_unique<Object::Blueprint>();
+    blueprint->SetId(kGeneratedBlueprintName);
+    blueprint->SetSchemaVersion(1);
+    blueprint->SetRootNode(std::move(root));
+    return blueprint;
+}
+
 // Satisfy the declaration in the header (delegates to file-scope helper)
 bool BuildingToObjectBlueprintConverter::IsWindowOnWall(const Window& window, const WallSegment& wall)
 {
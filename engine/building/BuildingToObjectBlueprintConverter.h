@@ -2,7 +2,7 @@
 
 /**
  * @file BuildingToObjectBlueprintConverter.h
- * @brief Converts a GeneratedBuilding into an object blueprint JSON string
+ * @brief Converts a GeneratedBuilding into an object blueprint
  *
  * This is the bridge between the Building pipeline output and the object blueprint runtime.
  * It handles:
@@ -13,13 +13,20 @@
  *   - Stair step and landing primitive generation
  *   - Floor slab generation (material by room usage)
  *
- * Produced JSON is suitable for Moon::Object::BlueprintLoader::ParseFromString().
+ * ConvertToBlueprint() builds the Moon::Object::Blueprint tree directly for CSGBuilder.
+ * Convert() produces the equivalent JSON export, suitable for
+ * Moon::Object::BlueprintLoader::ParseFromString() and for writing to disk.
  */
 
 #include "BuildingTypes.h"
+#include <memory>
 #include <string>
 
 namespace Moon {
+namespace Object {
+class Blueprint;
+}
+
 namespace Building {
 
 class BuildingToObjectBlueprintConverter
@@ -33,6 +40,17 @@ public:
      */
     static std::string Convert(const GeneratedBuilding& building);
 
+    /**
+     * @brief Convert a GeneratedBuilding straight to an object blueprint tree.
+     *
+     * Produces the same blueprint as parsing Convert() with BlueprintLoader,
+     * without serializing and reparsing the JSON.
+     *
+     * @param building   Output of BuildingPipeline::ProcessBuilding()
+     * @return           Blueprint ready for CSG::CSGBuilder::Build()
+     */
+    static std::unique_ptr<Object::Blueprint> ConvertToBlueprint(const GeneratedBuilding& building);
+
 private:
     // Returns true if the window center lies on this wall segment
     // (same spaceId, same floor level, within 50 cm perpendicular distance, not near endpoints)
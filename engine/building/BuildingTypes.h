@@ -497,6 +497,49 @@ struct SpaceConnection {
     bool hasDoor;           // Is there a door connecting them?
 };
 
+/**
+ * @brief Multi-candidate floor layout search statistics
+ * Scores are FloorLayoutSearch quality scores in [0, 1] over every candidate
+ * that the typology solver accepted.
+ */
+struct FloorLayoutSearchStats {
+    size_t floorsSearched = 0;
+    size_t candidatesEvaluated = 0;     // Solver runs, including rejected candidates
+    size_t candidatesRejected = 0;      // Candidates the solver failed on
+    size_t floorsImproved = 0;          // Floors whose selected candidate beats the authored order
+    double searchMs = 0.0;
+    float scoreMin = 0.0f;
+    float scoreMedian = 0.0f;
+    float scoreMax = 0.0f;
+    float baselineScoreMean = 0.0f;     // Authored-order candidate, averaged over floors
+    float selectedScoreMean = 0.0f;     // Selected candidate, averaged over floors
+
+    double CandidatesPerSecond() const {
+        return searchMs > 0.0 ? static_cast<double>(candidatesEvaluated) * 1000.0 / searchMs : 0.0;
+    }
+};
+
+/**
+ * @brief Pipeline execution statistics
+ * Stage timings are wall-clock milliseconds measured on the calling thread.
+ */
+struct BuildingPipelineStats {
+    bool floorParallel = false;     // Floor-parallel task mode was used
+    size_t workerCount = 1;         // Threads that executed stage tasks (including caller)
+    size_t floorLevelCount = 0;     // Distinct floor levels fanned out per stage
+    double validationMs = 0.0;
+    double structuralMs = 0.0;
+    double envelopeMs = 0.0;
+    double semanticLayoutMs = 0.0;
+    double spaceGraphMs = 0.0;
+    double wallsMs = 0.0;
+    double doorsMs = 0.0;
+    double stairsMs = 0.0;
+    double facadeMs = 0.0;
+    double totalMs = 0.0;
+    FloorLayoutSearchStats layoutSearch;  // Empty unless layout search is enabled
+};
+
 /**
  * @brief Generated building geometry
  * Output of the building pipeline
@@ -516,6 +559,7 @@ struct GeneratedBuilding {
     std::vector<Window> windows;
     std::vector<StairGeometry> stairs;  // ✅ Add stairs field
     std::vector<SpaceConnection> connections;
+    BuildingPipelineStats pipelineStats;  // Execution mode, worker count and stage timings
     // Mesh data will be generated from this structure
 };
 
@@ -28,33 +28,40 @@ void DoorGenerator::GenerateDoors(const BuildingDefinition& definition,
     const auto& adjacencies = spaceGraph.GetAdjacencies();
     
     for (const auto& adjacency : adjacencies) {
-        // Check if door should be placed
-        if (!ShouldPlaceDoor(adjacency, index)) {
-            continue;
-        }
-        
-        // Use BuildingIndex to find wall (O(1) instead of O(n) loop)
-        const WallSegment* wall = index.FindWall(adjacency.spaceA, adjacency.spaceB, adjacency.floorLevel);
-        
-        if (!wall) {
-            // No wall found for this adjacency, skip door placement
-            continue;
-        }
-        
-        // Create door
         Door door;
-        door.wallId = wall->wallId;  // Record which wall this door is in
-        door.spaceA = adjacency.spaceA;
-        door.spaceB = adjacency.spaceB;
-        door.position = CalculateDoorPosition(adjacency, index);
-        door.rotation = CalculateDoorRotation(adjacency);
-        door.type = DetermineDoorType(adjacency, index);
-        door.width = m_defaultDoorWidth;
-        door.height = m_defaultDoorHeight;
-        door.floorLevel = adjacency.floorLevel;  // Use floor level from adjacency
-        
-        outDoors.push_back(door);
+        if (TryCreateDoor(adjacency, index, door)) {
+            outDoors.push_back(door);
+        }
+    }
+}
+
+bool DoorGenerator::TryCreateDoor(const SpaceAdjacency& adjacency,
+                                  const BuildingIndex& index,
+                                  Door& outDoor) const {
+    // Check if door should be placed
+    if (!ShouldPlaceDoor(adjacency, index)) {
+        return false;
     }
+    
+    // Use BuildingIndex to find wall (O(1) instead of O(n) loop)
+    const WallSegment* wall = index.FindWall(adjacency.spaceA, adjacency.spaceB, adjacency.floorLevel);
+    
+    if (!wall) {
+        // No wall found for this adjacency, skip door placement
+        return false;
+    }
+    
+    // Create door
+    outDoor.wallId = wall->wallId;  // Record which wall this door is in
+    outDoor.spaceA = adjacency.spaceA;
+    outDoor.spaceB = adjacency.spaceB;
+    outDoor.position = CalculateDoorPosition(adjacency, index);
+    outDoor.rotation = CalculateDoorRotation(adjacency);
+    outDoor.type = DetermineDoorType(adjacency, index);
+    outDoor.width = m_defaultDoorWidth;
+    outDoor.height = m_defaultDoorHeight;
+    outDoor.floorLevel = adjacency.floorLevel;  // Use floor level from adjacency
+    return true;
 }
 
 bool DoorGenerator::ShouldPlaceDoor(const SpaceAdjacency& adjacency,
@@ -128,12 +135,11 @@ GridPos2D DoorGenerator::CalculateDoorPosition(const SpaceAdjacency& adjacency,
     const float maxDistanceToEdge = 0.5f;
     
     // Check for door hints in either space - but they must be near this edge
-    auto findClosestHint = [&](const Space* space) -> GridPos2D* {
-        static GridPos2D hintPos;
+    auto findClosestHint = [&](const Space* space, GridPos2D& hintPos) -> bool {
         float bestDist = maxDistanceToEdge;
         bool found = false;
         
-        if (!space) return nullptr;
+        if (!space) return false;
         
         for (const auto& anchor : space->anchors) {
             if (anchor.type == AnchorType::DoorHint) {
@@ -170,17 +176,18 @@ GridPos2D DoorGenerator::CalculateDoorPosition(const SpaceAdjacency& adjacency,
             }
         }
         
-        return found ? &hintPos : nullptr;
+        return found;
     };
     
     // Try spaceA hints first
-    if (GridPos2D* hint = findClosestHint(spaceA)) {
-        return *hint;
+    GridPos2D hint;
+    if (findClosestHint(spaceA, hint)) {
+        return hint;
     }
     
     // Try spaceB hints  
-    if (GridPos2D* hint = findClosestHint(spaceB)) {
-        return *hint;
+    if (findClosestHint(spaceB, hint)) {
+        return hint;
     }
     
     // Default: place door at center of shared edge
@@ -36,6 +36,18 @@ public:
                       const BuildingIndex& index,
                       std::vector<Door>& outDoors);
 
+    /**
+     * @brief Place a door for a single adjacency
+     * Read-only; safe to call concurrently for different adjacencies.
+     * @param adjacency Space adjacency to consider
+     * @param index Building index for fast lookups
+     * @param outDoor Output door placement
+     * @return true if a door should be placed on this adjacency
+     */
+    bool TryCreateDoor(const SpaceAdjacency& adjacency,
+                       const BuildingIndex& index,
+                       Door& outDoor) const;
+
     /**
      * @brief Set minimum door width
      */
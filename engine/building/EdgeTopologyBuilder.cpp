@@ -1,6 +1,8 @@
 #include "EdgeTopologyBuilder.h"
+#include "GridCoord.h"
 #include <cmath>
 #include <algorithm>
+#include <map>
 
 namespace Moon {
 namespace Building {
@@ -97,35 +99,141 @@ bool EdgeTopologyBuilder::EdgesCollinear(const EdgeInfo& a,
     return (cross1 / edgeLength < epsilon) && (cross2 / edgeLength < epsilon);
 }
 
+std::vector<std::pair<size_t, size_t>> EdgeTopologyBuilder::FindCandidatePairs(const std::vector<EdgeInfo>& edges) {
+    // Slack along the line and across grid-line boundaries; generous compared to the
+    // 0.001 epsilon of the exact predicates, so no touching pair is missed
+    const float tolerance = 0.01f;
+
+    struct SweepEntry {
+        int floorLevel;
+        int orientation;    // 0 = horizontal, 1 = vertical
+        int gridLine;       // Grid units of the constant coordinate
+        float minAlong;
+        float maxAlong;
+        size_t index;
+    };
+
+    std::vector<SweepEntry> entries;
+    entries.reserve(edges.size());
+    std::map<int, std::vector<size_t>> floorEdges;
+    std::vector<size_t> irregularEdges;
+
+    for (size_t i = 0; i < edges.size(); ++i) {
+        const EdgeInfo& edge = edges[i];
+        floorEdges[edge.floorLevel].push_back(i);
+
+        // Exactly axis-aligned edges longer than the tolerance are swept;
+        // everything else keeps the all-pairs comparison on its floor
+        const bool horizontal = edge.start[1] == edge.end[1];
+        const bool vertical = edge.start[0] == edge.end[0];
+        if (horizontal == vertical || edge.Length() <= tolerance) {
+            irregularEdges.push_back(i);
+            continue;
+        }
+
+        const int axis = horizontal ? 0 : 1;
+        const float line = edge.start[1 - axis];
+        SweepEntry entry;
+        entry.floorLevel = edge.floorLevel;
+        entry.orientation = axis;
+        entry.gridLine = GridCoord::ToGridUnits(line);
+        entry.minAlong = std::min(edge.start[axis], edge.end[axis]);
+        entry.maxAlong = std::max(edge.start[axis], edge.end[axis]);
+        entry.index = i;
+        entries.push_back(entry);
+
+        // Off-grid lines near a rounding boundary also join the neighbouring bucket
+        const float units = line / GRID_SIZE;
+        const float distanceToBoundary = std::abs(std::abs(units - static_cast<float>(entry.gridLine)) - 0.5f);
+        if (distanceToBoundary * GRID_SIZE < tolerance) {
+            entry.gridLine += (units > static_cast<float>(entry.gridLine)) ? 1 : -1;
+            entries.push_back(entry);
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const SweepEntry& a, const SweepEntry& b) {
+        if (a.floorLevel != b.floorLevel) return a.floorLevel < b.floorLevel;
+        if (a.orientation != b.orientation) return a.orientation < b.orientation;
+        if (a.gridLine != b.gridLine) return a.gridLine < b.gridLine;
+        if (a.minAlong != b.minAlong) return a.minAlong < b.minAlong;
+        return a.index < b.index;
+    });
+
+    std::vector<std::pair<size_t, size_t>> pairs;
+    auto addPair = [&pairs](size_t a, size_t b) {
+        pairs.emplace_back(std::min(a, b), std::max(a, b));
+    };
+
+    // Sweep each (floor, orientation, grid line) bucket in order of interval start
+    std::vector<const SweepEntry*> active;
+    for (size_t bucketStart = 0; bucketStart < entries.size();) {
+        size_t bucketEnd = bucketStart + 1;
+        while (bucketEnd < entries.size() &&
+               entries[bucketEnd].floorLevel == entries[bucketStart].floorLevel &&
+               entries[bucketEnd].orientation == entries[bucketStart].orientation &&
+               entries[bucketEnd].gridLine == entries[bucketStart].gridLine) {
+            ++bucketEnd;
+        }
+
+        active.clear();
+        for (size_t k = bucketStart; k < bucketEnd; ++k) {
+            const SweepEntry& entry = entries[k];
+            active.erase(std::remove_if(active.begin(), active.end(), [&](const SweepEntry* other) {
+                return other->maxAlong < entry.minAlong - tolerance;
+            }), active.end());
+
+            for (const SweepEntry* other : active) {
+                addPair(other->index, entry.index);
+            }
+            active.push_back(&entry);
+        }
+
+        bucketStart = bucketEnd;
+    }
+
+    for (size_t irregular : irregularEdges) {
+        for (size_t other : floorEdges[edges[irregular].floorLevel]) {
+            if (other != irregular) {
+                addPair(irregular, other);
+            }
+        }
+    }
+
+    // Boundary duplicates and irregular edges can report a pair twice
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    return pairs;
+}
+
 void EdgeTopologyBuilder::SegmentEdges(std::vector<EdgeInfo>& edges) {
     const float epsilon = 0.001f;
     
     // Collect split points for each edge
+    // Candidate pairs come sorted by (i, j), so each edge receives its split points
+    // in the same order as a full scan over the other edges
     std::vector<std::vector<GridPos2D>> splitPoints(edges.size());
-    
-    for (size_t i = 0; i < edges.size(); ++i) {
-        const EdgeInfo& edge = edges[i];
-        
-        // Look for other edges that might create split points
-        for (size_t j = 0; j < edges.size(); ++j) {
-            if (i == j) continue;
-            if (edge.floorLevel != edges[j].floorLevel) continue;
-            
-            const EdgeInfo& other = edges[j];
-            
-            // Check if edges are collinear
-            if (!EdgesCollinear(edge, other)) continue;
-            
-            // Check if other.start is on edge (not at endpoints)
-            if (PointOnEdge(other.start, edge.start, edge.end, epsilon)) {
-                splitPoints[i].push_back(other.start);
-            }
-            
-            // Check if other.end is on edge (not at endpoints)
-            if (PointOnEdge(other.end, edge.start, edge.end, epsilon)) {
-                splitPoints[i].push_back(other.end);
-            }
+
+    auto collectSplits = [&](size_t target, size_t source) {
+        const EdgeInfo& edge = edges[target];
+        const EdgeInfo& other = edges[source];
+
+        // Check if edges are collinear
+        if (!EdgesCollinear(edge, other)) return;
+
+        // Check if other.start is on edge (not at endpoints)
+        if (PointOnEdge(other.start, edge.start, edge.end, epsilon)) {
+            splitPoints[target].push_back(other.start);
         }
+
+        // Check if other.end is on edge (not at endpoints)
+        if (PointOnEdge(other.end, edge.start, edge.end, epsilon)) {
+            splitPoints[target].push_back(other.end);
+        }
+    };
+
+    for (const auto& pair : FindCandidatePairs(edges)) {
+        collectSplits(pair.first, pair.second);
+        collectSplits(pair.second, pair.first);
     }
     
     // Create new segmented edges
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "BuildingTypes.h"
+#include <cstddef>
+#include <utility>
 #include <vector>
 #include <array>
 
@@ -59,6 +61,18 @@ public:
      */
     static std::vector<EdgeInfo> BuildTopology(const BuildingDefinition& definition);
 
+    /**
+     * @brief Find candidate edge pairs for collinear overlap / T-junction tests
+     * Axis-aligned edges are bucketed by floor, orientation and grid line
+     * (GridCoord::ToGridUnits), sorted along the line and swept, so each floor
+     * costs O(E log E) plus the number of reported pairs. Edges that are not
+     * axis-aligned fall back to pairing with every edge on the same floor.
+     * @param edges Input edges
+     * @return Pairs (i, j) with i < j, sorted; every same-floor pair of collinear
+     *         edges whose intervals touch or overlap is included
+     */
+    static std::vector<std::pair<size_t, size_t>> FindCandidatePairs(const std::vector<EdgeInfo>& edges);
+
 private:
     // Helper: Check if point is on edge (between start and end)
     static bool PointOnEdge(const GridPos2D& point, 
@@ -64,16 +64,25 @@ public:
                        std::vector<FacadeElement>& outElements);
 
     /**
-     * @brief Set window parameters
+     * @brief Place windows on the exterior walls of a wall list
+     * Appends to outWindows in wall order; does not modify generator state,
+     * so disjoint wall lists may be processed concurrently.
+     * @param definition Building definition
+     * @param walls Wall segments to process
+     * @param index Building index for fast lookups
+     * @param outWindows Output window placements (appended)
      */
-    void SetWindowParameters(float width, float height, float sillHeight);
-
-private:
     void GenerateWindows(const BuildingDefinition& definition,
                         const std::vector<WallSegment>& walls,
                         const BuildingIndex& index,
                         std::vector<Window>& outWindows);
-    
+
+    /**
+     * @brief Set window parameters
+     */
+    void SetWindowParameters(float width, float height, float sillHeight);
+
+private:
     void GenerateBalconies(const BuildingDefinition& definition,
                           const std::vector<WallSegment>& walls,
                           const BuildingIndex& index,
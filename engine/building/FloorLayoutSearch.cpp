@@ -0,0 +1,217 @@
+#include "FloorLayoutSearch.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+using namespace Moon::Building;
+
+// Score weights; placement dominates so a candidate never wins by dropping spaces
+constexpr float kPlacementWeight = 0.5f;
+constexpr float kAreaWeight = 0.2f;
+constexpr float kAdjacencyWeight = 0.3f;
+constexpr float kOverlapPenaltyWeight = 0.5f;
+
+std::string ToLowerCopy(const std::string& value) {
+    std::string lowered = value;
+    std::transform(lowered.begin(), lowered.end(), lowered.begin(),
+                   [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+    return lowered;
+}
+
+bool IsCoreSemanticType(const std::string& type) {
+    const std::string lowered = ToLowerCopy(type);
+    return lowered == "core" || lowered == "stairs" || lowered == "elevator" || lowered == "mechanical";
+}
+
+float PriorityWeight(const std::string& priority) {
+    const std::string lowered = ToLowerCopy(priority);
+    if (lowered == "high" || lowered == "critical") {
+        return 3.0f;
+    }
+    if (lowered == "low") {
+        return 1.0f;
+    }
+    return 2.0f;
+}
+
+// SplitMix64: portable, unlike std::shuffle whose output differs between standard libraries
+uint64_t NextRandom(uint64_t& state) {
+    state += 0x9E3779B97F4A7C15ull;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+float RectArea(const Rect& rect) {
+    return std::max(0.0f, rect.size[0]) * std::max(0.0f, rect.size[1]);
+}
+
+float OverlapArea(const Rect& a, const Rect& b) {
+    const float width = std::min(a.origin[0] + a.size[0], b.origin[0] + b.size[0]) -
+        std::max(a.origin[0], b.origin[0]);
+    const float depth = std::min(a.origin[1] + a.size[1], b.origin[1] + b.size[1]) -
+        std::max(a.origin[1], b.origin[1]);
+    return width > 0.001f && depth > 0.001f ? width * depth : 0.0f;
+}
+
+bool RectsTouch(const Rect& a, const Rect& b, float tolerance) {
+    const float gapX = std::max(a.origin[0], b.origin[0]) -
+        std::min(a.origin[0] + a.size[0], b.origin[0] + b.size[0]);
+    const float gapY = std::max(a.origin[1], b.origin[1]) -
+        std::min(a.origin[1] + a.size[1], b.origin[1] + b.size[1]);
+    // Sharing a wall needs contact along one axis and overlap along the other
+    return (std::abs(gapX) <= tolerance && gapY < -tolerance) ||
+           (std::abs(gapY) <= tolerance && gapX < -tolerance);
+}
+
+float AreaFulfilment(const SemanticSpace& space, float area) {
+    const float target = space.areaPreferred > 0.0f ? space.areaPreferred : space.areaMin;
+    if (target <= 0.0f || area <= 0.0f) {
+        return 1.0f;
+    }
+    if (area < target) {
+        return area / target;
+    }
+    const float upper = std::max(target, space.areaMax);
+    return area <= upper ? 1.0f : upper / area;
+}
+
+} // namespace
+
+namespace Moon {
+namespace Building {
+
+FloorLayoutInput MakeFloorLayoutCandidate(const FloorLayoutInput& layoutInput,
+                                          uint64_t seed,
+                                          size_t candidateIndex) {
+    FloorLayoutInput candidate = layoutInput;
+    if (candidateIndex == 0) {
+        return candidate;
+    }
+
+    std::vector<size_t> movableSlots;
+    movableSlots.reserve(layoutInput.spaces.size());
+    for (size_t i = 0; i < layoutInput.spaces.size(); ++i) {
+        if (!IsCoreSemanticType(layoutInput.spaces[i].type)) {
+            movableSlots.push_back(i);
+        }
+    }
+
+    uint64_t state = seed;
+    state ^= NextRandom(state) + static_cast<uint64_t>(static_cast<int64_t>(layoutInput.level));
+    state ^= NextRandom(state) + static_cast<uint64_t>(candidateIndex);
+
+    std::vector<size_t> order = movableSlots;
+    for (size_t i = order.size(); i > 1; --i) {
+        const size_t j = static_cast<size_t>(NextRandom(state) % i);
+        std::swap(order[i - 1], order[j]);
+    }
+    for (size_t i = 0; i < movableSlots.size(); ++i) {
+        candidate.spaces[movableSlots[i]] = layoutInput.spaces[order[i]];
+    }
+    return candidate;
+}
+
+float ScoreFloorLayout(const FloorLayoutInput& layoutInput, const ResolvedFloorLayout& resolvedFloor) {
+    std::unordered_map<std::string, const ResolvedSpacePlan*> placed;
+    placed.reserve(resolvedFloor.spaces.size());
+    for (const auto& space : resolvedFloor.spaces) {
+        placed.emplace(space.spaceId, &space);
+    }
+
+    float requestedWeight = 0.0f;
+    float placedWeight = 0.0f;
+    float areaSum = 0.0f;
+    size_t areaCount = 0;
+    size_t requiredAdjacencies = 0;
+    size_t satisfiedAdjacencies = 0;
+    for (const auto& semanticSpace : layoutInput.spaces) {
+        if (IsCoreSemanticType(semanticSpace.type) ||
+            StringToSpaceUsage(semanticSpace.type) == SpaceUsage::Unknown) {
+            continue;
+        }
+
+        const float weight = PriorityWeight(semanticSpace.priority);
+        requestedWeight += weight;
+        auto it = placed.find(semanticSpace.spaceId);
+        if (it == placed.end()) {
+            continue;
+        }
+        placedWeight += weight;
+        areaSum += AreaFulfilment(semanticSpace, RectArea(it->second->rect));
+        ++areaCount;
+
+        for (const auto& adjacency : semanticSpace.adjacency) {
+            if (adjacency.importance != "required") {
+                continue;
+            }
+            auto anchor = placed.find(adjacency.to);
+            if (anchor == placed.end()) {
+                continue;
+            }
+            ++requiredAdjacencies;
+            if (RectsTouch(it->second->rect, anchor->second->rect, 0.05f)) {
+                ++satisfiedAdjacencies;
+            }
+        }
+    }
+
+    if (requestedWeight <= 0.0f) {
+        return resolvedFloor.spaces.empty() ? 1.0f : 0.0f;
+    }
+
+    float totalArea = 0.0f;
+    float overlappingArea = 0.0f;
+    for (size_t i = 0; i < resolvedFloor.spaces.size(); ++i) {
+        const Rect& rect = resolvedFloor.spaces[i].rect;
+        totalArea += RectArea(rect);
+        for (size_t j = i + 1; j < resolvedFloor.spaces.size(); ++j) {
+            overlappingArea += OverlapArea(rect, resolvedFloor.spaces[j].rect);
+        }
+    }
+
+    const float placement = placedWeight / requestedWeight;
+    const float area = areaCount > 0 ? areaSum / static_cast<float>(areaCount) : 0.0f;
+    const float adjacency = requiredAdjacencies > 0
+        ? static_cast<float>(satisfiedAdjacencies) / static_cast<float>(requiredAdjacencies)
+        : 1.0f;
+    const float overlap = totalArea > 0.0f ? std::min(1.0f, overlappingArea / totalArea) : 0.0f;
+
+    const float score = kPlacementWeight * placement + kAreaWeight * area * placement +
+        kAdjacencyWeight * adjacency * placement - kOverlapPenaltyWeight * overlap;
+    return std::clamp(score, 0.0f, 1.0f);
+}
+
+size_t SelectFloorLayoutCandidate(const std::vector<float>& scores, const std::vector<bool>& accepted) {
+    size_t best = scores.size();
+    for (size_t i = 0; i < scores.size() && i < accepted.size(); ++i) {
+        if (accepted[i] && (best == scores.size() || scores[i] > scores[best])) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void SummarizeFloorLayoutScores(std::vector<float> scores, FloorLayoutSearchStats& ioStats) {
+    if (scores.empty()) {
+        ioStats.scoreMin = ioStats.scoreMedian = ioStats.scoreMax = 0.0f;
+        return;
+    }
+
+    std::sort(scores.begin(), scores.end());
+    ioStats.scoreMin = scores.front();
+    ioStats.scoreMax = scores.back();
+    const size_t middle = scores.size() / 2;
+    ioStats.scoreMedian = scores.size() % 2 == 1
+        ? scores[middle]
+        : 0.5f * (scores[middle - 1] + scores[middle]);
+}
+
+} // namespace Building
+} // namespace Moon
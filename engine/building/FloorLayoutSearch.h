@@ -0,0 +1,58 @@
+#pragma once
+
+#include "BuildingGenerationInputs.h"
+#include "BuildingTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Moon {
+namespace Building {
+
+/**
+ * @brief Multi-candidate floor layout search settings
+ * The typology solvers place spaces first-fit in input order. Their attempt
+ * loops (office and retail safe-interior and atrium fits) only shrink a rect
+ * until it fits the plate, so they depend on plate geometry and not on order
+ * or seed. A search therefore runs the solver on candidateCount placement
+ * orders per floor and keeps the best-scoring layout. Candidate 0 is always the
+ * authored order, so candidateCount = 1 is the plain solver result.
+ */
+struct FloorLayoutSearchOptions {
+    size_t candidateCount = 1;
+    uint64_t seed = 0;              // Same seed and candidate count give the same layout
+};
+
+/**
+ * @brief Build the solver input for one search candidate
+ * Core, stair, elevator and mechanical entries keep their positions; the other
+ * spaces are permuted with a generator derived from (seed, floor level, index).
+ * @param candidateIndex 0 returns the authored order unchanged
+ */
+FloorLayoutInput MakeFloorLayoutCandidate(const FloorLayoutInput& layoutInput,
+                                          uint64_t seed,
+                                          size_t candidateIndex);
+
+/**
+ * @brief Typology-independent layout quality score in [0, 1]
+ * Combines the priority-weighted share of requested spaces that were placed,
+ * how close placed areas are to their preferred area, the share of required
+ * adjacencies whose rects touch, and a penalty for overlapping rects.
+ */
+float ScoreFloorLayout(const FloorLayoutInput& layoutInput, const ResolvedFloorLayout& resolvedFloor);
+
+/**
+ * @brief Pick the winning candidate: highest score, lowest index on ties
+ * @param scores Candidate scores; rejected candidates are marked by accepted[i] == false
+ * @return Winning index, or scores.size() when no candidate was accepted
+ */
+size_t SelectFloorLayoutCandidate(const std::vector<float>& scores, const std::vector<bool>& accepted);
+
+/**
+ * @brief Fill the score distribution of FloorLayoutSearchStats
+ * @param scores Scores of every accepted candidate over all searched floors
+ */
+void SummarizeFloorLayoutScores(std::vector<float> scores, FloorLayoutSearchStats& ioStats);
+
+} // namespace Building
+} // namespace Moon
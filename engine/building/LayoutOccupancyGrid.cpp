@@ -0,0 +1,231 @@
+#include "LayoutOccupancyGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Moon {
+namespace Building {
+
+namespace {
+
+constexpr float kOverlapEpsilon = 0.001f;
+constexpr float kAlignmentTolerance = 1e-4f;
+
+int CountTrailingZeros(uint64_t value) {
+    int count = 0;
+    while ((value & 1ull) == 0) {
+        value >>= 1;
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief out[i] = bit (i + shift) of in, over a multi-word bitset
+ */
+void ShiftDown(const std::vector<uint64_t>& in, size_t shift, std::vector<uint64_t>& out) {
+    const size_t wordShift = shift / 64;
+    const size_t bitShift = shift % 64;
+    for (size_t i = 0; i < in.size(); ++i) {
+        const size_t src = i + wordShift;
+        uint64_t value = src < in.size() ? in[src] >> bitShift : 0;
+        if (bitShift != 0 && src + 1 < in.size()) {
+            value |= in[src + 1] << (64 - bitShift);
+        }
+        out[i] = value;
+    }
+}
+
+} // namespace
+
+bool LayoutOccupancyGrid::RectanglesOverlap(const GridPos2D& aPos, const GridSize2D& aSize,
+                                            const GridPos2D& bPos, const GridSize2D& bSize) {
+    return !(aPos[0] + aSize[0] <= bPos[0] + kOverlapEpsilon ||
+             bPos[0] + bSize[0] <= aPos[0] + kOverlapEpsilon ||
+             aPos[1] + aSize[1] <= bPos[1] + kOverlapEpsilon ||
+             bPos[1] + bSize[1] <= aPos[1] + kOverlapEpsilon);
+}
+
+void LayoutOccupancyGrid::Reset(float width, float depth, float cellSize) {
+    m_width = width;
+    m_depth = depth;
+    m_cellSize = cellSize > 0.0f ? cellSize : 0.5f;
+
+    // A footprint that is not a whole number of cells disables the raster entirely
+    int cellsX = 0;
+    int cellsY = 0;
+    if (!(width > 0.0f && depth > 0.0f && ToCells(width, cellsX) && ToCells(depth, cellsY))) {
+        cellsX = 0;
+        cellsY = 0;
+    }
+    m_cellsX = cellsX;
+    m_cellsY = cellsY;
+    m_wordsPerRow = (static_cast<size_t>(m_cellsX) + 63) / 64;
+    Clear();
+}
+
+void LayoutOccupancyGrid::Clear() {
+    m_rowBits.assign(m_wordsPerRow * static_cast<size_t>(m_cellsY), 0);
+    m_coverage.assign((static_cast<size_t>(m_cellsX) + 1) * (static_cast<size_t>(m_cellsY) + 1), 0);
+    m_reserved.clear();
+    m_irregular.clear();
+}
+
+bool LayoutOccupancyGrid::ToCells(float value, int& outCell) const {
+    const float cells = value / m_cellSize;
+    const float rounded = std::round(cells);
+    if (std::abs(cells - rounded) * m_cellSize > kAlignmentTolerance) {
+        return false;
+    }
+    outCell = static_cast<int>(rounded);
+    return true;
+}
+
+bool LayoutOccupancyGrid::ToCellRect(const GridPos2D& position, const GridSize2D& size, CellRect& outRect) const {
+    int x = 0;
+    int y = 0;
+    int w = 0;
+    int h = 0;
+    if (!ToCells(position[0], x) || !ToCells(position[1], y) ||
+        !ToCells(size[0], w) || !ToCells(size[1], h) || w <= 0 || h <= 0) {
+        return false;
+    }
+    outRect.x0 = x;
+    outRect.y0 = y;
+    outRect.x1 = x + w;
+    outRect.y1 = y + h;
+    return true;
+}
+
+void LayoutOccupancyGrid::Reserve(const GridPos2D& origin, const GridSize2D& size) {
+    m_reserved.push_back({origin, size});
+
+    CellRect rect;
+    if (m_cellsX == 0 || !ToCellRect(origin, size, rect)) {
+        m_irregular.push_back({origin, size});
+        return;
+    }
+
+    // Parts outside the footprint can only overlap off-grid queries, which use m_reserved
+    const int x0 = std::max(rect.x0, 0);
+    const int y0 = std::max(rect.y0, 0);
+    const int x1 = std::min(rect.x1, m_cellsX);
+    const int y1 = std::min(rect.y1, m_cellsY);
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+
+    for (int y = y0; y < y1; ++y) {
+        uint64_t* row = &m_rowBits[static_cast<size_t>(y) * m_wordsPerRow];
+        for (int x = x0; x < x1; ++x) {
+            row[x / 64] |= 1ull << (x % 64);
+        }
+    }
+
+    // Coverage counts (not occupancy) keep the update additive: a region is free iff its sum is 0
+    const size_t stride = static_cast<size_t>(m_cellsX) + 1;
+    for (int y = y0 + 1; y <= m_cellsY; ++y) {
+        const uint32_t rows = static_cast<uint32_t>(std::min(y, y1) - y0);
+        for (int x = x0 + 1; x <= m_cellsX; ++x) {
+            const uint32_t columns = static_cast<uint32_t>(std::min(x, x1) - x0);
+            m_coverage[static_cast<size_t>(y) * stride + static_cast<size_t>(x)] += rows * columns;
+        }
+    }
+}
+
+uint32_t LayoutOccupancyGrid::CoverageSum(const CellRect& rect) const {
+    const size_t stride = static_cast<size_t>(m_cellsX) + 1;
+    auto at = [&](int x, int y) {
+        return m_coverage[static_cast<size_t>(y) * stride + static_cast<size_t>(x)];
+    };
+    return at(rect.x1, rect.y1) - at(rect.x0, rect.y1) - at(rect.x1, rect.y0) + at(rect.x0, rect.y0);
+}
+
+bool LayoutOccupancyGrid::OverlapsAny(const std::vector<ReservedRect>& rects,
+                                      const GridPos2D& position, const GridSize2D& size) const {
+    for (const auto& rect : rects) {
+        if (RectanglesOverlap(position, size, rect.origin, rect.size)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LayoutOccupancyGrid::IsFree(const GridPos2D& position, const GridSize2D& size) const {
+    CellRect rect;
+    if (!ToCellRect(position, size, rect) ||
+        rect.x0 < 0 || rect.y0 < 0 || rect.x1 > m_cellsX || rect.y1 > m_cellsY) {
+        return !OverlapsAny(m_reserved, position, size);
+    }
+
+    return CoverageSum(rect) == 0 && !OverlapsAny(m_irregular, position, size);
+}
+
+bool LayoutOccupancyGrid::FindFirstFitLinear(const GridSize2D& size, GridPos2D& outPosition) const {
+    for (float y = 0.0f; y <= m_depth - size[1] + 0.001f; y += m_cellSize) {
+        for (float x = 0.0f; x <= m_width - size[0] + 0.001f; x += m_cellSize) {
+            const GridPos2D candidate = {
+                std::round(x / m_cellSize) * m_cellSize,
+                std::round(y / m_cellSize) * m_cellSize
+            };
+            if (IsFree(candidate, size)) {
+                outPosition = candidate;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool LayoutOccupancyGrid::FindFirstFit(const GridSize2D& size, GridPos2D& outPosition) const {
+    int w = 0;
+    int h = 0;
+    if (m_cellsX == 0 || !m_irregular.empty() ||
+        !ToCells(size[0], w) || !ToCells(size[1], h) || w <= 0 || h <= 0) {
+        return FindFirstFitLinear(size, outPosition);
+    }
+    if (w > m_cellsX || h > m_cellsY) {
+        return false;
+    }
+
+    // Mask of real cells in the last word, so runs never extend past the footprint
+    const int tailBits = m_cellsX % 64;
+    const uint64_t tailMask = tailBits == 0 ? ~0ull : (1ull << tailBits) - 1;
+
+    std::vector<uint64_t> runs(m_wordsPerRow);
+    std::vector<uint64_t> shifted(m_wordsPerRow);
+    for (int y = 0; y + h <= m_cellsY; ++y) {
+        // Free cells across the h rows of the candidate band
+        for (size_t word = 0; word < m_wordsPerRow; ++word) {
+            uint64_t occupied = 0;
+            for (int row = y; row < y + h; ++row) {
+                occupied |= m_rowBits[static_cast<size_t>(row) * m_wordsPerRow + word];
+            }
+            runs[word] = ~occupied;
+        }
+        runs.back() &= tailMask;
+
+        // Erode: bit x survives iff cells x .. x + w - 1 are all free
+        int length = 1;
+        while (length < w) {
+            const int step = std::min(length, w - length);
+            ShiftDown(runs, static_cast<size_t>(step), shifted);
+            for (size_t word = 0; word < m_wordsPerRow; ++word) {
+                runs[word] &= shifted[word];
+            }
+            length += step;
+        }
+
+        for (size_t word = 0; word < m_wordsPerRow; ++word) {
+            if (runs[word] != 0) {
+                const int x = static_cast<int>(word * 64) + CountTrailingZeros(runs[word]);
+                outPosition = {static_cast<float>(x) * m_cellSize, static_cast<float>(y) * m_cellSize};
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace Building
+} // namespace Moon
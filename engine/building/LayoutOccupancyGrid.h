@@ -0,0 +1,92 @@
+#pragma once
+
+#include "BuildingTypes.h"
+#include <cstdint>
+#include <vector>
+
+namespace Moon {
+namespace Building {
+
+/**
+ * @brief Occupancy grid for rectangle placement on one floor
+ * Grid-aligned reserved rects are rasterized into per-row bitsets and a
+ * summed-area table of coverage counts, so "is this rect free" is O(1) and
+ * first-fit scans 64 cells per word. Rects that are not grid aligned (or
+ * degenerate) are kept in a side list and checked with the exact float test,
+ * so results always match a linear scan over the reserved rects.
+ */
+class LayoutOccupancyGrid {
+public:
+    /**
+     * @brief Resize the grid to a footprint and drop all reserved rects
+     * @param width Footprint width (X)
+     * @param depth Footprint depth (Y)
+     * @param cellSize Grid cell size
+     */
+    void Reset(float width, float depth, float cellSize);
+
+    /**
+     * @brief Drop all reserved rects, keeping the grid size
+     */
+    void Clear();
+
+    /**
+     * @brief Mark a rect as occupied
+     */
+    void Reserve(const GridPos2D& origin, const GridSize2D& size);
+
+    /**
+     * @brief True when the rect overlaps no reserved rect (footprint bounds are not checked)
+     */
+    bool IsFree(const GridPos2D& position, const GridSize2D& size) const;
+
+    /**
+     * @brief Find the first free position in row-major order (Y outer, X inner)
+     * Only positions that keep the rect inside the footprint are considered.
+     */
+    bool FindFirstFit(const GridSize2D& size, GridPos2D& outPosition) const;
+
+    int GetCellsX() const { return m_cellsX; }
+    int GetCellsY() const { return m_cellsY; }
+
+    /**
+     * @brief Exact overlap test shared with LayoutResolver (0.001 m tolerance)
+     */
+    static bool RectanglesOverlap(const GridPos2D& aPos, const GridSize2D& aSize,
+                                  const GridPos2D& bPos, const GridSize2D& bSize);
+
+private:
+    struct CellRect {
+        int x0 = 0;
+        int y0 = 0;
+        int x1 = 0;   // Exclusive
+        int y1 = 0;   // Exclusive
+    };
+
+    struct ReservedRect {
+        GridPos2D origin;
+        GridSize2D size;
+    };
+
+    bool ToCells(float value, int& outCell) const;
+    bool ToCellRect(const GridPos2D& position, const GridSize2D& size, CellRect& outRect) const;
+    bool OverlapsAny(const std::vector<ReservedRect>& rects,
+                     const GridPos2D& position, const GridSize2D& size) const;
+    uint32_t CoverageSum(const CellRect& rect) const;
+    bool FindFirstFitLinear(const GridSize2D& size, GridPos2D& outPosition) const;
+
+    float m_width = 0.0f;
+    float m_depth = 0.0f;
+    float m_cellSize = 0.5f;
+    int m_cellsX = 0;
+    int m_cellsY = 0;
+    size_t m_wordsPerRow = 0;
+
+    std::vector<uint64_t> m_rowBits;      // m_cellsY rows of m_wordsPerRow words; bit set = occupied
+    std::vector<uint32_t> m_coverage;     // (m_cellsX + 1) x (m_cellsY + 1) summed-area table
+    std::vector<ReservedRect> m_reserved; // Every reserved rect, for off-grid queries
+    std::vector<ReservedRect> m_irregular;// Reserved rects the raster cannot represent exactly
+};
+
+} // namespace Building
+} // namespace Moon
@@ -172,7 +172,7 @@ bool LayoutResolver::ResolveInternal(
     MOON_LOG_INFO("LayoutResolver", "Building type: %s", input.buildingType.c_str());
 
     m_allocatedSpaces.clear();
-    m_reservedRects.clear();
+    ClearReservedRects();
     
     // Step 1: Calculate footprint
     if (!CalculateFootprint(input)) {
@@ -274,16 +274,16 @@ bool LayoutResolver::AllocateSpaces(const SemanticBuilding& input)
                         const float top = std::max(0.0f, voidIt->position[1] - band);
                         const float bottom = std::min(m_footprint[1], voidIt->position[1] + voidIt->size[1] + band);
 
-                        m_reservedRects.push_back(CreateRect(semanticSpace.spaceId + "_top",
+                        ReserveRect(CreateRect(semanticSpace.spaceId + "_top",
                             SnapToGrid({left, top}),
                             SnapToGrid({right - left, band})));
-                        m_reservedRects.push_back(CreateRect(semanticSpace.spaceId + "_bottom",
+                        ReserveRect(CreateRect(semanticSpace.spaceId + "_bottom",
                             SnapToGrid({left, std::max(0.0f, bottom - band)}),
                             SnapToGrid({right - left, band})));
-                        m_reservedRects.push_back(CreateRect(semanticSpace.spaceId + "_left",
+                        ReserveRect(CreateRect(semanticSpace.spaceId + "_left",
                             SnapToGrid({left, voidIt->position[1]}),
                             SnapToGrid({band, voidIt->size[1]})));
-                        m_reservedRects.push_back(CreateRect(semanticSpace.spaceId + "_right",
+                        ReserveRect(CreateRect(semanticSpace.spaceId + "_right",
                             SnapToGrid({std::max(0.0f, right - band), voidIt->position[1]}),
                             SnapToGrid({band, voidIt->size[1]})));
                         return;
@@ -291,7 +291,7 @@ bool LayoutResolver::AllocateSpaces(const SemanticBuilding& input)
                 }
             }
 
-            m_reservedRects.push_back(CreateRect(semanticSpace.spaceId,
+            ReserveRect(CreateRect(semanticSpace.spaceId,
                 SnapToGrid(allocated.position),
                 SnapToGrid(allocated.size)));
         };
@@ -425,7 +425,7 @@ bool LayoutResolver::AllocateSpaces(const SemanticBuilding& input)
                                     std::vector<AllocatedSpace>& outSpaces,
                                     float& outUsedHeight) -> bool {
             outSpaces.clear();
-            m_reservedRects.clear();
+            ClearReservedRects();
 
             outUsedHeight = 0.0f;
 
@@ -1010,12 +1010,7 @@ std::vector<const SemanticSpace*> LayoutResolver::BuildPlacementOrder(const Sema
 bool LayoutResolver::RectanglesOverlap(const GridPos2D& aPos, const GridSize2D& aSize,
                                        const GridPos2D& bPos, const GridSize2D& bSize) const
 {
-    const float epsilon = 0.001f;
-
-    return !(aPos[0] + aSize[0] <= bPos[0] + epsilon ||
-             bPos[0] + bSize[0] <= aPos[0] + epsilon ||
-             aPos[1] + aSize[1] <= bPos[1] + epsilon ||
-             bPos[1] + bSize[1] <= aPos[1] + epsilon);
+    return LayoutOccupancyGrid::RectanglesOverlap(aPos, aSize, bPos, bSize);
 }
 
 bool LayoutResolver::FitsWithoutOverlap(const GridPos2D& position,
@@ -1032,6 +1027,10 @@ bool LayoutResolver::FitsWithoutOverlap(const GridPos2D& position,
         return false;
     }
 
+    if (m_useOccupancyGrid) {
+        return m_occupancy.IsFree(position, size);
+    }
+
     for (const auto& reservedRect : m_reservedRects) {
         if (RectanglesOverlap(position, size, reservedRect.origin, reservedRect.size)) {
             return false;
@@ -1045,6 +1044,10 @@ bool LayoutResolver::FindFirstFitPosition(const GridSize2D& size,
                                           const std::vector<AllocatedSpace>& placedSpaces,
                                           GridPos2D& outPosition) const
 {
+    if (m_useOccupancyGrid) {
+        return m_occupancy.FindFirstFit(size, outPosition);
+    }
+
     for (float y = 0.0f; y <= m_footprint[1] - size[1] + 0.001f; y += m_gridSize) {
         for (float x = 0.0f; x <= m_footprint[0] - size[0] + 0.001f; x += m_gridSize) {
             GridPos2D candidate = SnapToGrid({x, y});
@@ -1383,42 +1386,61 @@ bool LayoutResolver::TryPlaceOnExteriorWall(const SemanticSpace& space,
         candidates.push_back(SnapToGrid({std::max(0.0f, m_footprint[0] - size[0]), y}));
     }
 
-    auto scoreCandidate = [&](const GridPos2D& candidate) -> float {
-        float score = 0.0f;
+    // Resolve adjacency anchors once instead of per comparison
+    struct ScoreAnchor {
+        GridPos2D position;
+        float weight;
+    };
+    std::vector<ScoreAnchor> scoreAnchors;
+    for (const auto& adjacency : space.adjacency) {
+        if (adjacency.relationship != "connected" && adjacency.relationship != "nearby") {
+            continue;
+        }
 
-        for (const auto& adjacency : space.adjacency) {
-            if (adjacency.relationship != "connected" && adjacency.relationship != "nearby") {
-                continue;
-            }
+        auto it = std::find_if(placedSpaces.begin(), placedSpaces.end(),
+                               [&](const AllocatedSpace& placed) {
+                                   return placed.spaceId == adjacency.to;
+                               });
+        if (it == placedSpaces.end()) {
+            continue;
+        }
 
-            auto it = std::find_if(placedSpaces.begin(), placedSpaces.end(),
-                                   [&](const AllocatedSpace& placed) {
-                                       return placed.spaceId == adjacency.to;
-                                   });
-            if (it == placedSpaces.end()) {
-                continue;
-            }
+        scoreAnchors.push_back({it->position, adjacency.importance == "required" ? 2.0f : 1.0f});
+    }
 
-            const float dx = candidate[0] - it->position[0];
-            const float dy = candidate[1] - it->position[1];
+    auto scoreCandidate = [&](const GridPos2D& candidate) -> float {
+        float score = 0.0f;
+        for (const auto& anchor : scoreAnchors) {
+            const float dx = candidate[0] - anchor.position[0];
+            const float dy = candidate[1] - anchor.position[1];
             const float distance = std::abs(dx) + std::abs(dy);
             score -= distance;
-            if (adjacency.importance == "required") {
+            if (anchor.weight > 1.0f) {
                 score -= distance;
             }
         }
-
         return score;
     };
 
-    std::sort(candidates.begin(), candidates.end(),
-              [&](const GridPos2D& lhs, const GridPos2D& rhs) {
-                  return scoreCandidate(lhs) > scoreCandidate(rhs);
+    // Same comparison outcomes as sorting on positions, so the order is unchanged
+    struct ScoredCandidate {
+        GridPos2D position;
+        float score;
+    };
+    std::vector<ScoredCandidate> scored;
+    scored.reserve(candidates.size());
+    for (const auto& candidate : candidates) {
+        scored.push_back({candidate, scoreCandidate(candidate)});
+    }
+
+    std::sort(scored.begin(), scored.end(),
+              [](const ScoredCandidate& lhs, const ScoredCandidate& rhs) {
+                  return lhs.score > rhs.score;
               });
 
-    for (const auto& candidate : candidates) {
-        if (FitsWithoutOverlap(candidate, size, placedSpaces)) {
-            outPosition = candidate;
+    for (const auto& candidate : scored) {
+        if (FitsWithoutOverlap(candidate.position, size, placedSpaces)) {
+            outPosition = candidate.position;
             return true;
         }
     }
@@ -1715,5 +1737,17 @@ Rect LayoutResolver::CreateRect(const std::string& rectId, const GridPos2D& orig
     return rect;
 }
 
+void LayoutResolver::ReserveRect(Rect rect)
+{
+    m_occupancy.Reserve(rect.origin, rect.size);
+    m_reservedRects.push_back(std::move(rect));
+}
+
+void LayoutResolver::ClearReservedRects()
+{
+    m_reservedRects.clear();
+    m_occupancy.Reset(m_footprint[0], m_footprint[1], m_gridSize);
+}
+
 } // namespace Building
 } // namespace Moon
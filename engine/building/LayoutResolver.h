@@ -2,6 +2,7 @@
 
 #include "BuildingTypology.h"
 #include "BuildingTypes.h"
+#include "LayoutOccupancyGrid.h"
 #include "SemanticBuildingTypes.h"
 
 #include <string>
@@ -23,6 +24,13 @@ public:
     void SetGridSize(float gridSize) { m_gridSize = gridSize; }
     void SetVerbose(bool verbose) { m_verbose = verbose; }
 
+    /**
+     * @brief Answer placement queries from the per-floor occupancy grid (default)
+     * When disabled, every query scans the reserved rects linearly. Both paths
+     * produce identical layouts; the switch exists for benchmarking.
+     */
+    void SetUseOccupancyGrid(bool enabled) { m_useOccupancyGrid = enabled; }
+
 private:
     struct AllocatedSpace {
         std::string spaceId;
@@ -61,6 +69,8 @@ private:
     GridSize2D CalculateOptimalDimensions(float area, float aspectRatio) const;
     GridPos2D SnapToGrid(const GridPos2D& v) const;
     Rect CreateRect(const std::string& rectId, const GridPos2D& origin, const GridSize2D& size) const;
+    void ReserveRect(Rect rect);
+    void ClearReservedRects();
     bool RectanglesOverlap(const GridPos2D& aPos, const GridSize2D& aSize,
                            const GridPos2D& bPos, const GridSize2D& bSize) const;
     bool FitsWithoutOverlap(const GridPos2D& position,
@@ -103,9 +113,11 @@ private:
 
     float m_gridSize = 0.5f;
     bool m_verbose = false;
-    GridSize2D m_footprint;
+    bool m_useOccupancyGrid = true;
+    GridSize2D m_footprint = {0.0f, 0.0f};
     std::vector<AllocatedSpace> m_allocatedSpaces;
     std::vector<Rect> m_reservedRects;
+    LayoutOccupancyGrid m_occupancy;    // Mirrors m_reservedRects for the floor being placed
 };
 
 } // namespace Building
@@ -1,4 +1,6 @@
 #include "LayoutValidator.h"
+#include "BuildingTaskPool.h"
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 #include <sstream>
@@ -26,43 +28,46 @@ void LayoutValidator::SetWallThickness(float thickness) {
     m_wallThickness = thickness;
 }
 
-ValidationResult LayoutValidator::Validate(const BuildingDefinition& definition) {
-    ValidationResult result;
-    result.valid = true;
-
-    // Validate masses
-    if (!ValidateMasses(definition, result)) {
-        result.valid = false;
-    }
-
-    // Validate floor-mass references
-    if (!ValidateFloorMassReferences(definition, result)) {
-        result.valid = false;
-    }
-
-    // Validate space overlaps
-    if (!ValidateSpaceOverlaps(definition, result)) {
-        result.valid = false;
-    }
-
-    // Validate space boundaries
-    if (!ValidateSpaceBoundaries(definition, result)) {
-        result.valid = false;
-    }
+ValidationResult LayoutValidator::Validate(const BuildingDefinition& definition, BuildingTaskPool* pool) {
+    BuildingIndex index;
+    index.Build(definition);
+    index.BuildFloorRectIndex(definition);
+
+    // Checks are independent and read-only; each writes its own slot, merged in this order
+    const std::function<bool(ValidationResult&)> checks[] = {
+        [&](ValidationResult& r) { return ValidateMasses(definition, r); },
+        [&](ValidationResult& r) { return ValidateFloorMassReferences(definition, r); },
+        [&](ValidationResult& r) { return ValidateSpaceOverlaps(index, r); },
+        [&](ValidationResult& r) { return ValidateSpaceBoundaries(definition, index, r); },
+        [&](ValidationResult& r) { return ValidateMinimumSizes(definition, r); },
+        [&](ValidationResult& r) { return ValidateGridAlignment(definition, r); },
+        [&](ValidationResult& r) { return ValidateStairConnections(definition, r); },
+    };
+    constexpr size_t kCheckCount = sizeof(checks) / sizeof(checks[0]);
 
-    // Validate minimum sizes
-    if (!ValidateMinimumSizes(definition, result)) {
-        result.valid = false;
-    }
+    ValidationResult partial[kCheckCount];
+    bool passed[kCheckCount] = {};
+    auto runCheck = [&](size_t i) {
+        partial[i].valid = true;
+        passed[i] = checks[i](partial[i]);
+    };
 
-    // Validate grid alignment
-    if (!ValidateGridAlignment(definition, result)) {
-        result.valid = false;
+    if (pool) {
+        pool->Run(kCheckCount, runCheck);
+    } else {
+        for (size_t i = 0; i < kCheckCount; ++i) {
+            runCheck(i);
+        }
     }
 
-    // Validate stair connections
-    if (!ValidateStairConnections(definition, result)) {
-        result.valid = false;
+    ValidationResult result;
+    result.valid = true;
+    for (size_t i = 0; i < kCheckCount; ++i) {
+        if (!passed[i]) {
+            result.valid = false;
+        }
+        result.errors.insert(result.errors.end(), partial[i].errors.begin(), partial[i].errors.end());
+        result.warnings.insert(result.warnings.end(), partial[i].warnings.begin(), partial[i].warnings.end());
     }
 
     return result;
@@ -141,38 +146,33 @@ bool LayoutValidator::ValidateFloorMassReferences(const BuildingDefinition& defi
     return valid;
 }
 
-bool LayoutValidator::ValidateSpaceOverlaps(const BuildingDefinition& definition, ValidationResult& result) {
+bool LayoutValidator::ValidateSpaceOverlaps(const BuildingIndex& index, ValidationResult& result) {
     bool valid = true;
 
-    // Group spaces by floor level
-    std::unordered_map<int, std::vector<Rectangle>> floorSpaces;
-
-    for (const auto& floor : definition.floors) {
-        for (const auto& space : floor.spaces) {
-            for (const auto& rect : space.rects) {
-                Rectangle r;
-                r.x = rect.origin[0];
-                r.y = rect.origin[1];
-                r.width = rect.size[0];
-                r.height = rect.size[1];
-                r.spaceId = space.spaceId;
-                r.floorLevel = floor.level;
-                floorSpaces[floor.level].push_back(r);
-            }
-        }
-    }
-
-    // Check for overlaps within each floor
-    for (auto it = floorSpaces.begin(); it != floorSpaces.end(); ++it) {
-        int level = it->first;
-        const auto& rects = it->second;
-        for (size_t i = 0; i < rects.size(); ++i) {
-            for (size_t j = i + 1; j < rects.size(); ++j) {
-                if (rects[i].spaceId != rects[j].spaceId && RectanglesOverlap(rects[i], rects[j])) {
+    // Check for overlaps within each floor; the grid only yields nearby rects
+    std::vector<uint32_t> candidates;
+    for (int level : index.GetIndexedFloorLevels()) {
+        const auto& entries = index.GetFloorRects(level);
+        for (uint32_t i = 0; i < entries.size(); ++i) {
+            const Rect& rect = *entries[i].rect;
+            const Rectangle a = {rect.origin[0], rect.origin[1], rect.size[0], rect.size[1],
+                                 entries[i].spaceId, level};
+            index.QueryFloorRects(level, rect.origin,
+                                  {rect.origin[0] + rect.size[0], rect.origin[1] + rect.size[1]},
+                                  candidates);
+
+            for (uint32_t j : candidates) {
+                if (j <= i || entries[j].spaceId == a.spaceId) {
+                    continue;
+                }
+                const Rect& other = *entries[j].rect;
+                const Rectangle b = {other.origin[0], other.origin[1], other.size[0], other.size[1],
+                                     entries[j].spaceId, level};
+                if (RectanglesOverlap(a, b)) {
                     std::ostringstream oss;
                     oss << "Overlap detected on floor " << level 
-                        << " between space " << rects[i].spaceId 
-                        << " and space " << rects[j].spaceId;
+                        << " between space " << a.spaceId 
+                        << " and space " << b.spaceId;
                     result.errors.push_back(oss.str());
                     valid = false;
                 }
@@ -183,17 +183,12 @@ bool LayoutValidator::ValidateSpaceOverlaps(const BuildingDefinition& definition
     return valid;
 }
 
-bool LayoutValidator::ValidateSpaceBoundaries(const BuildingDefinition& definition, ValidationResult& result) {
+bool LayoutValidator::ValidateSpaceBoundaries(const BuildingDefinition& definition, const BuildingIndex& index,
+                                              ValidationResult& result) {
     bool valid = true;
 
-    // Build mass lookup
-    std::unordered_map<std::string, const Mass*> masses;
-    for (const auto& mass : definition.masses) {
-        masses[mass.massId] = &mass;
-    }
-
     for (const auto& floor : definition.floors) {
-        const Mass* mass = masses[floor.massId];
+        const Mass* mass = index.GetMass(floor.massId);
         if (!mass) continue;
 
         for (const auto& space : floor.spaces) {
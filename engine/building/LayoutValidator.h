@@ -1,5 +1,6 @@
 #pragma once
 
+#include "BuildingIndex.h"
 #include "BuildingTypes.h"
 #include <vector>
 #include <string>
@@ -7,10 +8,14 @@
 namespace Moon {
 namespace Building {
 
+class BuildingTaskPool;
+
 /**
  * @brief Layout Validator
  * Validates the spatial layout of buildings
  * Checks for overlaps, minimum sizes, boundaries, etc.
+ * Rect queries go through a per-floor grid built once per Validate() call, so
+ * overlap detection is near-linear in the number of rects.
  */
 class LayoutValidator {
 public:
@@ -20,9 +25,10 @@ public:
     /**
      * @brief Validate building layout
      * @param definition Building definition to validate
-     * @return Validation result with errors and warnings
+     * @param pool Optional worker pool; when set, the independent checks run concurrently
+     * @return Validation result with errors and warnings (same order with or without a pool)
      */
-    ValidationResult Validate(const BuildingDefinition& definition);
+    ValidationResult Validate(const BuildingDefinition& definition, BuildingTaskPool* pool = nullptr);
 
     /**
      * @brief Set minimum room dimensions
@@ -43,8 +49,9 @@ private:
 
     bool ValidateMasses(const BuildingDefinition& definition, ValidationResult& result);
     bool ValidateFloorMassReferences(const BuildingDefinition& definition, ValidationResult& result);
-    bool ValidateSpaceOverlaps(const BuildingDefinition& definition, ValidationResult& result);
-    bool ValidateSpaceBoundaries(const BuildingDefinition& definition, ValidationResult& result);
+    bool ValidateSpaceOverlaps(const BuildingIndex& index, ValidationResult& result);
+    bool ValidateSpaceBoundaries(const BuildingDefinition& definition, const BuildingIndex& index,
+                                 ValidationResult& result);
     bool ValidateMinimumSizes(const BuildingDefinition& definition, ValidationResult& result);
     bool ValidateGridAlignment(const BuildingDefinition& definition, ValidationResult& result);
     bool ValidateStairConnections(const BuildingDefinition& definition, ValidationResult& result);
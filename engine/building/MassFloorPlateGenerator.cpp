@@ -870,8 +870,7 @@ void AddInterpolatedEdgePoint(const Moon::Vector3& a,
 bool LoadMassingBuild(const std::string& assetRef,
                       CachedMassingBuild& outBuild,
                       std::string& outError) {
-    const std::string assetPath = Moon::Assets::BuildAssetPath(
-        assetRef.rfind("massing/", 0) == 0 ? assetRef : std::string("massing/") + assetRef);
+    const std::string assetPath = Moon::Assets::BuildMassingPath(assetRef);
     const std::string json = ReadTextFile(assetPath);
     if (json.empty()) {
         outError = "Failed to read massing rule asset: " + assetPath;
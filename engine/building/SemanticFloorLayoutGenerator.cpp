@@ -1,8 +1,10 @@
 #include "SemanticFloorLayoutGenerator.h"
+#include "BuildingTaskPool.h"
 #include "BuildingTypology.h"
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 
 namespace {
 
@@ -101,7 +103,9 @@ bool SemanticFloorLayoutGenerator::Generate(const BuildingDefinition& definition
                                             std::vector<Floor>& ioFloors,
                                             ResolvedBuildingLayout* outResolvedLayout,
                                             std::vector<ProgramBlock>* outDebugBlocks,
-                                            std::string& outError) const {
+                                            std::string& outError,
+                                            BuildingTaskPool* pool,
+                                            FloorLayoutSearchStats* outSearchStats) const {
     if (!layoutInput || floorPlates.empty()) {
         return true;
     }
@@ -128,6 +132,14 @@ bool SemanticFloorLayoutGenerator::Generate(const BuildingDefinition& definition
         }
     }
 
+    struct FloorJob {
+        Floor* floor = nullptr;
+        const FloorLayoutInput* semanticFloor = nullptr;
+        const FloorPlate* plate = nullptr;
+        std::vector<VerticalCore> cores;
+    };
+
+    std::vector<FloorJob> jobs;
     for (auto& floor : ioFloors) {
         const FloorLayoutInput* semanticFloor = FindFloorLayoutInput(layoutInput, floor.level);
         if (!semanticFloor) {
@@ -154,40 +166,94 @@ bool SemanticFloorLayoutGenerator::Generate(const BuildingDefinition& definition
             continue;
         }
 
+        FloorJob job;
+        job.floor = &floor;
+        job.semanticFloor = semanticFloor;
+        job.plate = &(*plateIt);
+        job.cores = std::move(floorCores);
+        jobs.push_back(std::move(job));
+    }
+
+    // Every (floor, candidate) pair is an independent task writing only its own slot
+    struct CandidateSlot {
         ResolvedFloorLayout resolvedFloor;
-        resolvedFloor.verticalTransports.clear();
-        if (typology == BuildingTypology::Office) {
-            if (!m_officeSolver.GenerateFloor(
-                    definition,
-                    *semanticFloor,
-                    *plateIt,
-                    floorCores,
-                    resolvedFloor,
-                    outError)) {
-                return false;
-            }
-        } else if (typology == BuildingTypology::Residential) {
-            if (!m_residentialSolver.GenerateFloor(
-                    definition,
-                    *semanticFloor,
-                    *plateIt,
-                    floorCores,
-                    resolvedFloor,
-                    outError)) {
-                return false;
+        std::string error;
+        bool accepted = false;
+        float score = 0.0f;
+    };
+
+    const size_t candidateCount = std::max<size_t>(1, m_searchOptions.candidateCount);
+    const bool searching = candidateCount > 1;
+    std::vector<CandidateSlot> slots(jobs.size() * candidateCount);
+    auto solveCandidate = [&](size_t slotIndex) {
+        const FloorJob& job = jobs[slotIndex / candidateCount];
+        const size_t candidateIndex = slotIndex % candidateCount;
+        CandidateSlot& slot = slots[slotIndex];
+        if (!searching) {
+            slot.accepted = SolveFloor(typology, definition, *job.semanticFloor, *job.plate, job.cores,
+                                       slot.resolvedFloor, slot.error);
+            return;
+        }
+
+        const FloorLayoutInput candidateInput =
+            MakeFloorLayoutCandidate(*job.semanticFloor, m_searchOptions.seed, candidateIndex);
+        slot.accepted = SolveFloor(typology, definition, candidateInput, *job.plate, job.cores,
+                                   slot.resolvedFloor, slot.error);
+        if (slot.accepted) {
+            slot.score = ScoreFloorLayout(*job.semanticFloor, slot.resolvedFloor);
+        }
+    };
+
+    const auto searchStart = std::chrono::steady_clock::now();
+    if (pool) {
+        pool->Run(slots.size(), solveCandidate);
+    } else {
+        for (size_t i = 0; i < slots.size(); ++i) {
+            solveCandidate(i);
+        }
+    }
+    const double searchMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - searchStart).count();
+
+    FloorLayoutSearchStats searchStats;
+    std::vector<float> acceptedScores;
+    std::vector<float> candidateScores(candidateCount);
+    std::vector<bool> candidateAccepted(candidateCount);
+    for (size_t jobIndex = 0; jobIndex < jobs.size(); ++jobIndex) {
+        const size_t firstSlot = jobIndex * candidateCount;
+        size_t selected = 0;
+        if (searching) {
+            for (size_t c = 0; c < candidateCount; ++c) {
+                const CandidateSlot& slot = slots[firstSlot + c];
+                candidateScores[c] = slot.score;
+                candidateAccepted[c] = slot.accepted;
+                if (slot.accepted) {
+                    acceptedScores.push_back(slot.score);
+                } else {
+                    ++searchStats.candidatesRejected;
+                }
             }
-        } else if (typology == BuildingTypology::Retail) {
-            if (!m_retailSolver.GenerateFloor(
-                    definition,
-                    *semanticFloor,
-                    *plateIt,
-                    floorCores,
-                    resolvedFloor,
-                    outError)) {
-                return false;
+            selected = SelectFloorLayoutCandidate(candidateScores, candidateAccepted);
+        } else if (!slots[firstSlot].accepted) {
+            selected = candidateCount;
+        }
+
+        if (selected == candidateCount) {
+            // No candidate was accepted; report the authored-order failure
+            outError = slots[firstSlot].error;
+            return false;
+        }
+
+        if (searching) {
+            ++searchStats.floorsSearched;
+            searchStats.baselineScoreMean += slots[firstSlot].accepted ? slots[firstSlot].score : 0.0f;
+            searchStats.selectedScoreMean += slots[firstSlot + selected].score;
+            if (selected != 0) {
+                ++searchStats.floorsImproved;
             }
         }
 
+        const ResolvedFloorLayout& resolvedFloor = slots[firstSlot + selected].resolvedFloor;
         if (outDebugBlocks) {
             outDebugBlocks->insert(outDebugBlocks->end(),
                                    resolvedFloor.debugBlocks.begin(),
@@ -197,11 +263,44 @@ bool SemanticFloorLayoutGenerator::Generate(const BuildingDefinition& definition
             outResolvedLayout->floors.push_back(resolvedFloor);
         }
 
-        BuildFloorSpacesFromResolvedLayout(resolvedFloor, nextSpaceId, floor.spaces);
+        BuildFloorSpacesFromResolvedLayout(resolvedFloor, nextSpaceId, jobs[jobIndex].floor->spaces);
+    }
+
+    if (searching && outSearchStats) {
+        searchStats.candidatesEvaluated = slots.size();
+        searchStats.searchMs = searchMs;
+        if (searchStats.floorsSearched > 0) {
+            searchStats.baselineScoreMean /= static_cast<float>(searchStats.floorsSearched);
+            searchStats.selectedScoreMean /= static_cast<float>(searchStats.floorsSearched);
+        }
+        SummarizeFloorLayoutScores(std::move(acceptedScores), searchStats);
+        *outSearchStats = searchStats;
     }
 
     return true;
 }
 
+bool SemanticFloorLayoutGenerator::SolveFloor(BuildingTypology typology,
+                                              const BuildingDefinition& definition,
+                                              const FloorLayoutInput& layoutInput,
+                                              const FloorPlate& floorPlate,
+                                              const std::vector<VerticalCore>& floorCores,
+                                              ResolvedFloorLayout& outResolvedFloor,
+                                              std::string& outError) const {
+    if (typology == BuildingTypology::Office) {
+        return m_officeSolver.GenerateFloor(
+            definition, layoutInput, floorPlate, floorCores, outResolvedFloor, outError);
+    }
+    if (typology == BuildingTypology::Residential) {
+        return m_residentialSolver.GenerateFloor(
+            definition, layoutInput, floorPlate, floorCores, outResolvedFloor, outError);
+    }
+    if (typology == BuildingTypology::Retail) {
+        return m_retailSolver.GenerateFloor(
+            definition, layoutInput, floorPlate, floorCores, outResolvedFloor, outError);
+    }
+    return true;
+}
+
 } // namespace Building
 } // namespace Moon
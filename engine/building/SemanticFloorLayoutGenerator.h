@@ -1,18 +1,35 @@
 #pragma once
 
 #include "BuildingGenerationInputs.h"
+#include "FloorLayoutSearch.h"
 #include "OfficeFloorLayoutSolver.h"
 #include "ResidentialFloorLayoutSolver.h"
 #include "RetailFloorLayoutSolver.h"
 #include "BuildingTypes.h"
+#include "BuildingTypology.h"
 #include <string>
 #include <vector>
 
 namespace Moon {
 namespace Building {
 
+class BuildingTaskPool;
+
 class SemanticFloorLayoutGenerator {
 public:
+    /**
+     * @brief Enable multi-candidate layout search (candidateCount 1 = solver result only)
+     */
+    void SetSearchOptions(const FloorLayoutSearchOptions& options) { m_searchOptions = options; }
+    const FloorLayoutSearchOptions& GetSearchOptions() const { return m_searchOptions; }
+
+    /**
+     * @brief Resolve semantic spaces of every floor with the typology solver
+     * Floors and search candidates are solved as independent tasks on pool when
+     * given and merged in floor order, so the result does not depend on the pool.
+     * @param pool Optional task pool (nullptr = calling thread only)
+     * @param outSearchStats Optional search statistics, filled when search is enabled
+     */
     bool Generate(const BuildingDefinition& definition,
                   const BuildingFormInput* formInput,
                   const BuildingLayoutInput* layoutInput,
@@ -21,12 +38,23 @@ public:
                   std::vector<Floor>& ioFloors,
                   ResolvedBuildingLayout* outResolvedLayout,
                   std::vector<ProgramBlock>* outDebugBlocks,
-                  std::string& outError) const;
+                  std::string& outError,
+                  BuildingTaskPool* pool = nullptr,
+                  FloorLayoutSearchStats* outSearchStats = nullptr) const;
 
 private:
+    bool SolveFloor(BuildingTypology typology,
+                    const BuildingDefinition& definition,
+                    const FloorLayoutInput& layoutInput,
+                    const FloorPlate& floorPlate,
+                    const std::vector<VerticalCore>& floorCores,
+                    ResolvedFloorLayout& outResolvedFloor,
+                    std::string& outError) const;
+
     OfficeFloorLayoutSolver m_officeSolver;
     ResidentialFloorLayoutSolver m_residentialSolver;
     RetailFloorLayoutSolver m_retailSolver;
+    FloorLayoutSearchOptions m_searchOptions;
 };
 
 } // namespace Building
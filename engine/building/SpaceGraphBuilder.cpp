@@ -42,45 +42,38 @@ bool SpaceGraphBuilder::GetSharedEdge(int spaceA, int spaceB, SpaceAdjacency& ou
 }
 
 void SpaceGraphBuilder::FindAdjacencies(const std::vector<EdgeInfo>& edges) {
-    // Compare all edges to find overlaps
-    for (size_t i = 0; i < edges.size(); ++i) {
-        for (size_t j = i + 1; j < edges.size(); ++j) {
-            const EdgeInfo& edgeA = edges[i];
-            const EdgeInfo& edgeB = edges[j];
-            
-            // Skip if same space or different floor
-            if (edgeA.spaceId == edgeB.spaceId) continue;
-            if (edgeA.floorLevel != edgeB.floorLevel) continue;
-            
-            // Check if edges overlap
-            GridPos2D overlapStart, overlapEnd;
-            float overlapLength;
-            
-            if (EdgesOverlap(edgeA, edgeB, overlapStart, overlapEnd, overlapLength)) {
-                // Check if we already have this adjacency
-                bool found = false;
-                for (const auto& adj : m_adjacencies) {
-                    if ((adj.spaceA == edgeA.spaceId && adj.spaceB == edgeB.spaceId) ||
-                        (adj.spaceA == edgeB.spaceId && adj.spaceB == edgeA.spaceId)) {
-                        found = true;
-                        break;
-                    }
-                }
-                
-                if (!found && overlapLength > 0.1f) { // Minimum overlap threshold
-                    SpaceAdjacency adj;
-                    adj.spaceA = edgeA.spaceId;
-                    adj.spaceB = edgeB.spaceId;
-                    adj.sharedEdgeLength = overlapLength;
-                    adj.sharedEdgeStart = overlapStart;
-                    adj.sharedEdgeEnd = overlapEnd;
-                    adj.floorLevel = edgeA.floorLevel;
-                    m_adjacencies.push_back(adj);
-                    
-                    // O(1) insert into adjacency set
-                    m_adjacencySet.insert(MakeAdjacencyKey(edgeA.spaceId, edgeB.spaceId));
-                }
-            }
+    // Only collinear edges sharing a grid line can overlap; the sweep reports them
+    // as sorted (i, j) pairs, so the first overlap found per space pair is the same
+    // one a full pairwise scan would find
+    for (const auto& pair : EdgeTopologyBuilder::FindCandidatePairs(edges)) {
+        const EdgeInfo& edgeA = edges[pair.first];
+        const EdgeInfo& edgeB = edges[pair.second];
+
+        // Skip if same space or different floor
+        if (edgeA.spaceId == edgeB.spaceId) continue;
+        if (edgeA.floorLevel != edgeB.floorLevel) continue;
+
+        // Check if we already have this adjacency
+        const uint64_t key = MakeAdjacencyKey(edgeA.spaceId, edgeB.spaceId);
+        if (m_adjacencySet.count(key) > 0) continue;
+
+        // Check if edges overlap
+        GridPos2D overlapStart, overlapEnd;
+        float overlapLength;
+
+        if (EdgesOverlap(edgeA, edgeB, overlapStart, overlapEnd, overlapLength) &&
+            overlapLength > 0.1f) { // Minimum overlap threshold
+            SpaceAdjacency adj;
+            adj.spaceA = edgeA.spaceId;
+            adj.spaceB = edgeB.spaceId;
+            adj.sharedEdgeLength = overlapLength;
+            adj.sharedEdgeStart = overlapStart;
+            adj.sharedEdgeEnd = overlapEnd;
+            adj.floorLevel = edgeA.floorLevel;
+            m_adjacencies.push_back(adj);
+
+            // O(1) insert into adjacency set
+            m_adjacencySet.insert(key);
         }
     }
 }
@@ -4,6 +4,7 @@
 #include "core/Logging/Logger.h"
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
 #include <unordered_map>
 
 namespace Moon {
@@ -23,6 +24,111 @@ bool IsDegenerateSegment(const GridPos2D& start, const GridPos2D& end) {
     return SegmentLengthSquared(start, end) <= kWallSegmentEpsilon * kWallSegmentEpsilon;
 }
 
+bool AreCollinear(const WallSegment& a, const WallSegment& b) {
+    // Check if two walls are on the same infinite line
+    const float epsilon = kWallSegmentEpsilon;
+    float dx1 = a.end[0] - a.start[0];
+    float dy1 = a.end[1] - a.start[1];
+    float dx2 = b.end[0] - b.start[0];
+    float dy2 = b.end[1] - b.start[1];
+
+    float len1 = std::sqrt(dx1*dx1 + dy1*dy1);
+    float len2 = std::sqrt(dx2*dx2 + dy2*dy2);
+
+    if (len1 < epsilon || len2 < epsilon) return false;
+
+    // Normalize direction vectors
+    dx1 /= len1; dy1 /= len1;
+    dx2 /= len2; dy2 /= len2;
+
+    // Check if parallel (or anti-parallel)
+    float dot = dx1*dx2 + dy1*dy2;
+    if (std::abs(std::abs(dot) - 1.0f) > epsilon) return false;
+
+    // Check if point b.start lies on line through a
+    float toStartX = b.start[0] - a.start[0];
+    float toStartY = b.start[1] - a.start[1];
+    float cross = dx1 * toStartY - dy1 * toStartX;
+
+    return std::abs(cross) < epsilon;
+}
+
+bool PointsCoincide(const GridPos2D& a, const GridPos2D& b) {
+    return std::abs(a[0] - b[0]) < kWallSegmentEpsilon && std::abs(a[1] - b[1]) < kWallSegmentEpsilon;
+}
+
+bool AreConnected(const WallSegment& a, const WallSegment& b) {
+    // Check if walls share a vertex
+    return PointsCoincide(a.end, b.start) || PointsCoincide(a.start, b.end) ||
+           PointsCoincide(a.end, b.end) || PointsCoincide(a.start, b.start);
+}
+
+bool CanMergeWalls(const WallSegment& a, const WallSegment& b) {
+    // Must be same type
+    if (a.type != b.type) return false;
+
+    // Must be same floor
+    if (a.floorLevel != b.floorLevel) return false;
+
+    // For interior walls, must have same space IDs (order doesn't matter)
+    if (a.type == WallType::Interior) {
+        bool sameSpaces = (a.spaceId == b.spaceId && a.neighborSpaceId == b.neighborSpaceId) ||
+                         (a.spaceId == b.neighborSpaceId && a.neighborSpaceId == b.spaceId);
+        if (!sameSpaces) return false;
+    } else {
+        // For exterior walls, must be same space
+        if (a.spaceId != b.spaceId) return false;
+    }
+
+    // Must be collinear and connected
+    return AreCollinear(a, b) && AreConnected(a, b);
+}
+
+// Merge `other` into `wall`: keep wall.start, extend to the endpoint farthest from it
+void AbsorbWall(WallSegment& wall, const WallSegment& other) {
+    const GridPos2D points[4] = {wall.start, wall.end, other.start, other.end};
+
+    float maxDist = 0;
+    GridPos2D maxPoint = points[0];
+    for (const auto& p : points) {
+        float dist = (p[0] - points[0][0]) * (p[0] - points[0][0]) +
+                     (p[1] - points[0][1]) * (p[1] - points[0][1]);
+        if (dist > maxDist) {
+            maxDist = dist;
+            maxPoint = p;
+        }
+    }
+
+    wall.end = maxPoint;
+    wall.height = std::max(wall.height, other.height);
+}
+
+/**
+ * @brief Key of a wall endpoint in integer grid units (floor level, x, y)
+ */
+struct EndpointKey {
+    int floorLevel;
+    int x;
+    int y;
+
+    bool operator==(const EndpointKey& other) const {
+        return floorLevel == other.floorLevel && x == other.x && y == other.y;
+    }
+};
+
+struct EndpointKeyHash {
+    size_t operator()(const EndpointKey& key) const {
+        size_t h = std::hash<int>{}(key.x);
+        h = h * 31 + std::hash<int>{}(key.y);
+        return h * 31 + std::hash<int>{}(key.floorLevel);
+    }
+};
+
+EndpointKey MakeEndpointKey(int floorLevel, const GridPos2D& point) {
+    const auto units = GridCoord::ToGridUnits(point);
+    return {floorLevel, units[0], units[1]};
+}
+
 } // namespace
 
 WallGenerator::WallGenerator()
@@ -90,12 +196,23 @@ void WallGenerator::GenerateWalls(const BuildingDefinition& definition,
     // Step 3: Classify edges as interior or exterior walls
     ClassifyEdges(edgeMap, outWalls);
     MOON_LOG_INFO("Building", "Generated %zu wall segments", outWalls.size());
+
+    // Step 3.5: Put walls in canonical order (floor level, then position)
+    // Edge map iteration order is unspecified; sorting makes the output stable and
+    // lets floor levels be generated independently and concatenated in level order
+    SortWalls(outWalls);
     
     // Step 4: Merge collinear walls of same type
     // This fixes T-junction segmentation side-effects where one wall is split into
     // multiple segments (some interior, some exterior)
     MergeCollinearWalls(outWalls);
     MOON_LOG_INFO("Building", "After merging collinear walls: %zu walls", outWalls.size());
+
+    // Step 5: Assign dense wall IDs in output order
+    for (size_t i = 0; i < outWalls.size(); ++i) {
+        outWalls[i].wallId = static_cast<int>(i);
+    }
+    m_nextWallId = static_cast<int>(outWalls.size());
     
     MOON_LOG_INFO("Building", "=== Wall Generation Complete ===");
 }
@@ -206,6 +323,18 @@ void WallGenerator::ClassifyEdges(const std::unordered_map<EdgeInfo, EdgeSpaces,
     }
 }
 
+void WallGenerator::SortWalls(std::vector<WallSegment>& walls) {
+    // Walls come from unique grid-snapped edges, so (floor, start, end) identifies each one
+    std::sort(walls.begin(), walls.end(), [](const WallSegment& a, const WallSegment& b) {
+        if (a.floorLevel != b.floorLevel) return a.floorLevel < b.floorLevel;
+        if (a.start[0] != b.start[0]) return a.start[0] < b.start[0];
+        if (a.start[1] != b.start[1]) return a.start[1] < b.start[1];
+        if (a.end[0] != b.end[0]) return a.end[0] < b.end[0];
+        if (a.end[1] != b.end[1]) return a.end[1] < b.end[1];
+        return static_cast<int>(a.type) < static_cast<int>(b.type);
+    });
+}
+
 void WallGenerator::CreateInteriorWall(const GridPos2D& start, const GridPos2D& end,
                                        int spaceIdA, int spaceIdB, int floorLevel,
                                        float height, float thickness, bool hasOutdoor,
@@ -308,66 +437,16 @@ void WallGenerator::MergeCollinearWalls(std::vector<WallSegment>& walls) {
     }), walls.end());
 
     if (walls.empty()) return;
+
+    const int mergeCount = m_useEndpointIndex ? MergeCollinearWallsIndexed(walls)
+                                              : MergeCollinearWallsPairwise(walls);
     
-    const float epsilon = 0.001f;
-    
-    auto AreCollinear = [epsilon](const WallSegment& a, const WallSegment& b) -> bool {
-        // Check if two walls are on the same infinite line
-        float dx1 = a.end[0] - a.start[0];
-        float dy1 = a.end[1] - a.start[1];
-        float dx2 = b.end[0] - b.start[0];
-        float dy2 = b.end[1] - b.start[1];
-        
-        float len1 = std::sqrt(dx1*dx1 + dy1*dy1);
-        float len2 = std::sqrt(dx2*dx2 + dy2*dy2);
-        
-        if (len1 < epsilon || len2 < epsilon) return false;
-        
-        // Normalize direction vectors
-        dx1 /= len1; dy1 /= len1;
-        dx2 /= len2; dy2 /= len2;
-        
-        // Check if parallel (or anti-parallel)
-        float dot = dx1*dx2 + dy1*dy2;
-        if (std::abs(std::abs(dot) - 1.0f) > epsilon) return false;
-        
-        // Check if point b.start lies on line through a
-        float toStartX = b.start[0] - a.start[0];
-        float toStartY = b.start[1] - a.start[1];
-        float cross = dx1 * toStartY - dy1 * toStartX;
-        
-        return std::abs(cross) < epsilon;
-    };
-    
-    auto AreConnected = [epsilon](const WallSegment& a, const WallSegment& b) -> bool {
-        // Check if walls share a vertex
-        return (std::abs(a.end[0] - b.start[0]) < epsilon && std::abs(a.end[1] - b.start[1]) < epsilon) ||
-               (std::abs(a.start[0] - b.end[0]) < epsilon && std::abs(a.start[1] - b.end[1]) < epsilon) ||
-               (std::abs(a.end[0] - b.end[0]) < epsilon && std::abs(a.end[1] - b.end[1]) < epsilon) ||
-               (std::abs(a.start[0] - b.start[0]) < epsilon && std::abs(a.start[1] - b.start[1]) < epsilon);
-    };
-    
-    auto CanMerge = [&](const WallSegment& a, const WallSegment& b) -> bool {
-        // Must be same type
-        if (a.type != b.type) return false;
-        
-        // Must be same floor
-        if (a.floorLevel != b.floorLevel) return false;
-        
-        // For interior walls, must have same space IDs (order doesn't matter)
-        if (a.type == WallType::Interior) {
-            bool sameSpaces = (a.spaceId == b.spaceId && a.neighborSpaceId == b.neighborSpaceId) ||
-                             (a.spaceId == b.neighborSpaceId && a.neighborSpaceId == b.spaceId);
-            if (!sameSpaces) return false;
-        } else {
-            // For exterior walls, must be same space
-            if (a.spaceId != b.spaceId) return false;
-        }
-        
-        // Must be collinear and connected
-        return AreCollinear(a, b) && AreConnected(a, b);
-    };
-    
+    if (mergeCount > 0) {
+        MOON_LOG_INFO("Building", "Merged %d collinear wall segments", mergeCount);
+    }
+}
+
+int WallGenerator::MergeCollinearWallsPairwise(std::vector<WallSegment>& walls) {
     // Iteratively merge walls until no more merges possible
     bool merged = true;
     int mergeCount = 0;
@@ -376,37 +455,9 @@ void WallGenerator::MergeCollinearWalls(std::vector<WallSegment>& walls) {
         
         for (size_t i = 0; i < walls.size(); ++i) {
             for (size_t j = i + 1; j < walls.size(); ++j) {
-                if (CanMerge(walls[i], walls[j])) {
-                    // Merge wall[j] into wall[i]
-                    // Find the two endpoints that are farthest apart
-                    std::vector<GridPos2D> points = {
-                        walls[i].start, walls[i].end,
-                        walls[j].start, walls[j].end
-                    };
-                    
-                    // Find min and max along the wall direction
-                    float minDist = 0, maxDist = 0;
-                    GridPos2D minPoint = points[0], maxPoint = points[0];
-                    
-                    for (const auto& p : points) {
-                        float dist = (p[0] - points[0][0]) * (p[0] - points[0][0]) +
-                                   (p[1] - points[0][1]) * (p[1] - points[0][1]);
-                        if (dist < minDist) {
-                            minDist = dist;
-                            minPoint = p;
-                        }
-                        if (dist > maxDist) {
-                            maxDist = dist;
-                            maxPoint = p;
-                        }
-                    }
-                    
-                    // Update wall[i] with merged endpoints
-                    walls[i].start = minPoint;
-                    walls[i].end = maxPoint;
-                    walls[i].height = std::max(walls[i].height, walls[j].height);
-                    
-                    // Remove wall[j]
+                if (CanMergeWalls(walls[i], walls[j])) {
+                    // Merge wall[j] into wall[i], then remove wall[j]
+                    AbsorbWall(walls[i], walls[j]);
                     walls.erase(walls.begin() + j);
                     
                     mergeCount++;
@@ -417,10 +468,79 @@ void WallGenerator::MergeCollinearWalls(std::vector<WallSegment>& walls) {
             if (merged) break;
         }
     }
-    
+    return mergeCount;
+}
+
+int WallGenerator::MergeCollinearWallsIndexed(std::vector<WallSegment>& walls) {
+    // Same result as the pairwise scan: that scan always grows the lowest-index wall
+    // that still has a partner, absorbing its lowest-index partner first. Partners
+    // share an endpoint, so they are found through a hash of grid-unit endpoints
+    // instead of a rescan of every pair.
+    std::unordered_map<EndpointKey, std::vector<uint32_t>, EndpointKeyHash> wallsByEndpoint;
+    wallsByEndpoint.reserve(walls.size() * 2);
+    for (uint32_t i = 0; i < walls.size(); ++i) {
+        const WallSegment& wall = walls[i];
+        auto& atStart = wallsByEndpoint[MakeEndpointKey(wall.floorLevel, wall.start)];
+        atStart.push_back(i);
+        auto& atEnd = wallsByEndpoint[MakeEndpointKey(wall.floorLevel, wall.end)];
+        if (atEnd.empty() || atEnd.back() != i) {
+            atEnd.push_back(i);
+        }
+    }
+
+    std::vector<char> absorbed(walls.size(), 0);
+    int mergeCount = 0;
+    for (uint32_t i = 0; i < walls.size(); ++i) {
+        if (absorbed[i]) {
+            continue;
+        }
+
+        WallSegment& wall = walls[i];
+        while (true) {
+            uint32_t partner = UINT32_MAX;
+            for (const GridPos2D* point : {&wall.start, &wall.end}) {
+                // Endpoints within the merge tolerance may round into a neighbouring grid cell
+                const int x0 = GridCoord::ToGridUnits((*point)[0] - kWallSegmentEpsilon);
+                const int x1 = GridCoord::ToGridUnits((*point)[0] + kWallSegmentEpsilon);
+                const int y0 = GridCoord::ToGridUnits((*point)[1] - kWallSegmentEpsilon);
+                const int y1 = GridCoord::ToGridUnits((*point)[1] + kWallSegmentEpsilon);
+                for (int y = y0; y <= y1; ++y) {
+                    for (int x = x0; x <= x1; ++x) {
+                        auto it = wallsByEndpoint.find({wall.floorLevel, x, y});
+                        if (it == wallsByEndpoint.end()) {
+                            continue;
+                        }
+                        for (uint32_t j : it->second) {
+                            if (j > i && j < partner && !absorbed[j] && CanMergeWalls(wall, walls[j])) {
+                                partner = j;
+                            }
+                        }
+                    }
+                }
+            }
+            if (partner == UINT32_MAX) {
+                break;
+            }
+
+            AbsorbWall(wall, walls[partner]);
+            absorbed[partner] = 1;
+            ++mergeCount;
+        }
+    }
+
     if (mergeCount > 0) {
-        MOON_LOG_INFO("Building", "Merged %d collinear wall segments", mergeCount);
+        size_t kept = 0;
+        for (size_t i = 0; i < walls.size(); ++i) {
+            if (!absorbed[i]) {
+                if (kept != i) {
+                    walls[kept] = walls[i];
+                }
+                ++kept;
+            }
+        }
+        walls.resize(kept);
     }
+    return mergeCount;
 }
 
 bool WallGenerator::EdgesMatch(const EdgeInfo& a, const EdgeInfo& b) const {
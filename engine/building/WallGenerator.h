@@ -25,6 +25,9 @@ public:
 
     /**
      * @brief Generate walls from building definition
+     * Walls are returned sorted by floor level, then position, with wallId equal
+     * to the index in outWalls. Floor levels never share walls, so generating each
+     * level separately and concatenating in level order gives the same result.
      * @param definition Building definition
      * @param spaceGraph Space connectivity graph
      * @param outWalls Output wall segments
@@ -43,6 +46,13 @@ public:
      */
     void SetDefaultWallHeight(float height);
 
+    /**
+     * @brief Find collinear merge partners through a grid endpoint hash (default)
+     * When disabled, merging rescans every wall pair after each merge. Both paths
+     * produce identical walls; the switch exists for benchmarking.
+     */
+    void SetUseEndpointIndex(bool enabled) { m_useEndpointIndex = enabled; }
+
 private:
     // Edge to spaces mapping
     struct EdgeSpaces {
@@ -67,6 +77,9 @@ private:
                       std::vector<WallSegment>& outWalls);
     
     void MergeCollinearWalls(std::vector<WallSegment>& walls);
+    int MergeCollinearWallsPairwise(std::vector<WallSegment>& walls);
+    int MergeCollinearWallsIndexed(std::vector<WallSegment>& walls);
+    static void SortWalls(std::vector<WallSegment>& walls);
     
     bool EdgesMatch(const EdgeInfo& a, const EdgeInfo& b) const;
     
@@ -89,6 +102,7 @@ private:
     float m_wallThickness;
     float m_defaultWallHeight;
     int m_nextWallId;  // For assigning unique wall IDs
+    bool m_useEndpointIndex = true;
 };
 
 } // namespace Building
@@ -0,0 +1,213 @@
+#include "BenchmarkCorpus.h"
+
+#include "core/Assets/AssetPaths.h"
+#include "../../../external/nlohmann/json.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace Moon {
+namespace Building {
+namespace Benchmark {
+
+namespace {
+
+using json = nlohmann::json;
+
+std::string ReadTextFile(const std::string& path) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return {};
+    }
+
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+/**
+ * @brief Read a fixture relative to assets/building, falling back to the configured asset root
+ */
+std::string LoadBuildingFixture(const std::string& filename) {
+    const std::string path = FindRepositoryFile("assets/building/" + filename);
+    return ReadTextFile(path.empty() ? Assets::BuildBuildingPath(filename) : path);
+}
+
+json MakeSpace(const std::string& spaceId, const std::string& type, const std::string& zone,
+               float area, float minWidth) {
+    return {
+        {"space_id", spaceId},
+        {"type", type},
+        {"zone", zone},
+        {"area_preferred", area},
+        {"constraints", {{"min_width", minWidth}}}
+    };
+}
+
+json MakeConnectedSpace(const std::string& spaceId, const std::string& type, const std::string& zone,
+                        float area, float minWidth, const std::string& hubId) {
+    json space = MakeSpace(spaceId, type, zone, area, minWidth);
+    space["adjacency"] = json::array({{{"to", hubId}, {"relationship", "connected"}, {"importance", "preferred"}}});
+    return space;
+}
+
+/**
+ * @brief Generated program: every floor repeats the same core, circulation and room mix
+ */
+std::string CreateLargeProgram(const std::string& category, int floors, int roomsPerFloor) {
+    const bool residential = category == "residential";
+    const bool office = category == "office";
+    const bool mall = category == "mall";
+    const bool retail = mall || category == "retail";
+
+    json program = json::array();
+    float floorArea = 0.0f;
+    for (int level = 0; level < floors; ++level) {
+        const std::string suffix = "_" + std::to_string(level);
+        const std::string hubId = (retail ? "galleria" : "corridor") + suffix;
+
+        json spaces = json::array();
+        spaces.push_back(MakeSpace("core" + suffix, "core", "service", 64.0f, 5.0f));
+        float area = 64.0f;
+        if (office && level == 0) {
+            spaces.push_back(MakeConnectedSpace("lobby" + suffix, "lobby", "public", 120.0f, 6.0f, hubId));
+            area += 120.0f;
+        }
+        if (retail) {
+            json hub = MakeSpace(hubId, "corridor", "circulation", 400.0f, 5.0f);
+            hub["adjacency"] = json::array({{{"to", "atrium" + suffix}, {"relationship", "around"}, {"importance", "required"}}});
+            spaces.push_back(MakeSpace("atrium" + suffix, "void", "public", 300.0f, 12.0f));
+            spaces.push_back(hub);
+            area += 700.0f;
+        } else {
+            const float corridorArea = residential ? 12.0f * roomsPerFloor : 180.0f;
+            spaces.push_back(MakeSpace(hubId, "corridor", "circulation", corridorArea, office ? 2.0f : 2.5f));
+            area += corridorArea;
+        }
+
+        for (int room = 0; room < roomsPerFloor; ++room) {
+            const std::string id = suffix + "_" + std::to_string(room);
+            if (residential) {
+                // One apartment per "room": living, bedroom and bathroom sharing a unit id
+                const std::string unitId = "apt" + id;
+                const json unitSpaces[] = {
+                    MakeConnectedSpace("living" + id, "living", "public", 30.0f, 4.0f, hubId),
+                    MakeSpace("bedroom" + id, "bedroom", "private", 16.0f, 3.5f),
+                    MakeSpace("bathroom" + id, "bathroom", "service", 6.0f, 2.0f)
+                };
+                for (json space : unitSpaces) {
+                    space["unit_id"] = unitId;
+                    spaces.push_back(space);
+                }
+                area += 52.0f;
+            } else {
+                const float roomArea = 30.0f + static_cast<float>((room * 7) % 25);
+                json space = MakeConnectedSpace((office ? "office" : "shop") + id, office ? "office" : "shop",
+                                                "public", roomArea, 3.0f, hubId);
+                if (retail) {
+                    space["unit_id"] = "unit" + id;
+                }
+                spaces.push_back(space);
+                area += roomArea;
+            }
+        }
+
+        floorArea = std::max(floorArea, area);
+        program.push_back({{"level", level}, {"name", "floor" + suffix}, {"spaces", spaces}});
+    }
+
+    const char* buildingType = residential ? "apartment" : (office ? "office_tower" : (mall ? "shopping_mall" : "retail_center"));
+    const char* styleCategory = residential ? "residential" : (office ? "commercial" : "retail");
+    json building = {
+        {"schema", "moon_building"},
+        {"grid", 0.5},
+        {"building_type", buildingType},
+        {"style", {
+            {"category", styleCategory},
+            {"facade", residential ? "concrete" : "glass"},
+            {"roof", "flat"},
+            {"window_style", residential ? "standard" : "full_height"},
+            {"material", "concrete"}
+        }},
+        {"mass", {{"footprint_area", static_cast<int>(floorArea * 1.5f)}, {"floors", floors}}},
+        {"program", {{"floors", program}}}
+    };
+    return building.dump();
+}
+
+struct FixtureEntry {
+    const char* name;
+    const char* category;
+    const char* size;
+    const char* file;
+};
+
+const FixtureEntry kFixtures[] = {
+    {"residential_apartment", "residential", "small", "fixtures/apartment_building.json"},
+    {"residential_cbd", "residential", "medium", "fixtures/cbd_residential.json"},
+    {"office_neighborhood", "office", "small", "reference/neighborhood_office.json"},
+    {"office_enterprise_tower", "office", "medium", "office_enterprise_tower_demo.json"},
+    {"retail_center", "retail", "small", "reference/retail_center.json"},
+    {"retail_shopping_center", "retail", "medium", "reference/shopping_center.json"},
+    {"mall_shopping_mall", "mall", "small", "fixtures/shopping_mall.json"},
+    {"mall_complex", "mall", "medium", "complex_shopping_mall_demo.json"},
+};
+
+struct GeneratedEntry {
+    const char* name;
+    const char* category;
+    int floors;
+    int roomsPerFloor;
+};
+
+const GeneratedEntry kGenerated[] = {
+    {"residential_generated", "residential", 12, 8},
+    {"office_generated", "office", 16, 24},
+    {"retail_generated", "retail", 3, 30},
+    {"mall_generated", "mall", 4, 60},
+};
+
+} // namespace
+
+std::string FindRepositoryFile(const std::string& relativePath) {
+    // Covers running from the solution directory and from bin/x64/<Configuration>
+    static const char* const kPrefixes[] = {"", "../", "../../", "../../../", "../../../../"};
+    for (const char* prefix : kPrefixes) {
+        const std::string candidate = std::string(prefix) + relativePath;
+        if (std::ifstream(candidate).is_open()) {
+            return candidate;
+        }
+    }
+    return {};
+}
+
+std::vector<BenchmarkCase> LoadBenchmarkCorpus(std::string& outError) {
+    std::vector<BenchmarkCase> corpus;
+    outError.clear();
+
+    for (const auto& fixture : kFixtures) {
+        std::string content = LoadBuildingFixture(fixture.file);
+        if (content.empty()) {
+            outError += std::string(outError.empty() ? "" : ", ") + fixture.file;
+            continue;
+        }
+        corpus.push_back({fixture.name, fixture.category, fixture.size, std::move(content)});
+    }
+    if (!outError.empty()) {
+        outError = "Missing benchmark fixtures: " + outError;
+    }
+    if (corpus.empty()) {
+        return corpus;
+    }
+
+    for (const auto& generated : kGenerated) {
+        corpus.push_back({generated.name, generated.category, "large",
+                          CreateLargeProgram(generated.category, generated.floors, generated.roomsPerFloor)});
+    }
+    return corpus;
+}
+
+} // namespace Benchmark
+} // namespace Building
+} // namespace Moon
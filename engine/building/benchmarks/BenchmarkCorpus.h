@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Moon {
+namespace Building {
+namespace Benchmark {
+
+/**
+ * @brief One semantic building input of the benchmark corpus
+ */
+struct BenchmarkCase {
+    std::string name;           // Stable key used to match baseline entries
+    std::string category;       // residential / office / retail / mall
+    std::string size;           // small / medium / large
+    std::string semanticJson;   // moon_building semantic input
+};
+
+/**
+ * @brief Resolve a path relative to the repository root from the working directory or its parents
+ * @return First existing candidate, or an empty string when none exists
+ */
+std::string FindRepositoryFile(const std::string& relativePath);
+
+/**
+ * @brief Load the fixed benchmark corpus
+ * Small and medium cases are the checked-in fixtures under assets/building;
+ * large cases are generated programs with many floors and rooms per floor.
+ * @param outError Names of fixtures that could not be read
+ * @return Cases in a fixed order (empty only when no fixture was found)
+ */
+std::vector<BenchmarkCase> LoadBenchmarkCorpus(std::string& outError);
+
+} // namespace Benchmark
+} // namespace Building
+} // namespace Moon
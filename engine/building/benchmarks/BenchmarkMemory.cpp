@@ -0,0 +1,82 @@
+#include "BenchmarkMemory.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+std::atomic<uint64_t> g_allocationCount{0};
+std::atomic<uint64_t> g_allocationBytes{0};
+
+void* CountedAllocate(std::size_t size) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* CountedAllocateOrThrow(std::size_t size) {
+    void* ptr = CountedAllocate(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+} // namespace
+
+// Replacement global allocation functions (aligned overloads keep the default implementation)
+void* operator new(std::size_t size) { return CountedAllocateOrThrow(size); }
+void* operator new[](std::size_t size) { return CountedAllocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+namespace Moon {
+namespace Building {
+namespace Benchmark {
+
+AllocationCounters GetAllocationCounters() {
+    AllocationCounters counters;
+    counters.count = g_allocationCount.load(std::memory_order_relaxed);
+    counters.bytes = g_allocationBytes.load(std::memory_order_relaxed);
+    return counters;
+}
+
+size_t GetPeakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters = {};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<size_t>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;   // Kilobytes on Linux
+#endif
+#endif
+}
+
+} // namespace Benchmark
+} // namespace Building
+} // namespace Moon
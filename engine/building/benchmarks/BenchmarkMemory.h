@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Moon {
+namespace Building {
+namespace Benchmark {
+
+/**
+ * @brief Heap allocations made through global operator new since process start
+ * Counted by the operator new replacement in BenchmarkMemory.cpp, so every
+ * allocation in the engine libraries linked into the benchmark is included.
+ */
+struct AllocationCounters {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+AllocationCounters GetAllocationCounters();
+
+/**
+ * @brief Peak resident set size of the process so far (0 when unavailable)
+ */
+size_t GetPeakResidentBytes();
+
+} // namespace Benchmark
+} // namespace Building
+} // namespace Moon
@@ -0,0 +1,245 @@
+#include "BenchmarkReport.h"
+
+#include "../../../external/nlohmann/json.hpp"
+
+#include <cstdio>
+
+namespace Moon {
+namespace Building {
+namespace Benchmark {
+
+namespace {
+
+using json = nlohmann::ordered_json;
+
+constexpr const char* kReportSchema = "moon_building_benchmark";
+constexpr int kReportVersion = 1;
+
+std::string FormatRegression(const CaseReport& entry, const StageMeasurement& stage, const char* metric,
+                             double baselineValue, double currentValue, double limit) {
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer), "%s/%s %s: %.3f -> %.3f (limit %.3f)",
+                  entry.name.c_str(), stage.stage.c_str(), metric, baselineValue, currentValue, limit);
+    return buffer;
+}
+
+const CaseReport* FindCase(const BenchmarkReport& report, const std::string& name) {
+    for (const auto& entry : report.cases) {
+        if (entry.name == name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const StageMeasurement* FindStage(const CaseReport& entry, const std::string& stage) {
+    for (const auto& measurement : entry.stages) {
+        if (measurement.stage == stage) {
+            return &measurement;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+const char* GetPlatformName() {
+#if defined(_WIN32)
+    return "windows";
+#elif defined(__APPLE__)
+    return "macos";
+#else
+    return "linux";
+#endif
+}
+
+std::string WriteReportJson(const BenchmarkReport& report) {
+    json cases = json::array();
+    for (const auto& entry : report.cases) {
+        json stages = json::object();
+        for (const auto& stage : entry.stages) {
+            stages[stage.stage] = {
+                {"median_ms", stage.medianMs},
+                {"min_ms", stage.minMs},
+                {"allocations", stage.allocations},
+                {"allocated_bytes", stage.allocatedBytes},
+                {"peak_rss_bytes", stage.peakRssBytes}
+            };
+        }
+
+        json item = {
+            {"name", entry.name},
+            {"category", entry.category},
+            {"size", entry.size},
+            {"succeeded", entry.succeeded}
+        };
+        if (!entry.error.empty()) {
+            item["error"] = entry.error;
+        }
+        item["floors"] = entry.floorCount;
+        item["spaces"] = entry.spaceCount;
+        item["walls"] = entry.wallCount;
+        item["meshes"] = entry.meshCount;
+        item["stages"] = stages;
+        cases.push_back(item);
+    }
+
+    json root = {
+        {"schema", kReportSchema},
+        {"version", kReportVersion},
+        {"platform", report.platform},
+        {"execution_mode", report.executionMode},
+        {"iterations", report.iterations},
+        {"peak_rss_bytes", report.peakRssBytes},
+        {"tolerances", {
+            {"time_ratio", report.tolerances.timeRatio},
+            {"time_slack_ms", report.tolerances.timeSlackMs},
+            {"allocation_ratio", report.tolerances.allocationRatio},
+            {"allocation_slack", report.tolerances.allocationSlack},
+            {"peak_rss_ratio", report.tolerances.peakRssRatio}
+        }},
+        {"cases", cases}
+    };
+    return root.dump(2) + "\n";
+}
+
+bool ParseReportJson(const std::string& jsonText, BenchmarkReport& outReport, std::string& outError) {
+    json root = json::parse(jsonText, nullptr, false);
+    if (root.is_discarded() || !root.is_object()) {
+        outError = "Benchmark report is not valid JSON";
+        return false;
+    }
+    if (root.value("schema", "") != kReportSchema) {
+        outError = std::string("Benchmark report schema must be '") + kReportSchema + "'";
+        return false;
+    }
+    if (root.value("version", 0) != kReportVersion) {
+        outError = "Unsupported benchmark report version";
+        return false;
+    }
+
+    BenchmarkReport report;
+    report.platform = root.value("platform", "");
+    report.executionMode = root.value("execution_mode", "");
+    report.iterations = root.value("iterations", 0);
+    report.peakRssBytes = root.value("peak_rss_bytes", static_cast<size_t>(0));
+
+    if (root.contains("tolerances") && root["tolerances"].is_object()) {
+        const json& tolerances = root["tolerances"];
+        BenchmarkTolerances& target = report.tolerances;
+        target.timeRatio = tolerances.value("time_ratio", target.timeRatio);
+        target.timeSlackMs = tolerances.value("time_slack_ms", target.timeSlackMs);
+        target.allocationRatio = tolerances.value("allocation_ratio", target.allocationRatio);
+        target.allocationSlack = tolerances.value("allocation_slack", target.allocationSlack);
+        target.peakRssRatio = tolerances.value("peak_rss_ratio", target.peakRssRatio);
+    }
+
+    if (!root.contains("cases") || !root["cases"].is_array()) {
+        outError = "Benchmark report has no 'cases' array";
+        return false;
+    }
+    for (const auto& item : root["cases"]) {
+        CaseReport entry;
+        entry.name = item.value("name", "");
+        entry.category = item.value("category", "");
+        entry.size = item.value("size", "");
+        entry.succeeded = item.value("succeeded", false);
+        entry.error = item.value("error", "");
+        entry.floorCount = item.value("floors", static_cast<size_t>(0));
+        entry.spaceCount = item.value("spaces", static_cast<size_t>(0));
+        entry.wallCount = item.value("walls", static_cast<size_t>(0));
+        entry.meshCount = item.value("meshes", static_cast<size_t>(0));
+        if (entry.name.empty()) {
+            outError = "Benchmark report case without a name";
+            return false;
+        }
+
+        if (item.contains("stages") && item["stages"].is_object()) {
+            for (const auto& stage : item["stages"].items()) {
+                StageMeasurement measurement;
+                measurement.stage = stage.key();
+                measurement.medianMs = stage.value().value("median_ms", 0.0);
+                measurement.minMs = stage.value().value("min_ms", 0.0);
+                measurement.allocations = stage.value().value("allocations", static_cast<uint64_t>(0));
+                measurement.allocatedBytes = stage.value().value("allocated_bytes", static_cast<uint64_t>(0));
+                measurement.peakRssBytes = stage.value().value("peak_rss_bytes", static_cast<size_t>(0));
+                entry.stages.push_back(measurement);
+            }
+        }
+        report.cases.push_back(entry);
+    }
+
+    outReport = report;
+    return true;
+}
+
+BaselineComparison CompareToBaseline(const BenchmarkReport& current, const BenchmarkReport& baseline) {
+    BaselineComparison comparison;
+    // Timings, allocation counts (different standard library) and RSS only mean something on the
+    // platform the baseline was recorded on; elsewhere only case failures are gated
+    const bool sameMachineClass = current.platform == baseline.platform;
+    if (!sameMachineClass) {
+        comparison.notes.push_back("Baseline was recorded on '" + baseline.platform + "', this run is '" +
+                                   current.platform + "'; timing, allocation and peak RSS checks skipped "
+                                   "(record a baseline on this platform with --update-baseline)");
+    }
+    if (current.executionMode != baseline.executionMode) {
+        comparison.notes.push_back("Baseline execution mode is '" + baseline.executionMode + "', this run is '" +
+                                   current.executionMode + "'; timings may not be comparable");
+    }
+
+    const BenchmarkTolerances& tolerances = baseline.tolerances;
+    for (const auto& entry : current.cases) {
+        const CaseReport* reference = FindCase(baseline, entry.name);
+        if (!reference) {
+            comparison.notes.push_back(entry.name + ": no baseline entry");
+            continue;
+        }
+        if (reference->succeeded && !entry.succeeded) {
+            comparison.regressions.push_back(entry.name + ": failed (" + entry.error + ")");
+            continue;
+        }
+        if (!sameMachineClass) {
+            continue;
+        }
+
+        for (const auto& stage : entry.stages) {
+            const StageMeasurement* referenceStage = FindStage(*reference, stage.stage);
+            if (!referenceStage) {
+                comparison.notes.push_back(entry.name + "/" + stage.stage + ": no baseline entry");
+                continue;
+            }
+
+            const double timeLimit = referenceStage->medianMs * (1.0 + tolerances.timeRatio) + tolerances.timeSlackMs;
+            if (stage.medianMs > timeLimit) {
+                comparison.regressions.push_back(FormatRegression(
+                    entry, stage, "median_ms", referenceStage->medianMs, stage.medianMs, timeLimit));
+            }
+
+            const double allocationLimit = static_cast<double>(referenceStage->allocations) *
+                (1.0 + tolerances.allocationRatio) + static_cast<double>(tolerances.allocationSlack);
+            if (static_cast<double>(stage.allocations) > allocationLimit) {
+                comparison.regressions.push_back(FormatRegression(
+                    entry, stage, "allocations", static_cast<double>(referenceStage->allocations),
+                    static_cast<double>(stage.allocations), allocationLimit));
+            }
+        }
+    }
+
+    // Per-stage RSS is a running high-water mark, so only the whole-run peak is gated
+    if (sameMachineClass && baseline.peakRssBytes > 0) {
+        const double rssLimit = static_cast<double>(baseline.peakRssBytes) * (1.0 + tolerances.peakRssRatio);
+        if (static_cast<double>(current.peakRssBytes) > rssLimit) {
+            char buffer[160];
+            std::snprintf(buffer, sizeof(buffer), "peak_rss_mb: %.1f -> %.1f (limit %.1f)",
+                          baseline.peakRssBytes / (1024.0 * 1024.0), current.peakRssBytes / (1024.0 * 1024.0),
+                          rssLimit / (1024.0 * 1024.0));
+            comparison.regressions.push_back(buffer);
+        }
+    }
+    return comparison;
+}
+
+} // namespace Benchmark
+} // namespace Building
+} // namespace Moon
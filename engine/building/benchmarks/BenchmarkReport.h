@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Moon {
+namespace Building {
+namespace Benchmark {
+
+/**
+ * @brief Cost of one stage of one benchmark case
+ */
+struct StageMeasurement {
+    std::string stage;
+    double medianMs = 0.0;          // Median wall time over the measured iterations
+    double minMs = 0.0;
+    uint64_t allocations = 0;       // operator new calls per iteration
+    uint64_t allocatedBytes = 0;    // Bytes requested per iteration
+    size_t peakRssBytes = 0;        // Process high-water mark after the stage
+};
+
+struct CaseReport {
+    std::string name;
+    std::string category;
+    std::string size;
+    bool succeeded = false;
+    std::string error;
+    size_t floorCount = 0;
+    size_t spaceCount = 0;          // Spaces in the resolved layout
+    size_t wallCount = 0;
+    size_t meshCount = 0;
+    std::vector<StageMeasurement> stages;
+};
+
+/**
+ * @brief Allowed growth before a metric counts as a regression
+ * A metric regresses when current > baseline * (1 + ratio) + slack.
+ */
+struct BenchmarkTolerances {
+    double timeRatio = 0.30;
+    double timeSlackMs = 1.0;           // Absorbs timer noise on sub-millisecond stages
+    double allocationRatio = 0.10;
+    uint64_t allocationSlack = 64;
+    double peakRssRatio = 0.25;
+};
+
+struct BenchmarkReport {
+    int iterations = 0;
+    std::string executionMode;          // serial / floor_parallel
+    std::string platform;               // On a mismatch only case failures are compared
+    size_t peakRssBytes = 0;
+    BenchmarkTolerances tolerances;
+    std::vector<CaseReport> cases;
+};
+
+struct BaselineComparison {
+    std::vector<std::string> regressions;
+    std::vector<std::string> notes;     // Warnings, skipped or unmatched entries
+};
+
+/**
+ * @brief Platform tag written into reports ("windows", "linux", "macos")
+ */
+const char* GetPlatformName();
+
+std::string WriteReportJson(const BenchmarkReport& report);
+bool ParseReportJson(const std::string& jsonText, BenchmarkReport& outReport, std::string& outError);
+
+/**
+ * @brief Compare a run against a baseline report using the baseline's tolerances
+ * Cases or stages missing from either side are reported as notes, not regressions.
+ * When the platforms differ, timing, allocation and peak RSS checks are skipped with a note.
+ */
+BaselineComparison CompareToBaseline(const BenchmarkReport& current, const BenchmarkReport& baseline);
+
+} // namespace Benchmark
+} // namespace Building
+} // namespace Moon
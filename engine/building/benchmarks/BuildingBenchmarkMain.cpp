@@ -0,0 +1,351 @@
+// Building generation benchmark: per-stage wall time, allocations and peak RSS over a fixed corpus,
+// written as JSON and compared against a checked-in baseline.
+//
+//   EngineBuildingBenchmarks [--iterations N] [--filter TEXT] [--output PATH]
+//                            [--baseline PATH | --no-baseline] [--update-baseline] [--floor-parallel]
+//
+// Exit code: 0 = within tolerances, 1 = regression against the baseline, 2 = setup error or failed case.
+
+#include "BenchmarkCorpus.h"
+#include "BenchmarkMemory.h"
+#include "BenchmarkReport.h"
+
+#include "building/BuildingPipeline.h"
+#include "building/BuildingToObjectBlueprintConverter.h"
+#include "building/LayoutResolver.h"
+#include "building/SemanticBuildingTypes.h"
+#include "core/Assets/AssetPaths.h"
+#include "core/CSG/CSGBuilder.h"
+#include "core/Object/Blueprint.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace Moon::Building;
+using namespace Moon::Building::Benchmark;
+
+namespace {
+
+const char* const kDefaultBaselinePath = "engine/building/benchmarks/baseline.json";
+
+struct Options {
+    int iterations = 5;
+    std::string filter;
+    std::string outputPath;
+    std::string baselinePath;
+    bool useBaseline = true;
+    bool updateBaseline = false;
+    bool floorParallel = false;
+};
+
+/**
+ * @brief Accumulates one stage over the measured iterations
+ */
+struct StageSamples {
+    std::string stage;
+    std::vector<double> timesMs;
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+    size_t peakRssBytes = 0;
+
+    explicit StageSamples(std::string stageName) : stage(std::move(stageName)) {}
+
+    StageMeasurement Summarize() const {
+        StageMeasurement measurement;
+        measurement.stage = stage;
+        if (!timesMs.empty()) {
+            std::vector<double> sorted = timesMs;
+            std::sort(sorted.begin(), sorted.end());
+            measurement.medianMs = sorted[sorted.size() / 2];
+            measurement.minMs = sorted.front();
+            measurement.allocations = allocations / timesMs.size();
+            measurement.allocatedBytes = allocatedBytes / timesMs.size();
+        }
+        measurement.peakRssBytes = peakRssBytes;
+        return measurement;
+    }
+};
+
+/**
+ * @brief Run one stage, recording time and allocations when measure is set
+ */
+bool RunStage(StageSamples& samples, bool measure, const std::function<bool()>& stage) {
+    const AllocationCounters before = GetAllocationCounters();
+    const auto start = std::chrono::steady_clock::now();
+    const bool ok = stage();
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    const AllocationCounters after = GetAllocationCounters();
+
+    if (measure) {
+        samples.timesMs.push_back(elapsedMs);
+        samples.allocations += after.count - before.count;
+        samples.allocatedBytes += after.bytes - before.bytes;
+    }
+    samples.peakRssBytes = GetPeakResidentBytes();
+    return ok;
+}
+
+bool ReadTextFile(const std::string& path, std::string& outText) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    outText = buffer.str();
+    return true;
+}
+
+bool WriteTextFile(const std::string& path, const std::string& text) {
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << text;
+    return static_cast<bool>(file);
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--iterations" && hasValue) {
+            options.iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--output" && hasValue) {
+            options.outputPath = argv[++i];
+        } else if (arg == "--baseline" && hasValue) {
+            options.baselinePath = argv[++i];
+        } else if (arg == "--no-baseline") {
+            options.useBaseline = false;
+        } else if (arg == "--update-baseline") {
+            options.updateBaseline = true;
+        } else if (arg == "--floor-parallel") {
+            options.floorParallel = true;
+        } else {
+            std::fprintf(stderr, "Unknown or incomplete argument: %s\n", arg.c_str());
+            return false;
+        }
+    }
+    if (options.baselinePath.empty()) {
+        options.baselinePath = FindRepositoryFile(kDefaultBaselinePath);
+        if (options.baselinePath.empty()) {
+            options.baselinePath = kDefaultBaselinePath;
+        }
+    }
+    return true;
+}
+
+CaseReport RunCase(const BenchmarkCase& benchmarkCase, const Options& options,
+                   Moon::Object::BlueprintDatabase* database) {
+    CaseReport report;
+    report.name = benchmarkCase.name;
+    report.category = benchmarkCase.category;
+    report.size = benchmarkCase.size;
+
+    StageSamples resolveSamples("layout_resolve");
+    StageSamples pipelineSamples("process_building");
+    StageSamples convertSamples("convert");
+    StageSamples blueprintSamples("convert_blueprint");
+    StageSamples csgSamples("csg_build");
+
+    BuildingPipeline pipeline;
+    pipeline.SetExecutionMode(options.floorParallel ? PipelineExecutionMode::FloorParallel
+                                                    : PipelineExecutionMode::Serial);
+
+    // Iteration 0 warms caches and lazily loaded blueprints and is not measured
+    for (int iteration = 0; iteration <= options.iterations; ++iteration) {
+        const bool measure = iteration > 0;
+        std::string error;
+
+        SemanticBuilding semantic;
+        BuildingDefinition resolved;
+        const bool resolvedOk = RunStage(resolveSamples, measure, [&]() {
+            LayoutResolver resolver;
+            return SemanticBuildingParser::ParseFromString(benchmarkCase.semanticJson, semantic, error) &&
+                   resolver.Resolve(semantic, resolved, error);
+        });
+        if (!resolvedOk) {
+            report.error = "layout_resolve: " + error;
+            return report;
+        }
+
+        GeneratedBuilding building;
+        if (!RunStage(pipelineSamples, measure, [&]() {
+                return pipeline.ProcessBuilding(benchmarkCase.semanticJson, building, error);
+            })) {
+            report.error = "process_building: " + error;
+            return report;
+        }
+
+        std::string blueprintJson;
+        RunStage(convertSamples, measure, [&]() {
+            blueprintJson = BuildingToObjectBlueprintConverter::Convert(building);
+            return !blueprintJson.empty();
+        });
+
+        std::unique_ptr<Moon::Object::Blueprint> blueprint;
+        if (!RunStage(blueprintSamples, measure, [&]() {
+                blueprint = BuildingToObjectBlueprintConverter::ConvertToBlueprint(building);
+                return blueprint != nullptr;
+            })) {
+            report.error = "convert_blueprint: conversion returned no blueprint";
+            return report;
+        }
+
+        Moon::CSG::BuildResult result;
+        if (!RunStage(csgSamples, measure, [&]() {
+                // The shared result cache would turn every measured iteration into a cache hit
+                Moon::CSG::CSGBuilder builder;
+                builder.SetResultCache(nullptr);
+                builder.SetBlueprintDatabase(database);
+                result = builder.Build(blueprint.get(), {}, error);
+                return error.empty() && !result.meshes.empty();
+            })) {
+            report.error = "csg_build: " + error;
+            return report;
+        }
+
+        if (!measure) {
+            report.floorCount = resolved.floors.size();
+            for (const auto& floor : resolved.floors) {
+                report.spaceCount += floor.spaces.size();
+            }
+            report.wallCount = building.walls.size();
+            report.meshCount = result.meshes.size();
+        }
+    }
+
+    for (const StageSamples* samples : {&resolveSamples, &pipelineSamples, &convertSamples,
+                                        &blueprintSamples, &csgSamples}) {
+        report.stages.push_back(samples->Summarize());
+    }
+    report.succeeded = true;
+    return report;
+}
+
+void PrintCase(const CaseReport& report) {
+    if (!report.succeeded) {
+        std::printf("%-26s FAILED %s\n", report.name.c_str(), report.error.c_str());
+        return;
+    }
+    std::printf("%-26s %3zu floors %5zu spaces %6zu walls\n",
+                report.name.c_str(), report.floorCount, report.spaceCount, report.wallCount);
+    for (const auto& stage : report.stages) {
+        std::printf("    %-18s %10.3f ms (min %.3f) %10llu allocs %9.1f KB  peak RSS %.1f MB\n",
+                    stage.stage.c_str(), stage.medianMs, stage.minMs,
+                    static_cast<unsigned long long>(stage.allocations), stage.allocatedBytes / 1024.0,
+                    stage.peakRssBytes / (1024.0 * 1024.0));
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    std::string corpusError;
+    const std::vector<BenchmarkCase> corpus = LoadBenchmarkCorpus(corpusError);
+    if (!corpusError.empty()) {
+        std::fprintf(stderr, "%s\n", corpusError.c_str());
+    }
+    if (corpus.empty()) {
+        std::fprintf(stderr, "Benchmark corpus is empty; run from the solution directory\n");
+        return 2;
+    }
+
+    // Building blueprints reference shared objects (doors, stairs) from the object index
+    Moon::Object::BlueprintDatabase database;
+    std::string indexPath = FindRepositoryFile("assets/objects/index.json");
+    if (indexPath.empty()) {
+        indexPath = Moon::Assets::BuildObjectPath("index.json");
+    }
+    std::string indexError;
+    if (!database.LoadIndex(indexPath, indexError)) {
+        std::fprintf(stderr, "Object index not loaded (%s); referenced objects will not build\n", indexError.c_str());
+    }
+
+    BenchmarkReport report;
+    report.iterations = options.iterations;
+    report.executionMode = options.floorParallel ? "floor_parallel" : "serial";
+    report.platform = GetPlatformName();
+
+    bool allSucceeded = true;
+    for (const auto& benchmarkCase : corpus) {
+        if (!options.filter.empty() && benchmarkCase.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        report.cases.push_back(RunCase(benchmarkCase, options, &database));
+        allSucceeded = allSucceeded && report.cases.back().succeeded;
+        PrintCase(report.cases.back());
+    }
+    report.peakRssBytes = GetPeakResidentBytes();
+    std::printf("Peak RSS: %.1f MB\n", report.peakRssBytes / (1024.0 * 1024.0));
+
+    BenchmarkReport baseline;
+    bool haveBaseline = false;
+    if (options.useBaseline || options.updateBaseline) {
+        std::string baselineText;
+        std::string baselineError;
+        if (ReadTextFile(options.baselinePath, baselineText)) {
+            haveBaseline = ParseReportJson(baselineText, baseline, baselineError);
+            if (!haveBaseline) {
+                std::fprintf(stderr, "Ignoring baseline %s: %s\n", options.baselinePath.c_str(), baselineError.c_str());
+            }
+        } else if (!options.updateBaseline) {
+            std::fprintf(stderr, "No baseline at %s\n", options.baselinePath.c_str());
+        }
+    }
+
+    // Keep hand-tuned tolerances when a baseline is re-recorded
+    if (haveBaseline) {
+        report.tolerances = baseline.tolerances;
+    }
+    const std::string reportJson = WriteReportJson(report);
+    if (!options.outputPath.empty() && !WriteTextFile(options.outputPath, reportJson)) {
+        std::fprintf(stderr, "Failed to write %s\n", options.outputPath.c_str());
+        return 2;
+    }
+
+    if (options.updateBaseline) {
+        if (!allSucceeded || !options.filter.empty()) {
+            std::fprintf(stderr, "Baseline not updated: it needs a complete, successful run\n");
+            return 2;
+        }
+        if (!WriteTextFile(options.baselinePath, reportJson)) {
+            std::fprintf(stderr, "Failed to write %s\n", options.baselinePath.c_str());
+            return 2;
+        }
+        std::printf("Baseline written to %s\n", options.baselinePath.c_str());
+        return 0;
+    }
+
+    int exitCode = allSucceeded ? 0 : 2;
+    if (options.useBaseline && haveBaseline) {
+        const BaselineComparison comparison = CompareToBaseline(report, baseline);
+        for (const auto& note : comparison.notes) {
+            std::printf("note: %s\n", note.c_str());
+        }
+        for (const auto& regression : comparison.regressions) {
+            std::printf("REGRESSION %s\n", regression.c_str());
+        }
+        if (!comparison.regressions.empty() && exitCode == 0) {
+            exitCode = 1;
+        }
+        std::printf("%zu regression(s) against %s\n", comparison.regressions.size(), options.baselinePath.c_str());
+    }
+    return exitCode;
+}
@@ -97,10 +97,12 @@ const json* FindNodeByNameRecursive(const json& node, const std::string& name) {
             return found;
         }
     }
-    if (node.contains("children") && node["children"].is_array()) {
-        for (const auto& child : node["children"]) {
-            if (const json* found = FindNodeByNameRecursive(child, name)) {
-                return found;
+    for (const char* key : {"children", "operands"}) {
+        if (node.contains(key) && node[key].is_array()) {
+            for (const auto& child : node[key]) {
+                if (const json* found = FindNodeByNameRecursive(child, name)) {
+                    return found;
+                }
             }
         }
     }
@@ -125,9 +127,11 @@ void CollectNodesByPrefixRecursive(const json& node,
     if (node.contains("right")) {
         CollectNodesByPrefixRecursive(node["right"], prefix, outNodes);
     }
-    if (node.contains("children") && node["children"].is_array()) {
-        for (const auto& child : node["children"]) {
-            CollectNodesByPrefixRecursive(child, prefix, outNodes);
+    for (const char* key : {"children", "operands"}) {
+        if (node.contains(key) && node[key].is_array()) {
+            for (const auto& child : node[key]) {
+                CollectNodesByPrefixRecursive(child, prefix, outNodes);
+            }
         }
     }
 }
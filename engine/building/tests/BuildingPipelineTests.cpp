@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "building/BuildingPipeline.h"
 #include "building/BuildingGenerationInputs.h"
+#include "building/FloorLayoutSearch.h"
 #include "building/LayoutResolver.h"
 #include "building/MassFloorPlateGenerator.h"
 #include "building/OfficeFloorLayoutSolver.h"
@@ -9,9 +10,12 @@
 #include "TestHelpers.h"
 #include <array>
 #include <chrono>
+#include <cstdio>
 #include <iostream>
 #include <limits>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 using namespace Moon::Building;
 using namespace Moon::Building::Test;
@@ -1494,3 +1498,378 @@ TEST_F(BuildingPipelineTest, DISABLED_PerformanceTest_LargeBuilding) {
     EXPECT_TRUE(result);
     std::cout << "Processing time: " << duration.count() << "ms" << std::endl;
 }
+
+namespace {
+
+void ExpectSameGeneratedOutput(const GeneratedBuilding& serial, const GeneratedBuilding& parallel) {
+    ASSERT_EQ(serial.walls.size(), parallel.walls.size());
+    for (size_t i = 0; i < serial.walls.size(); ++i) {
+        const WallSegment& a = serial.walls[i];
+        const WallSegment& b = parallel.walls[i];
+        EXPECT_EQ(a.wallId, b.wallId) << "wall " << i;
+        EXPECT_EQ(a.start, b.start) << "wall " << i;
+        EXPECT_EQ(a.end, b.end) << "wall " << i;
+        EXPECT_EQ(a.type, b.type) << "wall " << i;
+        EXPECT_EQ(a.spaceId, b.spaceId) << "wall " << i;
+        EXPECT_EQ(a.neighborSpaceId, b.neighborSpaceId) << "wall " << i;
+        EXPECT_EQ(a.floorLevel, b.floorLevel) << "wall " << i;
+        EXPECT_EQ(a.height, b.height) << "wall " << i;
+        EXPECT_EQ(a.thickness, b.thickness) << "wall " << i;
+    }
+
+    ASSERT_EQ(serial.doors.size(), parallel.doors.size());
+    for (size_t i = 0; i < serial.doors.size(); ++i) {
+        const Door& a = serial.doors[i];
+        const Door& b = parallel.doors[i];
+        EXPECT_EQ(a.wallId, b.wallId) << "door " << i;
+        EXPECT_EQ(a.position, b.position) << "door " << i;
+        EXPECT_EQ(a.rotation, b.rotation) << "door " << i;
+        EXPECT_EQ(a.type, b.type) << "door " << i;
+        EXPECT_EQ(a.spaceA, b.spaceA) << "door " << i;
+        EXPECT_EQ(a.spaceB, b.spaceB) << "door " << i;
+        EXPECT_EQ(a.floorLevel, b.floorLevel) << "door " << i;
+    }
+
+    ASSERT_EQ(serial.windows.size(), parallel.windows.size());
+    for (size_t i = 0; i < serial.windows.size(); ++i) {
+        const Window& a = serial.windows[i];
+        const Window& b = parallel.windows[i];
+        EXPECT_EQ(a.wallId, b.wallId) << "window " << i;
+        EXPECT_EQ(a.position, b.position) << "window " << i;
+        EXPECT_EQ(a.rotation, b.rotation) << "window " << i;
+        EXPECT_EQ(a.spaceId, b.spaceId) << "window " << i;
+        EXPECT_EQ(a.floorLevel, b.floorLevel) << "window " << i;
+    }
+
+    ASSERT_EQ(serial.envelopeMeshes.size(), parallel.envelopeMeshes.size());
+    for (size_t i = 0; i < serial.envelopeMeshes.size(); ++i) {
+        const GeneratedMeshPart& a = serial.envelopeMeshes[i];
+        const GeneratedMeshPart& b = parallel.envelopeMeshes[i];
+        EXPECT_EQ(a.partId, b.partId);
+        ASSERT_TRUE(a.mesh && b.mesh);
+        ASSERT_EQ(a.mesh->GetVertices().size(), b.mesh->GetVertices().size()) << a.partId;
+        EXPECT_EQ(a.mesh->GetIndices(), b.mesh->GetIndices()) << a.partId;
+        for (size_t v = 0; v < a.mesh->GetVertices().size(); ++v) {
+            const Moon::Vector3& pa = a.mesh->GetVertices()[v].position;
+            const Moon::Vector3& pb = b.mesh->GetVertices()[v].position;
+            EXPECT_TRUE(pa.x == pb.x && pa.y == pb.y && pa.z == pb.z) << a.partId << " vertex " << v;
+        }
+    }
+
+    EXPECT_EQ(serial.stairs.size(), parallel.stairs.size());
+    EXPECT_EQ(serial.connections.size(), parallel.connections.size());
+}
+
+} // namespace
+
+TEST_F(BuildingPipelineTest, ProcessBuilding_FloorParallel_MatchesSerialOutput) {
+    const std::vector<std::pair<const char*, std::string>> buildings = {
+        {"multi_floor", TestHelpers::CreateMultiFloorBuilding()},
+        {"l_shaped", TestHelpers::CreateLShapedBuilding()},
+        {"office_tower", TestHelpers::CreateOfficeTower()},
+        {"shopping_mall", TestHelpers::CreateShoppingMall()},
+        {"cbd_residential", TestHelpers::CreateCBDResidential()},
+        {"massing_vase_office", TestHelpers::LoadFromFile("massing_vase_office_demo.json")},
+    };
+
+    for (const auto& entry : buildings) {
+        SCOPED_TRACE(entry.first);
+        ASSERT_FALSE(entry.second.empty());
+
+        GeneratedBuilding serial;
+        ASSERT_TRUE(pipeline.ProcessBuilding(entry.second, serial, errorMsg)) << errorMsg;
+        EXPECT_FALSE(serial.pipelineStats.floorParallel);
+        EXPECT_EQ(serial.pipelineStats.workerCount, 1u);
+
+        for (size_t workers : {size_t(1), size_t(3), size_t(8)}) {
+            SCOPED_TRACE(workers);
+            BuildingPipeline parallelPipeline;
+            parallelPipeline.SetExecutionMode(PipelineExecutionMode::FloorParallel);
+            parallelPipeline.SetWorkerCount(workers);
+
+            GeneratedBuilding parallel;
+            ASSERT_TRUE(parallelPipeline.ProcessBuilding(entry.second, parallel, errorMsg)) << errorMsg;
+            EXPECT_TRUE(parallel.pipelineStats.floorParallel);
+            EXPECT_EQ(parallel.pipelineStats.workerCount, workers);
+            EXPECT_EQ(parallel.pipelineStats.floorLevelCount, serial.pipelineStats.floorLevelCount);
+            ExpectSameGeneratedOutput(serial, parallel);
+        }
+    }
+}
+
+TEST_F(BuildingPipelineTest, ProcessBuilding_ReportsStageTimings) {
+    pipeline.SetExecutionMode(PipelineExecutionMode::FloorParallel);
+    pipeline.SetWorkerCount(4);
+    ASSERT_TRUE(pipeline.ProcessBuilding(TestHelpers::CreateOfficeTower(), building, errorMsg)) << errorMsg;
+
+    const BuildingPipelineStats& stats = building.pipelineStats;
+    EXPECT_EQ(stats.workerCount, 4u);
+    EXPECT_GT(stats.floorLevelCount, 1u);
+    EXPECT_GT(stats.totalMs, 0.0);
+    const double stageSum = stats.validationMs + stats.structuralMs + stats.envelopeMs +
+        stats.semanticLayoutMs + stats.spaceGraphMs + stats.wallsMs + stats.doorsMs +
+        stats.stairsMs + stats.facadeMs;
+    EXPECT_LE(stageSum, stats.totalMs + 0.001);
+}
+
+TEST(FloorLayoutSearchTest, MakeFloorLayoutCandidate_PermutesOnlyNonCoreSpacesDeterministically) {
+    FloorLayoutInput floor;
+    floor.level = 3;
+    for (const char* type : {"office", "stairs", "meeting_room", "elevator", "office", "restroom", "pantry"}) {
+        SemanticSpace space;
+        space.spaceId = std::string(type) + "_" + std::to_string(floor.spaces.size());
+        space.type = type;
+        floor.spaces.push_back(space);
+    }
+
+    const FloorLayoutInput authored = MakeFloorLayoutCandidate(floor, 7, 0);
+    ASSERT_EQ(authored.spaces.size(), floor.spaces.size());
+    for (size_t i = 0; i < floor.spaces.size(); ++i) {
+        EXPECT_EQ(authored.spaces[i].spaceId, floor.spaces[i].spaceId);
+    }
+
+    bool anyReordered = false;
+    for (size_t candidate = 1; candidate < 8; ++candidate) {
+        const FloorLayoutInput permuted = MakeFloorLayoutCandidate(floor, 7, candidate);
+        const FloorLayoutInput repeated = MakeFloorLayoutCandidate(floor, 7, candidate);
+        ASSERT_EQ(permuted.spaces.size(), floor.spaces.size());
+        std::unordered_set<std::string> ids;
+        for (size_t i = 0; i < permuted.spaces.size(); ++i) {
+            EXPECT_EQ(permuted.spaces[i].spaceId, repeated.spaces[i].spaceId);
+            ids.insert(permuted.spaces[i].spaceId);
+            anyReordered = anyReordered || permuted.spaces[i].spaceId != floor.spaces[i].spaceId;
+        }
+        EXPECT_EQ(ids.size(), floor.spaces.size());
+        EXPECT_EQ(permuted.spaces[1].spaceId, floor.spaces[1].spaceId);
+        EXPECT_EQ(permuted.spaces[3].spaceId, floor.spaces[3].spaceId);
+    }
+    EXPECT_TRUE(anyReordered);
+}
+
+TEST(FloorLayoutSearchTest, ScoreFloorLayout_RewardsPlacementAdjacencyAndPenalizesOverlap) {
+    FloorLayoutInput floor;
+    SemanticSpace office;
+    office.spaceId = "office";
+    office.type = "office";
+    office.areaPreferred = 20.0f;
+    office.adjacency.push_back({"corridor", "connected", "required"});
+    SemanticSpace corridor;
+    corridor.spaceId = "corridor";
+    corridor.type = "corridor";
+    corridor.areaPreferred = 10.0f;
+    floor.spaces = {office, corridor};
+
+    auto makeSpace = [](const char* id, float x, float y, float width, float depth) {
+        ResolvedSpacePlan space;
+        space.spaceId = id;
+        space.rect.origin = {x, y};
+        space.rect.size = {width, depth};
+        return space;
+    };
+
+    ResolvedFloorLayout adjacent;
+    adjacent.spaces = {makeSpace("office", 0.0f, 0.0f, 5.0f, 4.0f), makeSpace("corridor", 5.0f, 0.0f, 2.5f, 4.0f)};
+    ResolvedFloorLayout apart;
+    apart.spaces = {makeSpace("office", 0.0f, 0.0f, 5.0f, 4.0f), makeSpace("corridor", 9.0f, 0.0f, 2.5f, 4.0f)};
+    ResolvedFloorLayout overlapping;
+    overlapping.spaces = {makeSpace("office", 0.0f, 0.0f, 5.0f, 4.0f), makeSpace("corridor", 3.0f, 0.0f, 2.5f, 4.0f)};
+    ResolvedFloorLayout partial;
+    partial.spaces = {makeSpace("office", 0.0f, 0.0f, 5.0f, 4.0f)};
+
+    const float adjacentScore = ScoreFloorLayout(floor, adjacent);
+    EXPECT_NEAR(adjacentScore, 1.0f, 1e-5f);
+    EXPECT_LT(ScoreFloorLayout(floor, apart), adjacentScore);
+    EXPECT_LT(ScoreFloorLayout(floor, overlapping), ScoreFloorLayout(floor, apart));
+    EXPECT_LT(ScoreFloorLayout(floor, partial), ScoreFloorLayout(floor, apart));
+
+    EXPECT_EQ(SelectFloorLayoutCandidate({0.4f, 0.7f, 0.7f}, {true, true, true}), 1u);
+    EXPECT_EQ(SelectFloorLayoutCandidate({0.4f, 0.9f}, {true, false}), 0u);
+    EXPECT_EQ(SelectFloorLayoutCandidate({0.4f}, {false}), 1u);
+}
+
+TEST_F(BuildingPipelineTest, ProcessBuilding_LayoutSearch_IsDeterministicAndNeverWorseThanAuthoredOrder) {
+    const std::vector<std::pair<const char*, std::string>> buildings = {
+        {"office_tower", TestHelpers::CreateOfficeTower()},
+        {"shopping_mall", TestHelpers::CreateShoppingMall()},
+        {"cbd_residential", TestHelpers::CreateCBDResidential()},
+        {"massing_vase_office", TestHelpers::LoadFromFile("massing_vase_office_demo.json")},
+    };
+
+    FloorLayoutSearchOptions options;
+    options.candidateCount = 8;
+    options.seed = 20260416;
+
+    for (const auto& entry : buildings) {
+        SCOPED_TRACE(entry.first);
+        ASSERT_FALSE(entry.second.empty());
+
+        GeneratedBuilding authored;
+        ASSERT_TRUE(pipeline.ProcessBuilding(entry.second, authored, errorMsg)) << errorMsg;
+        EXPECT_EQ(authored.pipelineStats.layoutSearch.candidatesEvaluated, 0u);
+
+        BuildingPipeline searchPipeline;
+        searchPipeline.SetLayoutSearchOptions(options);
+        GeneratedBuilding serial;
+        ASSERT_TRUE(searchPipeline.ProcessBuilding(entry.second, serial, errorMsg)) << errorMsg;
+        const FloorLayoutSearchStats& search = serial.pipelineStats.layoutSearch;
+        EXPECT_GT(search.floorsSearched, 0u);
+        EXPECT_EQ(search.candidatesEvaluated, search.floorsSearched * options.candidateCount);
+        EXPECT_GE(search.selectedScoreMean, search.baselineScoreMean);
+        EXPECT_LE(search.scoreMin, search.scoreMedian);
+        EXPECT_LE(search.scoreMedian, search.scoreMax);
+
+        for (size_t workers : {size_t(1), size_t(3), size_t(8)}) {
+            SCOPED_TRACE(workers);
+            BuildingPipeline parallelPipeline;
+            parallelPipeline.SetLayoutSearchOptions(options);
+            parallelPipeline.SetExecutionMode(PipelineExecutionMode::FloorParallel);
+            parallelPipeline.SetWorkerCount(workers);
+
+            GeneratedBuilding parallel;
+            ASSERT_TRUE(parallelPipeline.ProcessBuilding(entry.second, parallel, errorMsg)) << errorMsg;
+            EXPECT_EQ(parallel.pipelineStats.layoutSearch.floorsImproved, search.floorsImproved);
+            EXPECT_EQ(parallel.pipelineStats.layoutSearch.selectedScoreMean, search.selectedScoreMean);
+            ExpectSameGeneratedOutput(serial, parallel);
+        }
+
+        std::printf("[Benchmark] %s layout search (%zu floors x %zu candidates): %.0f candidates/s, "
+                    "score min %.3f median %.3f max %.3f, authored %.3f -> selected %.3f, %zu floors improved, %zu rejected\n",
+            entry.first, search.floorsSearched, options.candidateCount, search.CandidatesPerSecond(),
+            search.scoreMin, search.scoreMedian, search.scoreMax, search.baselineScoreMean,
+            search.selectedScoreMean, search.floorsImproved, search.candidatesRejected);
+    }
+}
+
+namespace {
+
+/**
+ * @brief Remove the last non-stair space from the level with the most spaces
+ * @return Edited floor level, or -1 when no space can be removed
+ */
+int RemoveOneSpace(BuildingDefinition& definition) {
+    Floor* target = nullptr;
+    for (auto& floor : definition.floors) {
+        if (!target || floor.spaces.size() > target->spaces.size()) {
+            target = &floor;
+        }
+    }
+    if (!target || target->spaces.size() < 2) {
+        return -1;
+    }
+
+    for (size_t i = target->spaces.size(); i-- > 0;) {
+        if (!target->spaces[i].properties.hasStairs) {
+            target->spaces.erase(target->spaces.begin() + static_cast<std::ptrdiff_t>(i));
+            return target->level;
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+TEST_F(BuildingPipelineTest, RebuildBuilding_EditedFloor_MatchesFullRebuildAndTouchesOnlyThatFloor) {
+    const std::vector<std::pair<const char*, std::string>> buildings = {
+        {"l_shaped", TestHelpers::CreateLShapedBuilding()},
+        {"office_tower", TestHelpers::CreateOfficeTower()},
+        {"shopping_mall", TestHelpers::CreateShoppingMall()},
+        {"cbd_residential", TestHelpers::CreateCBDResidential()},
+    };
+
+    for (const auto& entry : buildings) {
+        for (PipelineExecutionMode mode : {PipelineExecutionMode::Serial, PipelineExecutionMode::FloorParallel}) {
+            SCOPED_TRACE(entry.first);
+            SCOPED_TRACE(mode == PipelineExecutionMode::Serial ? "serial" : "floor-parallel");
+            pipeline.SetExecutionMode(mode);
+
+            // Edits start from the authored definition, as an editor would hold it
+            BuildingDefinition definition;
+            ASSERT_TRUE(pipeline.GetSchemaValidator().ValidateAndParse(entry.second, definition, errorMsg)) << errorMsg;
+            GeneratedBuilding previous;
+            ASSERT_TRUE(pipeline.ProcessBuilding(definition, previous, errorMsg)) << errorMsg;
+
+            BuildingDefinition edited = previous.definition;
+            const int editedLevel = RemoveOneSpace(edited);
+            ASSERT_GE(editedLevel, 0);
+
+            GeneratedBuilding expected;
+            const auto fullStart = std::chrono::steady_clock::now();
+            ASSERT_TRUE(pipeline.ProcessBuilding(edited, expected, errorMsg)) << errorMsg;
+            const double fullMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - fullStart).count();
+
+            GeneratedBuilding rebuilt;
+            BuildingDelta delta;
+            const auto incrementalStart = std::chrono::steady_clock::now();
+            ASSERT_TRUE(pipeline.RebuildBuilding(previous, edited, rebuilt, delta, errorMsg)) << errorMsg;
+            const double incrementalMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - incrementalStart).count();
+
+            ExpectSameGeneratedOutput(expected, rebuilt);
+            EXPECT_EQ(rebuilt.floorPlateMeshes.size(), expected.floorPlateMeshes.size());
+
+            EXPECT_FALSE(delta.definitionChanges.requiresFullRebuild) << delta.definitionChanges.fullRebuildReason;
+            EXPECT_EQ(delta.definitionChanges.dirtyFloorLevels, std::vector<int>{editedLevel});
+            EXPECT_EQ(delta.definitionChanges.changedSpaceIds.size(), 1u);
+            EXPECT_EQ(delta.regeneratedFloorLevels, std::vector<int>{editedLevel});
+            EXPECT_FALSE(delta.IsEmpty());
+            for (const auto& part : delta.parts) {
+                if (part.type != BuildingPartType::FloorPlateMesh) {
+                    EXPECT_EQ(part.floorLevel, editedLevel) << part.key;
+                }
+            }
+
+            // Unchanged meshes are shared rather than rebuilt
+            ASSERT_EQ(rebuilt.envelopeMeshes.size(), previous.envelopeMeshes.size());
+            for (size_t i = 0; i < rebuilt.envelopeMeshes.size(); ++i) {
+                EXPECT_EQ(rebuilt.envelopeMeshes[i].mesh, previous.envelopeMeshes[i].mesh);
+            }
+            if (delta.Count(BuildingPartType::FloorPlateMesh, BuildingPartChangeType::Modified) == 0 &&
+                rebuilt.floorPlateMeshes.size() == previous.floorPlateMeshes.size()) {
+                for (size_t i = 0; i < rebuilt.floorPlateMeshes.size(); ++i) {
+                    EXPECT_EQ(rebuilt.floorPlateMeshes[i].mesh, previous.floorPlateMeshes[i].mesh);
+                }
+            }
+
+            std::printf("[Benchmark] %s rebuild of level %d: %zu part changes, incremental %.3f ms, full %.3f ms\n",
+                entry.first, editedLevel, delta.parts.size(), incrementalMs, fullMs);
+        }
+    }
+}
+
+TEST_F(BuildingPipelineTest, RebuildBuilding_UnchangedDefinition_ReturnsEmptyDelta) {
+    ASSERT_TRUE(pipeline.ProcessBuilding(TestHelpers::CreateOfficeTower(), building, errorMsg)) << errorMsg;
+
+    GeneratedBuilding rebuilt;
+    BuildingDelta delta;
+    ASSERT_TRUE(pipeline.RebuildBuilding(building, building.definition, rebuilt, delta, errorMsg)) << errorMsg;
+
+    EXPECT_FALSE(delta.definitionChanges.HasChanges());
+    EXPECT_TRUE(delta.IsEmpty());
+    EXPECT_TRUE(delta.regeneratedFloorLevels.empty());
+    ExpectSameGeneratedOutput(building, rebuilt);
+}
+
+TEST_F(BuildingPipelineTest, RebuildBuilding_StyleChange_FallsBackToFullRebuild) {
+    BuildingDefinition definition;
+    ASSERT_TRUE(pipeline.GetSchemaValidator().ValidateAndParse(TestHelpers::CreateOfficeTower(), definition, errorMsg)) << errorMsg;
+    ASSERT_TRUE(pipeline.ProcessBuilding(definition, building, errorMsg)) << errorMsg;
+
+    BuildingDefinition edited = building.definition;
+    edited.style.facade = edited.style.facade == "brick" ? "glass_white" : "brick";
+    const int editedLevel = RemoveOneSpace(edited);
+    ASSERT_GE(editedLevel, 0);
+
+    GeneratedBuilding expected;
+    ASSERT_TRUE(pipeline.ProcessBuilding(edited, expected, errorMsg)) << errorMsg;
+
+    // Rebuild in place: previous and output may alias
+    BuildingDelta delta;
+    ASSERT_TRUE(pipeline.RebuildBuilding(building, edited, building, delta, errorMsg)) << errorMsg;
+
+    EXPECT_TRUE(delta.definitionChanges.requiresFullRebuild);
+    EXPECT_FALSE(delta.definitionChanges.fullRebuildReason.empty());
+    EXPECT_EQ(delta.regeneratedFloorLevels.size(), expected.pipelineStats.floorLevelCount);
+    EXPECT_FALSE(delta.IsEmpty());
+    ExpectSameGeneratedOutput(expected, building);
+}
@@ -2,8 +2,12 @@
 
 #include "building/BuildingPipeline.h"
 #include "building/BuildingQualityChecks.h"
+#include "building/BuildingTaskPool.h"
 #include "core/Assets/AssetPaths.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 #include <vector>
@@ -39,6 +43,96 @@ Moon::Building::GeneratedBuilding BuildRepresentativeAsset(const std::string& pa
     return building;
 }
 
+/**
+ * @brief Stack copies of a generated building on top of each other
+ * Space, wall and floor numbering is offset per copy, so the result looks like
+ * one tall building to the quality checks.
+ */
+Moon::Building::GeneratedBuilding StackBuilding(const Moon::Building::GeneratedBuilding& source, int copies) {
+    int levels = 0;
+    int spaceIdSpan = 0;
+    int wallIdSpan = 0;
+    for (const auto& floor : source.definition.floors) {
+        levels = std::max(levels, floor.level + 1);
+        for (const auto& space : floor.spaces) {
+            spaceIdSpan = std::max(spaceIdSpan, space.spaceId + 1);
+        }
+    }
+    for (const auto& wall : source.walls) {
+        wallIdSpan = std::max(wallIdSpan, wall.wallId + 1);
+    }
+
+    Moon::Building::GeneratedBuilding stacked = source;
+    for (int copy = 1; copy < copies; ++copy) {
+        const int dl = copy * levels;
+        const int ds = copy * spaceIdSpan;
+        const int dw = copy * wallIdSpan;
+        auto space = [&](int id) { return id >= 0 ? id + ds : id; };
+        for (auto floor : source.definition.floors) {
+            floor.level += dl;
+            for (auto& s : floor.spaces) {
+                s.spaceId += ds;
+            }
+            stacked.definition.floors.push_back(floor);
+        }
+        for (auto plate : source.floorPlates) {
+            plate.floorLevel += dl;
+            stacked.floorPlates.push_back(plate);
+        }
+        for (auto wall : source.walls) {
+            wall.wallId += dw;
+            wall.spaceId = space(wall.spaceId);
+            wall.neighborSpaceId = space(wall.neighborSpaceId);
+            wall.floorLevel += dl;
+            stacked.walls.push_back(wall);
+        }
+        for (auto door : source.doors) {
+            door.wallId += dw;
+            door.spaceA = space(door.spaceA);
+            door.spaceB = space(door.spaceB);
+            door.floorLevel += dl;
+            stacked.doors.push_back(door);
+        }
+        for (auto window : source.windows) {
+            window.wallId = window.wallId >= 0 ? window.wallId + dw : window.wallId;
+            window.spaceId = space(window.spaceId);
+            window.floorLevel += dl;
+            stacked.windows.push_back(window);
+        }
+        for (auto connection : source.connections) {
+            connection.spaceA = space(connection.spaceA);
+            connection.spaceB = space(connection.spaceB);
+            stacked.connections.push_back(connection);
+        }
+        for (auto column : source.supportColumns) {
+            column.floorFrom += dl;
+            column.floorTo += dl;
+            stacked.supportColumns.push_back(column);
+        }
+    }
+
+    // Stretch vertical circulation over the whole stack
+    const int top = copies * levels - 1;
+    for (auto& transport : stacked.verticalTransports) {
+        transport.floorTo = top;
+    }
+    for (auto& core : stacked.verticalCores) {
+        core.floorTo = top;
+    }
+    for (auto& mass : stacked.definition.masses) {
+        mass.floors = top + 1;
+    }
+    return stacked;
+}
+
+std::vector<std::string> FormatIssues(const std::vector<Moon::Building::BuildingQualityIssue>& issues) {
+    std::vector<std::string> formatted;
+    for (const auto& issue : issues) {
+        formatted.push_back(issue.code + "|" + issue.message + "|" + std::to_string(issue.floorLevel));
+    }
+    return formatted;
+}
+
 } // namespace
 
 TEST(BuildingQualityChecksTests, RepresentativeAssetsPassQualityChecks) {
@@ -282,3 +376,58 @@ TEST(BuildingQualityChecksTests, ColumnInsideShaftFailsQualityChecks) {
     EXPECT_FALSE(report.passed);
     EXPECT_TRUE(report.HasErrorCode("column_inside_shaft"));
 }
+
+TEST(BuildingQualityChecksTests, ParallelChecksMatchSerialReport) {
+    auto broken = BuildRepresentativeAsset(Moon::Assets::BuildAssetPath("building/fixtures/office_tower.json"));
+    broken.stairs.clear();
+    broken.verticalTransports.clear();
+    if (!broken.doors.empty()) {
+        broken.doors.front().wallId = -42;
+    }
+
+    const std::vector<Moon::Building::GeneratedBuilding> buildings = {
+        BuildRepresentativeAsset(Moon::Assets::BuildAssetPath("building/fixtures/villa.json")),
+        BuildRepresentativeAsset(Moon::Assets::BuildAssetPath("building/fixtures/shopping_mall.json")),
+        StackBuilding(BuildRepresentativeAsset(Moon::Assets::BuildAssetPath("building/fixtures/office_tower.json")), 4),
+        broken
+    };
+
+    Moon::Building::BuildingTaskPool pool(4);
+    for (size_t i = 0; i < buildings.size(); ++i) {
+        SCOPED_TRACE(i);
+        const auto serial = Moon::Building::EvaluateBuildingQuality(buildings[i]);
+        const auto parallel = Moon::Building::EvaluateBuildingQuality(buildings[i], &pool);
+        EXPECT_EQ(parallel.passed, serial.passed);
+        EXPECT_EQ(FormatIssues(parallel.errors), FormatIssues(serial.errors));
+        EXPECT_EQ(FormatIssues(parallel.warnings), FormatIssues(serial.warnings));
+    }
+
+    const auto brokenReport = Moon::Building::EvaluateBuildingQuality(broken, &pool);
+    EXPECT_TRUE(brokenReport.HasErrorCode("missing_vertical_circulation"));
+    EXPECT_TRUE(brokenReport.HasErrorCode("door_missing_wall"));
+}
+
+TEST(BuildingQualityChecksTests, Benchmark_HundredFloorQualityChecks) {
+    constexpr int kIterations = 5;
+    const auto source = BuildRepresentativeAsset(Moon::Assets::BuildAssetPath("building/fixtures/office_tower.json"));
+    int sourceLevels = 1;
+    for (const auto& floor : source.definition.floors) {
+        sourceLevels = std::max(sourceLevels, floor.level + 1);
+    }
+    const auto stacked = StackBuilding(source, (100 + sourceLevels - 1) / sourceLevels);
+    Moon::Building::BuildingTaskPool pool(0);
+
+    auto timeMs = [&](Moon::Building::BuildingTaskPool* runPool) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i) {
+            Moon::Building::EvaluateBuildingQuality(stacked, runPool);
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kIterations;
+    };
+
+    const double serialMs = timeMs(nullptr);
+    const double parallelMs = timeMs(&pool);
+    std::printf("[Benchmark] quality checks, %zu floors / %zu walls / %zu doors: serial %.3f ms, parallel (%zu workers) %.3f ms\n",
+                stacked.definition.floors.size(), stacked.walls.size(), stacked.doors.size(),
+                serialMs, pool.GetWorkerCount(), parallelMs);
+}
@@ -10,9 +10,13 @@
 #include "json.hpp"
 #include <chrono>
 #include <cmath>
+#include <cstdio>
 #include <fstream>
 #include <functional>
+#include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace Moon::Building;
 using namespace Moon::Building::Test;
@@ -135,10 +139,12 @@ const json* FindNodeByNameRecursive(const json& node, const std::string& name) {
             return found;
         }
     }
-    if (node.contains("children") && node["children"].is_array()) {
-        for (const auto& child : node["children"]) {
-            if (const json* found = FindNodeByNameRecursive(child, name)) {
-                return found;
+    for (const char* key : {"children", "operands"}) {
+        if (node.contains(key) && node[key].is_array()) {
+            for (const auto& child : node[key]) {
+                if (const json* found = FindNodeByNameRecursive(child, name)) {
+                    return found;
+                }
             }
         }
     }
@@ -163,9 +169,11 @@ void CollectNodesByPrefixRecursive(const json& node,
     if (node.contains("right")) {
         CollectNodesByPrefixRecursive(node["right"], prefix, outNodes);
     }
-    if (node.contains("children") && node["children"].is_array()) {
-        for (const auto& child : node["children"]) {
-            CollectNodesByPrefixRecursive(child, prefix, outNodes);
+    for (const char* key : {"children", "operands"}) {
+        if (node.contains(key) && node[key].is_array()) {
+            for (const auto& child : node[key]) {
+                CollectNodesByPrefixRecursive(child, prefix, outNodes);
+            }
         }
     }
 }
@@ -1136,6 +1144,213 @@ TEST_F(BuildingToObjectBlueprintConverterTest, ApartmentSingleStairDemo_BuiltWal
     EXPECT_GT(checkedWallLikeMeshes, 0);
 }
 
+// ========================================
+// Direct Blueprint Output Tests
+// ========================================
+
+namespace {
+
+using Moon::Object::Node;
+using Moon::Object::NodeType;
+using Moon::Object::ValueExpr;
+
+void ExpectSameValue(const ValueExpr& a, const ValueExpr& b, const std::string& path) {
+    EXPECT_EQ(a.kind, b.kind) << path;
+    EXPECT_EQ(a.constantValue, b.constantValue) << path;
+    EXPECT_EQ(a.paramName, b.paramName) << path;
+    EXPECT_EQ(a.expression, b.expression) << path;
+}
+
+void ExpectSameValues(const std::unordered_map<std::string, ValueExpr>& a,
+                      const std::unordered_map<std::string, ValueExpr>& b,
+                      const std::string& path) {
+    ASSERT_EQ(a.size(), b.size()) << path;
+    for (const auto& entry : a) {
+        const auto found = b.find(entry.first);
+        ASSERT_NE(found, b.end()) << path << "." << entry.first;
+        ExpectSameValue(entry.second, found->second, path + "." + entry.first);
+    }
+}
+
+void ExpectSameTransform(const Moon::Object::TransformTRS& a,
+                         const Moon::Object::TransformTRS& b,
+                         const std::string& path) {
+    ExpectSameValue(a.positionX, b.positionX, path + ".position.x");
+    ExpectSameValue(a.positionY, b.positionY, path + ".position.y");
+    ExpectSameValue(a.positionZ, b.positionZ, path + ".position.z");
+    ExpectSameValue(a.rotationX, b.rotationX, path + ".rotation.x");
+    ExpectSameValue(a.rotationY, b.rotationY, path + ".rotation.y");
+    ExpectSameValue(a.rotationZ, b.rotationZ, path + ".rotation.z");
+    ExpectSameValue(a.scaleX, b.scaleX, path + ".scale.x");
+    ExpectSameValue(a.scaleY, b.scaleY, path + ".scale.y");
+    ExpectSameValue(a.scaleZ, b.scaleZ, path + ".scale.z");
+}
+
+/**
+ * @brief Recursively compare two blueprint node trees field by field
+ */
+void ExpectSameNode(const Node* a, const Node* b, const std::string& path) {
+    ASSERT_TRUE(a != nullptr && b != nullptr) << path;
+    ASSERT_EQ(a->type, b->type) << path;
+
+    switch (a->type) {
+    case NodeType::Primitive: {
+        const auto& pa = *a->data.primitive;
+        const auto& pb = *b->data.primitive;
+        EXPECT_EQ(pa.primitive, pb.primitive) << path;
+        EXPECT_EQ(pa.material, pb.material) << path;
+        ExpectSameValues(pa.params, pb.params, path + ".params");
+        ExpectSameTransform(pa.localTransform, pb.localTransform, path);
+        break;
+    }
+    case NodeType::Csg: {
+        const auto& ca = *a->data.csg;
+        const auto& cb = *b->data.csg;
+        EXPECT_EQ(ca.operation, cb.operation) << path;
+        EXPECT_EQ(ca.options.solver, cb.options.solver) << path;
+        if (ca.left || cb.left) {
+            ExpectSameNode(ca.left.get(), cb.left.get(), path + ".left");
+        }
+        if (ca.right || cb.right) {
+            ExpectSameNode(ca.right.get(), cb.right.get(), path + ".right");
+        }
+        ASSERT_EQ(ca.operands.size(), cb.operands.size()) << path;
+        for (size_t i = 0; i < ca.operands.size(); ++i) {
+            ExpectSameNode(ca.operands[i].get(), cb.operands[i].get(),
+                           path + ".operands[" + std::to_string(i) + "]");
+        }
+        break;
+    }
+    case NodeType::Group: {
+        const auto& ga = *a->data.group;
+        const auto& gb = *b->data.group;
+        EXPECT_EQ(ga.outputMode, gb.outputMode) << path;
+        ASSERT_EQ(ga.childNames, gb.childNames) << path;
+        ASSERT_EQ(ga.children.size(), gb.children.size()) << path;
+        ExpectSameTransform(ga.localTransform, gb.localTransform, path);
+        for (size_t i = 0; i < ga.children.size(); ++i) {
+            ExpectSameNode(ga.children[i].get(), gb.children[i].get(), path + "/" + ga.childNames[i]);
+        }
+        break;
+    }
+    case NodeType::Reference: {
+        const auto& ra = *a->data.ref;
+        const auto& rb = *b->data.ref;
+        EXPECT_EQ(ra.refId, rb.refId) << path;
+        EXPECT_EQ(ra.attach.hasAttach, rb.attach.hasAttach) << path;
+        ExpectSameValues(ra.overrides, rb.overrides, path + ".overrides");
+        ExpectSameTransform(ra.localTransform, rb.localTransform, path);
+        break;
+    }
+    default:
+        ADD_FAILURE() << "Unexpected node type in generated building at " << path;
+        break;
+    }
+}
+
+/**
+ * @brief Semantic office program with a core, corridor and offices on every floor (lobby on level 0)
+ */
+std::string CreateHighRiseOffice(int floors, int officesPerFloor) {
+    std::string json = R"({"schema": "moon_building", "grid": 0.5, "building_type": "office_tower",)"
+        R"( "style": {"category": "commercial", "facade": "glass", "roof": "flat", "window_style": "full_height", "material": "concrete"},)"
+        R"( "mass": {"footprint_area": )" + std::to_string(officesPerFloor * 40 + 300) +
+        R"(, "floors": )" + std::to_string(floors) + R"(}, "program": {"floors": [)";
+
+    for (int level = 0; level < floors; ++level) {
+        const std::string suffix = "_" + std::to_string(level);
+        json += level == 0 ? "" : ",";
+        json += R"({"level": )" + std::to_string(level) + R"(, "name": "floor)" + suffix + R"(", "spaces": [)";
+        json += R"({"space_id": "core)" + suffix + R"(", "type": "core", "zone": "service", "area_preferred": 64, "constraints": {"min_width": 5.0}},)";
+        json += R"({"space_id": "corridor)" + suffix + R"(", "type": "corridor", "zone": "circulation", "area_preferred": 120, "constraints": {"min_width": 2.0}})";
+        if (level == 0) {
+            json += R"(, {"space_id": "lobby", "type": "lobby", "zone": "public", "area_preferred": 120, "constraints": {"min_width": 6.0}})";
+        }
+        for (int room = 0; room < officesPerFloor; ++room) {
+            json += R"(, {"space_id": "office)" + suffix + "_" + std::to_string(room) +
+                R"(", "type": "office", "zone": "public", "area_preferred": )" + std::to_string(30 + (room * 7) % 15) +
+                R"(, "adjacency": [{"to": "corridor)" + suffix + R"(", "relationship": "connected", "importance": "preferred"}], "constraints": {"min_width": 3.0}})";
+        }
+        json += "]}";
+    }
+    return json + "]}}";
+}
+
+} // namespace
+
+TEST_F(BuildingToObjectBlueprintConverterTest, ConvertToBlueprint_MatchesParsedJsonExport) {
+    const std::vector<std::pair<const char*, std::string>> fixtures = {
+        {"simple_room", TestHelpers::CreateSimpleRoom()},
+        {"l_shaped", TestHelpers::CreateLShapedBuilding()},
+        {"office_tower", TestHelpers::CreateOfficeTower()},
+        {"shopping_mall", TestHelpers::CreateShoppingMall()},
+        {"cbd_residential", TestHelpers::CreateCBDResidential()},
+        {"complex_shopping_mall", TestHelpers::LoadFromFile("complex_shopping_mall_demo.json")},
+        {"massing_vase_office", TestHelpers::LoadFromFile("massing_vase_office_demo.json")},
+    };
+
+    for (const auto& entry : fixtures) {
+        SCOPED_TRACE(entry.first);
+        ASSERT_FALSE(entry.second.empty());
+
+        GeneratedBuilding building;
+        std::string errorMsg;
+        ASSERT_TRUE(pipeline.ProcessBuilding(entry.second, building, errorMsg)) << errorMsg;
+
+        std::string parseError;
+        auto parsed = Moon::Object::BlueprintLoader::ParseFromString(
+            BuildingToObjectBlueprintConverter::Convert(building), parseError);
+        ASSERT_TRUE(parsed) << parseError;
+
+        auto direct = BuildingToObjectBlueprintConverter::ConvertToBlueprint(building);
+        ASSERT_TRUE(direct);
+        std::string validateError;
+        EXPECT_TRUE(direct->Validate(validateError)) << validateError;
+        EXPECT_EQ(direct->GetId(), parsed->GetId());
+        EXPECT_EQ(direct->GetSchemaVersion(), parsed->GetSchemaVersion());
+        EXPECT_TRUE(direct->GetParameters().empty());
+        ExpectSameNode(parsed->GetRootNode(), direct->GetRootNode(), "root");
+    }
+}
+
+TEST_F(BuildingToObjectBlueprintConverterTest, ConvertToBlueprint_OutlineSlabMatchesParsedJsonExport) {
+    GeneratedBuilding building;
+    building.definition.grid = 0.5f;
+
+    Floor floor;
+    floor.level = 0;
+    floor.floorHeight = 4.0f;
+    building.definition.floors.push_back(floor);
+
+    FloorPlate plate;
+    plate.floorLevel = 0;
+    plate.origin = {0.0f, 0.0f};
+    plate.size = {8.0f, 8.0f};
+    plate.outline = {
+        GridPos2D{0.0f, 0.0f},
+        GridPos2D{8.0f, 0.0f},
+        GridPos2D{6.0f, 6.0f},
+        GridPos2D{0.0f, 8.0f}
+    };
+    plate.voids.push_back({"stair_opening", {2.0f, 2.0f}, {2.0f, 2.0f}});
+    building.floorPlates.push_back(plate);
+
+    std::string parseError;
+    auto parsed = Moon::Object::BlueprintLoader::ParseFromString(
+        BuildingToObjectBlueprintConverter::Convert(building), parseError);
+    ASSERT_TRUE(parsed) << parseError;
+
+    auto direct = BuildingToObjectBlueprintConverter::ConvertToBlueprint(building);
+    ASSERT_TRUE(direct);
+    ExpectSameNode(parsed->GetRootNode(), direct->GetRootNode(), "root");
+
+    const Node* root = direct->GetRootNode();
+    ASSERT_EQ(root->type, NodeType::Group);
+    ASSERT_EQ(root->data.group->childNames.size(), 1u);
+    EXPECT_EQ(root->data.group->childNames[0], "floor_plate_0");
+    EXPECT_EQ(root->data.group->children[0]->type, NodeType::Csg);
+}
+
 // ========================================
 // Integration Tests
 // ========================================
@@ -1200,4 +1415,59 @@ TEST_F(BuildingToObjectBlueprintConverterTest, LargeBuilding_ReasonablePerforman
     EXPECT_TRUE(IsValidJSON(csgJson));
 }
 
+TEST_F(BuildingToObjectBlueprintConverterTest, Benchmark_ThirtyFloorEndToEnd) {
+    constexpr int kIterations = 3;
+
+    GeneratedBuilding building;
+    std::string errorMsg;
+    const auto pipelineStart = std::chrono::steady_clock::now();
+    ASSERT_TRUE(pipeline.ProcessBuilding(CreateHighRiseOffice(30, 8), building, errorMsg)) << errorMsg;
+    const double pipelineMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - pipelineStart).count();
+    ASSERT_EQ(building.definition.floors.size(), 30u);
+
+    PreloadedBlueprintDatabase database;
+    std::string indexError;
+    ASSERT_TRUE(database.LoadObjectIndex(indexError)) << indexError;
+
+    size_t jsonBytes = 0;
+    std::unique_ptr<Moon::Object::Blueprint> parsed;
+    const auto jsonStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        const std::string blueprintJson = BuildingToObjectBlueprintConverter::Convert(building);
+        jsonBytes = blueprintJson.size();
+        std::string parseError;
+        parsed = Moon::Object::BlueprintLoader::ParseFromString(blueprintJson, parseError);
+        ASSERT_TRUE(parsed) << parseError;
+    }
+    const double jsonMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - jsonStart).count() / kIterations;
+
+    std::unique_ptr<Moon::Object::Blueprint> direct;
+    const auto directStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        direct = BuildingToObjectBlueprintConverter::ConvertToBlueprint(building);
+        ASSERT_TRUE(direct);
+    }
+    const double directMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - directStart).count() / kIterations;
+
+    ExpectSameNode(parsed->GetRootNode(), direct->GetRootNode(), "root");
 
+    Moon::CSG::CSGBuilder builder;
+    builder.SetBlueprintDatabase(&database);
+    std::unordered_map<std::string, float> params;
+    std::string buildError;
+    const auto csgStart = std::chrono::steady_clock::now();
+    const Moon::CSG::BuildResult result = builder.Build(direct.get(), params, buildError);
+    const double csgMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - csgStart).count();
+    EXPECT_FALSE(result.meshes.empty()) << buildError;
+
+    std::printf("[Benchmark] 30-floor office (%zu walls, %zu windows, %zu KB JSON): pipeline %.3f ms, csg %.3f ms\n",
+        building.walls.size(), building.windows.size(), jsonBytes / 1024, pipelineMs, csgMs);
+    std::printf("[Benchmark]   JSON convert+parse %.3f ms -> end-to-end %.3f ms\n",
+        jsonMs, pipelineMs + jsonMs + csgMs);
+    std::printf("[Benchmark]   direct blueprint   %.3f ms -> end-to-end %.3f ms\n",
+        directMs, pipelineMs + directMs + csgMs);
+}
@@ -0,0 +1,309 @@
+// CSG 求值方式对比：Manifold 原生求值与逐节点 Mesh 往返求值结果一致，并对门窗部件计时
+// n 元 subtract_all / union_all 与等价的二元嵌套链结果一致
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/Assets/AssetPaths.h"
+#include "core/CSG/CSGBuilder.h"
+#include "core/Math/Bounds.h"
+#include "core/Object/Blueprint.h"
+#include "core/Object/BlueprintLoader.h"
+
+namespace {
+
+const char* const kArchitecturalBlueprints[] = {
+    "opening_v1",
+    "window_v1",
+    "door_v1",
+    "door_frame_v1",
+    "complete_door_v1",
+    "wall_panel_v1",
+    "wall_with_window_v1",
+};
+
+Moon::AABB ComputeWorldBounds(const Moon::CSG::BuildResult& result) {
+    Moon::AABB bounds;
+    for (const auto& item : result.meshes) {
+        if (!item.mesh) {
+            continue;
+        }
+        const auto& transform = item.worldTransform;
+        for (const auto& vertex : item.mesh->GetVertices()) {
+            const Moon::Vector3 rotated = transform.rotation * vertex.position;
+            bounds.Expand(Moon::Vector3(rotated.x * transform.scale.x,
+                                        rotated.y * transform.scale.y,
+                                        rotated.z * transform.scale.z) + transform.position);
+        }
+    }
+    return bounds;
+}
+
+// 闭合网格体积（散度定理）
+double ComputeVolume(const Moon::CSG::BuildResult& result) {
+    double volume = 0.0;
+    for (const auto& item : result.meshes) {
+        if (!item.mesh) {
+            continue;
+        }
+        const auto& vertices = item.mesh->GetVertices();
+        const auto& indices = item.mesh->GetIndices();
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            const Moon::Vector3& a = vertices[indices[i]].position;
+            const Moon::Vector3& b = vertices[indices[i + 1]].position;
+            const Moon::Vector3& c = vertices[indices[i + 2]].position;
+            volume += (a.x * (b.y * c.z - b.z * c.y) -
+                       a.y * (b.x * c.z - b.z * c.x) +
+                       a.z * (b.x * c.y - b.y * c.x)) / 6.0;
+        }
+    }
+    return volume;
+}
+
+// 600x300x20 cm 墙板，沿长度均匀排布 windowCount 个窗洞切割体
+std::string MakeCubeJson(float sx, float sy, float sz, float x, float y, const char* material) {
+    return R"({ "type": "primitive", "primitive": "cube", "material": ")" + std::string(material) +
+        R"(", "params": { "size_x": )" + std::to_string(sx) + R"(, "size_y": )" + std::to_string(sy) +
+        R"(, "size_z": )" + std::to_string(sz) + R"( }, "transform": { "position": [)" +
+        std::to_string(x) + ", " + std::to_string(y) + R"(, 0] } })";
+}
+
+std::vector<std::string> MakeWindowCutters(int windowCount) {
+    std::vector<std::string> cutters;
+    const float spacing = 600.0f / static_cast<float>(windowCount);
+    for (int i = 0; i < windowCount; ++i) {
+        const float x = -300.0f + spacing * (static_cast<float>(i) + 0.5f);
+        cutters.push_back(MakeCubeJson(spacing * 0.5f, 120.0f, 30.0f, x, 20.0f, "glass"));
+    }
+    return cutters;
+}
+
+std::string WrapBlueprint(const std::string& root) {
+    return R"({ "schema_version": 1, "name": "nary_csg_test", "root": )" + root + "}";
+}
+
+// operands[0] op operands[1] op ... 的二元嵌套链
+std::string MakeNestedChain(const char* operation, const std::vector<std::string>& operands) {
+    std::string node = operands.front();
+    for (size_t i = 1; i < operands.size(); ++i) {
+        node = R"({ "type": "csg", "operation": ")" + std::string(operation) +
+            R"(", "left": )" + node + R"(, "right": )" + operands[i] + "}";
+    }
+    return node;
+}
+
+std::string MakeNary(const char* operation, const std::vector<std::string>& operands) {
+    std::string node = R"({ "type": "csg", "operation": ")" + std::string(operation) + R"(", "operands": [)";
+    for (size_t i = 0; i < operands.size(); ++i) {
+        node += (i > 0 ? ", " : "") + operands[i];
+    }
+    return node + "] }";
+}
+
+std::vector<std::string> MakeWallOperands(int windowCount) {
+    std::vector<std::string> operands = {MakeCubeJson(600.0f, 300.0f, 20.0f, 0.0f, 0.0f, "concrete")};
+    for (auto& cutter : MakeWindowCutters(windowCount)) {
+        operands.push_back(std::move(cutter));
+    }
+    return operands;
+}
+
+} // namespace
+
+class CSGEvaluationModeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::string error;
+        ASSERT_TRUE(database.LoadIndex(Moon::Assets::BuildObjectPath("index.json"), error)) << error;
+    }
+
+    Moon::CSG::BuildResult Build(const std::string& id, Moon::CSG::EvaluationMode mode) {
+        const Moon::Object::Blueprint* blueprint = database.GetBlueprint(id);
+        EXPECT_NE(blueprint, nullptr) << id;
+        if (!blueprint) {
+            return Moon::CSG::BuildResult();
+        }
+
+        Moon::CSG::CSGBuilder builder;
+        builder.SetBlueprintDatabase(&database);
+        builder.SetResultCache(nullptr);
+        builder.SetEvaluationMode(mode);
+
+        std::string error;
+        Moon::CSG::BuildResult result = builder.Build(blueprint, {}, error);
+        EXPECT_TRUE(error.empty()) << id << ": " << error;
+        return result;
+    }
+
+    Moon::CSG::BuildResult BuildJson(const std::string& json, Moon::CSG::EvaluationMode mode) {
+        std::string error;
+        auto blueprint = Moon::Object::BlueprintLoader::ParseFromString(json, error);
+        EXPECT_NE(blueprint, nullptr) << error;
+        if (!blueprint) {
+            return Moon::CSG::BuildResult();
+        }
+
+        Moon::CSG::CSGBuilder builder;
+        builder.SetResultCache(nullptr);
+        builder.SetEvaluationMode(mode);
+
+        Moon::CSG::BuildResult result = builder.Build(blueprint.get(), {}, error);
+        EXPECT_TRUE(error.empty()) << error;
+        return result;
+    }
+
+    void ExpectSameSolid(const Moon::CSG::BuildResult& actual, const Moon::CSG::BuildResult& expected) {
+        ASSERT_EQ(actual.meshes.size(), 1u);
+        ASSERT_EQ(expected.meshes.size(), 1u);
+        ASSERT_TRUE(actual.meshes[0].mesh && actual.meshes[0].mesh->IsValid());
+        EXPECT_EQ(actual.meshes[0].material, expected.meshes[0].material);
+
+        const Moon::AABB a = ComputeWorldBounds(actual);
+        const Moon::AABB b = ComputeWorldBounds(expected);
+        constexpr float kTolerance = 1e-3f;
+        EXPECT_NEAR(a.minPoint.x, b.minPoint.x, kTolerance);
+        EXPECT_NEAR(a.minPoint.y, b.minPoint.y, kTolerance);
+        EXPECT_NEAR(a.minPoint.z, b.minPoint.z, kTolerance);
+        EXPECT_NEAR(a.maxPoint.x, b.maxPoint.x, kTolerance);
+        EXPECT_NEAR(a.maxPoint.y, b.maxPoint.y, kTolerance);
+        EXPECT_NEAR(a.maxPoint.z, b.maxPoint.z, kTolerance);
+
+        const double expectedVolume = ComputeVolume(expected);
+        EXPECT_NEAR(ComputeVolume(actual), expectedVolume, std::abs(expectedVolume) * 1e-4);
+    }
+
+    Moon::Object::BlueprintDatabase database;
+};
+
+TEST_F(CSGEvaluationModeTest, NativeMatchesMeshRoundTrip) {
+    for (const char* id : kArchitecturalBlueprints) {
+        SCOPED_TRACE(id);
+        const auto roundTrip = Build(id, Moon::CSG::EvaluationMode::MeshRoundTrip);
+        const auto native = Build(id, Moon::CSG::EvaluationMode::ManifoldNative);
+
+        ASSERT_FALSE(native.meshes.empty());
+        ASSERT_EQ(native.meshes.size(), roundTrip.meshes.size());
+        for (size_t i = 0; i < native.meshes.size(); ++i) {
+            ASSERT_TRUE(native.meshes[i].mesh && native.meshes[i].mesh->IsValid());
+            EXPECT_EQ(native.meshes[i].material, roundTrip.meshes[i].material);
+        }
+
+        const Moon::AABB expected = ComputeWorldBounds(roundTrip);
+        const Moon::AABB actual = ComputeWorldBounds(native);
+        constexpr float kTolerance = 1e-3f;
+        EXPECT_NEAR(actual.minPoint.x, expected.minPoint.x, kTolerance);
+        EXPECT_NEAR(actual.minPoint.y, expected.minPoint.y, kTolerance);
+        EXPECT_NEAR(actual.minPoint.z, expected.minPoint.z, kTolerance);
+        EXPECT_NEAR(actual.maxPoint.x, expected.maxPoint.x, kTolerance);
+        EXPECT_NEAR(actual.maxPoint.y, expected.maxPoint.y, kTolerance);
+        EXPECT_NEAR(actual.maxPoint.z, expected.maxPoint.z, kTolerance);
+    }
+}
+
+TEST_F(CSGEvaluationModeTest, Benchmark_DoorWindowBlueprints) {
+    constexpr int kIterations = 20;
+
+    auto timeMode = [&](const char* id, Moon::CSG::EvaluationMode mode) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < kIterations; ++i) {
+            Build(id, mode);
+        }
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count() / kIterations;
+    };
+
+    double totalRoundTrip = 0.0;
+    double totalNative = 0.0;
+    for (const char* id : kArchitecturalBlueprints) {
+        const double roundTripMs = timeMode(id, Moon::CSG::EvaluationMode::MeshRoundTrip);
+        const double nativeMs = timeMode(id, Moon::CSG::EvaluationMode::ManifoldNative);
+        totalRoundTrip += roundTripMs;
+        totalNative += nativeMs;
+        std::printf("[Benchmark] %-22s mesh round-trip %.3f ms, manifold native %.3f ms\n",
+            id, roundTripMs, nativeMs);
+    }
+    std::printf("[Benchmark] door/window total: mesh round-trip %.3f ms, manifold native %.3f ms\n",
+        totalRoundTrip, totalNative);
+}
+
+TEST_F(CSGEvaluationModeTest, SubtractAll_MatchesNestedSubtract) {
+    const auto operands = MakeWallOperands(12);
+    const std::string nested = WrapBlueprint(MakeNestedChain("subtract", operands));
+    const std::string batched = WrapBlueprint(MakeNary("subtract_all", operands));
+
+    for (auto mode : {Moon::CSG::EvaluationMode::ManifoldNative, Moon::CSG::EvaluationMode::MeshRoundTrip}) {
+        SCOPED_TRACE(mode == Moon::CSG::EvaluationMode::ManifoldNative ? "native" : "round-trip");
+        const auto expected = BuildJson(nested, mode);
+        const auto actual = BuildJson(batched, mode);
+        ExpectSameSolid(actual, expected);
+        EXPECT_EQ(actual.meshes[0].material, "concrete");
+    }
+}
+
+// group 操作数的子节点按 Mesh 构建后再转换为 Manifold，不能输出未焊接的 FlatShading 顶点
+TEST_F(CSGEvaluationModeTest, GroupCutter_MatchesPlainCutters) {
+    const auto operands = MakeWallOperands(2);
+    const std::string plain = WrapBlueprint(MakeNestedChain("subtract", operands));
+    const std::string groupCutter = WrapBlueprint(MakeNary("subtract_all", {operands[0],
+        R"({ "type": "group", "children": [)" + operands[1] + ", " + operands[2] + "] }"}));
+    const std::string singleChildGroup = WrapBlueprint(MakeNestedChain("subtract", {
+        MakeNestedChain("subtract", {operands[0], R"({ "type": "group", "children": [)" + operands[1] + "] }"}),
+        R"({ "type": "group", "children": [)" + operands[2] + "] }"}));
+
+    const auto expected = BuildJson(plain, Moon::CSG::EvaluationMode::MeshRoundTrip);
+    for (auto mode : {Moon::CSG::EvaluationMode::ManifoldNative, Moon::CSG::EvaluationMode::MeshRoundTrip}) {
+        SCOPED_TRACE(mode == Moon::CSG::EvaluationMode::ManifoldNative ? "native" : "round-trip");
+        ExpectSameSolid(BuildJson(singleChildGroup, mode), expected);
+    }
+
+    // 多 Mesh 切割体只有原生求值的 subtract_all 支持
+    ExpectSameSolid(BuildJson(groupCutter, Moon::CSG::EvaluationMode::ManifoldNative), expected);
+}
+
+TEST_F(CSGEvaluationModeTest, UnionAll_MatchesNestedUnion) {
+    std::vector<std::string> operands;
+    for (int i = 0; i < 6; ++i) {
+        operands.push_back(MakeCubeJson(40.0f, 40.0f, 40.0f, static_cast<float>(i) * 30.0f, 0.0f, "stone"));
+    }
+    const std::string nested = WrapBlueprint(MakeNestedChain("union", operands));
+    const std::string batched = WrapBlueprint(MakeNary("union_all", operands));
+
+    for (auto mode : {Moon::CSG::EvaluationMode::ManifoldNative, Moon::CSG::EvaluationMode::MeshRoundTrip}) {
+        SCOPED_TRACE(mode == Moon::CSG::EvaluationMode::ManifoldNative ? "native" : "round-trip");
+        ExpectSameSolid(BuildJson(batched, mode), BuildJson(nested, mode));
+    }
+}
+
+TEST_F(CSGEvaluationModeTest, SubtractAll_RequiresOperands) {
+    std::string error;
+    auto blueprint = Moon::Object::BlueprintLoader::ParseFromString(
+        WrapBlueprint(R"({ "type": "csg", "operation": "subtract_all", "operands": [] })"), error);
+    EXPECT_EQ(blueprint, nullptr);
+    EXPECT_NE(error.find("operands"), std::string::npos) << error;
+}
+
+TEST_F(CSGEvaluationModeTest, Benchmark_TwelveWindowWall) {
+    constexpr int kIterations = 20;
+    const auto operands = MakeWallOperands(12);
+    const std::string nested = WrapBlueprint(MakeNestedChain("subtract", operands));
+    const std::string batched = WrapBlueprint(MakeNary("subtract_all", operands));
+
+    auto timeBuild = [&](const std::string& json, Moon::CSG::EvaluationMode mode) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < kIterations; ++i) {
+            BuildJson(json, mode);
+        }
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count() / kIterations;
+    };
+
+    const double nestedMs = timeBuild(nested, Moon::CSG::EvaluationMode::ManifoldNative);
+    const double batchedMs = timeBuild(batched, Moon::CSG::EvaluationMode::ManifoldNative);
+    std::printf("[Benchmark] 12-window wall: nested subtract %.3f ms (12 booleans), subtract_all %.3f ms (1 batch + 1 boolean)\n",
+        nestedMs, batchedMs);
+}
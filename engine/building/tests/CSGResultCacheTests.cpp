@@ -0,0 +1,241 @@
+// CSG 结果缓存测试：命中共享 Mesh、键对参数与内容敏感、引用复用、磁盘层跨实例命中
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "core/CSG/CSGBuilder.h"
+#include "core/CSG/CSGResultCache.h"
+#include "core/Object/Blueprint.h"
+#include "core/Object/BlueprintLoader.h"
+
+using namespace Moon;
+
+namespace {
+
+const char* kHollowCylinderJson = R"({
+  "schema_version": 1,
+  "name": "cache_hollow_cylinder",
+  "parameters": { "radius": 3.5, "height": 20.0, "thickness": 0.2 },
+  "root": {
+    "type": "csg",
+    "operation": "subtract",
+    "left": {
+      "type": "primitive",
+      "primitive": "cylinder",
+      "params": { "radius": "$radius", "height": "$height" }
+    },
+    "right": {
+      "type": "primitive",
+      "primitive": "cylinder",
+      "params": { "radius": "$radius - $thickness", "height": "$height + 1.0" },
+      "transform": { "position": [0, "$thickness / 2", 0] }
+    }
+  }
+})";
+
+std::string MakeRowJson(int count) {
+    std::string json = R"({
+  "schema_version": 1,
+  "name": "cache_cylinder_row",
+  "parameters": { "spacing": 10.0 },
+  "root": {
+    "type": "group",
+    "children": [)";
+    for (int i = 0; i < count; ++i) {
+        json += i > 0 ? "," : "";
+        json += R"(
+      { "type": "reference", "ref": "cache_hollow_cylinder",
+        "overrides": { "radius": 2.0 },
+        "transform": { "position": [")" + std::to_string(i) + R"( * $spacing", 0, 0] } })";
+    }
+    json += R"(
+    ]
+  }
+})";
+    return json;
+}
+
+} // namespace
+
+class CSGResultCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        tempDir = std::filesystem::temp_directory_path() /
+            ("moon_csg_cache_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+        std::filesystem::create_directories(tempDir);
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        std::filesystem::remove_all(tempDir, ec);
+    }
+
+    std::unique_ptr<Object::Blueprint> Parse(const std::string& json) {
+        std::string error;
+        auto blueprint = Object::BlueprintLoader::ParseFromString(json, error);
+        EXPECT_TRUE(blueprint) << error;
+        return blueprint;
+    }
+
+    void LoadIntoDatabase(const std::string& name, const std::string& json) {
+        const std::filesystem::path path = tempDir / (name + ".json");
+        std::ofstream(path) << json;
+        std::string error;
+        ASSERT_TRUE(database.LoadBlueprint(path.string(), error)) << error;
+    }
+
+    CSG::BuildResult Build(CSG::CSGResultCache* cache, const Object::Blueprint* blueprint,
+                           const std::unordered_map<std::string, float>& overrides = {}) {
+        CSG::CSGBuilder builder;
+        builder.SetBlueprintDatabase(&database);
+        builder.SetResultCache(cache);
+        std::string error;
+        CSG::BuildResult result = builder.Build(blueprint, overrides, error);
+        EXPECT_TRUE(error.empty()) << error;
+        return result;
+    }
+
+    static void ExpectSameGeometry(const CSG::BuildResult& a, const CSG::BuildResult& b) {
+        ASSERT_EQ(a.meshes.size(), b.meshes.size());
+        for (size_t i = 0; i < a.meshes.size(); ++i) {
+            ASSERT_TRUE(a.meshes[i].mesh && b.meshes[i].mesh);
+            const auto& va = a.meshes[i].mesh->GetVertices();
+            const auto& vb = b.meshes[i].mesh->GetVertices();
+            ASSERT_EQ(va.size(), vb.size());
+            for (size_t v = 0; v < va.size(); ++v) {
+                EXPECT_EQ(va[v].position.x, vb[v].position.x);
+                EXPECT_EQ(va[v].position.y, vb[v].position.y);
+                EXPECT_EQ(va[v].position.z, vb[v].position.z);
+            }
+            EXPECT_EQ(a.meshes[i].mesh->GetIndices(), b.meshes[i].mesh->GetIndices());
+            EXPECT_EQ(a.meshes[i].material, b.meshes[i].material);
+            EXPECT_FLOAT_EQ(a.meshes[i].worldTransform.position.x, b.meshes[i].worldTransform.position.x);
+        }
+    }
+
+    Object::BlueprintDatabase database;
+    std::filesystem::path tempDir;
+};
+
+TEST_F(CSGResultCacheTest, RepeatedBuild_ReturnsSharedMeshes) {
+    CSG::CSGResultCache cache;
+    auto blueprint = Parse(kHollowCylinderJson);
+
+    const CSG::BuildResult first = Build(&cache, blueprint.get());
+    const CSG::BuildResult second = Build(&cache, blueprint.get());
+
+    ASSERT_EQ(first.meshes.size(), 1u);
+    ASSERT_EQ(second.meshes.size(), 1u);
+    EXPECT_EQ(first.meshes[0].mesh.get(), second.meshes[0].mesh.get());
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.lookups, 2u);
+    EXPECT_EQ(stats.memoryHits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.stores, 1u);
+    EXPECT_EQ(stats.entryCount, 1u);
+    EXPECT_EQ(stats.memoryBytes, CSG::CSGResultCache::ComputeResultBytes(first));
+    EXPECT_DOUBLE_EQ(stats.GetHitRate(), 0.5);
+
+    // 与不走缓存的构建结果一致
+    ExpectSameGeometry(second, Build(nullptr, blueprint.get()));
+}
+
+TEST_F(CSGResultCacheTest, KeyTracksParametersAndContent) {
+    CSG::CSGResultCache cache;
+    auto blueprint = Parse(kHollowCylinderJson);
+
+    const CSG::BuildResult base = Build(&cache, blueprint.get());
+    const CSG::BuildResult wider = Build(&cache, blueprint.get(), { { "radius", 5.0f } });
+    EXPECT_NE(base.meshes[0].mesh.get(), wider.meshes[0].mesh.get());
+
+    // 覆盖值等于默认值：解析后的参数相同，应命中
+    const CSG::BuildResult sameAsDefault = Build(&cache, blueprint.get(), { { "radius", 3.5f } });
+    EXPECT_EQ(base.meshes[0].mesh.get(), sameAsDefault.meshes[0].mesh.get());
+
+    // 内容变化（表达式不同）即使参数相同也不能命中
+    std::string modifiedJson = kHollowCylinderJson;
+    modifiedJson.replace(modifiedJson.find("$height + 1.0"), 13, "$height + 2.0");
+    auto modified = Parse(modifiedJson);
+    const CSG::BuildResult modifiedResult = Build(&cache, modified.get());
+    EXPECT_NE(base.meshes[0].mesh.get(), modifiedResult.meshes[0].mesh.get());
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.memoryHits, 1u);
+    EXPECT_EQ(stats.misses, 3u);
+}
+
+TEST_F(CSGResultCacheTest, RepeatedReferences_EvaluateOnce) {
+    constexpr int kCount = 200;
+    LoadIntoDatabase("cache_hollow_cylinder", kHollowCylinderJson);
+    auto row = Parse(MakeRowJson(kCount));
+
+    auto start = std::chrono::high_resolution_clock::now();
+    const CSG::BuildResult uncached = Build(nullptr, row.get());
+    const double uncachedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+
+    CSG::CSGResultCache cache;
+    start = std::chrono::high_resolution_clock::now();
+    const CSG::BuildResult cold = Build(&cache, row.get());
+    const double coldMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    const CSG::BuildResult warm = Build(&cache, row.get());
+    const double warmMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+
+    ASSERT_EQ(cold.meshes.size(), static_cast<size_t>(kCount));
+    ExpectSameGeometry(uncached, cold);
+    ExpectSameGeometry(uncached, warm);
+
+    // 外层 1 次未命中 + 部件 1 次未命中，其余 199 次引用命中；再次构建外层直接命中
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.memoryHits, static_cast<uint64_t>(kCount - 1) + 1u);
+    EXPECT_EQ(stats.entryCount, 2u);
+
+    std::printf("[Benchmark] CSG %d refs: uncached %.2f ms, cold cache %.2f ms, warm %.3f ms, "
+                "hit rate %.1f%%, %llu bytes\n",
+        kCount, uncachedMs, coldMs, warmMs, stats.GetHitRate() * 100.0,
+        static_cast<unsigned long long>(stats.memoryBytes));
+}
+
+TEST_F(CSGResultCacheTest, DiskTier_HitsAcrossInstances) {
+    LoadIntoDatabase("cache_hollow_cylinder", kHollowCylinderJson);
+    auto row = Parse(MakeRowJson(3));
+    const std::string cacheDir = (tempDir / "cache").string();
+
+    CSG::BuildResult original;
+    uint64_t bytesWritten = 0;
+    {
+        CSG::CSGResultCache cache;
+        cache.SetDiskDirectory(cacheDir);
+        original = Build(&cache, row.get());
+        bytesWritten = cache.GetStats().diskBytesWritten;
+        EXPECT_GT(bytesWritten, 0u);
+    }
+
+    // 模拟重启：新的缓存实例只有磁盘层
+    CSG::CSGResultCache restarted;
+    restarted.SetDiskDirectory(cacheDir);
+    const CSG::BuildResult reloaded = Build(&restarted, row.get());
+
+    const auto stats = restarted.GetStats();
+    EXPECT_EQ(stats.lookups, 1u);
+    EXPECT_EQ(stats.diskHits, 1u);
+    EXPECT_EQ(stats.misses, 0u);
+    EXPECT_GT(stats.diskBytesRead, 0u);
+    EXPECT_LE(stats.diskBytesRead, bytesWritten);
+    ExpectSameGeometry(original, reloaded);
+
+    // 磁盘命中后回填内存层
+    const CSG::BuildResult again = Build(&restarted, row.get());
+    EXPECT_EQ(reloaded.meshes[0].mesh.get(), again.meshes[0].mesh.get());
+    EXPECT_EQ(restarted.GetStats().memoryHits, 1u);
+}
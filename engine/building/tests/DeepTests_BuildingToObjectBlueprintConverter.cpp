@@ -442,7 +442,7 @@ TEST_F(BuildingToObjectBlueprintConverterDeepTest, CSG_UsesSubtractOperation) {
     std::function<bool(const json&)> findSubtract = [&](const json& node) -> bool {
         if (node.contains("operation")) {
             std::string op = node["operation"];
-            if (op == "subtract" || op == "difference") {
+            if (op == "subtract" || op == "subtract_all" || op == "difference") {
                 return true;
             }
         }
@@ -460,6 +460,11 @@ TEST_F(BuildingToObjectBlueprintConverterDeepTest, CSG_UsesSubtractOperation) {
         if (node.contains("right")) {
             if (findSubtract(node["right"])) return true;
         }
+        if (node.contains("operands") && node["operands"].is_array()) {
+            for (const auto& operand : node["operands"]) {
+                if (findSubtract(operand)) return true;
+            }
+        }
         
         return false;
     };
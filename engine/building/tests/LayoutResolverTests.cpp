@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include "building/LayoutOccupancyGrid.h"
+#include "building/LayoutResolver.h"
+#include "building/SemanticBuildingTypes.h"
+#include "TestHelpers.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Moon::Building;
+using namespace Moon::Building::Test;
+
+/**
+ * @brief Test fixture for LayoutResolver placement
+ */
+class LayoutResolverTest : public ::testing::Test {
+protected:
+    bool ResolveFixture(const std::string& json, bool useOccupancyGrid, BuildingDefinition& outDefinition) {
+        SemanticBuilding semantic;
+        if (!SemanticBuildingParser::ParseFromString(json, semantic, errorMsg)) {
+            return false;
+        }
+
+        LayoutResolver resolver;
+        resolver.SetUseOccupancyGrid(useOccupancyGrid);
+        return resolver.Resolve(semantic, outDefinition, errorMsg);
+    }
+
+    std::vector<std::pair<const char*, std::string>> MallAndOfficeFixtures() const {
+        return {
+            {"shopping_center", TestHelpers::CreateShoppingCenter()},
+            {"complex_shopping_mall", TestHelpers::LoadFromFile("complex_shopping_mall_demo.json")},
+            {"corporate_office_tower", TestHelpers::CreateCorporateOfficeTower()},
+            {"office_enterprise_tower", TestHelpers::LoadFromFile("office_enterprise_tower_demo.json")},
+        };
+    }
+
+    std::string errorMsg;
+};
+
+namespace {
+
+/**
+ * @brief Semantic program with many rooms per floor, so placement dominates resolve time
+ */
+std::string CreateLargeProgram(bool retail, int floors, int roomsPerFloor) {
+    const std::string roomType = retail ? "shop" : "office";
+    std::string json = std::string(R"({"schema": "moon_building", "grid": 0.5, "building_type": ")") +
+        (retail ? "shopping_center" : "office_tower") +
+        R"(", "style": {"category": ")" + (retail ? "retail" : "commercial") +
+        R"(", "facade": "glass", "roof": "flat", "window_style": "full_height", "material": "concrete"},)" +
+        R"( "mass": {"footprint_area": )" + std::to_string(roomsPerFloor * 60 + 900) +
+        R"(, "floors": )" + std::to_string(floors) + R"(}, "program": {"floors": [)";
+
+    for (int level = 0; level < floors; ++level) {
+        const std::string suffix = "_" + std::to_string(level);
+        const std::string hub = (retail ? "galleria" : "corridor") + suffix;
+        json += level == 0 ? "" : ",";
+        json += R"({"level": )" + std::to_string(level) + R"(, "name": "floor)" + suffix + R"(", "spaces": [)";
+        json += R"({"space_id": "core)" + suffix + R"(", "type": "core", "zone": "service", "area_preferred": 64, "constraints": {"min_width": 5.0}},)";
+        if (retail) {
+            json += R"({"space_id": "atrium)" + suffix + R"(", "type": "void", "zone": "public", "area_preferred": 300, "constraints": {"min_width": 12.0}},)";
+            json += R"({"space_id": ")" + hub + R"(", "type": "corridor", "zone": "circulation", "area_preferred": 400, "adjacency": [{"to": "atrium)" + suffix + R"(", "relationship": "around", "importance": "required"}], "constraints": {"min_width": 5.0}})";
+        } else {
+            json += R"({"space_id": ")" + hub + R"(", "type": "corridor", "zone": "circulation", "area_preferred": 180, "constraints": {"min_width": 2.0}})";
+        }
+        for (int room = 0; room < roomsPerFloor; ++room) {
+            const std::string id = roomType + suffix + "_" + std::to_string(room);
+            json += R"(, {"space_id": ")" + id + R"(", "type": ")" + roomType +
+                R"(", "zone": "public", "area_preferred": )" + std::to_string(30 + (room * 7) % 25) +
+                R"(, "adjacency": [{"to": ")" + hub + R"(", "relationship": "connected", "importance": "preferred"}], "constraints": {"min_width": 3.0}})";
+        }
+        json += "]}";
+    }
+    return json + "]}}";
+}
+
+bool LinearIsFree(const std::vector<std::pair<GridPos2D, GridSize2D>>& reserved,
+                  const GridPos2D& position, const GridSize2D& size) {
+    for (const auto& rect : reserved) {
+        if (LayoutOccupancyGrid::RectanglesOverlap(position, size, rect.first, rect.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_F(LayoutResolverTest, OccupancyGrid_MatchesLinearScan) {
+    constexpr float kCell = 0.5f;
+    const float width = 83.5f;   // Spans two bitset words
+    const float depth = 41.0f;
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> cellX(-4, 170);
+    std::uniform_int_distribution<int> cellY(-4, 85);
+    std::uniform_int_distribution<int> extent(1, 24);
+
+    LayoutOccupancyGrid grid;
+    grid.Reset(width, depth, kCell);
+    EXPECT_EQ(grid.GetCellsX(), 167);
+    EXPECT_EQ(grid.GetCellsY(), 82);
+
+    std::vector<std::pair<GridPos2D, GridSize2D>> reserved;
+    for (int step = 0; step < 60; ++step) {
+        GridPos2D origin = {cellX(rng) * kCell, cellY(rng) * kCell};
+        GridSize2D size = {extent(rng) * kCell, extent(rng) * kCell};
+        if (step == 40) {
+            // Off-grid and degenerate rects take the exact fallback path
+            origin = {10.25f, 3.1f};
+            size = {2.2f, 0.0f};
+        }
+        grid.Reserve(origin, size);
+        reserved.emplace_back(origin, size);
+
+        for (int query = 0; query < 200; ++query) {
+            const GridPos2D position = {cellX(rng) * kCell, cellY(rng) * kCell};
+            const GridSize2D querySize = {extent(rng) * kCell, extent(rng) * kCell};
+            ASSERT_EQ(grid.IsFree(position, querySize), LinearIsFree(reserved, position, querySize))
+                << "step " << step << " at (" << position[0] << ", " << position[1] << ")";
+        }
+
+        const GridSize2D fitSize = {extent(rng) * kCell, extent(rng) * kCell};
+        GridPos2D expected = {0.0f, 0.0f};
+        bool expectedFound = false;
+        for (float y = 0.0f; y <= depth - fitSize[1] + 0.001f && !expectedFound; y += kCell) {
+            for (float x = 0.0f; x <= width - fitSize[0] + 0.001f; x += kCell) {
+                if (LinearIsFree(reserved, {x, y}, fitSize)) {
+                    expected = {x, y};
+                    expectedFound = true;
+                    break;
+                }
+            }
+        }
+
+        GridPos2D actual = {-1.0f, -1.0f};
+        ASSERT_EQ(grid.FindFirstFit(fitSize, actual), expectedFound) << "step " << step;
+        if (expectedFound) {
+            EXPECT_EQ(actual, expected) << "step " << step;
+        }
+    }
+}
+
+TEST_F(LayoutResolverTest, Resolve_OccupancyGridMatchesLinearScan) {
+    auto fixtures = MallAndOfficeFixtures();
+    fixtures.emplace_back("large_mall", CreateLargeProgram(true, 2, 40));
+    fixtures.emplace_back("large_office", CreateLargeProgram(false, 2, 40));
+
+    for (const auto& entry : fixtures) {
+        SCOPED_TRACE(entry.first);
+        ASSERT_FALSE(entry.second.empty());
+
+        BuildingDefinition linear;
+        BuildingDefinition indexed;
+        ASSERT_TRUE(ResolveFixture(entry.second, false, linear)) << errorMsg;
+        ASSERT_TRUE(ResolveFixture(entry.second, true, indexed)) << errorMsg;
+
+        ASSERT_EQ(linear.floors.size(), indexed.floors.size());
+        for (size_t f = 0; f < linear.floors.size(); ++f) {
+            const auto& a = linear.floors[f].spaces;
+            const auto& b = indexed.floors[f].spaces;
+            ASSERT_EQ(a.size(), b.size()) << "floor " << f;
+            for (size_t s = 0; s < a.size(); ++s) {
+                EXPECT_EQ(a[s].spaceId, b[s].spaceId);
+                ASSERT_EQ(a[s].rects.size(), b[s].rects.size());
+                for (size_t r = 0; r < a[s].rects.size(); ++r) {
+                    EXPECT_EQ(a[s].rects[r].origin, b[s].rects[r].origin) << a[s].rects[r].rectId;
+                    EXPECT_EQ(a[s].rects[r].size, b[s].rects[r].size) << a[s].rects[r].rectId;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(LayoutResolverTest, Benchmark_MallAndOfficePlacement) {
+    constexpr int kIterations = 10;
+
+    auto fixtures = MallAndOfficeFixtures();
+    fixtures.emplace_back("large_mall", CreateLargeProgram(true, 4, 60));
+    fixtures.emplace_back("large_office", CreateLargeProgram(false, 4, 60));
+
+    for (const auto& entry : fixtures) {
+        auto timeResolve = [&](bool useOccupancyGrid) {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < kIterations; ++i) {
+                BuildingDefinition definition;
+                EXPECT_TRUE(ResolveFixture(entry.second, useOccupancyGrid, definition)) << errorMsg;
+            }
+            return std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count() / kIterations;
+        };
+
+        const double linearMs = timeResolve(false);
+        const double gridMs = timeResolve(true);
+        std::printf("[Benchmark] %-24s resolve: linear scan %.3f ms, occupancy grid %.3f ms\n",
+            entry.first, linearMs, gridMs);
+    }
+}
@@ -1,8 +1,15 @@
 #include <gtest/gtest.h>
+#include "building/BuildingIndex.h"
+#include "building/BuildingTaskPool.h"
 #include "building/LayoutValidator.h"
 #include "building/SchemaValidator.h"
 #include "building/BuildingTypes.h"
 #include "TestHelpers.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <utility>
 
 using namespace Moon::Building;
 using namespace Moon::Building::Test;
@@ -76,7 +83,8 @@ TEST_F(LayoutValidatorTest, OverlappingSpaces_Fails) {
         "mass_1",
         {0.0f, 0.0f},
         {20.0f, 20.0f},
-        1
+        1,
+        ""
     });
     
     Floor floor;
@@ -118,7 +126,8 @@ TEST_F(LayoutValidatorTest, SpaceOutsideMass_Fails) {
         "mass_1",
         {0.0f, 0.0f},
         {10.0f, 10.0f},
-        1
+        1,
+        ""
     });
     
     Floor floor;
@@ -150,7 +159,8 @@ TEST_F(LayoutValidatorTest, TooSmallRoom_Fails) {
         "mass_1",
         {0.0f, 0.0f},
         {10.0f, 10.0f},
-        1
+        1,
+        ""
     });
     
     Floor floor;
@@ -181,7 +191,8 @@ TEST_F(LayoutValidatorTest, InvalidMassReference_Fails) {
         "mass_1",
         {0.0f, 0.0f},
         {10.0f, 10.0f},
-        1
+        1,
+        ""
     });
     
     Floor floor;
@@ -208,7 +219,8 @@ TEST_F(LayoutValidatorTest, CustomMinimumRoomSize) {
         "mass_1",
         {0.0f, 0.0f},
         {10.0f, 10.0f},
-        1
+        1,
+        ""
     });
     
     Floor floor;
@@ -231,3 +243,153 @@ TEST_F(LayoutValidatorTest, CustomMinimumRoomSize) {
     
     EXPECT_FALSE(result.valid) << "Should fail with custom minimum 3m x 3m";
 }
+
+// ========================================
+// Spatial Index / Stress Tests
+// ========================================
+
+namespace {
+
+/**
+ * @brief Tall building with a regular room grid per floor
+ * Every 7th floor gets one room shifted onto its neighbour (an overlap), and
+ * every 11th floor one room pushed outside the mass.
+ */
+BuildingDefinition CreateStressDefinition(int floorCount, int roomsPerSide) {
+    constexpr float kRoom = 4.0f;
+    BuildingDefinition definition;
+    definition.grid = 0.5f;
+    definition.masses.push_back({"tower", {0.0f, 0.0f}, {kRoom * roomsPerSide, kRoom * roomsPerSide}, floorCount, ""});
+
+    int nextSpaceId = 1;
+    for (int level = 0; level < floorCount; ++level) {
+        Floor floor;
+        floor.level = level;
+        floor.massId = "tower";
+        floor.floorHeight = 3.5f;
+        for (int y = 0; y < roomsPerSide; ++y) {
+            for (int x = 0; x < roomsPerSide; ++x) {
+                Space space;
+                space.spaceId = nextSpaceId++;
+                space.rects.push_back({"r" + std::to_string(space.spaceId),
+                                       {x * kRoom, y * kRoom}, {kRoom, kRoom}});
+                floor.spaces.push_back(space);
+            }
+        }
+        if (level % 7 == 3) {
+            floor.spaces[5].rects[0].origin[0] += kRoom * 0.5f;
+        }
+        if (level % 11 == 5) {
+            floor.spaces.back().rects[0].origin[1] += kRoom;
+        }
+        definition.floors.push_back(floor);
+    }
+    return definition;
+}
+
+size_t CountOverlapsPairwise(const BuildingDefinition& definition) {
+    size_t overlaps = 0;
+    for (const auto& floor : definition.floors) {
+        std::vector<std::pair<int, const Rect*>> rects;
+        for (const auto& space : floor.spaces) {
+            for (const auto& rect : space.rects) {
+                rects.emplace_back(space.spaceId, &rect);
+            }
+        }
+        for (size_t i = 0; i < rects.size(); ++i) {
+            for (size_t j = i + 1; j < rects.size(); ++j) {
+                const Rect& a = *rects[i].second;
+                const Rect& b = *rects[j].second;
+                if (rects[i].first != rects[j].first &&
+                    !(a.origin[0] + a.size[0] <= b.origin[0] + 0.001f ||
+                      b.origin[0] + b.size[0] <= a.origin[0] + 0.001f ||
+                      a.origin[1] + a.size[1] <= b.origin[1] + 0.001f ||
+                      b.origin[1] + b.size[1] <= a.origin[1] + 0.001f)) {
+                    ++overlaps;
+                }
+            }
+        }
+    }
+    return overlaps;
+}
+
+size_t CountErrorsContaining(const ValidationResult& result, const std::string& text) {
+    size_t count = 0;
+    for (const auto& error : result.errors) {
+        count += error.find(text) != std::string::npos ? 1 : 0;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST_F(LayoutValidatorTest, FloorRectIndex_QueryMatchesBruteForce) {
+    const BuildingDefinition stress = CreateStressDefinition(3, 12);
+    BuildingIndex index;
+    index.BuildFloorRectIndex(stress);
+    ASSERT_EQ(index.GetIndexedFloorLevels().size(), 3u);
+
+    std::vector<uint32_t> candidates;
+    for (int level : index.GetIndexedFloorLevels()) {
+        const auto& entries = index.GetFloorRects(level);
+        ASSERT_EQ(entries.size(), 144u);
+        for (float qx = -6.0f; qx < 54.0f; qx += 3.7f) {
+            for (float qy = -6.0f; qy < 54.0f; qy += 5.3f) {
+                const GridPos2D minCorner = {qx, qy};
+                const GridPos2D maxCorner = {qx + 6.5f, qy + 2.5f};
+                index.QueryFloorRects(level, minCorner, maxCorner, candidates);
+
+                // Every rect that touches the box must be a candidate
+                for (uint32_t i = 0; i < entries.size(); ++i) {
+                    const Rect& rect = *entries[i].rect;
+                    const bool touches = rect.origin[0] <= maxCorner[0] && rect.origin[0] + rect.size[0] >= minCorner[0] &&
+                                         rect.origin[1] <= maxCorner[1] && rect.origin[1] + rect.size[1] >= minCorner[1];
+                    if (touches) {
+                        EXPECT_TRUE(std::binary_search(candidates.begin(), candidates.end(), i))
+                            << "level " << level << " rect " << rect.rectId;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(LayoutValidatorTest, StressBuilding_IndexedOverlapsMatchPairwiseScan) {
+    const BuildingDefinition stress = CreateStressDefinition(100, 8);
+
+    const ValidationResult serial = validator.Validate(stress);
+    EXPECT_FALSE(serial.valid);
+    EXPECT_EQ(CountErrorsContaining(serial, "Overlap detected"), CountOverlapsPairwise(stress));
+    EXPECT_GT(CountErrorsContaining(serial, "Overlap detected"), 0u);
+    EXPECT_EQ(CountErrorsContaining(serial, "extends outside mass"), 9u);
+
+    BuildingTaskPool pool(4);
+    const ValidationResult parallel = validator.Validate(stress, &pool);
+    EXPECT_EQ(parallel.valid, serial.valid);
+    EXPECT_EQ(parallel.errors, serial.errors);
+    EXPECT_EQ(parallel.warnings, serial.warnings);
+}
+
+TEST_F(LayoutValidatorTest, Benchmark_HundredFloorStressBuilding) {
+    constexpr int kIterations = 5;
+    const BuildingDefinition stress = CreateStressDefinition(100, 10);
+    BuildingTaskPool pool(0);
+
+    auto timeMs = [&](const std::function<void()>& run) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i) {
+            run();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kIterations;
+    };
+
+    size_t pairwiseOverlaps = 0;
+    const double pairwiseMs = timeMs([&]() { pairwiseOverlaps = CountOverlapsPairwise(stress); });
+    const double serialMs = timeMs([&]() { validator.Validate(stress); });
+    const double parallelMs = timeMs([&]() { validator.Validate(stress, &pool); });
+    EXPECT_GT(pairwiseOverlaps, 0u);
+
+    std::printf("[Benchmark] 100 floors x 100 rects: pairwise overlap scan alone %.3f ms, "
+                "indexed Validate serial %.3f ms, parallel (%zu workers) %.3f ms\n",
+                pairwiseMs, serialMs, pool.GetWorkerCount(), parallelMs);
+}
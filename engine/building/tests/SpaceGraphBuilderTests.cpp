@@ -1,4 +1,9 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <set>
+#include <utility>
 #include "building/SpaceGraphBuilder.h"
 #include "building/SchemaValidator.h"
 #include "building/BuildingTypes.h"
@@ -7,6 +12,64 @@
 using namespace Moon::Building;
 using namespace Moon::Building::Test;
 
+namespace {
+
+/**
+ * @brief Generate identical office-like floors: staggered rooms plus a corridor per row
+ * Staggered rows and full-width corridors create many T-junctions.
+ */
+BuildingDefinition CreateStaggeredFloors(int floorCount, int roomsPerRow, int rowCount) {
+    BuildingDefinition definition;
+    definition.grid = GRID_SIZE;
+    int nextSpaceId = 1;
+    for (int level = 0; level < floorCount; ++level) {
+        Floor floor;
+        floor.level = level;
+        floor.floorHeight = 3.5f;
+        for (int row = 0; row < rowCount; ++row) {
+            const float rowY = row * 5.0f;
+            const float offset = (row % 2 == 0) ? 0.0f : 1.5f;
+            for (int i = 0; i < roomsPerRow; ++i) {
+                Space room;
+                room.spaceId = nextSpaceId++;
+                room.rects.push_back({"room", {offset + i * 3.0f, rowY}, {3.0f, 3.0f}});
+                floor.spaces.push_back(room);
+            }
+            Space corridor;
+            corridor.spaceId = nextSpaceId++;
+            corridor.rects.push_back({"corridor", {0.0f, rowY + 3.0f}, {roomsPerRow * 3.0f + 1.5f, 2.0f}});
+            floor.spaces.push_back(corridor);
+        }
+        definition.floors.push_back(floor);
+    }
+    return definition;
+}
+
+/**
+ * @brief Reference adjacency: any pair of rect edges of two spaces overlapping by more than 0.1m
+ */
+std::set<std::pair<int, int>> BruteForceAdjacentSpaces(const BuildingDefinition& definition) {
+    std::vector<EdgeInfo> edges = EdgeTopologyBuilder::ExtractEdges(definition);
+    std::set<std::pair<int, int>> adjacent;
+    for (size_t i = 0; i < edges.size(); ++i) {
+        for (size_t j = i + 1; j < edges.size(); ++j) {
+            const EdgeInfo& a = edges[i];
+            const EdgeInfo& b = edges[j];
+            if (a.spaceId == b.spaceId || a.floorLevel != b.floorLevel) continue;
+            if (a.IsHorizontal() != b.IsHorizontal()) continue;
+            const int axis = a.IsHorizontal() ? 0 : 1;
+            if (std::abs(a.start[1 - axis] - b.start[1 - axis]) > 0.001f) continue;
+            const float overlap = std::min(a.end[axis], b.end[axis]) - std::max(a.start[axis], b.start[axis]);
+            if (overlap > 0.1f) {
+                adjacent.insert({std::min(a.spaceId, b.spaceId), std::max(a.spaceId, b.spaceId)});
+            }
+        }
+    }
+    return adjacent;
+}
+
+} // namespace
+
 /**
  * @brief Test fixture for SpaceGraphBuilder
  */
@@ -263,3 +326,80 @@ TEST_F(SpaceGraphBuilderTest, SingleSpace_NoSelfConnection) {
         EXPECT_NE(conn.spaceA, conn.spaceB) << "Space should not connect to itself";
     }
 }
+
+// ========================================
+// Sweep-line adjacency
+// ========================================
+
+TEST_F(SpaceGraphBuilderTest, SweepAdjacency_MatchesPairwiseScan) {
+    definition = CreateStaggeredFloors(3, 6, 4);
+    graphBuilder.BuildGraph(definition, connections);
+
+    std::set<std::pair<int, int>> found;
+    for (const auto& adj : graphBuilder.GetAdjacencies()) {
+        EXPECT_TRUE(found.insert({std::min(adj.spaceA, adj.spaceB), std::max(adj.spaceA, adj.spaceB)}).second)
+            << "Duplicate adjacency " << adj.spaceA << "-" << adj.spaceB;
+    }
+    EXPECT_EQ(found, BruteForceAdjacentSpaces(definition));
+    EXPECT_EQ(connections.size(), found.size());
+}
+
+TEST_F(SpaceGraphBuilderTest, SweepCandidates_CoverAllCollinearPairs) {
+    std::vector<EdgeInfo> edges = EdgeTopologyBuilder::ExtractEdges(CreateStaggeredFloors(2, 4, 3));
+    // Off-grid lines straddling a rounding boundary, and a diagonal edge
+    edges.push_back({{0.0f, 0.2499f}, {2.0f, 0.2499f}, 900, 0, 3.0f, false});
+    edges.push_back({{1.0f, 0.2505f}, {3.0f, 0.2505f}, 901, 0, 3.0f, false});
+    edges.push_back({{0.0f, 0.0f}, {1.0f, 1.0f}, 902, 0, 3.0f, false});
+
+    const auto candidates = EdgeTopologyBuilder::FindCandidatePairs(edges);
+    ASSERT_TRUE(std::is_sorted(candidates.begin(), candidates.end()));
+    const std::set<std::pair<size_t, size_t>> candidateSet(candidates.begin(), candidates.end());
+    EXPECT_EQ(candidateSet.size(), candidates.size());
+
+    for (size_t i = 0; i < edges.size(); ++i) {
+        for (size_t j = i + 1; j < edges.size(); ++j) {
+            const EdgeInfo& a = edges[i];
+            const EdgeInfo& b = edges[j];
+            if (a.floorLevel != b.floorLevel) continue;
+            const bool irregular = !(a.IsHorizontal() ^ a.IsVertical()) || !(b.IsHorizontal() ^ b.IsVertical());
+            bool touching = irregular;
+            if (!irregular && a.IsHorizontal() == b.IsHorizontal()) {
+                const int axis = a.IsHorizontal() ? 0 : 1;
+                touching = std::abs(a.start[1 - axis] - b.start[1 - axis]) <= 0.001f &&
+                    std::min(a.end[axis], b.end[axis]) >= std::max(a.start[axis], b.start[axis]);
+            }
+            if (touching) {
+                EXPECT_TRUE(candidateSet.count({i, j}) > 0) << "Missing candidate pair " << i << ", " << j;
+            }
+        }
+    }
+}
+
+TEST_F(SpaceGraphBuilderTest, Benchmark_AdjacencyScaling_Floors) {
+    // Identical floors: with per-floor buckets the work grows linearly with floor count
+    const BuildingDefinition singleFloor = CreateStaggeredFloors(1, 25, 8);
+    const size_t pairsPerFloor = EdgeTopologyBuilder::FindCandidatePairs(
+        EdgeTopologyBuilder::BuildTopology(singleFloor)).size();
+    graphBuilder.BuildGraph(singleFloor, connections);
+    const size_t adjacenciesPerFloor = graphBuilder.GetAdjacencies().size();
+    ASSERT_GT(adjacenciesPerFloor, 0u);
+
+    for (int floors : {1, 10, 40, 100}) {
+        const BuildingDefinition tower = CreateStaggeredFloors(floors, 25, 8);
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        SpaceGraphBuilder builder;
+        std::vector<SpaceConnection> towerConnections;
+        builder.BuildGraph(tower, towerConnections);
+        const double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count();
+
+        const std::vector<EdgeInfo> edges = EdgeTopologyBuilder::BuildTopology(tower);
+        const size_t pairs = EdgeTopologyBuilder::FindCandidatePairs(edges).size();
+        EXPECT_EQ(pairs, pairsPerFloor * floors);
+        EXPECT_EQ(builder.GetAdjacencies().size(), adjacenciesPerFloor * floors);
+
+        std::printf("[Benchmark] %3d floors, %6zu edges: BuildGraph %8.2f ms (%.3f ms/floor), %zu candidate pairs\n",
+            floors, edges.size(), ms, ms / floors, pairs);
+    }
+}
@@ -4,6 +4,9 @@
 #include "building/SchemaValidator.h"
 #include "building/BuildingTypes.h"
 #include "TestHelpers.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
 
 using namespace Moon::Building;
 using namespace Moon::Building::Test;
@@ -376,3 +379,118 @@ TEST_F(WallGeneratorTest, WallThickness_AffectsPosition) {
         // (exact position depends on implementation)
     }
 }
+
+// ========================================
+// Collinear Merge Indexing Tests
+// ========================================
+
+namespace {
+
+/**
+ * @brief Synthetic floor plan: rows of two-rect spaces, odd rows staggered by one rect
+ * Each space splits its long sides into collinear segments with identical owners, and the
+ * stagger puts T-junctions on every row boundary, so the collinear merge does real work.
+ */
+BuildingDefinition CreateGridPlan(int floors, int rows, int columns) {
+    constexpr float kRectSize = 2.0f;
+
+    BuildingDefinition definition;
+    definition.schema = "moon_building";
+    definition.grid = 0.5f;
+    for (int level = 0; level < floors; ++level) {
+        Floor floor;
+        floor.level = level;
+        floor.massId = "main";
+        floor.floorHeight = 3.0f;
+        for (int row = 0; row < rows; ++row) {
+            const float offset = (row % 2 == 1) ? kRectSize : 0.0f;
+            for (int column = 0; column < columns; ++column) {
+                Space space;
+                space.spaceId = level * 100000 + row * columns + column + 1;
+                for (int part = 0; part < 2; ++part) {
+                    Rect rect;
+                    rect.rectId = "r" + std::to_string(part);
+                    rect.origin = {offset + (column * 2 + part) * kRectSize, row * kRectSize};
+                    rect.size = {kRectSize, kRectSize};
+                    space.rects.push_back(rect);
+                }
+                floor.spaces.push_back(space);
+            }
+        }
+        definition.floors.push_back(floor);
+    }
+    return definition;
+}
+
+} // namespace
+
+TEST_F(WallGeneratorTest, EndpointIndexMerge_MatchesPairwiseScan) {
+    std::vector<std::pair<std::string, BuildingDefinition>> fixtures;
+    for (const auto& json : {TestHelpers::CreateSimpleRoom(), TestHelpers::CreateVilla(),
+                             TestHelpers::CreateApartmentBuilding()}) {
+        SchemaValidator validator;
+        std::string errorMsg;
+        BuildingDefinition parsed;
+        ASSERT_TRUE(validator.ValidateAndParse(json, parsed, errorMsg)) << errorMsg;
+        fixtures.emplace_back("fixture_" + std::to_string(fixtures.size()), parsed);
+    }
+    fixtures.emplace_back("grid_plan", CreateGridPlan(2, 6, 5));
+
+    for (const auto& entry : fixtures) {
+        SCOPED_TRACE(entry.first);
+        std::vector<SpaceConnection> fixtureConnections;
+        SpaceGraphBuilder graph;
+        graph.BuildGraph(entry.second, fixtureConnections);
+
+        std::vector<WallSegment> pairwise;
+        std::vector<WallSegment> indexed;
+        wallGenerator.SetUseEndpointIndex(false);
+        wallGenerator.GenerateWalls(entry.second, graph, pairwise);
+        wallGenerator.SetUseEndpointIndex(true);
+        wallGenerator.GenerateWalls(entry.second, graph, indexed);
+
+        ASSERT_FALSE(indexed.empty());
+        ASSERT_EQ(pairwise.size(), indexed.size());
+        for (size_t i = 0; i < pairwise.size(); ++i) {
+            EXPECT_EQ(pairwise[i].wallId, indexed[i].wallId);
+            EXPECT_EQ(pairwise[i].start, indexed[i].start) << "wall " << i;
+            EXPECT_EQ(pairwise[i].end, indexed[i].end) << "wall " << i;
+            EXPECT_EQ(pairwise[i].type, indexed[i].type) << "wall " << i;
+            EXPECT_EQ(pairwise[i].spaceId, indexed[i].spaceId) << "wall " << i;
+            EXPECT_EQ(pairwise[i].neighborSpaceId, indexed[i].neighborSpaceId) << "wall " << i;
+            EXPECT_EQ(pairwise[i].floorLevel, indexed[i].floorLevel) << "wall " << i;
+            EXPECT_FLOAT_EQ(pairwise[i].height, indexed[i].height) << "wall " << i;
+        }
+    }
+}
+
+TEST_F(WallGeneratorTest, Benchmark_TenThousandWallPlan) {
+    auto timeGenerate = [&](const BuildingDefinition& plan, bool useEndpointIndex, size_t& outWalls) {
+        std::vector<SpaceConnection> planConnections;
+        SpaceGraphBuilder graph;
+        graph.BuildGraph(plan, planConnections);
+
+        std::vector<WallSegment> planWalls;
+        wallGenerator.SetUseEndpointIndex(useEndpointIndex);
+        const auto start = std::chrono::steady_clock::now();
+        wallGenerator.GenerateWalls(plan, graph, planWalls);
+        outWalls = planWalls.size();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    // The pairwise scan is quadratic per merge, so it only runs on the small plan
+    const BuildingDefinition small = CreateGridPlan(2, 10, 10);
+    const BuildingDefinition large = CreateGridPlan(10, 25, 20);
+
+    size_t smallWalls = 0;
+    size_t largeWalls = 0;
+    const double smallPairwiseMs = timeGenerate(small, false, smallWalls);
+    const double smallIndexedMs = timeGenerate(small, true, smallWalls);
+    const double largeIndexedMs = timeGenerate(large, true, largeWalls);
+    EXPECT_GE(largeWalls, 10000u);
+
+    std::printf("[Benchmark] GenerateWalls %zu walls: pairwise merge %.3f ms, endpoint index %.3f ms\n",
+        smallWalls, smallPairwiseMs, smallIndexedMs);
+    std::printf("[Benchmark] GenerateWalls %zu walls: endpoint index %.3f ms\n",
+        largeWalls, largeIndexedMs);
+}
@@ -65,5 +65,14 @@ inline std::string BuildTexturePath(const std::string& path)
     return BuildAssetPath("textures/" + normalized);
 }
 
+inline std::string BuildMassingPath(const std::string& path)
+{
+    std::string normalized = NormalizeSlashes(path);
+    if (IsAbsolutePath(normalized) || normalized.rfind("assets/", 0) == 0 || normalized.rfind("massing/", 0) == 0) {
+        return BuildAssetPath(normalized);
+    }
+    return BuildAssetPath("massing/" + normalized);
+}
+
 } // namespace Assets
 } // namespace Moon
@@ -1,5 +1,6 @@
 #include "CSGBuilder.h"
 #include "CSGOperations.h"
+#include "CSGResultCache.h"
 #include "../Geometry/PathMeshBuilder.h"
 #include "../Logging/Logger.h"
 #include "../../objects/Stairs/StairMeshGenerator.h"
@@ -14,8 +15,32 @@ namespace CSG {
 using namespace Moon::Object;
 using namespace Moon::Geometry;
 
+namespace {
+
+// Copy a mesh with its world transform applied (rotation, then scale, then position)
+std::shared_ptr<Mesh> BakeWorldTransform(const MeshItem& item) {
+    std::vector<Vertex> transformedVertices = item.mesh->GetVertices();
+    for (auto& vertex : transformedVertices) {
+        Vector3 rotated = item.worldTransform.rotation * vertex.position;
+        Vector3 scaled(
+            rotated.x * item.worldTransform.scale.x,
+            rotated.y * item.worldTransform.scale.y,
+            rotated.z * item.worldTransform.scale.z
+        );
+        vertex.position = scaled + item.worldTransform.position;
+    }
+
+    auto transformed = std::make_shared<Mesh>();
+    transformed->SetVertices(std::move(transformedVertices));
+    transformed->SetIndices(item.mesh->GetIndices());
+    return transformed;
+}
+
+} // namespace
+
 CSGBuilder::CSGBuilder() 
-    : m_database(nullptr) {
+    : m_database(nullptr)
+    , m_resultCache(&CSGResultCache::GetShared()) {
 }
 
 CSGBuilder::~CSGBuilder() {
@@ -30,17 +55,19 @@ BuildResult CSGBuilder::Build(const Blueprint* blueprint,
         return BuildResult();
     }
 
-    // 创建根参数作用域
-    ParameterScope rootScope;
-
-    // 填充默认参数值
+    // 解析根参数：默认值 + 覆盖
+    std::unordered_map<std::string, float> resolvedParameters;
     for (const auto& param : blueprint->GetParameters()) {
-        rootScope.SetValue(param.first, param.second.defaultValue);
+        resolvedParameters[param.first] = param.second.defaultValue;
     }
-
-    // 应用参数覆盖
     for (const auto& override : parameterOverrides) {
-        rootScope.SetValue(override.first, override.second);
+        resolvedParameters[override.first] = override.second;
+    }
+
+    // 创建根参数作用域
+    ParameterScope rootScope;
+    for (const auto& param : resolvedParameters) {
+        rootScope.SetValue(param.first, param.second);
     }
 
     // 构建根节点
@@ -51,6 +78,24 @@ BuildResult CSGBuilder::Build(const Blueprint* blueprint,
         return BuildResult();
     }
 
+    // 结果缓存：键包含是否做 FlatShading（仅最外层构建会做）与求值方式
+    // Blueprint 内容哈希只在一次最外层构建内复用，构建之间 Blueprint 可能被修改
+    uint64_t cacheKey = 0;
+    bool cacheable = false;
+    if (m_resultCache) {
+        if (m_buildDepth == 0 || !m_cacheKeyBuilder) {
+            m_cacheKeyBuilder = std::make_unique<CSGCacheKeyBuilder>(m_database);
+        }
+        cacheable = outError.empty() &&
+            m_cacheKeyBuilder->ComputeKey(blueprint, resolvedParameters, m_buildDepth == 0,
+                static_cast<uint32_t>(m_evaluationMode), cacheKey);
+
+        BuildResult cached;
+        if (cacheable && m_resultCache->Lookup(cacheKey, cached)) {
+            return cached;
+        }
+    }
+
     m_buildDepth++;
     BuildResult result = BuildNode(rootNode, rootScope, outError);
     m_buildDepth--;
@@ -71,6 +116,11 @@ BuildResult CSGBuilder::Build(const Blueprint* blueprint,
             }
         }
     }
+
+    // 只缓存无错误的结果（错误通过 outError 传递，不会中断构建）
+    if (cacheable && outError.empty()) {
+        m_resultCache->Store(cacheKey, result);
+    }
     
     return result;
 }
@@ -106,129 +156,110 @@ BuildResult CSGBuilder::BuildNode(const Node* node, ParameterScope& scope, std::
     }
 }
 
-BuildResult CSGBuilder::BuildPrimitive(const PrimitiveNode* prim, ParameterScope& scope, std::string& outError) {
-    if (!prim) {
-        outError = "PrimitiveNode is null";
-        return BuildResult();
-    }
-
-    std::shared_ptr<Mesh> mesh;
+bool CSGBuilder::ResolvePrimitiveShape(const PrimitiveNode* prim, ParameterScope& scope,
+                                       PrimitiveShape& outShape, std::string& outError) {
+    // JSON 单位为 cm，转换为引擎单位（米）
+    static constexpr float CM_TO_M = 0.01f;
 
-    // 解析 Transform
-    Vector3 position, scale;
-    Quaternion rotation;
-    ResolveTransform(prim->localTransform, scope, position, rotation, scale, outError);
+    auto resolveParam = [&](const char* name, float& value) {
+        auto it = prim->params.find(name);
+        if (it != prim->params.end()) {
+            value = ResolveValue(it->second, scope, outError);
+        }
+    };
 
-    // 根据基础几何体类型创建 Mesh
     switch (prim->primitive) {
         case PrimitiveType::Cube: {
             // 解析参数：支持size（正方体）或size_x/size_y/size_z（长方体）
-            float size_x = 1.0f;
-            float size_y = 1.0f;
-            float size_z = 1.0f;
-            
-            auto itSize = prim->params.find("size");
-            if (itSize != prim->params.end()) {
-                float size = ResolveValue(itSize->second, scope, outError);
-                size_x = size_y = size_z = size;
-            }
-            
-            auto itSizeX = prim->params.find("size_x");
-            if (itSizeX != prim->params.end()) {
-                size_x = ResolveValue(itSizeX->second, scope, outError);
-            }
-            
-            auto itSizeY = prim->params.find("size_y");
-            if (itSizeY != prim->params.end()) {
-                size_y = ResolveValue(itSizeY->second, scope, outError);
-            }
-            
-            auto itSizeZ = prim->params.find("size_z");
-            if (itSizeZ != prim->params.end()) {
-                size_z = ResolveValue(itSizeZ->second, scope, outError);
-            }
-
-            // JSON 单位为 cm，转换为引擎单位（米）
-            static constexpr float CM_TO_M = 0.01f;
-            mesh = CreateCSGBox(size_x * CM_TO_M, size_y * CM_TO_M, size_z * CM_TO_M,
-                Vector3(0, 0, 0),  // Keep mesh at origin, position applied via worldTransform
-                Vector3(0, 0, 0), // rotation 将通过四元数应用
-                Vector3(1, 1, 1),  // scale applied via worldTransform
-                false); // flatShading = false for CSG operations
-
-            break;
+            float size = 1.0f;
+            resolveParam("size", size);
+            float size_x = size;
+            float size_y = size;
+            float size_z = size;
+            resolveParam("size_x", size_x);
+            resolveParam("size_y", size_y);
+            resolveParam("size_z", size_z);
+
+            outShape.type = PrimitiveShape::Type::Box;
+            outShape.size = Vector3(size_x * CM_TO_M, size_y * CM_TO_M, size_z * CM_TO_M);
+            return true;
         }
 
         case PrimitiveType::Sphere: {
             float radius = 1.0f;
-            auto it = prim->params.find("radius");
-            if (it != prim->params.end()) {
-                radius = ResolveValue(it->second, scope, outError);
-            }
-
-            static constexpr float CM_TO_M = 0.01f;
-            mesh = CreateCSGSphere(radius * CM_TO_M, 32,
-                Vector3(0, 0, 0),  // Keep mesh at origin, position applied via worldTransform
-                Vector3(0, 0, 0),
-                Vector3(1, 1, 1),  // scale applied via worldTransform
-                false);
+            resolveParam("radius", radius);
 
-            break;
+            outShape.type = PrimitiveShape::Type::Sphere;
+            outShape.radius = radius * CM_TO_M;
+            return true;
         }
 
-        case PrimitiveType::Cylinder: {
+        case PrimitiveType::Cylinder:
+        case PrimitiveType::Cone: {
             float radius = 1.0f;
             float height = 2.0f;
-            
-            auto itRadius = prim->params.find("radius");
-            if (itRadius != prim->params.end()) {
-                radius = ResolveValue(itRadius->second, scope, outError);
-            }
-            
-            auto itHeight = prim->params.find("height");
-            if (itHeight != prim->params.end()) {
-                height = ResolveValue(itHeight->second, scope, outError);
-            }
-
-            static constexpr float CM_TO_M = 0.01f;
-            mesh = CreateCSGCylinder(radius * CM_TO_M, height * CM_TO_M, 32,
-                Vector3(0, 0, 0),  // Keep mesh at origin, position applied via worldTransform
-                Vector3(0, 0, 0),
-                Vector3(1, 1, 1),  // scale applied via worldTransform
-                false);
+            resolveParam("radius", radius);
+            resolveParam("height", height);
+
+            outShape.type = prim->primitive == PrimitiveType::Cylinder
+                ? PrimitiveShape::Type::Cylinder
+                : PrimitiveShape::Type::Cone;
+            outShape.radius = radius * CM_TO_M;
+            outShape.height = height * CM_TO_M;
+            return true;
+        }
 
+        case PrimitiveType::Capsule:
+        case PrimitiveType::Torus:
             break;
-        }
+    }
 
-        case PrimitiveType::Cone: {
-            float radius = 1.0f;
-            float height = 2.0f;
-            
-            auto itRadius = prim->params.find("radius");
-            if (itRadius != prim->params.end()) {
-                radius = ResolveValue(itRadius->second, scope, outError);
-            }
-            
-            auto itHeight = prim->params.find("height");
-            if (itHeight != prim->params.end()) {
-                height = ResolveValue(itHeight->second, scope, outError);
-            }
+    outError = "Primitive type not yet implemented";
+    MOON_LOG_WARN("CSGBuilder", "%s", outError.c_str());
+    return false;
+}
 
-            static constexpr float CM_TO_M = 0.01f;
-            mesh = CreateCSGCone(radius * CM_TO_M, height * CM_TO_M, 32,
-                Vector3(0, 0, 0),  // Keep mesh at origin, position applied via worldTransform
-                Vector3(0, 0, 0),
-                Vector3(1, 1, 1),  // scale applied via worldTransform
-                false);
+BuildResult CSGBuilder::BuildPrimitive(const PrimitiveNode* prim, ParameterScope& scope, std::string& outError) {
+    if (!prim) {
+        outError = "PrimitiveNode is null";
+        return BuildResult();
+    }
 
-            break;
-        }
+    // 解析 Transform
+    Vector3 position, scale;
+    Quaternion rotation;
+    ResolveTransform(prim->localTransform, scope, position, rotation, scale, outError);
 
-        case PrimitiveType::Capsule:
-        case PrimitiveType::Torus:
-            outError = "Primitive type not yet implemented";
-            MOON_LOG_WARN("CSGBuilder", "%s", outError.c_str());
-            return BuildResult();
+    PrimitiveShape shape;
+    if (!ResolvePrimitiveShape(prim, scope, shape, outError)) {
+        return BuildResult();
+    }
+
+    // Manifold 原生模式下，最外层构建的输出直接生成 FlatShading，不再走 Build 末尾的转换
+    // 作为 CSG 操作数构建时（如 group 的子节点）需要保持顶点共享，之后还要转换为 Manifold
+    const bool flatShading = m_evaluationMode == EvaluationMode::ManifoldNative &&
+        m_buildDepth == 1 && m_operandDepth == 0;
+
+    // 根据基础几何体类型创建 Mesh
+    // Mesh 保持在原点，position / rotation / scale 通过 worldTransform 应用
+    std::shared_ptr<Mesh> mesh;
+    switch (shape.type) {
+        case PrimitiveShape::Type::Box:
+            mesh = CreateCSGBox(shape.size.x, shape.size.y, shape.size.z,
+                Vector3(0, 0, 0), Vector3(0, 0, 0), Vector3(1, 1, 1), flatShading);
+            break;
+        case PrimitiveShape::Type::Sphere:
+            mesh = CreateCSGSphere(shape.radius, shape.segments,
+                Vector3(0, 0, 0), Vector3(0, 0, 0), Vector3(1, 1, 1), flatShading);
+            break;
+        case PrimitiveShape::Type::Cylinder:
+            mesh = CreateCSGCylinder(shape.radius, shape.height, shape.segments,
+                Vector3(0, 0, 0), Vector3(0, 0, 0), Vector3(1, 1, 1), flatShading);
+            break;
+        case PrimitiveShape::Type::Cone:
+            mesh = CreateCSGCone(shape.radius, shape.height, shape.segments,
+                Vector3(0, 0, 0), Vector3(0, 0, 0), Vector3(1, 1, 1), flatShading);
+            break;
     }
 
     if (!mesh) {
@@ -240,7 +271,7 @@ BuildResult CSGBuilder::BuildPrimitive(const PrimitiveNode* prim, ParameterScope
     // 不再烘焙旋转到顶点，让 scene node 的 transform 处理
     // 这样可以避免坐标系转换的问题
     BuildResult result;
-    result.AddMesh(MeshItem(mesh, prim->material, ResolvedTransform(position, rotation, scale)));
+    result.AddMesh(MeshItem(mesh, prim->material, ResolvedTransform(position, rotation, scale), !flatShading));
     return result;
 }
 
@@ -250,6 +281,31 @@ BuildResult CSGBuilder::BuildCSG(const CsgNode* csg, ParameterScope& scope, std:
         return BuildResult();
     }
 
+    if (m_evaluationMode == EvaluationMode::ManifoldNative) {
+        Solid solid;
+        std::string material;
+        if (!BuildCSGSolid(csg, scope, solid, material, outError)) {
+            return BuildResult();
+        }
+
+        // 整棵 CSG 子树只在这里转换一次 Mesh；最外层构建直接输出 FlatShading
+        const bool flatShading = m_buildDepth == 1 && m_operandDepth == 0;
+        std::shared_ptr<Mesh> resultMesh = solid.ToMesh(flatShading);
+        if (!resultMesh) {
+            outError = "CSG boolean operation failed";
+            MOON_LOG_ERROR("CSGBuilder", "%s", outError.c_str());
+            return BuildResult();
+        }
+
+        BuildResult result;
+        result.AddMesh(MeshItem(resultMesh, material, ResolvedTransform(), !flatShading));
+        return result;
+    }
+
+    if (IsNaryCsgOp(csg->operation)) {
+        return BuildNaryCSG(csg, scope, outError);
+    }
+
     //构建左右子节点
     BuildResult leftResult = BuildNode(csg->left.get(), scope, outError);
     if (leftResult.meshes.empty()) {
@@ -276,52 +332,8 @@ BuildResult CSGBuilder::BuildCSG(const CsgNode* csg, ParameterScope& scope, std:
     const auto& rightItem = rightResult.meshes[0];
     
     // Create transformed copies if transforms are non-identity
-    std::shared_ptr<Mesh> leftMeshTransformed = std::make_shared<Mesh>();
-    std::shared_ptr<Mesh> rightMeshTransformed = std::make_shared<Mesh>();
-    
-    // Copy and transform left mesh vertices
-    {
-        const auto& srcVertices = leftItem.mesh->GetVertices();
-        std::vector<Vertex> transformedVertices = srcVertices;
-        
-        for (auto& vertex : transformedVertices) {
-            // Apply rotation
-            Vector3 rotated = leftItem.worldTransform.rotation * vertex.position;
-            // Apply scale
-            Vector3 scaled(
-                rotated.x * leftItem.worldTransform.scale.x,
-                rotated.y * leftItem.worldTransform.scale.y,
-                rotated.z * leftItem.worldTransform.scale.z
-            );
-            // Apply position
-            vertex.position = scaled + leftItem.worldTransform.position;
-        }
-        
-        leftMeshTransformed->SetVertices(std::move(transformedVertices));
-        leftMeshTransformed->SetIndices(leftItem.mesh->GetIndices());
-    }
-    
-    // Copy and transform right mesh vertices
-    {
-        const auto& srcVertices = rightItem.mesh->GetVertices();
-        std::vector<Vertex> transformedVertices = srcVertices;
-        
-        for (auto& vertex : transformedVertices) {
-            // Apply rotation
-            Vector3 rotated = rightItem.worldTransform.rotation * vertex.position;
-            // Apply scale
-            Vector3 scaled(
-                rotated.x * rightItem.worldTransform.scale.x,
-                rotated.y * rightItem.worldTransform.scale.y,
-                rotated.z * rightItem.worldTransform.scale.z
-            );
-            // Apply position
-            vertex.position = scaled + rightItem.worldTransform.position;
-        }
-        
-        rightMeshTransformed->SetVertices(std::move(transformedVertices));
-        rightMeshTransformed->SetIndices(rightItem.mesh->GetIndices());
-    }
+    std::shared_ptr<Mesh> leftMeshTransformed = BakeWorldTransform(leftItem);
+    std::shared_ptr<Mesh> rightMeshTransformed = BakeWorldTransform(rightItem);
 
     // 执行 CSG 运算
     Operation op;
@@ -355,6 +367,221 @@ BuildResult CSGBuilder::BuildCSG(const CsgNode* csg, ParameterScope& scope, std:
     return result;
 }
 
+BuildResult CSGBuilder::BuildNaryCSG(const CsgNode* csg, ParameterScope& scope, std::string& outError) {
+    // 旧路径逐个执行二元运算：SubtractAll 依次减去每个切割体，UnionAll 依次求并
+    const Operation op = csg->operation == CsgOp::UnionAll ? Operation::Union : Operation::Subtract;
+
+    std::shared_ptr<Mesh> accumulated;
+    std::string material;
+    for (size_t i = 0; i < csg->operands.size(); ++i) {
+        BuildResult operandResult = BuildNode(csg->operands[i].get(), scope, outError);
+        if (operandResult.meshes.empty()) {
+            outError = "CSG operand #" + std::to_string(i) + " produced no meshes";
+            return BuildResult();
+        }
+        if (operandResult.meshes.size() > 1) {
+            outError = "CSG operation requires exactly one mesh on each side (M1 limitation)";
+            MOON_LOG_ERROR("CSGBuilder", "%s", outError.c_str());
+            return BuildResult();
+        }
+
+        std::shared_ptr<Mesh> operandMesh = BakeWorldTransform(operandResult.meshes[0]);
+        if (i == 0) {
+            accumulated = operandMesh;
+            material = operandResult.meshes[0].material;
+            continue;
+        }
+
+        accumulated = PerformBoolean(accumulated.get(), operandMesh.get(), op);
+        if (!accumulated) {
+            outError = "CSG boolean operation failed";
+            MOON_LOG_ERROR("CSGBuilder", "%s", outError.c_str());
+            return BuildResult();
+        }
+    }
+
+    if (!accumulated) {
+        outError = "CSG node has no operands";
+        return BuildResult();
+    }
+
+    BuildResult result;
+    result.AddMesh(MeshItem(accumulated, material, ResolvedTransform()));
+    return result;
+}
+
+bool CSGBuilder::BuildSolid(const Node* node, ParameterScope& scope, Solid& outSolid,
+                            std::string& outMaterial, std::string& outError) {
+    std::vector<Solid> solids;
+    if (!BuildOperandSolids(node, scope, false, solids, outMaterial, outError)) {
+        return false;
+    }
+    outSolid = std::move(solids.front());
+    return true;
+}
+
+bool CSGBuilder::BuildOperandSolids(const Node* node, ParameterScope& scope, bool allowMultipleMeshes,
+                                    std::vector<Solid>& outSolids, std::string& outMaterial,
+                                    std::string& outError) {
+    if (!node) {
+        outError = "Node is null";
+        return false;
+    }
+
+    if (node->type == NodeType::Csg) {
+        Solid solid;
+        if (!BuildCSGSolid(node->data.csg, scope, solid, outMaterial, outError)) {
+            return false;
+        }
+        outSolids.push_back(std::move(solid));
+        return true;
+    }
+
+    if (node->type == NodeType::Primitive) {
+        const PrimitiveNode* prim = node->data.primitive;
+        Vector3 position, scale;
+        Quaternion rotation;
+        ResolveTransform(prim->localTransform, scope, position, rotation, scale, outError);
+
+        PrimitiveShape shape;
+        if (!ResolvePrimitiveShape(prim, scope, shape, outError)) {
+            return false;
+        }
+
+        Solid solid = Solid::FromPrimitive(shape).Transformed(position, rotation, scale);
+        if (solid.IsEmpty()) {
+            outError = "Failed to create primitive mesh";
+            MOON_LOG_ERROR("CSGBuilder", "%s", outError.c_str());
+            return false;
+        }
+        outSolids.push_back(std::move(solid));
+        outMaterial = prim->material;
+        return true;
+    }
+
+    // 其他节点（reference / group / stair）按 Mesh 构建后转换一次
+    // 构建期间不做 FlatShading：未焊接的顶点无法构成 Manifold
+    m_operandDepth++;
+    BuildResult built = BuildNode(node, scope, outError);
+    m_operandDepth--;
+    if (built.meshes.empty()) {
+        return false;
+    }
+    if (built.meshes.size() > 1 && !allowMultipleMeshes) {
+        outError = "CSG operation requires exactly one mesh on each side (M1 limitation)";
+        MOON_LOG_ERROR("CSGBuilder", "%s", outError.c_str());
+        return false;
+    }
+
+    for (const MeshItem& item : built.meshes) {
+        Solid solid = Solid::FromMesh(item.mesh.get()).Transformed(
+            item.worldTransform.position, item.worldTransform.rotation, item.worldTransform.scale);
+        if (solid.IsEmpty()) {
+            outError = "Failed to convert CSG operand to manifold";
+            MOON_LOG_ERROR("CSGBuilder", "%s", outError.c_str());
+            return false;
+        }
+        outSolids.push_back(std::move(solid));
+    }
+    outMaterial = built.meshes[0].material;
+    return true;
+}
+
+bool CSGBuilder::BuildCSGSolid(const CsgNode* csg, ParameterScope& scope, Solid& outSolid,
+                               std::string& outMaterial, std::string& outError) {
+    if (IsNaryCsgOp(csg->operation)) {
+        return BuildNaryCSGSolid(csg, scope, outSolid, outMaterial, outError);
+    }
+
+    Solid left;
+    std::string leftMaterial;
+    if (!BuildSolid(csg->left.get(), scope, left, leftMaterial, outError)) {
+        if (outError.empty()) {
+            outError = "CSG left child produced no meshes";
+        }
+        return false;
+    }
+
+    Solid right;
+    std::string rightMaterial;
+    if (!BuildSolid(csg->right.get(), scope, right, rightMaterial, outError)) {
+        if (outError.empty()) {
+            outError = "CSG right child produced no meshes";
+        }
+        return false;
+    }
+
+    Operation op;
+    switch (csg->operation) {
+        case CsgOp::Union: op = Operation::Union; break;
+        case CsgOp::Subtract: op = Operation::Subtract; break;
+        case CsgOp::Intersect: op = Operation::Intersect; break;
+        default:
+            outError = "Unknown CSG operation";
+            return false;
+    }
+
+    outSolid = left.Boolean(right, op);
+    if (outSolid.IsEmpty()) {
+        outError = "CSG boolean operation failed";
+        MOON_LOG_ERROR("CSGBuilder", "%s", outError.c_str());
+        return false;
+    }
+
+    // 合并材质（优先使用左侧）
+    outMaterial = leftMaterial;
+    return true;
+}
+
+bool CSGBuilder::BuildNaryCSGSolid(const CsgNode* csg, ParameterScope& scope, Solid& outSolid,
+                                   std::string& outMaterial, std::string& outError) {
+    if (csg->operands.empty()) {
+        outError = "CSG node has no operands";
+        return false;
+    }
+
+    // SubtractAll 的被减体必须是单个 Mesh；切割体与 UnionAll 的操作数可展开为多个实体
+    const bool subtract = csg->operation == CsgOp::SubtractAll;
+    Solid base;
+    std::vector<Solid> operands;
+    operands.reserve(csg->operands.size());
+    for (size_t i = 0; i < csg->operands.size(); ++i) {
+        std::string material;
+        const bool isBase = subtract && i == 0;
+        const size_t before = operands.size();
+        if (!BuildOperandSolids(csg->operands[i].get(), scope, !isBase, operands, material, outError)) {
+            if (outError.empty()) {
+                outError = "CSG operand #" + std::to_string(i) + " produced no meshes";
+            }
+            return false;
+        }
+        if (i == 0) {
+            outMaterial = material;
+        }
+        if (isBase) {
+            base = std::move(operands[before]);
+            operands.pop_back();
+        }
+    }
+
+    if (!subtract) {
+        outSolid = operands.size() == 1 ? operands.front() : Solid::BatchBoolean(operands, Operation::Union);
+    } else if (operands.empty()) {
+        outSolid = base;
+    } else {
+        // 全部切割体一次批量求并，再只做一次差集
+        const Solid cutters = operands.size() == 1 ? operands.front() : Solid::BatchBoolean(operands, Operation::Union);
+        outSolid = base.Boolean(cutters, Operation::Subtract);
+    }
+
+    if (outSolid.IsEmpty()) {
+        outError = "CSG boolean operation failed";
+        MOON_LOG_ERROR("CSGBuilder", "%s", outError.c_str());
+        return false;
+    }
+    return true;
+}
+
 BuildResult CSGBuilder::BuildGroup(const GroupNode* group, ParameterScope& scope, std::string& outError) {
     if (!group) {
         outError = "GroupNode is null";
@@ -96,6 +96,11 @@ struct LightItem {
     ResolvedTransform worldTransform;
 };
 
+class CSGResultCache;
+class CSGCacheKeyBuilder;
+class Solid;
+struct PrimitiveShape;
+
 struct BuildResult {
     std::vector<MeshItem> meshes;
     std::vector<LightItem> lights;
@@ -118,6 +123,14 @@ struct BuildResult {
     }
 };
 
+/**
+ * @brief CSG 求值方式
+ */
+enum class EvaluationMode {
+    MeshRoundTrip,   // 每个 CSG 节点输出 Mesh，嵌套时反复与 Manifold 互转（旧路径，保留用于对比）
+    ManifoldNative   // CSG 子树全程保持 Manifold，只在子树根部转换一次 Mesh
+};
+
 class CSGBuilder {
 public:
     CSGBuilder();
@@ -127,6 +140,30 @@ public:
         m_database = db;
     }
 
+    /**
+     * @brief 设置结果缓存（默认使用 CSGResultCache::GetShared()，nullptr 关闭缓存）
+     *
+     * 引用（Reference）展开时的递归构建同样走缓存，重复引用同一部件只求值一次。
+     */
+    void SetResultCache(CSGResultCache* cache) {
+        m_resultCache = cache;
+    }
+
+    CSGResultCache* GetResultCache() const {
+        return m_resultCache;
+    }
+
+    /**
+     * @brief 设置求值方式（默认 ManifoldNative）
+     */
+    void SetEvaluationMode(EvaluationMode mode) {
+        m_evaluationMode = mode;
+    }
+
+    EvaluationMode GetEvaluationMode() const {
+        return m_evaluationMode;
+    }
+
     BuildResult Build(const Object::Blueprint* blueprint,
                       const std::unordered_map<std::string, float>& parameterOverrides,
                       std::string& outError);
@@ -140,6 +177,18 @@ private:
     BuildResult BuildLight(const Object::LightNode* light, ParameterScope& scope, std::string& outError);
     BuildResult BuildStair(const Object::StairNode* stair, ParameterScope& scope, std::string& outError);
 
+    bool ResolvePrimitiveShape(const Object::PrimitiveNode* prim, ParameterScope& scope,
+                               PrimitiveShape& outShape, std::string& outError);
+    bool BuildSolid(const Object::Node* node, ParameterScope& scope, Solid& outSolid,
+                    std::string& outMaterial, std::string& outError);
+    bool BuildCSGSolid(const Object::CsgNode* csg, ParameterScope& scope, Solid& outSolid,
+                       std::string& outMaterial, std::string& outError);
+    bool BuildNaryCSGSolid(const Object::CsgNode* csg, ParameterScope& scope, Solid& outSolid,
+                           std::string& outMaterial, std::string& outError);
+    bool BuildOperandSolids(const Object::Node* node, ParameterScope& scope, bool allowMultipleMeshes,
+                            std::vector<Solid>& outSolids, std::string& outMaterial, std::string& outError);
+    BuildResult BuildNaryCSG(const Object::CsgNode* csg, ParameterScope& scope, std::string& outError);
+
     std::unordered_map<std::string, Vector3> EvaluateAnchors(
         const Object::Blueprint* blueprint, ParameterScope& scope, std::string& outError);
     float EvaluateStringExpr(const std::string& exprStr, ParameterScope& scope, std::string& outError);
@@ -151,7 +200,11 @@ private:
     void ApplyTransform(BuildResult& result, const ResolvedTransform& transform) const;
 
     Object::BlueprintDatabase* m_database;
+    CSGResultCache* m_resultCache;
+    std::unique_ptr<CSGCacheKeyBuilder> m_cacheKeyBuilder;
+    EvaluationMode m_evaluationMode = EvaluationMode::ManifoldNative;
     int m_buildDepth = 0;
+    int m_operandDepth = 0;     // >0 表示正在把子树构建为 Manifold 原生求值的 CSG 操作数
 };
 
 } // namespace CSG
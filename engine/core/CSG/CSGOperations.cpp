@@ -469,5 +469,143 @@ std::shared_ptr<Mesh> CreateCSGCone(float radius, float height, int segments,
     return flatShading ? ManifoldToMesh_FlatShading(cone) : ManifoldToMesh_PreserveTopology(cone);
 }
 
+// =============================
+// Solid（Manifold 原生求值）
+// =============================
+struct Solid::Impl {
+    explicit Impl(manifold::Manifold&& m)
+        : manifold(std::move(m)) {
+    }
+
+    manifold::Manifold manifold;
+};
+
+Solid Solid::FromPrimitive(const PrimitiveShape& shape) {
+    // 与 CreateCSG* 相同的构造方式，坐标在 Manifold 坐标系(Z-up)中，几何中心在原点
+    manifold::Manifold primitive;
+    switch (shape.type) {
+        case PrimitiveShape::Type::Box:
+            primitive = manifold::Manifold::Cube({shape.size.x, shape.size.z, shape.size.y}, true);
+            break;
+        case PrimitiveShape::Type::Sphere:
+            primitive = manifold::Manifold::Sphere(shape.radius, shape.segments);
+            break;
+        case PrimitiveShape::Type::Cylinder:
+            primitive = manifold::Manifold::Cylinder(shape.height, shape.radius, shape.radius, shape.segments)
+                .Translate({0.0f, 0.0f, -shape.height / 2.0f});
+            break;
+        case PrimitiveShape::Type::Cone:
+            primitive = manifold::Manifold::Cylinder(shape.height, shape.radius, 0.0f, shape.segments)
+                .Translate({0.0f, 0.0f, -shape.height / 2.0f});
+            break;
+    }
+
+    Solid solid;
+    if (primitive.Status() == manifold::Manifold::Error::NoError && !primitive.IsEmpty()) {
+        solid.m_impl = std::make_shared<const Impl>(std::move(primitive));
+    }
+    return solid;
+}
+
+Solid Solid::FromMesh(const Mesh* mesh) {
+    manifold::Manifold converted = MeshToManifold(mesh);
+    Solid solid;
+    if (!converted.IsEmpty()) {
+        solid.m_impl = std::make_shared<const Impl>(std::move(converted));
+    }
+    return solid;
+}
+
+bool Solid::IsEmpty() const {
+    return !m_impl || m_impl->manifold.IsEmpty();
+}
+
+Solid Solid::Transformed(const Vector3& position, const Quaternion& rotation, const Vector3& scale) const {
+    if (IsEmpty()) {
+        return Solid();
+    }
+
+    // 引擎空间：p' = scale ⊙ (rotation * p) + position
+    // 引擎 → Manifold 的坐标映射 C: (x, y, z) → (x, -z, y)，Manifold 空间矩阵为 C·A·C^T
+    auto engineColumn = [&](const Vector3& axis) {
+        const Vector3 rotated = rotation * axis;
+        return Vector3(rotated.x * scale.x, rotated.y * scale.y, rotated.z * scale.z);
+    };
+    auto toManifold = [](const Vector3& v) {
+        return manifold::vec3(v.x, -v.z, v.y);
+    };
+
+    const Vector3 axisX = engineColumn(Vector3(1, 0, 0));
+    const Vector3 axisY = engineColumn(Vector3(0, 1, 0));
+    const Vector3 axisZ = engineColumn(Vector3(0, 0, 1));
+
+    // Manifold 的 X/Y/Z 轴分别对应引擎的 X / -Z / Y
+    const manifold::mat3x4 transform(
+        toManifold(axisX),
+        toManifold(Vector3(-axisZ.x, -axisZ.y, -axisZ.z)),
+        toManifold(axisY),
+        toManifold(position));
+
+    Solid solid;
+    solid.m_impl = std::make_shared<const Impl>(m_impl->manifold.Transform(transform));
+    return solid;
+}
+
+Solid Solid::Boolean(const Solid& other, Operation op) const {
+    if (IsEmpty() || other.IsEmpty()) {
+        return Solid();
+    }
+
+    manifold::Manifold result;
+    switch (op) {
+        case Operation::Union: result = m_impl->manifold + other.m_impl->manifold; break;
+        case Operation::Subtract: result = m_impl->manifold - other.m_impl->manifold; break;
+        case Operation::Intersect: result = m_impl->manifold ^ other.m_impl->manifold; break;
+    }
+
+    Solid solid;
+    if (!result.IsEmpty()) {
+        solid.m_impl = std::make_shared<const Impl>(std::move(result));
+    }
+    return solid;
+}
+
+Solid Solid::BatchBoolean(const std::vector<Solid>& solids, Operation op) {
+    if (solids.empty()) {
+        return Solid();
+    }
+
+    std::vector<manifold::Manifold> manifolds;
+    manifolds.reserve(solids.size());
+    for (const auto& solid : solids) {
+        if (solid.IsEmpty()) {
+            return Solid();
+        }
+        manifolds.push_back(solid.m_impl->manifold);
+    }
+
+    manifold::OpType opType = manifold::OpType::Add;
+    switch (op) {
+        case Operation::Union: opType = manifold::OpType::Add; break;
+        case Operation::Subtract: opType = manifold::OpType::Subtract; break;
+        case Operation::Intersect: opType = manifold::OpType::Intersect; break;
+    }
+
+    manifold::Manifold result = manifold::Manifold::BatchBoolean(manifolds, opType);
+    Solid solid;
+    if (!result.IsEmpty()) {
+        solid.m_impl = std::make_shared<const Impl>(std::move(result));
+    }
+    return solid;
+}
+
+std::shared_ptr<Mesh> Solid::ToMesh(bool flatShading) const {
+    if (IsEmpty()) {
+        return nullptr;
+    }
+    return flatShading ? ManifoldToMesh_FlatShading(m_impl->manifold)
+                       : ManifoldToMesh_PreserveTopology(m_impl->manifold);
+}
+
 } // namespace CSG
-} // namespace Moon
\ No newline at end of file
+} // namespace Moon
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "../Mesh/Mesh.h"
+#include "../Math/Quaternion.h"
 #include "../Math/Vector3.h"
 #include <memory>
+#include <vector>
 
 namespace Moon {
 namespace CSG {
@@ -30,6 +32,77 @@ std::shared_ptr<Mesh> PerformBoolean(
     Operation op
 );
 
+/**
+ * @brief 基础几何体描述（引擎坐标系，几何中心在原点，单位米）
+ */
+struct PrimitiveShape {
+    enum class Type {
+        Box,
+        Sphere,
+        Cylinder,
+        Cone
+    };
+
+    Type type = Type::Box;
+    Vector3 size = Vector3(1, 1, 1);  // Box：X/Y/Z 尺寸
+    float radius = 0.5f;              // Sphere / Cylinder / Cone
+    float height = 1.0f;              // Cylinder / Cone（沿 Y 轴）
+    int segments = 32;
+};
+
+/**
+ * @brief 布尔运算实体（内部为 manifold::Manifold）
+ *
+ * 用于在嵌套 CSG 节点之间保持 Manifold 形式：变换通过 Manifold::Transform 作用，
+ * 布尔运算直接在 Manifold 上进行，只在 CSG 子树根部调用一次 ToMesh。
+ * 内部数据共享，拷贝代价很低。
+ */
+class Solid {
+public:
+    Solid() = default;
+
+    /**
+     * @brief 直接以 Manifold 构造基础几何体（不经过 Mesh）
+     */
+    static Solid FromPrimitive(const PrimitiveShape& shape);
+
+    /**
+     * @brief 从 Mesh 转换（顶点需共享，即非 FlatShading 拓扑）
+     */
+    static Solid FromMesh(const Mesh* mesh);
+
+    bool IsEmpty() const;
+
+    /**
+     * @brief 应用变换：先旋转，再按世界轴缩放，最后平移（与 MeshItem::worldTransform 一致）
+     */
+    Solid Transformed(const Vector3& position, const Quaternion& rotation, const Vector3& scale) const;
+
+    /**
+     * @brief 布尔运算（this op other）
+     */
+    Solid Boolean(const Solid& other, Operation op) const;
+
+    /**
+     * @brief 批量布尔运算，一次 manifold::Manifold::BatchBoolean 完成
+     *
+     * Union / Intersect 作用于全部实体；Subtract 为 solids[0] 减去其余实体。
+     * 任一实体为空时返回空实体。
+     */
+    static Solid BatchBoolean(const std::vector<Solid>& solids, Operation op);
+
+    /**
+     * @brief 输出 Mesh
+     * @param flatShading true 输出 FlatShading（最终渲染），false 保留顶点共享（供后续布尔运算）
+     * @return 空实体返回 nullptr
+     */
+    std::shared_ptr<Mesh> ToMesh(bool flatShading) const;
+
+private:
+    struct Impl;
+    std::shared_ptr<const Impl> m_impl;
+};
+
 /**
  * @brief 将Mesh转换为FlatShading（硬边效果）
  * 
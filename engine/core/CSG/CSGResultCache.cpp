@@ -0,0 +1,654 @@
+#include "CSGResultCache.h"
+#include "../Logging/Logger.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+
+namespace Moon {
+namespace CSG {
+
+using namespace Moon::Object;
+
+namespace {
+
+// 磁盘格式：魔数 + 版本，结构变化时提升版本号使旧文件失效
+constexpr uint32_t kDiskMagic = 0x4743534D;  // "MSCG"
+constexpr uint32_t kDiskVersion = 1;
+constexpr size_t kDefaultMemoryBudget = 256ull * 1024ull * 1024ull;
+
+// =============================
+// 结构化哈希（FNV-1a 64）
+// =============================
+class Hasher {
+public:
+    void Bytes(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            m_hash ^= bytes[i];
+            m_hash *= 1099511628211ull;
+        }
+    }
+
+    void U8(uint8_t value) { Bytes(&value, sizeof(value)); }
+    void U32(uint32_t value) { Bytes(&value, sizeof(value)); }
+    void U64(uint64_t value) { Bytes(&value, sizeof(value)); }
+    void Int(int value) { U32(static_cast<uint32_t>(value)); }
+    void Bool(bool value) { U8(value ? 1 : 0); }
+
+    void Float(float value) {
+        // -0 与 0 求值结果相同，统一后再哈希
+        if (value == 0.0f) {
+            value = 0.0f;
+        }
+        Bytes(&value, sizeof(value));
+    }
+
+    void String(const std::string& value) {
+        U32(static_cast<uint32_t>(value.size()));
+        Bytes(value.data(), value.size());
+    }
+
+    uint64_t Get() const { return m_hash; }
+
+private:
+    uint64_t m_hash = 14695981039346656037ull;
+};
+
+template <typename T>
+std::vector<const typename std::unordered_map<std::string, T>::value_type*> SortedEntries(
+    const std::unordered_map<std::string, T>& map) {
+    std::vector<const typename std::unordered_map<std::string, T>::value_type*> entries;
+    entries.reserve(map.size());
+    for (const auto& entry : map) {
+        entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(),
+        [](const auto* a, const auto* b) { return a->first < b->first; });
+    return entries;
+}
+
+void HashValue(Hasher& hasher, const ValueExpr& expr) {
+    hasher.U8(static_cast<uint8_t>(expr.kind));
+    switch (expr.kind) {
+    case ValueExpr::Kind::Constant: hasher.Float(expr.constantValue); break;
+    case ValueExpr::Kind::ParamRef: hasher.String(expr.paramName); break;
+    case ValueExpr::Kind::Expression: hasher.String(expr.expression); break;
+    }
+}
+
+void HashValueMap(Hasher& hasher, const std::unordered_map<std::string, ValueExpr>& values) {
+    hasher.U32(static_cast<uint32_t>(values.size()));
+    for (const auto* entry : SortedEntries(values)) {
+        hasher.String(entry->first);
+        HashValue(hasher, entry->second);
+    }
+}
+
+void HashTransform(Hasher& hasher, const TransformTRS& transform) {
+    HashValue(hasher, transform.positionX);
+    HashValue(hasher, transform.positionY);
+    HashValue(hasher, transform.positionZ);
+    HashValue(hasher, transform.rotationX);
+    HashValue(hasher, transform.rotationY);
+    HashValue(hasher, transform.rotationZ);
+    HashValue(hasher, transform.scaleX);
+    HashValue(hasher, transform.scaleY);
+    HashValue(hasher, transform.scaleZ);
+}
+
+void HashNode(Hasher& hasher, const Node* node, std::set<std::string>& refIds) {
+    if (!node || !node->data.primitive) {
+        hasher.U8(0xFF);
+        return;
+    }
+
+    hasher.U8(static_cast<uint8_t>(node->type));
+    switch (node->type) {
+    case NodeType::Primitive: {
+        const PrimitiveNode* prim = node->data.primitive;
+        hasher.U8(static_cast<uint8_t>(prim->primitive));
+        HashValueMap(hasher, prim->params);
+        HashTransform(hasher, prim->localTransform);
+        hasher.String(prim->material);
+        break;
+    }
+    case NodeType::Csg: {
+        const CsgNode* csg = node->data.csg;
+        hasher.U8(static_cast<uint8_t>(csg->operation));
+        hasher.String(csg->options.solver);
+        hasher.Float(csg->options.weldEpsilon);
+        hasher.Bool(csg->options.recomputeNormals);
+        HashNode(hasher, csg->left.get(), refIds);
+        HashNode(hasher, csg->right.get(), refIds);
+        hasher.U32(static_cast<uint32_t>(csg->operands.size()));
+        for (const auto& operand : csg->operands) {
+            HashNode(hasher, operand.get(), refIds);
+        }
+        break;
+    }
+    case NodeType::Group: {
+        const GroupNode* group = node->data.group;
+        hasher.U8(static_cast<uint8_t>(group->outputMode));
+        HashTransform(hasher, group->localTransform);
+        hasher.U32(static_cast<uint32_t>(group->childNames.size()));
+        for (const auto& name : group->childNames) {
+            hasher.String(name);
+        }
+        hasher.U32(static_cast<uint32_t>(group->children.size()));
+        for (const auto& child : group->children) {
+            HashNode(hasher, child.get(), refIds);
+        }
+        break;
+    }
+    case NodeType::Reference: {
+        const RefNode* ref = node->data.ref;
+        hasher.String(ref->refId);
+        HashTransform(hasher, ref->localTransform);
+        HashValueMap(hasher, ref->overrides);
+        hasher.Bool(ref->attach.hasAttach);
+        hasher.String(ref->attach.selfAnchor);
+        hasher.String(ref->attach.targetPath);
+        hasher.String(ref->attach.targetAnchor);
+        refIds.insert(ref->refId);
+        break;
+    }
+    case NodeType::Light: {
+        const LightNode* light = node->data.light;
+        hasher.U8(static_cast<uint8_t>(light->type));
+        HashTransform(hasher, light->localTransform);
+        HashValue(hasher, light->colorR);
+        HashValue(hasher, light->colorG);
+        HashValue(hasher, light->colorB);
+        HashValue(hasher, light->intensity);
+        HashValue(hasher, light->range);
+        HashValue(hasher, light->attenuationConstant);
+        HashValue(hasher, light->attenuationLinear);
+        HashValue(hasher, light->attenuationQuadratic);
+        HashValue(hasher, light->spotInnerConeAngle);
+        HashValue(hasher, light->spotOuterConeAngle);
+        hasher.Bool(light->castShadows);
+        break;
+    }
+    case NodeType::Stair: {
+        const StairNode* stair = node->data.stair;
+        HashValueMap(hasher, stair->params);
+        HashTransform(hasher, stair->localTransform);
+        hasher.String(stair->treadMaterial);
+        hasher.String(stair->stringerMaterial);
+        hasher.String(stair->railMaterial);
+        hasher.Bool(stair->leftRail);
+        hasher.Bool(stair->rightRail);
+        break;
+    }
+    }
+}
+
+// =============================
+// 二进制读写
+// =============================
+class BinaryWriter {
+public:
+    template <typename T>
+    void Pod(const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void Raw(const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+    }
+
+    void String(const std::string& value) {
+        Pod(static_cast<uint32_t>(value.size()));
+        Raw(value.data(), value.size());
+    }
+
+    void Transform(const ResolvedTransform& transform) {
+        Pod(transform.position);
+        Pod(transform.rotation);
+        Pod(transform.scale);
+    }
+
+    const std::vector<char>& GetBuffer() const { return m_buffer; }
+
+private:
+    std::vector<char> m_buffer;
+};
+
+class BinaryReader {
+public:
+    BinaryReader(const char* data, size_t size)
+        : m_data(data)
+        , m_size(size) {
+    }
+
+    template <typename T>
+    bool Pod(T& outValue) {
+        return Raw(&outValue, sizeof(T));
+    }
+
+    bool Raw(void* outData, size_t size) {
+        if (size > m_size - m_offset) {
+            return false;
+        }
+        std::memcpy(outData, m_data + m_offset, size);
+        m_offset += size;
+        return true;
+    }
+
+    bool String(std::string& outValue) {
+        uint32_t length = 0;
+        if (!Pod(length) || length > m_size - m_offset) {
+            return false;
+        }
+        outValue.assign(m_data + m_offset, length);
+        m_offset += length;
+        return true;
+    }
+
+    bool Transform(ResolvedTransform& outTransform) {
+        return Pod(outTransform.position) && Pod(outTransform.rotation) && Pod(outTransform.scale);
+    }
+
+    // 数组长度上限：防止损坏的文件触发超大分配
+    bool Count(uint32_t& outCount, size_t elementSize) {
+        return Pod(outCount) && static_cast<uint64_t>(outCount) * elementSize <= m_size - m_offset;
+    }
+
+    bool AtEnd() const { return m_offset == m_size; }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_offset = 0;
+};
+
+} // namespace
+
+// =============================
+// CSGResultCache
+// =============================
+CSGResultCache::CSGResultCache()
+    : m_memoryBudget(kDefaultMemoryBudget) {
+}
+
+CSGResultCache::~CSGResultCache() {
+}
+
+CSGResultCache& CSGResultCache::GetShared() {
+    static CSGResultCache s_shared;
+    return s_shared;
+}
+
+bool CSGResultCache::Lookup(uint64_t key, BuildResult& outResult) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.lookups++;
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+        outResult = it->second.result;
+        m_stats.memoryHits++;
+        return true;
+    }
+
+    if (!m_diskDirectory.empty() && ReadDiskLocked(key, outResult)) {
+        InsertLocked(key, outResult);
+        m_stats.diskHits++;
+        return true;
+    }
+
+    m_stats.misses++;
+    return false;
+}
+
+void CSGResultCache::Store(uint64_t key, const BuildResult& result) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.count(key) > 0) {
+        return;
+    }
+    InsertLocked(key, result);
+    m_stats.stores++;
+    if (!m_diskDirectory.empty()) {
+        WriteDiskLocked(key, result);
+    }
+}
+
+void CSGResultCache::SetDiskDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_diskDirectory = directory;
+    if (m_diskDirectory.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_diskDirectory, ec);
+    if (ec) {
+        MOON_LOG_WARN("CSGResultCache", "Failed to create cache directory '%s': %s",
+            m_diskDirectory.c_str(), ec.message().c_str());
+        m_diskDirectory.clear();
+    }
+}
+
+std::string CSGResultCache::GetDiskDirectory() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_diskDirectory;
+}
+
+void CSGResultCache::SetMemoryBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_memoryBudget = bytes;
+    EvictLocked();
+}
+
+void CSGResultCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_lru.clear();
+    m_stats.memoryBytes = 0;
+    m_stats.entryCount = 0;
+}
+
+CSGResultCache::Stats CSGResultCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void CSGResultCache::ResetStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint64_t memoryBytes = m_stats.memoryBytes;
+    const size_t entryCount = m_stats.entryCount;
+    m_stats = Stats();
+    m_stats.memoryBytes = memoryBytes;
+    m_stats.entryCount = entryCount;
+}
+
+size_t CSGResultCache::ComputeResultBytes(const BuildResult& result) {
+    size_t bytes = result.lights.size() * sizeof(LightItem);
+    for (const auto& item : result.meshes) {
+        bytes += sizeof(MeshItem) + item.material.size();
+        if (item.mesh) {
+            bytes += item.mesh->GetVertexCount() * sizeof(Vertex) + item.mesh->GetIndexCount() * sizeof(uint32_t);
+        }
+    }
+    return bytes;
+}
+
+void CSGResultCache::InsertLocked(uint64_t key, const BuildResult& result) {
+    m_lru.push_front(key);
+    Entry& entry = m_entries[key];
+    entry.result = result;
+    entry.bytes = ComputeResultBytes(result);
+    entry.lruPosition = m_lru.begin();
+
+    m_stats.memoryBytes += entry.bytes;
+    m_stats.entryCount = m_entries.size();
+    EvictLocked();
+}
+
+void CSGResultCache::EvictLocked() {
+    // 至少保留最近插入的条目，单个超预算的结果仍可复用
+    while (m_stats.memoryBytes > m_memoryBudget && m_lru.size() > 1) {
+        const uint64_t key = m_lru.back();
+        m_lru.pop_back();
+        auto it = m_entries.find(key);
+        m_stats.memoryBytes -= it->second.bytes;
+        m_entries.erase(it);
+        m_stats.evictions++;
+    }
+    m_stats.entryCount = m_entries.size();
+}
+
+std::string CSGResultCache::GetDiskPathLocked(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016" PRIx64 ".csgcache", key);
+    return (std::filesystem::path(m_diskDirectory) / name).string();
+}
+
+bool CSGResultCache::ReadDiskLocked(uint64_t key, BuildResult& outResult) {
+    std::ifstream file(GetDiskPathLocked(key), std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    const std::streamsize size = file.tellg();
+    if (size <= 0) {
+        return false;
+    }
+    std::vector<char> buffer(static_cast<size_t>(size));
+    file.seekg(0);
+    if (!file.read(buffer.data(), size)) {
+        return false;
+    }
+
+    BinaryReader reader(buffer.data(), buffer.size());
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t storedKey = 0;
+    if (!reader.Pod(magic) || !reader.Pod(version) || !reader.Pod(storedKey) ||
+        magic != kDiskMagic || version != kDiskVersion || storedKey != key) {
+        return false;
+    }
+
+    BuildResult result;
+    uint32_t meshCount = 0;
+    if (!reader.Count(meshCount, sizeof(uint32_t))) {
+        return false;
+    }
+    result.meshes.resize(meshCount);
+    for (auto& item : result.meshes) {
+        uint8_t flatShading = 0;
+        uint8_t hasMesh = 0;
+        if (!reader.String(item.material) || !reader.Transform(item.worldTransform) ||
+            !reader.Pod(flatShading) || !reader.Pod(hasMesh)) {
+            return false;
+        }
+        item.requiresFlatShading = flatShading != 0;
+        if (!hasMesh) {
+            continue;
+        }
+
+        uint32_t vertexCount = 0;
+        std::vector<Vertex> vertices;
+        if (!reader.Count(vertexCount, sizeof(Vertex))) {
+            return false;
+        }
+        vertices.resize(vertexCount);
+        if (!reader.Raw(vertices.data(), vertexCount * sizeof(Vertex))) {
+            return false;
+        }
+
+        uint32_t indexCount = 0;
+        std::vector<uint32_t> indices;
+        if (!reader.Count(indexCount, sizeof(uint32_t))) {
+            return false;
+        }
+        indices.resize(indexCount);
+        if (!reader.Raw(indices.data(), indexCount * sizeof(uint32_t))) {
+            return false;
+        }
+
+        item.mesh = std::make_shared<Mesh>();
+        item.mesh->SetVertices(std::move(vertices));
+        item.mesh->SetIndices(std::move(indices));
+    }
+
+    uint32_t lightCount = 0;
+    if (!reader.Count(lightCount, sizeof(uint32_t))) {
+        return false;
+    }
+    result.lights.resize(lightCount);
+    for (auto& light : result.lights) {
+        uint8_t castShadows = 0;
+        if (!reader.Pod(light.type) || !reader.Pod(light.color) || !reader.Pod(light.intensity) ||
+            !reader.Pod(light.range) || !reader.Pod(light.attenuation) ||
+            !reader.Pod(light.spotInnerConeAngle) || !reader.Pod(light.spotOuterConeAngle) ||
+            !reader.Pod(castShadows) || !reader.Transform(light.worldTransform)) {
+            return false;
+        }
+        light.castShadows = castShadows != 0;
+    }
+
+    if (!reader.AtEnd()) {
+        return false;
+    }
+
+    m_stats.diskBytesRead += static_cast<uint64_t>(size);
+    outResult = std::move(result);
+    return true;
+}
+
+void CSGResultCache::WriteDiskLocked(uint64_t key, const BuildResult& result) {
+    BinaryWriter writer;
+    writer.Pod(kDiskMagic);
+    writer.Pod(kDiskVersion);
+    writer.Pod(key);
+
+    writer.Pod(static_cast<uint32_t>(result.meshes.size()));
+    for (const auto& item : result.meshes) {
+        writer.String(item.material);
+        writer.Transform(item.worldTransform);
+        writer.Pod(static_cast<uint8_t>(item.requiresFlatShading ? 1 : 0));
+        writer.Pod(static_cast<uint8_t>(item.mesh ? 1 : 0));
+        if (!item.mesh) {
+            continue;
+        }
+        const auto& vertices = item.mesh->GetVertices();
+        const auto& indices = item.mesh->GetIndices();
+        writer.Pod(static_cast<uint32_t>(vertices.size()));
+        writer.Raw(vertices.data(), vertices.size() * sizeof(Vertex));
+        writer.Pod(static_cast<uint32_t>(indices.size()));
+        writer.Raw(indices.data(), indices.size() * sizeof(uint32_t));
+    }
+
+    writer.Pod(static_cast<uint32_t>(result.lights.size()));
+    for (const auto& light : result.lights) {
+        writer.Pod(light.type);
+        writer.Pod(light.color);
+        writer.Pod(light.intensity);
+        writer.Pod(light.range);
+        writer.Pod(light.attenuation);
+        writer.Pod(light.spotInnerConeAngle);
+        writer.Pod(light.spotOuterConeAngle);
+        writer.Pod(static_cast<uint8_t>(light.castShadows ? 1 : 0));
+        writer.Transform(light.worldTransform);
+    }
+
+    // 先写临时文件再改名，避免并发读取到写了一半的文件
+    const std::string path = GetDiskPathLocked(key);
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            MOON_LOG_WARN("CSGResultCache", "Failed to write cache file '%s'", tempPath.c_str());
+            return;
+        }
+        const auto& buffer = writer.GetBuffer();
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!file) {
+            return;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return;
+    }
+    m_stats.diskBytesWritten += writer.GetBuffer().size();
+}
+
+// =============================
+// CSGCacheKeyBuilder
+// =============================
+bool CSGCacheKeyBuilder::ComputeKey(const Blueprint* blueprint,
+                                    const std::unordered_map<std::string, float>& resolvedParameters,
+                                    bool flatShaded, uint32_t variant, uint64_t& outKey) {
+    if (!blueprint) {
+        return false;
+    }
+
+    // 收集传递引用闭包（按 ID 排序，保证键与遍历顺序无关）
+    std::map<std::string, uint64_t> referenced;
+    std::vector<std::string> pending = GetContentHash(blueprint).refIds;
+    while (!pending.empty()) {
+        const std::string refId = std::move(pending.back());
+        pending.pop_back();
+        if (referenced.count(refId) > 0) {
+            continue;
+        }
+        const Blueprint* refBlueprint = m_database ? m_database->GetBlueprint(refId) : nullptr;
+        if (!refBlueprint) {
+            return false;
+        }
+        const ContentHash& refHash = GetContentHash(refBlueprint);
+        referenced[refId] = refHash.hash;
+        pending.insert(pending.end(), refHash.refIds.begin(), refHash.refIds.end());
+    }
+
+    Hasher hasher;
+    hasher.U32(kDiskVersion);
+    hasher.U64(GetContentHash(blueprint).hash);
+    hasher.U32(static_cast<uint32_t>(referenced.size()));
+    for (const auto& entry : referenced) {
+        hasher.String(entry.first);
+        hasher.U64(entry.second);
+    }
+    hasher.U32(static_cast<uint32_t>(resolvedParameters.size()));
+    for (const auto* entry : SortedEntries(resolvedParameters)) {
+        hasher.String(entry->first);
+        hasher.Float(entry->second);
+    }
+    hasher.Bool(flatShaded);
+    hasher.U32(variant);
+
+    outKey = hasher.Get();
+    return true;
+}
+
+const CSGCacheKeyBuilder::ContentHash& CSGCacheKeyBuilder::GetContentHash(const Blueprint* blueprint) {
+    auto it = m_contentHashes.find(blueprint);
+    if (it != m_contentHashes.end()) {
+        return it->second;
+    }
+
+    Hasher hasher;
+    std::set<std::string> refIds;
+
+    hasher.String(blueprint->GetId());
+    const auto& parameters = blueprint->GetParameters();
+    hasher.U32(static_cast<uint32_t>(parameters.size()));
+    for (const auto* entry : SortedEntries(parameters)) {
+        hasher.String(entry->first);
+        hasher.U8(static_cast<uint8_t>(entry->second.type));
+        hasher.Float(entry->second.defaultValue);
+        hasher.Float(entry->second.minValue);
+        hasher.Float(entry->second.maxValue);
+    }
+
+    const auto& anchors = blueprint->GetAnchors();
+    hasher.U32(static_cast<uint32_t>(anchors.size()));
+    for (const auto* entry : SortedEntries(anchors)) {
+        hasher.String(entry->first);
+        for (const auto& axis : entry->second) {
+            hasher.String(axis);
+        }
+    }
+
+    HashNode(hasher, blueprint->GetRootNode(), refIds);
+
+    ContentHash& content = m_contentHashes[blueprint];
+    content.hash = hasher.Get();
+    content.refIds.assign(refIds.begin(), refIds.end());
+    return content;
+}
+
+} // namespace CSG
+} // namespace Moon
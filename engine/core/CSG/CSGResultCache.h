@@ -0,0 +1,155 @@
+#pragma once
+
+#include "CSGBuilder.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Moon {
+namespace CSG {
+
+/**
+ * @brief CSG 构建结果缓存（内容寻址）
+ *
+ * 键是 Blueprint 内容、其引用的子 Blueprint 内容、解析后的参数值以及是否已做
+ * FlatShading 的哈希；相同输入必然得到相同结果，因此命中时直接返回共享的 Mesh，
+ * 完全跳过布尔运算。Mesh 在缓存和所有使用者之间共享，使用者不得修改。
+ *
+ * 两级存储：
+ * - 内存层：按字节预算做 LRU 淘汰
+ * - 磁盘层（可选）：每个条目一个二进制文件，编辑器重启后仍可命中
+ *
+ * 线程安全，可被多个 CSGBuilder 同时使用。
+ */
+class CSGResultCache {
+public:
+    /**
+     * @brief 命中率与占用统计
+     */
+    struct Stats {
+        uint64_t lookups = 0;
+        uint64_t memoryHits = 0;
+        uint64_t diskHits = 0;
+        uint64_t misses = 0;
+        uint64_t stores = 0;
+        uint64_t evictions = 0;
+        uint64_t memoryBytes = 0;       ///< 内存层当前占用（顶点 + 索引）
+        uint64_t diskBytesRead = 0;
+        uint64_t diskBytesWritten = 0;
+        size_t entryCount = 0;          ///< 内存层条目数
+
+        double GetHitRate() const {
+            return lookups > 0 ? static_cast<double>(memoryHits + diskHits) / static_cast<double>(lookups) : 0.0;
+        }
+    };
+
+    CSGResultCache();
+    ~CSGResultCache();
+
+    CSGResultCache(const CSGResultCache&) = delete;
+    CSGResultCache& operator=(const CSGResultCache&) = delete;
+
+    /**
+     * @brief 进程级共享缓存（CSGBuilder 默认使用）
+     */
+    static CSGResultCache& GetShared();
+
+    /**
+     * @brief 查找缓存结果（先内存后磁盘，磁盘命中会回填内存层）
+     */
+    bool Lookup(uint64_t key, BuildResult& outResult);
+
+    /**
+     * @brief 写入缓存（启用磁盘层时同时写文件）
+     */
+    void Store(uint64_t key, const BuildResult& result);
+
+    /**
+     * @brief 设置磁盘缓存目录（空字符串关闭磁盘层）
+     */
+    void SetDiskDirectory(const std::string& directory);
+    std::string GetDiskDirectory() const;
+
+    /**
+     * @brief 设置内存层字节预算（超出时淘汰最久未使用的条目）
+     */
+    void SetMemoryBudget(size_t bytes);
+
+    /**
+     * @brief 清空内存层（不删除磁盘文件）
+     */
+    void Clear();
+
+    Stats GetStats() const;
+    void ResetStats();
+
+    /**
+     * @brief 计算结果占用的字节数（顶点 + 索引）
+     */
+    static size_t ComputeResultBytes(const BuildResult& result);
+
+private:
+    struct Entry {
+        BuildResult result;
+        size_t bytes = 0;
+        std::list<uint64_t>::iterator lruPosition;
+    };
+
+    void InsertLocked(uint64_t key, const BuildResult& result);
+    void EvictLocked();
+    std::string GetDiskPathLocked(uint64_t key) const;
+    bool ReadDiskLocked(uint64_t key, BuildResult& outResult);
+    void WriteDiskLocked(uint64_t key, const BuildResult& result);
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<uint64_t, Entry> m_entries;
+    std::list<uint64_t> m_lru;  ///< 头部为最近使用
+    std::string m_diskDirectory;
+    size_t m_memoryBudget;
+    Stats m_stats;
+};
+
+/**
+ * @brief CSG 缓存键计算
+ *
+ * 对 Blueprint 做结构化哈希（FNV-1a，无序表按键排序，保证跨进程稳定），
+ * 再合并传递引用到的所有子 Blueprint 的内容哈希与解析后的参数值。
+ * 单个 Blueprint 的内容哈希按指针缓存，只应在 Blueprint 不再修改的一次构建期间复用。
+ */
+class CSGCacheKeyBuilder {
+public:
+    explicit CSGCacheKeyBuilder(Object::BlueprintDatabase* database)
+        : m_database(database) {
+    }
+
+    /**
+     * @brief 计算完整缓存键
+     * @param resolvedParameters 根作用域参数（默认值 + 覆盖）
+     * @param flatShaded 结果是否已做 FlatShading（最外层构建）
+     * @param variant 其他影响结果的构建选项（如求值方式）
+     * @param outKey 输出键
+     * @return false 表示无法计算（引用无法解析），此时不应使用缓存
+     */
+    bool ComputeKey(const Object::Blueprint* blueprint,
+                    const std::unordered_map<std::string, float>& resolvedParameters,
+                    bool flatShaded, uint32_t variant, uint64_t& outKey);
+
+private:
+    struct ContentHash {
+        uint64_t hash = 0;
+        std::vector<std::string> refIds;  ///< 直接引用的 Blueprint ID（已去重排序）
+    };
+
+    const ContentHash& GetContentHash(const Object::Blueprint* blueprint);
+
+    Object::BlueprintDatabase* m_database;
+    std::unordered_map<const Object::Blueprint*, ContentHash> m_contentHashes;
+};
+
+} // namespace CSG
+} // namespace Moon
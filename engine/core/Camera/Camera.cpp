@@ -43,4 +43,19 @@ void Camera::LookAt(const Vector3& target) {
     SetTarget(target);
 }
 
-}
\ No newline at end of file
+void Camera::ScreenPointToRay(float ndcX, float ndcY, Vector3& outOrigin, Vector3& outDirection) const {
+    // 反投影近/远平面上的点（DirectX 风格 z ∈ [0, 1]，行向量 [x y z 1] × M）
+    const Matrix4x4 invViewProj = GetViewProjectionMatrix().Inverse();
+    auto unproject = [&invViewProj](float x, float y, float z) {
+        const auto& m = invViewProj.m;
+        const float w = x * m[0][3] + y * m[1][3] + z * m[2][3] + m[3][3];
+        const Vector3 p = invViewProj.MultiplyPoint(Vector3(x, y, z));
+        return w != 0.0f ? p * (1.0f / w) : p;
+    };
+    const Vector3 nearPoint = unproject(ndcX, ndcY, 0.0f);
+    const Vector3 farPoint = unproject(ndcX, ndcY, 1.0f);
+    outOrigin = nearPoint;
+    outDirection = (farPoint - nearPoint).Normalized();
+}
+
+}
@@ -38,6 +38,9 @@ public:
     // Helper method for easier camera positioning
     void LookAt(const Vector3& target);
     
+    // 屏幕点 → 世界空间射线（ndc ∈ [-1, 1]，y 向上），用于 CPU 拾取
+    void ScreenPointToRay(float ndcX, float ndcY, Vector3& outOrigin, Vector3& outDirection) const;
+    
 protected:
     Vector3 m_position, m_target, m_up;
     mutable bool m_viewDirty = true;
@@ -0,0 +1,155 @@
+#include "Frustum.h"
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#define MOON_FRUSTUM_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace Moon {
+
+Frustum::Frustum() {
+    // 法线为 0、d 为正：任何点的距离都为正，不剔除
+    for (int i = 0; i < 8; ++i) {
+        m_nx[i] = 0.0f;
+        m_ny[i] = 0.0f;
+        m_nz[i] = 0.0f;
+        m_d[i] = 1.0f;
+    }
+}
+
+Frustum Frustum::FromViewProjection(const Matrix4x4& vp) {
+    // clip = [x y z 1] × M，clip 分量 j = dot(p, 第 j 列)
+    auto col = [&vp](int j, int i) { return vp.m[i][j]; };
+
+    Frustum frustum;
+    frustum.SetPlane(Left,   col(3, 0) + col(0, 0), col(3, 1) + col(0, 1), col(3, 2) + col(0, 2), col(3, 3) + col(0, 3));
+    frustum.SetPlane(Right,  col(3, 0) - col(0, 0), col(3, 1) - col(0, 1), col(3, 2) - col(0, 2), col(3, 3) - col(0, 3));
+    frustum.SetPlane(Bottom, col(3, 0) + col(1, 0), col(3, 1) + col(1, 1), col(3, 2) + col(1, 2), col(3, 3) + col(1, 3));
+    frustum.SetPlane(Top,    col(3, 0) - col(1, 0), col(3, 1) - col(1, 1), col(3, 2) - col(1, 2), col(3, 3) - col(1, 3));
+    frustum.SetPlane(Near,   col(2, 0), col(2, 1), col(2, 2), col(2, 3));
+    frustum.SetPlane(Far,    col(3, 0) - col(2, 0), col(3, 1) - col(2, 1), col(3, 2) - col(2, 2), col(3, 3) - col(2, 3));
+
+    // 补齐槽位：重复 Far 平面，不改变测试结果
+    for (int i = PlaneCount; i < 8; ++i) {
+        frustum.m_nx[i] = frustum.m_nx[Far];
+        frustum.m_ny[i] = frustum.m_ny[Far];
+        frustum.m_nz[i] = frustum.m_nz[Far];
+        frustum.m_d[i] = frustum.m_d[Far];
+    }
+    return frustum;
+}
+
+void Frustum::SetPlane(int plane, float a, float b, float c, float d) {
+    const float length = std::sqrt(a * a + b * b + c * c);
+    const float inv = length > 0.0f ? 1.0f / length : 0.0f;
+    m_nx[plane] = a * inv;
+    m_ny[plane] = b * inv;
+    m_nz[plane] = c * inv;
+    m_d[plane] = d * inv;
+}
+
+bool Frustum::IsSphereVisible(const Vector3& center, float radius) const {
+#ifdef MOON_FRUSTUM_SSE
+    const __m128 cx = _mm_set1_ps(center.x);
+    const __m128 cy = _mm_set1_ps(center.y);
+    const __m128 cz = _mm_set1_ps(center.z);
+    const __m128 negRadius = _mm_set1_ps(-radius);
+    for (int group = 0; group < 8; group += 4) {
+        __m128 dist = _mm_add_ps(_mm_mul_ps(_mm_load_ps(m_nx + group), cx), _mm_load_ps(m_d + group));
+        dist = _mm_add_ps(dist, _mm_mul_ps(_mm_load_ps(m_ny + group), cy));
+        dist = _mm_add_ps(dist, _mm_mul_ps(_mm_load_ps(m_nz + group), cz));
+        if (_mm_movemask_ps(_mm_cmplt_ps(dist, negRadius)) != 0) {
+            return false;
+        }
+    }
+    return true;
+#else
+    for (int i = 0; i < PlaneCount; ++i) {
+        const float dist = m_nx[i] * center.x + m_ny[i] * center.y + m_nz[i] * center.z + m_d[i];
+        if (dist < -radius) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+bool Frustum::IsAABBVisible(const AABB& box) const {
+    if (!box.IsValid()) {
+        return false;
+    }
+    const Vector3 c = box.GetCenter();
+    const Vector3 e = box.GetExtents();
+#ifdef MOON_FRUSTUM_SSE
+    // 投影半径 r = |n|·e；完全在平面外侧（dist + r < 0）则剔除
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 cx = _mm_set1_ps(c.x);
+    const __m128 cy = _mm_set1_ps(c.y);
+    const __m128 cz = _mm_set1_ps(c.z);
+    const __m128 ex = _mm_set1_ps(e.x);
+    const __m128 ey = _mm_set1_ps(e.y);
+    const __m128 ez = _mm_set1_ps(e.z);
+    const __m128 zero = _mm_setzero_ps();
+    for (int group = 0; group < 8; group += 4) {
+        const __m128 nx = _mm_load_ps(m_nx + group);
+        const __m128 ny = _mm_load_ps(m_ny + group);
+        const __m128 nz = _mm_load_ps(m_nz + group);
+        __m128 dist = _mm_add_ps(_mm_mul_ps(nx, cx), _mm_load_ps(m_d + group));
+        dist = _mm_add_ps(dist, _mm_mul_ps(ny, cy));
+        dist = _mm_add_ps(dist, _mm_mul_ps(nz, cz));
+        __m128 r = _mm_mul_ps(_mm_andnot_ps(signMask, nx), ex);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_andnot_ps(signMask, ny), ey));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_andnot_ps(signMask, nz), ez));
+        if (_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(dist, r), zero)) != 0) {
+            return false;
+        }
+    }
+    return true;
+#else
+    for (int i = 0; i < PlaneCount; ++i) {
+        const float dist = m_nx[i] * c.x + m_ny[i] * c.y + m_nz[i] * c.z + m_d[i];
+        const float r = std::fabs(m_nx[i]) * e.x + std::fabs(m_ny[i]) * e.y + std::fabs(m_nz[i]) * e.z;
+        if (dist + r < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+size_t Frustum::CullSpheres(const float* centerX, const float* centerY, const float* centerZ,
+                            const float* radius, size_t count, uint8_t* outVisible) const {
+    size_t visible = 0;
+    size_t i = 0;
+#ifdef MOON_FRUSTUM_SSE
+    // 每次 4 个物体：对 6 个平面依次累积“在某平面外侧”的掩码
+    for (; i + 4 <= count; i += 4) {
+        const __m128 cx = _mm_loadu_ps(centerX + i);
+        const __m128 cy = _mm_loadu_ps(centerY + i);
+        const __m128 cz = _mm_loadu_ps(centerZ + i);
+        const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+        __m128 outside = _mm_setzero_ps();
+        for (int p = 0; p < PlaneCount; ++p) {
+            __m128 dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m_nx[p]), cx), _mm_set1_ps(m_d[p]));
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(m_ny[p]), cy));
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(m_nz[p]), cz));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, negRadius));
+        }
+        const int outsideMask = _mm_movemask_ps(outside);
+        for (int lane = 0; lane < 4; ++lane) {
+            const uint8_t isVisible = (outsideMask & (1 << lane)) ? 0 : 1;
+            outVisible[i + lane] = isVisible;
+            visible += isVisible;
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        const uint8_t isVisible = IsSphereVisible(Vector3(centerX[i], centerY[i], centerZ[i]), radius[i]) ? 1 : 0;
+        outVisible[i] = isVisible;
+        visible += isVisible;
+    }
+    return visible;
+}
+
+} // namespace Moon
@@ -0,0 +1,72 @@
+#pragma once
+#include "../Math/Math.h"
+#include "../Math/Bounds.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Moon {
+
+/**
+ * @brief 视锥体 - 从 ViewProjection 矩阵提取的 6 个裁剪平面
+ *
+ * 平面以 SoA 形式保存（法线 x/y/z 与 d 各一组），法线朝向视锥内部并已归一化，
+ * 点到平面的有符号距离 = dot(n, p) + d。
+ * 平面测试使用 SSE 一次处理 4 个平面（单个物体）或 4 个物体（批量包围球）。
+ */
+class Frustum {
+public:
+    enum PlaneIndex {
+        Left,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        PlaneCount
+    };
+
+    /**
+     * @brief 默认构造：不剔除任何物体
+     */
+    Frustum();
+
+    /**
+     * @brief 从 ViewProjection 矩阵提取平面（行向量系统，DirectX 风格 z ∈ [0, 1]）
+     */
+    static Frustum FromViewProjection(const Matrix4x4& viewProj);
+
+    /**
+     * @brief 获取平面（法线 + d）
+     */
+    Vector3 GetPlaneNormal(int plane) const { return Vector3(m_nx[plane], m_ny[plane], m_nz[plane]); }
+    float GetPlaneDistance(int plane) const { return m_d[plane]; }
+
+    /**
+     * @brief 包围球是否与视锥相交（保守：相交即可见）
+     */
+    bool IsSphereVisible(const Vector3& center, float radius) const;
+
+    /**
+     * @brief AABB 是否与视锥相交（保守：相交即可见）
+     */
+    bool IsAABBVisible(const AABB& box) const;
+
+    /**
+     * @brief 批量测试包围球（SoA 输入，每次 4 个物体）
+     * @param outVisible 每个物体一个字节：1 = 可见，0 = 被剔除
+     * @return 可见物体数量
+     */
+    size_t CullSpheres(const float* centerX, const float* centerY, const float* centerZ,
+                       const float* radius, size_t count, uint8_t* outVisible) const;
+
+private:
+    void SetPlane(int plane, float a, float b, float c, float d);
+
+    // 8 个槽位 = 6 个平面 + 2 个重复 Far 平面补齐到两组 SSE 寄存器
+    alignas(16) float m_nx[8];
+    alignas(16) float m_ny[8];
+    alignas(16) float m_nz[8];
+    alignas(16) float m_d[8];
+};
+
+} // namespace Moon
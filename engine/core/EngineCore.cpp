@@ -95,15 +95,10 @@ void EngineCore::SyncPhysicsToScene() {
         return;
     }
 
-    m_mainScene->TraverseActive([](Moon::SceneNode* node) {
-        if (!node) {
-            return;
-        }
-
-        Moon::RigidBody* rigidBody = node->GetComponent<Moon::RigidBody>();
-        if (rigidBody) {
+    // 直接遍历所有 RigidBody（按类型数组），只同步激活节点
+    m_mainScene->ForEachComponent<Moon::RigidBody>([](Moon::RigidBody* rigidBody) {
+        if (rigidBody->GetOwner()->IsActive()) {
             rigidBody->SyncFromPhysics();
         }
-
     });
 }
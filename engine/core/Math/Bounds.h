@@ -0,0 +1,118 @@
+#pragma once
+#include "Vector3.h"
+#include "Matrix4x4.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Moon {
+
+/**
+ * @brief 轴对齐包围盒（AABB）
+ *
+ * 默认构造为空盒（minPoint > maxPoint），Expand 任意点后变为有效。
+ * （std::min/max 加括号，避免被 windows.h 的同名宏展开）
+ */
+struct AABB {
+    Vector3 minPoint;
+    Vector3 maxPoint;
+
+    AABB()
+        : minPoint((std::numeric_limits<float>::max)(), (std::numeric_limits<float>::max)(), (std::numeric_limits<float>::max)())
+        , maxPoint(-(std::numeric_limits<float>::max)(), -(std::numeric_limits<float>::max)(), -(std::numeric_limits<float>::max)()) {}
+    AABB(const Vector3& lower, const Vector3& upper) : minPoint(lower), maxPoint(upper) {}
+
+    bool IsValid() const { return minPoint.x <= maxPoint.x && minPoint.y <= maxPoint.y && minPoint.z <= maxPoint.z; }
+
+    Vector3 GetCenter() const { return (minPoint + maxPoint) * 0.5f; }
+    Vector3 GetExtents() const { return (maxPoint - minPoint) * 0.5f; }
+
+    void Expand(const Vector3& p) {
+        minPoint = Vector3((std::min)(minPoint.x, p.x), (std::min)(minPoint.y, p.y), (std::min)(minPoint.z, p.z));
+        maxPoint = Vector3((std::max)(maxPoint.x, p.x), (std::max)(maxPoint.y, p.y), (std::max)(maxPoint.z, p.z));
+    }
+
+    /**
+     * @brief 两个包围盒的并集
+     */
+    static AABB Merge(const AABB& a, const AABB& b) {
+        AABB result = a;
+        result.Expand(b.minPoint);
+        result.Expand(b.maxPoint);
+        return result;
+    }
+
+    bool Contains(const AABB& other) const {
+        return minPoint.x <= other.minPoint.x && minPoint.y <= other.minPoint.y && minPoint.z <= other.minPoint.z &&
+               maxPoint.x >= other.maxPoint.x && maxPoint.y >= other.maxPoint.y && maxPoint.z >= other.maxPoint.z;
+    }
+
+    bool Overlaps(const AABB& other) const {
+        return minPoint.x <= other.maxPoint.x && maxPoint.x >= other.minPoint.x &&
+               minPoint.y <= other.maxPoint.y && maxPoint.y >= other.minPoint.y &&
+               minPoint.z <= other.maxPoint.z && maxPoint.z >= other.minPoint.z;
+    }
+
+    /**
+     * @brief 表面积（BVH 插入代价）
+     */
+    float SurfaceArea() const {
+        const Vector3 d = maxPoint - minPoint;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    /**
+     * @brief 点到包围盒的最近距离平方（点在盒内为 0）
+     */
+    float DistanceSquared(const Vector3& p) const {
+        const float dx = (std::max)((std::max)(minPoint.x - p.x, 0.0f), p.x - maxPoint.x);
+        const float dy = (std::max)((std::max)(minPoint.y - p.y, 0.0f), p.y - maxPoint.y);
+        const float dz = (std::max)((std::max)(minPoint.z - p.z, 0.0f), p.z - maxPoint.z);
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    /**
+     * @brief 变换后的包围盒（行向量系统，Arvo 方法：中心变换 + 范围取绝对值投影）
+     */
+    AABB Transformed(const Matrix4x4& m) const {
+        if (!IsValid()) {
+            return *this;
+        }
+        const Vector3 c = m.MultiplyPoint(GetCenter());
+        const Vector3 e = GetExtents();
+        const Vector3 r(
+            std::fabs(m.m[0][0]) * e.x + std::fabs(m.m[1][0]) * e.y + std::fabs(m.m[2][0]) * e.z,
+            std::fabs(m.m[0][1]) * e.x + std::fabs(m.m[1][1]) * e.y + std::fabs(m.m[2][1]) * e.z,
+            std::fabs(m.m[0][2]) * e.x + std::fabs(m.m[1][2]) * e.y + std::fabs(m.m[2][2]) * e.z);
+        return AABB(c - r, c + r);
+    }
+};
+
+/**
+ * @brief 包围球
+ */
+struct BoundingSphere {
+    Vector3 center;
+    float radius = -1.0f;  ///< 负数表示无效（空网格）
+
+    BoundingSphere() = default;
+    BoundingSphere(const Vector3& c, float r) : center(c), radius(r) {}
+
+    bool IsValid() const { return radius >= 0.0f; }
+
+    /**
+     * @brief 变换后的包围球（半径按最大轴缩放放大，保证仍然包含原几何体）
+     */
+    BoundingSphere Transformed(const Matrix4x4& m) const {
+        if (!IsValid()) {
+            return *this;
+        }
+        const float sx = m.m[0][0] * m.m[0][0] + m.m[0][1] * m.m[0][1] + m.m[0][2] * m.m[0][2];
+        const float sy = m.m[1][0] * m.m[1][0] + m.m[1][1] * m.m[1][1] + m.m[1][2] * m.m[1][2];
+        const float sz = m.m[2][0] * m.m[2][0] + m.m[2][1] * m.m[2][1] + m.m[2][2] * m.m[2][2];
+        const float maxScale = std::sqrt((std::max)(sx, (std::max)(sy, sz)));
+        return BoundingSphere(m.MultiplyPoint(center), radius * maxScale);
+    }
+};
+
+} // namespace Moon
@@ -1,5 +1,6 @@
 #include "Mesh.h"
 #include <atomic>
+#include <cmath>
 
 namespace Moon {
 
@@ -15,6 +16,30 @@ uint64_t Mesh::AllocateRuntimeId() {
     return g_nextMeshRuntimeId.fetch_add(1, std::memory_order_relaxed);
 }
 
+void Mesh::UpdateBounds() const {
+    m_bounds = AABB();
+    m_boundingSphere = BoundingSphere();
+    m_boundsDirty = false;
+    if (m_vertices.empty()) {
+        return;
+    }
+
+    for (const Vertex& vertex : m_vertices) {
+        m_bounds.Expand(vertex.position);
+    }
+
+    const Vector3 center = m_bounds.GetCenter();
+    float maxDistanceSq = 0.0f;
+    for (const Vertex& vertex : m_vertices) {
+        const Vector3 d = vertex.position - center;
+        const float distanceSq = d.x * d.x + d.y * d.y + d.z * d.z;
+        if (distanceSq > maxDistanceSq) {
+            maxDistanceSq = distanceSq;
+        }
+    }
+    m_boundingSphere = BoundingSphere(center, std::sqrt(maxDistanceSq));
+}
+
 Mesh* CreateCubeMesh(float size) {
     Mesh* mesh = new Mesh();
     
@@ -5,6 +5,7 @@
 
 #include "../Camera/Camera.h"
 #include "../Math/Vector2.h"
+#include "../Math/Bounds.h"
 
 namespace Moon {
 
@@ -80,10 +81,12 @@ public:
 
     void SetVertices(const std::vector<Vertex>& vertices) {
         m_vertices = vertices;
+        m_boundsDirty = true;
     }
 
     void SetVertices(std::vector<Vertex>&& vertices) {
         m_vertices = std::move(vertices);
+        m_boundsDirty = true;
     }
 
     void SetIndices(const std::vector<uint32_t>& indices) {
@@ -103,6 +106,26 @@ public:
 
     uint64_t GetRuntimeId() const { return m_runtimeId; }
 
+    /**
+     * @brief 局部空间包围盒（首次访问时计算，SetVertices / Clear 后失效）
+     */
+    const AABB& GetBounds() const {
+        if (m_boundsDirty) {
+            UpdateBounds();
+        }
+        return m_bounds;
+    }
+
+    /**
+     * @brief 局部空间包围球（以 AABB 中心为球心，半径为到最远顶点的距离）
+     */
+    const BoundingSphere& GetBoundingSphere() const {
+        if (m_boundsDirty) {
+            UpdateBounds();
+        }
+        return m_boundingSphere;
+    }
+
     bool IsValid() const {
         return !m_vertices.empty() && !m_indices.empty() && (m_indices.size() % 3 == 0);
     }
@@ -110,14 +133,21 @@ public:
     void Clear() {
         m_vertices.clear();
         m_indices.clear();
+        m_boundsDirty = true;
     }
 
 private:
     static uint64_t AllocateRuntimeId();
+    void UpdateBounds() const;
 
     std::vector<Vertex> m_vertices;
     std::vector<uint32_t> m_indices;
     uint64_t m_runtimeId = 0;
+
+    // 包围体缓存（顶点变化时标脏，惰性重算）
+    mutable AABB m_bounds;
+    mutable BoundingSphere m_boundingSphere;
+    mutable bool m_boundsDirty = true;
 };
 
 Mesh* CreateCubeMesh(float size = 1.0f);
@@ -267,6 +267,8 @@ std::unique_ptr<Node> BlueprintLoader::ParseNode(const void* jsonPtr, std::strin
             if (opStr == "union") csg->operation = CsgOp::Union;
             else if (opStr == "subtract") csg->operation = CsgOp::Subtract;
             else if (opStr == "intersect") csg->operation = CsgOp::Intersect;
+            else if (opStr == "union_all") csg->operation = CsgOp::UnionAll;
+            else if (opStr == "subtract_all") csg->operation = CsgOp::SubtractAll;
             else {
                 outError = "Unknown CSG operation: " + opStr;
                 return nullptr;
@@ -286,6 +288,21 @@ std::unique_ptr<Node> BlueprintLoader::ParseNode(const void* jsonPtr, std::strin
                 }
             }
 
+            // n 元运算：operands 数组（subtract_all 以第一个为被减体）
+            if (IsNaryCsgOp(csg->operation)) {
+                if (!j.contains("operands") || !j["operands"].is_array() || j["operands"].empty()) {
+                    outError = "CSG node '" + opStr + "' requires a non-empty 'operands' array";
+                    return nullptr;
+                }
+                csg->operands.reserve(j["operands"].size());
+                for (const auto& operandJson : j["operands"]) {
+                    auto operand = ParseNode(&operandJson, outError);
+                    if (!operand) return nullptr;
+                    csg->operands.push_back(std::move(operand));
+                }
+                break;
+            }
+
             // left & right
             if (!j.contains("left") || !j.contains("right")) {
                 outError = "CSG node missing 'left' or 'right' child";
@@ -31,9 +31,15 @@ enum class PrimitiveType {
 enum class CsgOp {
     Union,
     Subtract,
-    Intersect
+    Intersect,
+    UnionAll,       // n 元并集：operands[0] ∪ operands[1] ∪ ...
+    SubtractAll     // n 元差集：operands[0] - (operands[1] ∪ operands[2] ∪ ...)
 };
 
+inline bool IsNaryCsgOp(CsgOp op) {
+    return op == CsgOp::UnionAll || op == CsgOp::SubtractAll;
+}
+
 enum class GroupOutputMode {
     Separate,
     Merge
@@ -145,6 +151,7 @@ struct CsgNode {
     CsgOp operation;
     std::unique_ptr<Node> left;
     std::unique_ptr<Node> right;
+    std::vector<std::unique_ptr<Node>> operands;   // 仅 UnionAll / SubtractAll 使用（不使用 left/right）
     CsgOptions options;
 
     CsgNode()
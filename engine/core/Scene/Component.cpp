@@ -1,8 +1,14 @@
 #include "Component.h"
 #include "SceneNode.h"
+#include <atomic>
 
 namespace Moon {
 
+ComponentTypeId Component::AllocateTypeId() {
+    static std::atomic<ComponentTypeId> s_nextTypeId{0};
+    return s_nextTypeId.fetch_add(1, std::memory_order_relaxed);
+}
+
 Component::Component(SceneNode* owner)
     : m_owner(owner)
     , m_enabled(true)
@@ -1,9 +1,23 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 
 namespace Moon {
 
 // Forward declaration
 class SceneNode;
+class Scene;
+
+/**
+ * @brief 组件类型 ID（每个 Component 子类一个，进程内稳定）
+ */
+using ComponentTypeId = uint32_t;
+
+/**
+ * @brief 无效的组件类型 ID
+ */
+constexpr ComponentTypeId kInvalidComponentTypeId = std::numeric_limits<ComponentTypeId>::max();
 
 /**
  * @brief 组件基类 - 所有组件的抽象基类
@@ -60,9 +74,39 @@ public:
      */
     virtual void Update(float deltaTime) {}
 
+    /**
+     * @brief 获取组件的具体类型 ID（由 SceneNode::AddComponent<T> 设置）
+     */
+    ComponentTypeId GetTypeId() const { return m_typeId; }
+
+    /**
+     * @brief 分配一个新的组件类型 ID（内部使用，请使用 GetComponentTypeId<T>()）
+     */
+    static ComponentTypeId AllocateTypeId();
+
 protected:
     SceneNode* m_owner;  ///< 拥有此组件的节点
     bool m_enabled;      ///< 是否启用
+
+private:
+    ComponentTypeId m_typeId = kInvalidComponentTypeId;  ///< 具体类型 ID
+    size_t m_sceneSlot = 0;                              ///< 在 Scene 按类型组件数组中的下标
+
+    // SceneNode 设置类型 ID，Scene 维护按类型的稠密数组
+    friend class SceneNode;
+    friend class Scene;
 };
 
+/**
+ * @brief 获取组件类型 T 的类型 ID
+ *
+ * 第一次调用时分配，之后恒定。只按精确类型匹配（不考虑继承关系），
+ * 用于 SceneNode::GetComponent<T> 的 O(1) 查找和 Scene 的按类型组件数组。
+ */
+template<typename T>
+ComponentTypeId GetComponentTypeId() {
+    static const ComponentTypeId s_typeId = Component::AllocateTypeId();
+    return s_typeId;
+}
+
 } // namespace Moon
@@ -1,5 +1,6 @@
 #include "MeshRenderer.h"
 #include "SceneNode.h"
+#include "Scene.h"
 #include "../Mesh/Mesh.h"
 #include "../../render/IRenderer.h"
 
@@ -12,6 +13,15 @@ MeshRenderer::MeshRenderer(SceneNode* owner)
 {
 }
 
+void MeshRenderer::SetMesh(std::shared_ptr<Mesh> mesh) {
+    m_mesh = mesh;
+    
+    // 包围盒随 Mesh 变化，通知场景 BVH
+    if (GetOwner() && GetOwner()->GetScene()) {
+        GetOwner()->GetScene()->MarkSpatialDirty(GetOwner());
+    }
+}
+
 void MeshRenderer::Render(IRenderer* renderer) {
     // 检查是否可见、启用、且有有效的 Mesh
     if (!m_visible || !IsEnabled() || !m_mesh || !m_mesh->IsValid()) {
@@ -39,7 +39,7 @@ public:
      * @brief 设置要渲染的 Mesh（共享所有权）
      * @param mesh Mesh 智能指针
      */
-    void SetMesh(std::shared_ptr<Mesh> mesh) { m_mesh = mesh; }
+    void SetMesh(std::shared_ptr<Mesh> mesh);
     
     /**
      * @brief 获取当前的 Mesh
@@ -59,6 +59,9 @@ public:
 private:
     std::shared_ptr<Mesh> m_mesh;  ///< 要渲染的 Mesh（共享所有权）
     bool m_visible;                ///< 是否可见
+    int32_t m_spatialProxy = -1;   ///< Scene BVH 中的叶子 ID（未加入为 -1）
+
+    friend class Scene;
 };
 
 } // namespace Moon
@@ -1,5 +1,11 @@
 #include "Scene.h"
+#include "TransformHierarchy.h"
+#include "SceneBVH.h"
+#include "MeshRenderer.h"
+#include "../Mesh/Mesh.h"
 #include "../Logging/Logger.h"
+#include <algorithm>
+#include <cmath>
 
 namespace Moon {
 
@@ -12,6 +18,13 @@ Scene::Scene(const std::string& name)
 Scene::~Scene() {
     MOON_LOG_INFO("Scene", "Destroying scene: %s", m_name.c_str());
     
+    // 扁平层级只持有裸指针，先于节点释放，避免删除节点时触发失效回写
+    m_transformHierarchy.reset();
+    
+    // 空间索引同理：节点删除时不再逐个移除叶子
+    m_spatialIndex.reset();
+    m_spatialDirty.clear();
+    
     // 删除所有节点
     for (SceneNode* node : m_allNodes) {
         delete node;
@@ -19,6 +32,8 @@ Scene::~Scene() {
     m_allNodes.clear();
     m_rootNodes.clear();
     m_pendingDelete.clear();
+    m_nodesByID.clear();
+    m_nodesByName.clear();
 }
 
 // === 节点管理 ===
@@ -26,9 +41,7 @@ Scene::~Scene() {
 SceneNode* Scene::CreateNode(const std::string& name) {
     SceneNode* node = new SceneNode(name);
     node->SetScene(this);
-    
-    m_allNodes.push_back(node);
-    m_rootNodes.push_back(node);  // 默认作为根节点
+    RegisterNode(node);
     
     return node;
 }
@@ -43,9 +56,7 @@ SceneNode* Scene::CreateNodeWithID(uint32_t id, const std::string& name) {
     
     SceneNode* node = new SceneNode(id, name);
     node->SetScene(this);
-    
-    m_allNodes.push_back(node);
-    m_rootNodes.push_back(node);  // 默认作为根节点
+    RegisterNode(node);
     
     MOON_LOG_INFO("Scene", "Created node with ID=%u, name=%s", id, name.c_str());
     
@@ -66,6 +77,8 @@ void Scene::DestroyNodeImmediate(SceneNode* node) {
         return;
     }
     
+    OnHierarchyChanged();
+    
     // 从父节点移除
     if (node->GetParent()) {
         node->GetParent()->RemoveChild(node);
@@ -74,12 +87,27 @@ void Scene::DestroyNodeImmediate(SceneNode* node) {
     // 从根节点列表移除
     RemoveRootNode(node);
     
-    // 从所有节点列表移除
-    for (auto it = m_allNodes.begin(); it != m_allNodes.end(); ++it) {
-        if (*it == node) {
-            m_allNodes.erase(it);
-            break;
-        }
+    // 从所有节点列表移除（swap-and-pop）
+    const size_t index = node->m_sceneIndex;
+    if (index < m_allNodes.size() && m_allNodes[index] == node) {
+        SceneNode* last = m_allNodes.back();
+        m_allNodes[index] = last;
+        last->m_sceneIndex = index;
+        m_allNodes.pop_back();
+    }
+    node->m_sceneIndex = SceneNode::kInvalidIndex;
+    
+    // 从哈希索引移除
+    auto idIt = m_nodesByID.find(node->GetID());
+    if (idIt != m_nodesByID.end() && idIt->second == node) {
+        m_nodesByID.erase(idIt);
+    }
+    RemoveNameIndex(node, node->GetName());
+    
+    // 从 BVH 待更新列表移除（叶子随 MeshRenderer 注销时移除）
+    if (node->m_spatialDirty) {
+        m_spatialDirty.erase(std::remove(m_spatialDirty.begin(), m_spatialDirty.end(), node), m_spatialDirty.end());
+        node->m_spatialDirty = false;
     }
     
     // 递归删除所有子节点
@@ -96,21 +124,37 @@ void Scene::DestroyNodeImmediate(SceneNode* node) {
 }
 
 SceneNode* Scene::FindNodeByName(const std::string& name) const {
-    for (SceneNode* node : m_allNodes) {
-        if (node && node->GetName() == name) {
-            return node;
+    // 同名节点取 ID 最小者，保持“最早创建的节点优先”的语义
+    auto it = m_nodesByName.find(name);
+    if (it == m_nodesByName.end()) {
+        return nullptr;
+    }
+    
+    SceneNode* found = nullptr;
+    for (SceneNode* node : it->second) {
+        if (!found || node->GetID() < found->GetID()) {
+            found = node;
         }
     }
-    return nullptr;
+    return found;
 }
 
-SceneNode* Scene::FindNodeByID(uint32_t id) const {
-    for (SceneNode* node : m_allNodes) {
-        if (node && node->GetID() == id) {
-            return node;
-        }
+std::vector<SceneNode*> Scene::FindNodesByName(const std::string& name) const {
+    auto it = m_nodesByName.find(name);
+    if (it == m_nodesByName.end()) {
+        return {};
     }
-    return nullptr;
+    
+    std::vector<SceneNode*> result = it->second;
+    std::sort(result.begin(), result.end(), [](const SceneNode* a, const SceneNode* b) {
+        return a->GetID() < b->GetID();
+    });
+    return result;
+}
+
+SceneNode* Scene::FindNodeByID(uint32_t id) const {
+    auto it = m_nodesByID.find(id);
+    return it != m_nodesByID.end() ? it->second : nullptr;
 }
 
 // === 根节点管理 ===
@@ -127,13 +171,12 @@ void Scene::AddRootNode(SceneNode* node) {
         return;
     }
     
-    // 检查是否已存在
-    for (SceneNode* existing : m_rootNodes) {
-        if (existing == node) {
-            return;
-        }
+    // 检查是否已存在（通过节点记录的下标，O(1)）
+    if (node->m_rootIndex < m_rootNodes.size() && m_rootNodes[node->m_rootIndex] == node) {
+        return;
     }
     
+    node->m_rootIndex = m_rootNodes.size();
     m_rootNodes.push_back(node);
 }
 
@@ -142,12 +185,121 @@ void Scene::RemoveRootNode(SceneNode* node) {
         return;
     }
     
-    for (auto it = m_rootNodes.begin(); it != m_rootNodes.end(); ++it) {
-        if (*it == node) {
-            m_rootNodes.erase(it);
-            return;
+    // swap-and-pop
+    const size_t index = node->m_rootIndex;
+    if (index < m_rootNodes.size() && m_rootNodes[index] == node) {
+        SceneNode* last = m_rootNodes.back();
+        m_rootNodes[index] = last;
+        last->m_rootIndex = index;
+        m_rootNodes.pop_back();
+    }
+    node->m_rootIndex = SceneNode::kInvalidIndex;
+}
+
+void Scene::RegisterNode(SceneNode* node) {
+    node->m_sceneIndex = m_allNodes.size();
+    m_allNodes.push_back(node);
+    AddRootNode(node);  // 默认作为根节点
+    
+    // 新根节点追加到扁平层级末尾不破坏先序顺序
+    if (m_transformHierarchy) {
+        m_transformHierarchy->AppendRoot(node->GetTransform());
+    }
+    
+    m_nodesByID[node->GetID()] = node;
+    AddNameIndex(node);
+}
+
+void Scene::OnNodeRenamed(SceneNode* node, const std::string& oldName) {
+    if (!node || node->m_sceneIndex == SceneNode::kInvalidIndex) {
+        return;
+    }
+    
+    RemoveNameIndex(node, oldName);
+    AddNameIndex(node);
+}
+
+void Scene::AddNameIndex(SceneNode* node) {
+    std::vector<SceneNode*>& bucket = m_nodesByName[node->GetName()];
+    node->m_nameIndex = bucket.size();
+    bucket.push_back(node);
+}
+
+void Scene::RemoveNameIndex(SceneNode* node, const std::string& name) {
+    auto it = m_nodesByName.find(name);
+    if (it == m_nodesByName.end()) {
+        return;
+    }
+    
+    // swap-and-pop（节点记录了自己在同名列表中的下标）
+    std::vector<SceneNode*>& bucket = it->second;
+    const size_t index = node->m_nameIndex;
+    if (index < bucket.size() && bucket[index] == node) {
+        SceneNode* last = bucket.back();
+        bucket[index] = last;
+        last->m_nameIndex = index;
+        bucket.pop_back();
+    }
+    node->m_nameIndex = SceneNode::kInvalidIndex;
+    
+    if (bucket.empty()) {
+        m_nodesByName.erase(it);
+    }
+}
+
+// === 按类型访问组件 ===
+
+const std::vector<Component*>& Scene::GetComponentsOfType(ComponentTypeId typeId) const {
+    static const std::vector<Component*> s_empty;
+    if (typeId >= m_componentPools.size()) {
+        return s_empty;
+    }
+    return m_componentPools[typeId];
+}
+
+void Scene::RegisterComponent(Component* component) {
+    if (!component || component->m_typeId == kInvalidComponentTypeId) {
+        return;
+    }
+    
+    const ComponentTypeId typeId = component->m_typeId;
+    if (typeId >= m_componentPools.size()) {
+        m_componentPools.resize(typeId + 1);
+    }
+    
+    std::vector<Component*>& pool = m_componentPools[typeId];
+    component->m_sceneSlot = pool.size();
+    pool.push_back(component);
+    
+    if (typeId == GetComponentTypeId<MeshRenderer>()) {
+        MarkSpatialDirty(component->GetOwner());
+    }
+}
+
+void Scene::UnregisterComponent(Component* component) {
+    if (!component || component->m_typeId >= m_componentPools.size()) {
+        return;
+    }
+    
+    if (component->m_typeId == GetComponentTypeId<MeshRenderer>()) {
+        MeshRenderer* renderer = static_cast<MeshRenderer*>(component);
+        if (m_spatialIndex && renderer->m_spatialProxy != SceneBVH::kNullNode) {
+            m_spatialIndex->DestroyProxy(renderer->m_spatialProxy);
         }
+        renderer->m_spatialProxy = SceneBVH::kNullNode;
     }
+    
+    std::vector<Component*>& pool = m_componentPools[component->m_typeId];
+    const size_t slot = component->m_sceneSlot;
+    if (slot >= pool.size() || pool[slot] != component) {
+        return;
+    }
+    
+    // swap-and-pop：用最后一个组件填补空位
+    Component* last = pool.back();
+    pool[slot] = last;
+    last->m_sceneSlot = slot;
+    pool.pop_back();
 }
 
 // === 更新 ===
@@ -162,6 +314,216 @@ void Scene::Update(float deltaTime) {
     
     // 处理待删除节点
     ProcessPendingDeletes();
+    
+    // 扁平层级：一次线性遍历更新所有脏的世界矩阵
+    UpdateTransforms();
+}
+
+// === 扁平 Transform 层级 ===
+
+void Scene::SetFlatTransformsEnabled(bool enabled) {
+    if (enabled == IsFlatTransformsEnabled()) {
+        return;
+    }
+    
+    if (enabled) {
+        m_transformHierarchy = std::make_unique<TransformHierarchy>(this);
+        m_transformHierarchy->Update();
+    } else {
+        // 先把未解析的脏标记写回 Transform，再退回递归路径
+        m_transformHierarchy->Invalidate();
+        m_transformHierarchy.reset();
+    }
+}
+
+void Scene::UpdateTransforms() {
+    if (m_transformHierarchy) {
+        m_transformHierarchy->Update();
+    }
+}
+
+void Scene::OnHierarchyChanged() {
+    if (m_transformHierarchy) {
+        m_transformHierarchy->Invalidate();
+    }
+}
+
+// === 空间查询（BVH）===
+
+SceneBVH& Scene::GetSpatialIndex() {
+    UpdateSpatialIndex();
+    return *m_spatialIndex;
+}
+
+void Scene::UpdateSpatialIndex() {
+    if (!m_spatialIndex) {
+        m_spatialIndex = std::make_unique<SceneBVH>();
+        ClearSpatialDirty();
+        ForEachComponent<MeshRenderer>([this](MeshRenderer* renderer) {
+            SyncSpatialProxy(renderer);
+        });
+        return;
+    }
+    
+    if (m_spatialDirty.empty()) {
+        return;
+    }
+    
+    // 每个节点只入列一次；子树中的 MeshRenderer 都随之移动
+    std::vector<SceneNode*> stack;
+    for (SceneNode* dirty : m_spatialDirty) {
+        stack.push_back(dirty);
+        while (!stack.empty()) {
+            SceneNode* node = stack.back();
+            stack.pop_back();
+            for (Component* component : node->m_components) {
+                if (component->m_typeId == GetComponentTypeId<MeshRenderer>()) {
+                    SyncSpatialProxy(static_cast<MeshRenderer*>(component));
+                }
+            }
+            for (size_t i = 0; i < node->GetChildCount(); ++i) {
+                stack.push_back(node->GetChild(i));
+            }
+        }
+    }
+    ClearSpatialDirty();
+}
+
+void Scene::ClearSpatialDirty() {
+    for (SceneNode* node : m_spatialDirty) {
+        node->m_spatialDirty = false;
+    }
+    m_spatialDirty.clear();
+}
+
+void Scene::SyncSpatialProxy(MeshRenderer* renderer) {
+    AABB bounds;
+    Mesh* mesh = renderer->GetMesh().get();
+    if (mesh && mesh->IsValid()) {
+        bounds = mesh->GetBounds().Transformed(renderer->GetOwner()->GetTransform()->GetWorldMatrix());
+    }
+    
+    int32_t& proxy = renderer->m_spatialProxy;
+    if (!bounds.IsValid()) {
+        if (proxy != SceneBVH::kNullNode) {
+            m_spatialIndex->DestroyProxy(proxy);
+            proxy = SceneBVH::kNullNode;
+        }
+        return;
+    }
+    
+    if (proxy == SceneBVH::kNullNode) {
+        proxy = m_spatialIndex->CreateProxy(bounds, renderer);
+    } else {
+        m_spatialIndex->MoveProxy(proxy, bounds);
+    }
+}
+
+namespace {
+
+// Möller–Trumbore 射线-三角形求交（双面），返回射线参数 t，未命中返回负数
+float IntersectRayTriangle(const Vector3& origin, const Vector3& direction,
+                           const Vector3& v0, const Vector3& v1, const Vector3& v2)
+{
+    constexpr float kEpsilon = 1e-8f;
+    const Vector3 edge1 = v1 - v0;
+    const Vector3 edge2 = v2 - v0;
+    const Vector3 p = Vector3::Cross(direction, edge2);
+    const float det = Vector3::Dot(edge1, p);
+    if (std::fabs(det) < kEpsilon) {
+        return -1.0f;
+    }
+    const float invDet = 1.0f / det;
+    const Vector3 s = origin - v0;
+    const float u = Vector3::Dot(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f) {
+        return -1.0f;
+    }
+    const Vector3 q = Vector3::Cross(s, edge1);
+    const float v = Vector3::Dot(direction, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) {
+        return -1.0f;
+    }
+    return Vector3::Dot(edge2, q) * invDet;
+}
+
+bool IsRenderable(MeshRenderer* renderer) {
+    return renderer->IsEnabled() && renderer->IsVisible() && renderer->GetOwner()->IsActive();
+}
+
+} // namespace
+
+bool Scene::Raycast(const Vector3& origin, const Vector3& direction, SceneRaycastHit& outHit, float maxDistance) {
+    SceneBVH& bvh = GetSpatialIndex();
+    
+    // 射线变换到 Mesh 局部空间后参数 t 不变（仿射变换保持直线参数化），
+    // 因此局部空间求得的 t 就是世界空间距离
+    auto rayTest = [&](MeshRenderer* renderer, float closest) {
+        if (!IsRenderable(renderer)) {
+            return -1.0f;
+        }
+        const Matrix4x4 invWorld = renderer->GetOwner()->GetTransform()->GetWorldMatrix().Inverse();
+        const Vector3 localOrigin = invWorld.MultiplyPoint(origin);
+        const Vector3 localDirection = invWorld.MultiplyPoint(origin + direction) - localOrigin;
+        
+        const Mesh* mesh = renderer->GetMesh().get();
+        const std::vector<Vertex>& vertices = mesh->GetVertices();
+        const std::vector<uint32_t>& indices = mesh->GetIndices();
+        float best = -1.0f;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            const float t = IntersectRayTriangle(localOrigin, localDirection,
+                                                 vertices[indices[i]].position,
+                                                 vertices[indices[i + 1]].position,
+                                                 vertices[indices[i + 2]].position);
+            if (t >= 0.0f && t <= closest && (best < 0.0f || t < best)) {
+                best = t;
+            }
+        }
+        return best;
+    };
+    
+    SceneBVH::RayHit hit;
+    if (!bvh.RayCast(origin, direction, maxDistance, rayTest, hit)) {
+        return false;
+    }
+    
+    outHit.renderer = hit.renderer;
+    outHit.node = hit.renderer->GetOwner();
+    outHit.distance = hit.distance;
+    outHit.point = origin + direction * hit.distance;
+    return true;
+}
+
+void Scene::QueryAABB(const AABB& box, std::vector<SceneNode*>& outNodes) {
+    std::vector<MeshRenderer*> renderers;
+    GetSpatialIndex().QueryAABB(box, renderers);
+    for (MeshRenderer* renderer : renderers) {
+        outNodes.push_back(renderer->GetOwner());
+    }
+}
+
+void Scene::FindNearest(const Vector3& point, size_t k, std::vector<SceneNode*>& outNodes,
+                        const std::function<bool(SceneNode*, float)>& filter, float maxDistance) {
+    SceneBVH& bvh = GetSpatialIndex();
+    
+    // 同一节点可能有多个叶子（多个 MeshRenderer），只取最近的一个
+    const size_t firstOutput = outNodes.size();
+    auto accept = [&](MeshRenderer* renderer, float distanceSq) {
+        SceneNode* node = renderer->GetOwner();
+        if (filter ? !filter(node, std::sqrt(distanceSq)) : !node->IsActive()) {
+            return false;
+        }
+        return std::find(outNodes.begin() + firstOutput, outNodes.end(), node) == outNodes.end();
+    };
+    
+    std::vector<SceneBVH::NearestHit> hits;
+    bvh.QueryNearest(point, k, [&](MeshRenderer* renderer, float distanceSq) {
+        if (!accept(renderer, distanceSq)) {
+            return false;
+        }
+        outNodes.push_back(renderer->GetOwner());
+        return true;
+    }, hits, maxDistance);
 }
 
 // === 遍历 ===
@@ -221,4 +583,21 @@ void Scene::TraverseNode(SceneNode* node, std::function<void(SceneNode*)> callba
     }
 }
 
+void Scene::BuildHierarchyPath(const SceneNode* node, std::vector<size_t>& outPath) const {
+    outPath.clear();
+    for (const SceneNode* current = node; current; current = current->GetParent()) {
+        const SceneNode* parent = current->GetParent();
+        size_t index = 0;
+        if (parent) {
+            while (index < parent->GetChildCount() && parent->GetChild(index) != current) {
+                ++index;
+            }
+        } else {
+            index = static_cast<size_t>(std::find(m_rootNodes.begin(), m_rootNodes.end(), current) - m_rootNodes.begin());
+        }
+        outPath.push_back(index);
+    }
+    std::reverse(outPath.begin(), outPath.end());
+}
+
 } // namespace Moon
@@ -1,11 +1,30 @@
 #pragma once
 #include "SceneNode.h"
+#include "../Math/Bounds.h"
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <vector>
 #include <functional>
+#include <memory>
+#include <unordered_map>
 
 namespace Moon {
 
+class TransformHierarchy;
+class SceneBVH;
+class MeshRenderer;
+
+/**
+ * @brief 场景射线查询结果
+ */
+struct SceneRaycastHit {
+    SceneNode* node = nullptr;
+    MeshRenderer* renderer = nullptr;
+    float distance = 0.0f;  ///< 沿射线方向的距离
+    Vector3 point;          ///< 世界空间命中点
+};
+
 /**
  * @brief 场景管理器 - 管理场景中的所有节点
  * 
@@ -72,18 +91,30 @@ public:
     void DestroyNodeImmediate(SceneNode* node);
     
     /**
-     * @brief 按名称查找节点
+     * @brief 按名称查找节点（哈希索引）
      * @param name 节点名称
-     * @return 找到的第一个匹配节点，未找到返回 nullptr
+     * @return 同名节点中 ID 最小（最早创建）的节点，未找到返回 nullptr
      */
     SceneNode* FindNodeByName(const std::string& name) const;
     
     /**
-     * @brief 按 ID 查找节点
+     * @brief 按名称查找所有同名节点（哈希索引）
+     * @param name 节点名称
+     * @return 匹配节点列表（按 ID 升序）
+     */
+    std::vector<SceneNode*> FindNodesByName(const std::string& name) const;
+    
+    /**
+     * @brief 按 ID 查找节点（哈希索引，O(1)）
      * @param id 节点 ID
      * @return 找到的节点，未找到返回 nullptr
      */
     SceneNode* FindNodeByID(uint32_t id) const;
+    
+    /**
+     * @brief 获取场景中节点总数
+     */
+    size_t GetNodeCount() const { return m_allNodes.size(); }
 
     // === 根节点管理 ===
     
@@ -112,6 +143,92 @@ public:
      */
     void Update(float deltaTime);
 
+    // === 扁平 Transform 层级（可选）===
+    
+    /**
+     * @brief 启用/禁用扁平 Transform 层级
+     * @param enabled true=启用 SoA 存储，每帧一次线性更新世界矩阵
+     * 
+     * 适用于大量节点的场景（例如生成的建筑），默认禁用
+     */
+    void SetFlatTransformsEnabled(bool enabled);
+    
+    /**
+     * @brief 是否启用了扁平 Transform 层级
+     */
+    bool IsFlatTransformsEnabled() const { return m_transformHierarchy != nullptr; }
+    
+    /**
+     * @brief 获取扁平 Transform 层级（未启用返回 nullptr）
+     */
+    TransformHierarchy* GetTransformHierarchy() const { return m_transformHierarchy.get(); }
+    
+    /**
+     * @brief 批量更新所有脏的世界矩阵（启用扁平层级时由 Update 每帧调用）
+     */
+    void UpdateTransforms();
+
+    // === 空间查询（BVH）===
+    
+    /**
+     * @brief 获取场景 BVH（首次调用时构建，之后只增量更新变化的节点）
+     * 
+     * 叶子为每个 MeshRenderer 的世界空间包围盒。构建后，Transform 变脏、
+     * MeshRenderer 增删或更换 Mesh 都会记录到待更新列表，下次查询前 refit。
+     */
+    SceneBVH& GetSpatialIndex();
+    
+    /**
+     * @brief 把待更新列表中的节点（及其子树）同步到 BVH
+     */
+    void UpdateSpatialIndex();
+    
+    /**
+     * @brief 待同步到 BVH 的节点数（每个节点最多计一次）
+     */
+    size_t GetPendingSpatialUpdateCount() const { return m_spatialDirty.size(); }
+    
+    /**
+     * @brief 标记节点子树的包围盒需要更新
+     * 
+     * Transform / MeshRenderer 会自动调用；直接修改共享 Mesh 的顶点后需手动调用。
+     * 每个节点在两次同步之间只入列一次，列表长度不超过节点数。
+     */
+    void MarkSpatialDirty(SceneNode* node) {
+        if (m_spatialIndex && node && !node->m_spatialDirty) {
+            node->m_spatialDirty = true;
+            m_spatialDirty.push_back(node);
+        }
+    }
+    
+    /**
+     * @brief 射线拾取（包围盒粗测 + 三角形精测，只考虑激活且可见的 MeshRenderer）
+     * @param origin 射线起点
+     * @param direction 射线方向（单位向量）
+     * @param outHit 输出最近命中
+     * @param maxDistance 最大距离
+     * @return 是否命中
+     */
+    bool Raycast(const Vector3& origin, const Vector3& direction, SceneRaycastHit& outHit,
+                 float maxDistance = (std::numeric_limits<float>::max)());
+    
+    /**
+     * @brief 收集世界空间包围盒与 box 相交的节点（包含未激活节点）
+     */
+    void QueryAABB(const AABB& box, std::vector<SceneNode*>& outNodes);
+    
+    /**
+     * @brief k 最近邻：按到 Mesh 世界包围盒的距离升序返回节点
+     * @param point 查询点
+     * @param k 最多返回的数量
+     * @param outNodes 输出节点（同一节点只出现一次）
+     * @param filter 过滤回调（节点，距离），返回 false 跳过；为空时接受所有激活节点
+     * @param maxDistance 最大搜索距离（超出的 Mesh 不会被访问）
+     */
+    void FindNearest(const Vector3& point, size_t k, std::vector<SceneNode*>& outNodes,
+                     const std::function<bool(SceneNode*, float)>& filter = nullptr,
+                     float maxDistance = (std::numeric_limits<float>::max)());
+
     // === 遍历 ===
     
     /**
@@ -126,6 +243,66 @@ public:
      */
     void TraverseActive(std::function<void(SceneNode*)> callback);
 
+    // === 按类型访问组件 ===
+    
+    /**
+     * @brief 获取场景中某类型组件的稠密数组（不保证层级顺序）
+     * @param typeId 组件类型 ID
+     */
+    const std::vector<Component*>& GetComponentsOfType(ComponentTypeId typeId) const;
+    
+    /**
+     * @brief 获取场景中 T 类型组件的数量
+     */
+    template<typename T>
+    size_t GetComponentCount() const {
+        return GetComponentsOfType(GetComponentTypeId<T>()).size();
+    }
+    
+    /**
+     * @brief 遍历场景中所有 T 类型的组件（无需遍历节点层级）
+     * @param callback 回调函数，接收 T* 作为参数
+     * 
+     * 包含未激活节点上的组件，调用方自行检查 IsEnabled()/IsActive()。
+     * ⚠️ 回调中不要添加/移除 T 类型的组件
+     */
+    template<typename T, typename Func>
+    void ForEachComponent(Func&& callback) const {
+        static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+        for (Component* comp : GetComponentsOfType(GetComponentTypeId<T>())) {
+            callback(static_cast<T*>(comp));
+        }
+    }
+    
+    /**
+     * @brief 按层级深度优先顺序（与 Traverse 一致）收集 T 类型组件
+     * @param outComponents 输出组件列表，每个节点只取 GetComponent<T>() 返回的那个
+     * 
+     * 只访问持有 T 的节点及其祖先，适合"取第一个"这类依赖层级顺序的查找（光源、天空盒、环境）。
+     */
+    template<typename T>
+    void CollectComponentsInHierarchyOrder(std::vector<T*>& outComponents) const {
+        static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+        std::vector<std::pair<std::vector<size_t>, T*>> ordered;
+        for (Component* comp : GetComponentsOfType(GetComponentTypeId<T>())) {
+            T* typed = static_cast<T*>(comp);
+            SceneNode* owner = typed->GetOwner();
+            if (owner && owner->GetComponent<T>() == typed) {
+                ordered.emplace_back();
+                ordered.back().second = typed;
+                BuildHierarchyPath(owner, ordered.back().first);
+            }
+        }
+        std::sort(ordered.begin(), ordered.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        
+        outComponents.clear();
+        outComponents.reserve(ordered.size());
+        for (const auto& entry : ordered) {
+            outComponents.push_back(entry.second);
+        }
+    }
+
     // === 未来扩展：序列化 ===
     // bool SaveToFile(const std::string& path);
     // bool LoadFromFile(const std::string& path);
@@ -133,8 +310,14 @@ public:
 private:
     std::string m_name;                       ///< 场景名称
     std::vector<SceneNode*> m_rootNodes;      ///< 顶层节点列表
-    std::vector<SceneNode*> m_allNodes;       ///< 所有节点列表
+    std::vector<SceneNode*> m_allNodes;       ///< 所有节点列表（swap-and-pop 删除，无序）
+    std::unordered_map<uint32_t, SceneNode*> m_nodesByID;          ///< ID → 节点
+    std::unordered_map<std::string, std::vector<SceneNode*>> m_nodesByName; ///< 名称 → 同名节点（multimap）
     std::vector<SceneNode*> m_pendingDelete;  ///< 待删除节点列表
+    std::vector<std::vector<Component*>> m_componentPools;  ///< 按类型 ID 索引的组件稠密数组
+    std::unique_ptr<TransformHierarchy> m_transformHierarchy;  ///< 扁平 Transform 层级（可选）
+    std::unique_ptr<SceneBVH> m_spatialIndex;  ///< 空间索引（首次查询时构建）
+    std::vector<SceneNode*> m_spatialDirty;    ///< 待同步到 BVH 的子树根节点（各不相同，见 SceneNode::m_spatialDirty）
     
     /**
      * @brief 添加根节点
@@ -146,6 +329,51 @@ private:
      */
     void RemoveRootNode(SceneNode* node);
     
+    /**
+     * @brief 层级结构变化（父子关系改变/节点删除）时调用
+     */
+    void OnHierarchyChanged();
+    
+    /**
+     * @brief 把新节点加入所有节点列表、根节点列表和哈希索引
+     */
+    void RegisterNode(SceneNode* node);
+    
+    /**
+     * @brief 节点改名时更新名称索引（SceneNode::SetName 调用）
+     */
+    void OnNodeRenamed(SceneNode* node, const std::string& oldName);
+    
+    /**
+     * @brief 把节点加入名称索引
+     */
+    void AddNameIndex(SceneNode* node);
+    
+    /**
+     * @brief 从名称索引中移除节点
+     */
+    void RemoveNameIndex(SceneNode* node, const std::string& name);
+    
+    /**
+     * @brief 注册组件到按类型数组（SceneNode 添加组件或加入场景时调用）
+     */
+    void RegisterComponent(Component* component);
+    
+    /**
+     * @brief 从按类型数组注销组件（swap-and-pop，O(1)）
+     */
+    void UnregisterComponent(Component* component);
+    
+    /**
+     * @brief 按当前 Mesh 和世界矩阵创建/更新/移除 MeshRenderer 的 BVH 叶子
+     */
+    void SyncSpatialProxy(MeshRenderer* renderer);
+    
+    /**
+     * @brief 清空 BVH 待更新列表并复位节点的入列标记
+     */
+    void ClearSpatialDirty();
+    
     /**
      * @brief 处理待删除节点
      */
@@ -156,6 +384,11 @@ private:
      */
     void TraverseNode(SceneNode* node, std::function<void(SceneNode*)> callback);
     
+    /**
+     * @brief 计算节点的层级路径（根节点序号 + 逐级子节点序号），按字典序比较即为 Traverse 顺序
+     */
+    void BuildHierarchyPath(const SceneNode* node, std::vector<size_t>& outPath) const;
+    
     // 供 SceneNode 使用的内部方法
     friend class SceneNode;
 };
@@ -0,0 +1,496 @@
+#include "SceneBVH.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+namespace Moon {
+
+namespace {
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+constexpr float kMaxFloat = (std::numeric_limits<float>::max)();
+
+/**
+ * @brief 射线与包围盒的 slab 测试
+ * @param invDirection 方向分量的倒数（分量为 0 时为 ±inf）
+ * @return 是否在 [0, maxDistance] 内相交；outEntry 为进入距离（起点在盒内时为 0）
+ */
+bool IntersectRayAABB(const Vector3& origin, const Vector3& invDirection, const AABB& box,
+                      float maxDistance, float& outEntry)
+{
+    float tMin = 0.0f;
+    float tMax = maxDistance;
+    const float o[3] = {origin.x, origin.y, origin.z};
+    const float inv[3] = {invDirection.x, invDirection.y, invDirection.z};
+    const float lo[3] = {box.minPoint.x, box.minPoint.y, box.minPoint.z};
+    const float hi[3] = {box.maxPoint.x, box.maxPoint.y, box.maxPoint.z};
+    for (int axis = 0; axis < 3; ++axis) {
+        if (std::isinf(inv[axis])) {
+            // 射线与该轴平行：起点必须在 slab 内
+            if (o[axis] < lo[axis] || o[axis] > hi[axis]) {
+                return false;
+            }
+            continue;
+        }
+        float t0 = (lo[axis] - o[axis]) * inv[axis];
+        float t1 = (hi[axis] - o[axis]) * inv[axis];
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        tMin = (std::max)(tMin, t0);
+        tMax = (std::min)(tMax, t1);
+        if (tMin > tMax) {
+            return false;
+        }
+    }
+    outEntry = tMin;
+    return true;
+}
+
+} // namespace
+
+SceneBVH::SceneBVH() = default;
+
+// === 代理管理 ===
+
+int32_t SceneBVH::CreateProxy(const AABB& bounds, MeshRenderer* renderer)
+{
+    const int32_t proxy = AllocateNode();
+    Node& node = m_nodes[proxy];
+    const Vector3 margin(kFatMargin, kFatMargin, kFatMargin);
+    node.bounds = bounds;
+    node.fatBounds = AABB(bounds.minPoint - margin, bounds.maxPoint + margin);
+    node.renderer = renderer;
+    node.height = 0;
+    InsertLeaf(proxy);
+    ++m_proxyCount;
+    return proxy;
+}
+
+void SceneBVH::DestroyProxy(int32_t proxy)
+{
+    if (proxy < 0 || proxy >= static_cast<int32_t>(m_nodes.size()) || !m_nodes[proxy].IsLeaf() ||
+        m_nodes[proxy].height != 0) {
+        return;
+    }
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --m_proxyCount;
+}
+
+bool SceneBVH::MoveProxy(int32_t proxy, const AABB& bounds)
+{
+    Node& node = m_nodes[proxy];
+    node.bounds = bounds;
+    if (node.fatBounds.Contains(bounds)) {
+        return false;
+    }
+
+    RemoveLeaf(proxy);
+    const Vector3 margin(kFatMargin, kFatMargin, kFatMargin);
+    m_nodes[proxy].fatBounds = AABB(bounds.minPoint - margin, bounds.maxPoint + margin);
+    InsertLeaf(proxy);
+    return true;
+}
+
+void SceneBVH::Clear()
+{
+    m_nodes.clear();
+    m_root = kNullNode;
+    m_freeList = kNullNode;
+    m_proxyCount = 0;
+}
+
+// === 查询 ===
+
+void SceneBVH::QueryAABB(const AABB& box, std::vector<MeshRenderer*>& outRenderers) const
+{
+    if (m_root == kNullNode) {
+        return;
+    }
+
+    thread_local std::vector<int32_t> stack;
+    stack.clear();
+    stack.push_back(m_root);
+    while (!stack.empty()) {
+        const Node& node = m_nodes[stack.back()];
+        stack.pop_back();
+        if (!node.fatBounds.Overlaps(box)) {
+            continue;
+        }
+        if (node.IsLeaf()) {
+            if (node.bounds.Overlaps(box)) {
+                outRenderers.push_back(node.renderer);
+            }
+            continue;
+        }
+        stack.push_back(node.child1);
+        stack.push_back(node.child2);
+    }
+}
+
+bool SceneBVH::RayCast(const Vector3& origin, const Vector3& direction, float maxDistance,
+                       const RayTestFn& rayTest, RayHit& outHit) const
+{
+    if (m_root == kNullNode) {
+        return false;
+    }
+
+    const Vector3 invDirection(
+        direction.x != 0.0f ? 1.0f / direction.x : kInfinity,
+        direction.y != 0.0f ? 1.0f / direction.y : kInfinity,
+        direction.z != 0.0f ? 1.0f / direction.z : kInfinity);
+
+    float closest = maxDistance;
+    bool hit = false;
+
+    thread_local std::vector<int32_t> stack;
+    stack.clear();
+    stack.push_back(m_root);
+    while (!stack.empty()) {
+        const int32_t index = stack.back();
+        stack.pop_back();
+        const Node& node = m_nodes[index];
+
+        float entry = 0.0f;
+        if (node.IsLeaf()) {
+            if (!IntersectRayAABB(origin, invDirection, node.bounds, closest, entry)) {
+                continue;
+            }
+            const float distance = rayTest ? rayTest(node.renderer, closest) : entry;
+            if (distance >= 0.0f && distance <= closest) {
+                closest = distance;
+                outHit.renderer = node.renderer;
+                outHit.distance = distance;
+                hit = true;
+            }
+            continue;
+        }
+
+        if (!IntersectRayAABB(origin, invDirection, node.fatBounds, closest, entry)) {
+            continue;
+        }
+
+        // 近的子节点后入栈、先访问，尽早缩短 closest
+        float entry1 = kInfinity;
+        float entry2 = kInfinity;
+        const bool hit1 = IntersectRayAABB(origin, invDirection, m_nodes[node.child1].fatBounds, closest, entry1);
+        const bool hit2 = IntersectRayAABB(origin, invDirection, m_nodes[node.child2].fatBounds, closest, entry2);
+        if (hit1 && hit2) {
+            if (entry1 <= entry2) {
+                stack.push_back(node.child2);
+                stack.push_back(node.child1);
+            } else {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        } else if (hit1) {
+            stack.push_back(node.child1);
+        } else if (hit2) {
+            stack.push_back(node.child2);
+        }
+    }
+    return hit;
+}
+
+void SceneBVH::QueryNearest(const Vector3& point, size_t k, const NearestFilterFn& filter,
+                            std::vector<NearestHit>& outHits, float maxDistance) const
+{
+    if (m_root == kNullNode || k == 0) {
+        return;
+    }
+
+    // 最佳优先：父节点的胖包围盒包含子节点的胖包围盒及叶子的精确包围盒，
+    // 入队距离沿树单调不减，弹出的叶子即按距离升序
+    struct Entry {
+        float distanceSq;
+        int32_t node;
+        bool operator>(const Entry& other) const { return distanceSq > other.distanceSq; }
+    };
+    auto makeEntry = [&](int32_t index) {
+        const Node& node = m_nodes[index];
+        return Entry{(node.IsLeaf() ? node.bounds : node.fatBounds).DistanceSquared(point), index};
+    };
+
+    const float maxDistanceSq = maxDistance < std::sqrt(kMaxFloat) ? maxDistance * maxDistance : kMaxFloat;
+
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    open.push(makeEntry(m_root));
+
+    size_t found = 0;
+    while (!open.empty() && found < k) {
+        const Entry entry = open.top();
+        open.pop();
+        if (entry.distanceSq > maxDistanceSq) {
+            break;  // 剩余节点都更远
+        }
+        const Node& node = m_nodes[entry.node];
+
+        if (node.IsLeaf()) {
+            if (!filter || filter(node.renderer, entry.distanceSq)) {
+                outHits.push_back({node.renderer, entry.distanceSq});
+                ++found;
+            }
+            continue;
+        }
+
+        open.push(makeEntry(node.child1));
+        open.push(makeEntry(node.child2));
+    }
+}
+
+// === 树结构 ===
+
+int32_t SceneBVH::AllocateNode()
+{
+    if (m_freeList == kNullNode) {
+        m_nodes.emplace_back();
+        return static_cast<int32_t>(m_nodes.size() - 1);
+    }
+
+    const int32_t index = m_freeList;
+    m_freeList = m_nodes[index].parent;
+    m_nodes[index] = Node();
+    return index;
+}
+
+void SceneBVH::FreeNode(int32_t index)
+{
+    Node& node = m_nodes[index];
+    node = Node();
+    node.parent = m_freeList;
+    m_freeList = index;
+}
+
+void SceneBVH::InsertLeaf(int32_t leaf)
+{
+    if (m_root == kNullNode) {
+        m_root = leaf;
+        m_nodes[leaf].parent = kNullNode;
+        return;
+    }
+
+    // 沿表面积代价最小的方向下降寻找兄弟节点（分支限界的贪心近似）
+    const AABB leafBounds = m_nodes[leaf].fatBounds;
+    int32_t index = m_root;
+    while (!m_nodes[index].IsLeaf()) {
+        const Node& node = m_nodes[index];
+        const float area = node.fatBounds.SurfaceArea();
+        const float combinedArea = AABB::Merge(node.fatBounds, leafBounds).SurfaceArea();
+
+        // 在此处新建父节点的代价，以及继续下降时祖先增大的代价
+        const float cost = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int32_t child) {
+            const Node& c = m_nodes[child];
+            const float merged = AABB::Merge(leafBounds, c.fatBounds).SurfaceArea();
+            return (c.IsLeaf() ? merged : merged - c.fatBounds.SurfaceArea()) + inheritanceCost;
+        };
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+    const int32_t sibling = index;
+
+    const int32_t newParent = AllocateNode();  // 可能扩容 m_nodes，之后再取引用
+    const int32_t oldParent = m_nodes[sibling].parent;
+    Node& parentNode = m_nodes[newParent];
+    parentNode.parent = oldParent;
+    parentNode.fatBounds = AABB::Merge(leafBounds, m_nodes[sibling].fatBounds);
+    parentNode.height = m_nodes[sibling].height + 1;
+    parentNode.child1 = sibling;
+    parentNode.child2 = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent != kNullNode) {
+        Node& old = m_nodes[oldParent];
+        if (old.child1 == sibling) {
+            old.child1 = newParent;
+        } else {
+            old.child2 = newParent;
+        }
+    } else {
+        m_root = newParent;
+    }
+
+    // 向上修正高度与包围盒，沿途旋转保持平衡
+    index = m_nodes[leaf].parent;
+    while (index != kNullNode) {
+        index = Balance(index);
+        Node& node = m_nodes[index];
+        node.height = 1 + (std::max)(m_nodes[node.child1].height, m_nodes[node.child2].height);
+        node.fatBounds = AABB::Merge(m_nodes[node.child1].fatBounds, m_nodes[node.child2].fatBounds);
+        index = node.parent;
+    }
+}
+
+void SceneBVH::RemoveLeaf(int32_t leaf)
+{
+    if (leaf == m_root) {
+        m_root = kNullNode;
+        return;
+    }
+
+    const int32_t parent = m_nodes[leaf].parent;
+    const int32_t grandParent = m_nodes[parent].parent;
+    const int32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grandParent == kNullNode) {
+        m_root = sibling;
+        m_nodes[sibling].parent = kNullNode;
+        FreeNode(parent);
+        return;
+    }
+
+    // 用兄弟节点替换父节点
+    Node& grand = m_nodes[grandParent];
+    if (grand.child1 == parent) {
+        grand.child1 = sibling;
+    } else {
+        grand.child2 = sibling;
+    }
+    m_nodes[sibling].parent = grandParent;
+    FreeNode(parent);
+
+    int32_t index = grandParent;
+    while (index != kNullNode) {
+        index = Balance(index);
+        Node& node = m_nodes[index];
+        node.height = 1 + (std::max)(m_nodes[node.child1].height, m_nodes[node.child2].height);
+        node.fatBounds = AABB::Merge(m_nodes[node.child1].fatBounds, m_nodes[node.child2].fatBounds);
+        index = node.parent;
+    }
+}
+
+int32_t SceneBVH::Balance(int32_t iA)
+{
+    Node& A = m_nodes[iA];
+    if (A.IsLeaf() || A.height < 2) {
+        return iA;
+    }
+
+    const int32_t iB = A.child1;
+    const int32_t iC = A.child2;
+    Node& B = m_nodes[iB];
+    Node& C = m_nodes[iC];
+    const int32_t balance = C.height - B.height;
+
+    auto replaceInParent = [this, iA](int32_t newChild, int32_t parent) {
+        if (parent == kNullNode) {
+            m_root = newChild;
+        } else if (m_nodes[parent].child1 == iA) {
+            m_nodes[parent].child1 = newChild;
+        } else {
+            m_nodes[parent].child2 = newChild;
+        }
+    };
+
+    // C 上提
+    if (balance > 1) {
+        const int32_t iF = C.child1;
+        const int32_t iG = C.child2;
+        Node& F = m_nodes[iF];
+        Node& G = m_nodes[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+        replaceInParent(iC, C.parent);
+
+        if (F.height > G.height) {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.fatBounds = AABB::Merge(B.fatBounds, G.fatBounds);
+            C.fatBounds = AABB::Merge(A.fatBounds, F.fatBounds);
+            A.height = 1 + (std::max)(B.height, G.height);
+            C.height = 1 + (std::max)(A.height, F.height);
+        } else {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.fatBounds = AABB::Merge(B.fatBounds, F.fatBounds);
+            C.fatBounds = AABB::Merge(A.fatBounds, G.fatBounds);
+            A.height = 1 + (std::max)(B.height, F.height);
+            C.height = 1 + (std::max)(A.height, G.height);
+        }
+        return iC;
+    }
+
+    // B 上提
+    if (balance < -1) {
+        const int32_t iD = B.child1;
+        const int32_t iE = B.child2;
+        Node& D = m_nodes[iD];
+        Node& E = m_nodes[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+        replaceInParent(iB, B.parent);
+
+        if (D.height > E.height) {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.fatBounds = AABB::Merge(C.fatBounds, E.fatBounds);
+            B.fatBounds = AABB::Merge(A.fatBounds, D.fatBounds);
+            A.height = 1 + (std::max)(C.height, E.height);
+            B.height = 1 + (std::max)(A.height, D.height);
+        } else {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.fatBounds = AABB::Merge(C.fatBounds, D.fatBounds);
+            B.fatBounds = AABB::Merge(A.fatBounds, E.fatBounds);
+            A.height = 1 + (std::max)(C.height, D.height);
+            B.height = 1 + (std::max)(A.height, E.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+// === 校验 ===
+
+bool SceneBVH::Validate() const
+{
+    if (m_root == kNullNode) {
+        return m_proxyCount == 0;
+    }
+    if (m_nodes[m_root].parent != kNullNode) {
+        return false;
+    }
+    return ValidateNode(m_root, kNullNode);
+}
+
+bool SceneBVH::ValidateNode(int32_t index, int32_t parent) const
+{
+    const Node& node = m_nodes[index];
+    if (node.parent != parent) {
+        return false;
+    }
+    if (node.IsLeaf()) {
+        return node.height == 0 && node.child2 == kNullNode && node.fatBounds.Contains(node.bounds);
+    }
+
+    const Node& c1 = m_nodes[node.child1];
+    const Node& c2 = m_nodes[node.child2];
+    if (node.height != 1 + (std::max)(c1.height, c2.height)) {
+        return false;
+    }
+    if (!node.fatBounds.Contains(c1.fatBounds) || !node.fatBounds.Contains(c2.fatBounds)) {
+        return false;
+    }
+    return ValidateNode(node.child1, index) && ValidateNode(node.child2, index);
+}
+
+} // namespace Moon
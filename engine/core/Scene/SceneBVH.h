@@ -0,0 +1,154 @@
+#pragma once
+#include "../Math/Bounds.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace Moon {
+
+class MeshRenderer;
+
+/**
+ * @brief 场景包围体层次（动态 AABB 树）
+ *
+ * 每个叶子对应一个 MeshRenderer 的世界空间包围盒。叶子保存精确包围盒（用于查询）
+ * 和外扩的“胖”包围盒（用于树结构）：物体小幅移动时精确包围盒仍在胖包围盒内，
+ * 只更新叶子数据，不改动树；超出时才移除并按表面积代价重新插入，插入路径上
+ * 通过旋转保持平衡。
+ *
+ * 由 Scene 持有并维护（见 Scene::GetSpatialIndex），一般不需要直接创建。
+ */
+class SceneBVH {
+public:
+    static constexpr int32_t kNullNode = -1;
+
+    /// 胖包围盒的外扩量（世界单位）
+    static constexpr float kFatMargin = 0.1f;
+
+    /**
+     * @brief 射线命中结果
+     */
+    struct RayHit {
+        MeshRenderer* renderer = nullptr;
+        float distance = 0.0f;
+    };
+
+    /**
+     * @brief 最近邻查询结果（按距离升序）
+     */
+    struct NearestHit {
+        MeshRenderer* renderer = nullptr;
+        float distanceSq = 0.0f;  ///< 查询点到精确包围盒的距离平方
+    };
+
+    /**
+     * @brief 射线精确测试回调
+     * @return 命中距离（沿射线方向），未命中返回负数；maxDistance 之外的命中可直接忽略
+     */
+    using RayTestFn = std::function<float(MeshRenderer* renderer, float maxDistance)>;
+
+    /**
+     * @brief 最近邻过滤回调（返回 false 跳过该叶子）
+     */
+    using NearestFilterFn = std::function<bool(MeshRenderer* renderer, float distanceSq)>;
+
+    SceneBVH();
+
+    /**
+     * @brief 插入叶子
+     * @return 代理 ID（用于 MoveProxy / DestroyProxy）
+     */
+    int32_t CreateProxy(const AABB& bounds, MeshRenderer* renderer);
+
+    /**
+     * @brief 移除叶子
+     */
+    void DestroyProxy(int32_t proxy);
+
+    /**
+     * @brief 更新叶子包围盒
+     * @return true 表示叶子被重新插入（超出了胖包围盒）
+     */
+    bool MoveProxy(int32_t proxy, const AABB& bounds);
+
+    MeshRenderer* GetRenderer(int32_t proxy) const { return m_nodes[proxy].renderer; }
+    const AABB& GetBounds(int32_t proxy) const { return m_nodes[proxy].bounds; }
+    const AABB& GetFatBounds(int32_t proxy) const { return m_nodes[proxy].fatBounds; }
+
+    /**
+     * @brief 收集精确包围盒与 box 相交的叶子
+     */
+    void QueryAABB(const AABB& box, std::vector<MeshRenderer*>& outRenderers) const;
+
+    /**
+     * @brief 射线查询最近命中
+     * @param origin 射线起点
+     * @param direction 射线方向（单位向量）
+     * @param maxDistance 最大距离
+     * @param rayTest 叶子精确测试（为空时以包围盒进入距离作为命中距离）
+     * @param outHit 输出最近命中
+     * @return 是否命中
+     *
+     * 只访问包围盒进入距离小于当前最近命中的节点。
+     */
+    bool RayCast(const Vector3& origin, const Vector3& direction, float maxDistance,
+                 const RayTestFn& rayTest, RayHit& outHit) const;
+
+    /**
+     * @brief k 最近邻（到精确包围盒的距离，最佳优先遍历）
+     * @param point 查询点
+     * @param k 最多返回的数量
+     * @param filter 过滤回调（可为空）
+     * @param outHits 输出，按距离升序
+     * @param maxDistance 最大距离（更远的节点不再展开）
+     */
+    void QueryNearest(const Vector3& point, size_t k, const NearestFilterFn& filter,
+                      std::vector<NearestHit>& outHits,
+                      float maxDistance = (std::numeric_limits<float>::max)()) const;
+
+    /**
+     * @brief 清空所有叶子
+     */
+    void Clear();
+
+    size_t GetProxyCount() const { return m_proxyCount; }
+
+    /**
+     * @brief 树高（空树为 0，只有一个叶子为 1）
+     */
+    int32_t GetHeight() const { return m_root == kNullNode ? 0 : m_nodes[m_root].height + 1; }
+
+    /**
+     * @brief 检查父子指针、高度与包含关系（测试用）
+     */
+    bool Validate() const;
+
+private:
+    struct Node {
+        AABB fatBounds;   ///< 树结构使用的包围盒（叶子为外扩后的包围盒）
+        AABB bounds;      ///< 叶子的精确包围盒
+        MeshRenderer* renderer = nullptr;
+        int32_t parent = kNullNode;  ///< 空闲节点复用为 free list 的 next
+        int32_t child1 = kNullNode;
+        int32_t child2 = kNullNode;
+        int32_t height = -1;         ///< 叶子为 0，空闲节点为 -1
+
+        bool IsLeaf() const { return child1 == kNullNode; }
+    };
+
+    int32_t AllocateNode();
+    void FreeNode(int32_t node);
+    void InsertLeaf(int32_t leaf);
+    void RemoveLeaf(int32_t leaf);
+    int32_t Balance(int32_t node);
+    bool ValidateNode(int32_t node, int32_t parent) const;
+
+    std::vector<Node> m_nodes;
+    int32_t m_root = kNullNode;
+    int32_t m_freeList = kNullNode;
+    size_t m_proxyCount = 0;
+};
+
+} // namespace Moon
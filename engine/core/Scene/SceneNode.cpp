@@ -1,6 +1,7 @@
 #include "SceneNode.h"
 #include "Scene.h"
 #include "../Logging/Logger.h"
+#include <algorithm>
 
 namespace Moon {
 
@@ -14,6 +15,10 @@ SceneNode::SceneNode(const std::string& name)
     , m_transform(this)
     , m_parent(nullptr)
     , m_scene(nullptr)
+    , m_sceneIndex(kInvalidIndex)
+    , m_rootIndex(kInvalidIndex)
+    , m_nameIndex(kInvalidIndex)
+    , m_spatialDirty(false)
 {
 }
 
@@ -25,6 +30,10 @@ SceneNode::SceneNode(uint32_t id, const std::string& name)
     , m_transform(this)
     , m_parent(nullptr)
     , m_scene(nullptr)
+    , m_sceneIndex(kInvalidIndex)
+    , m_rootIndex(kInvalidIndex)
+    , m_nameIndex(kInvalidIndex)
+    , m_spatialDirty(false)
 {
     // 🚨 更新全局 ID 计数器（防止 ID 冲突）
     if (id >= s_nextID) {
@@ -33,11 +42,15 @@ SceneNode::SceneNode(uint32_t id, const std::string& name)
 }
 
 SceneNode::~SceneNode() {
-    // 清理所有组件
+    // 清理所有组件（先从场景的按类型数组中注销）
     for (auto it = m_components.rbegin(); it != m_components.rend(); ++it) {
+        if (m_scene) {
+            m_scene->UnregisterComponent(*it);
+        }
         delete *it;
     }
     m_components.clear();
+    m_componentSlots.clear();
     
     // 移除所有子节点的父指针（但不删除子节点，由 Scene 管理）
     for (SceneNode* child : m_children) {
@@ -48,6 +61,19 @@ SceneNode::~SceneNode() {
     m_children.clear();
 }
 
+void SceneNode::SetName(const std::string& name) {
+    if (m_name == name) {
+        return;
+    }
+    
+    std::string oldName = m_name;
+    m_name = name;
+    
+    if (m_scene) {
+        m_scene->OnNodeRenamed(this, oldName);
+    }
+}
+
 // === 激活状态 ===
 
 void SceneNode::SetActive(bool active) {
@@ -134,6 +160,9 @@ void SceneNode::AddChild(SceneNode* child) {
         }
     }
     
+    if (m_scene) {
+        m_scene->OnHierarchyChanged();
+    }
     m_children.push_back(child);
     
     // 如果子节点的父指针还没设置，设置它
@@ -150,6 +179,9 @@ void SceneNode::RemoveChild(SceneNode* child) {
     
     for (auto it = m_children.begin(); it != m_children.end(); ++it) {
         if (*it == child) {
+            if (m_scene) {
+                m_scene->OnHierarchyChanged();
+            }
             m_children.erase(it);
             return;
         }
@@ -181,18 +213,57 @@ SceneNode* SceneNode::FindChild(const std::string& name, bool recursive) {
 
 // === 组件系统 ===
 
-void SceneNode::AddComponentInternal(Component* component) {
+void SceneNode::AddComponentInternal(Component* component, ComponentTypeId typeId) {
     if (!component) {
         return;
     }
     
+    component->m_typeId = typeId;
     m_components.push_back(component);
     
+    if (typeId != kInvalidComponentTypeId) {
+        if (typeId >= m_componentSlots.size()) {
+            m_componentSlots.resize(typeId + 1, nullptr);
+        }
+        if (!m_componentSlots[typeId]) {
+            m_componentSlots[typeId] = component;
+        }
+    }
+    
+    if (m_scene) {
+        m_scene->RegisterComponent(component);
+    }
+    
     if (m_active && component->IsEnabled()) {
         component->OnEnable();
     }
 }
 
+void SceneNode::RemoveComponentInternal(Component* component) {
+    auto it = std::find(m_components.begin(), m_components.end(), component);
+    if (it == m_components.end()) {
+        return;
+    }
+    m_components.erase(it);
+    
+    // 如果移除的是该类型的首个组件，用同类型的下一个组件补位
+    const ComponentTypeId typeId = component->m_typeId;
+    if (typeId < m_componentSlots.size() && m_componentSlots[typeId] == component) {
+        m_componentSlots[typeId] = nullptr;
+        for (Component* other : m_components) {
+            if (other->m_typeId == typeId) {
+                m_componentSlots[typeId] = other;
+                break;
+            }
+        }
+    }
+    
+    if (m_scene) {
+        m_scene->UnregisterComponent(component);
+    }
+    delete component;
+}
+
 // === 更新 ===
 
 void SceneNode::Update(float deltaTime) {
@@ -218,6 +289,17 @@ void SceneNode::Update(float deltaTime) {
 // === 内部方法 ===
 
 void SceneNode::SetScene(Scene* scene) {
+    if (m_scene != scene) {
+        // 组件随节点在场景之间迁移
+        for (Component* comp : m_components) {
+            if (m_scene) {
+                m_scene->UnregisterComponent(comp);
+            }
+            if (scene) {
+                scene->RegisterComponent(comp);
+            }
+        }
+    }
     m_scene = scene;
     
     // 递归设置所有子节点的场景
@@ -56,9 +56,9 @@ public:
     const std::string& GetName() const { return m_name; }
     
     /**
-     * @brief 设置节点名称
+     * @brief 设置节点名称（同时更新所属场景的名称索引）
      */
-    void SetName(const std::string& name) { m_name = name; }
+    void SetName(const std::string& name);
 
     // === 激活状态 ===
     
@@ -142,9 +142,9 @@ public:
     T* AddComponent();
     
     /**
-     * @brief 获取组件
-     * @tparam T 组件类型
-     * @return 组件指针，未找到返回 nullptr
+     * @brief 获取组件（O(1)，按组件类型 ID 索引）
+     * @tparam T 组件类型（精确类型匹配）
+     * @return 该类型的第一个组件指针，未找到返回 nullptr
      */
     template<typename T>
     T* GetComponent() const;
@@ -159,8 +159,9 @@ public:
     /**
      * @brief 添加组件（基类指针版本）
      * @param component 组件指针
+     * @param typeId 组件的具体类型 ID（GetComponentTypeId<T>()）
      */
-    void AddComponentInternal(Component* component);
+    void AddComponentInternal(Component* component, ComponentTypeId typeId);
 
     // === 更新 ===
     
@@ -188,14 +189,22 @@ private:
     
     SceneNode* m_parent;                   ///< 父节点
     std::vector<SceneNode*> m_children;    ///< 子节点列表
-    std::vector<Component*> m_components;  ///< 组件列表
+    std::vector<Component*> m_components;  ///< 组件列表（按添加顺序）
+    std::vector<Component*> m_componentSlots;  ///< 按类型 ID 索引的组件（每种类型第一个）
     
     Scene* m_scene;            ///< 所属场景
+    size_t m_sceneIndex;       ///< 在 Scene::m_allNodes 中的下标
+    size_t m_rootIndex;        ///< 在 Scene::m_rootNodes 中的下标（非根节点为 kInvalidIndex）
+    size_t m_nameIndex;        ///< 在 Scene 同名节点列表中的下标
+    bool m_spatialDirty;       ///< 是否已在 Scene 的 BVH 待更新列表中
+    
+    static constexpr size_t kInvalidIndex = static_cast<size_t>(-1);
     
     // 供 Scene 类使用的内部方法
     friend class Scene;
     void SetScene(Scene* scene);
     void NotifyTransformChanged();
+    void RemoveComponentInternal(Component* component);
 };
 
 // === 模板实现 ===
@@ -205,7 +214,7 @@ T* SceneNode::AddComponent() {
     static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
     
     T* component = new T(this);
-    AddComponentInternal(component);
+    AddComponentInternal(component, GetComponentTypeId<T>());
     return component;
 }
 
@@ -213,26 +222,20 @@ template<typename T>
 T* SceneNode::GetComponent() const {
     static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
     
-    for (Component* comp : m_components) {
-        T* result = dynamic_cast<T*>(comp);
-        if (result) {
-            return result;
-        }
+    const ComponentTypeId typeId = GetComponentTypeId<T>();
+    if (typeId >= m_componentSlots.size()) {
+        return nullptr;
     }
-    return nullptr;
+    return static_cast<T*>(m_componentSlots[typeId]);
 }
 
 template<typename T>
 void SceneNode::RemoveComponent() {
     static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
     
-    for (auto it = m_components.begin(); it != m_components.end(); ++it) {
-        T* result = dynamic_cast<T*>(*it);
-        if (result) {
-            delete *it;
-            m_components.erase(it);
-            return;
-        }
+    T* component = GetComponent<T>();
+    if (component) {
+        RemoveComponentInternal(component);
     }
 }
 
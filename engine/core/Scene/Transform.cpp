@@ -1,5 +1,7 @@
 #include "Transform.h"
 #include "SceneNode.h"
+#include "Scene.h"
+#include "TransformHierarchy.h"
 #include <cmath>
 
 namespace Moon {
@@ -14,6 +16,8 @@ namespace Moon {
         , m_localScale(1, 1, 1)
         , m_localDirty(true)
         , m_worldDirty(true)
+        , m_hierarchy(nullptr)
+        , m_hierarchyIndex(TransformHierarchy::kInvalidIndex)
     {
     }
 
@@ -150,10 +154,14 @@ namespace Moon {
             UpdateLocalMatrix();
             m_localDirty = false;
         }
-        if (m_worldDirty)
+        if (IsWorldDirty())
         {
             UpdateWorldMatrix();
             m_worldDirty = false;
+            if (m_hierarchy)
+            {
+                m_hierarchy->ClearDirty(m_hierarchyIndex);
+            }
         }
         return m_worldMatrix;
     }
@@ -224,10 +232,33 @@ namespace Moon {
         m_localDirty = true;
         m_worldDirty = true;
 
+        // 子树的世界包围盒随之变化，由场景 BVH 在下次查询前 refit
+        if (Scene* scene = m_owner->GetScene())
+        {
+            scene->MarkSpatialDirty(m_owner);
+        }
+
+        // 扁平层级有效时，只需把子树区间置脏
+        if (m_hierarchy)
+        {
+            m_hierarchy->MarkDirty(m_hierarchyIndex);
+            return;
+        }
+
         // 递归标记所有子孙节点的世界矩阵为脏
         MarkChildrenWorldDirty();
     }
 
+    bool Transform::IsWorldDirty() const
+    {
+        if (m_worldDirty)
+        {
+            return true;
+        }
+        // 扁平层级只标记子树区间，子孙节点的脏状态保存在存储中
+        return m_hierarchy && m_hierarchy->HasPendingDirty() && m_hierarchy->IsDirty(m_hierarchyIndex);
+    }
+
     void Transform::MarkChildrenWorldDirty()
     {
         for (size_t i = 0; i < m_owner->GetChildCount(); ++i)
@@ -1,10 +1,12 @@
 #pragma once
 #include "../Camera/Camera.h"  // For Vector3, Matrix4x4
+#include <cstdint>
 
 namespace Moon {
 
 // Forward declaration
 class SceneNode;
+class TransformHierarchy;
 
 /**
  * @brief 变换组件 - 管理场景节点的位置、旋转、缩放
@@ -12,11 +14,15 @@ class SceneNode;
  * Transform 组件存储和计算场景节点的空间变换。
  * 支持本地坐标系（相对于父节点）和世界坐标系。
  * 使用脏标记机制进行矩阵缓存优化。
+ * 所属场景启用扁平层级（Scene::SetFlatTransformsEnabled）时，
+ * Transform 同时是 TransformHierarchy 中的一个句柄（m_hierarchyIndex），
+ * 脏标记由扁平存储按子树区间维护，不再递归遍历子节点。
  */
 
 class Transform {
 
     friend class SceneNode;
+    friend class TransformHierarchy;
 public:
     Transform(SceneNode* owner);
 
@@ -61,6 +67,7 @@ private:
     void UpdateWorldMatrix();
     void MarkDirty();
     void MarkChildrenWorldDirty();  // 递归标记所有子孙节点世界矩阵为脏
+    bool IsWorldDirty() const;
 
 private:
     SceneNode* m_owner;
@@ -74,6 +81,9 @@ private:
 
     bool m_localDirty;
     bool m_worldDirty;
+
+    TransformHierarchy* m_hierarchy;  ///< 所在的扁平层级（未启用或已失效为 nullptr）
+    uint32_t m_hierarchyIndex;        ///< 在 TransformHierarchy 中的下标
 };
 
 } // namespace Moon
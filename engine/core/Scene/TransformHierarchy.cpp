@@ -0,0 +1,145 @@
+#include "TransformHierarchy.h"
+#include "Scene.h"
+#include "SceneNode.h"
+#include "Transform.h"
+#include <algorithm>
+
+namespace Moon {
+
+TransformHierarchy::TransformHierarchy(Scene* scene)
+    : m_scene(scene)
+    , m_valid(false)
+    , m_pendingDirty(false)
+    , m_lastUpdatedCount(0)
+{
+}
+
+void TransformHierarchy::Invalidate() {
+    if (!m_valid) {
+        return;
+    }
+
+    // 把未解析的脏标记写回 Transform（子树已整体置脏，旧路径的不变式仍成立），
+    // 并解除句柄；之后被删除的节点不会再被访问
+    for (size_t i = 0; i < m_transforms.size(); ++i) {
+        Transform* transform = m_transforms[i];
+        if (m_dirty[i]) {
+            transform->m_worldDirty = true;
+        }
+        transform->m_hierarchy = nullptr;
+        transform->m_hierarchyIndex = kInvalidIndex;
+    }
+
+    m_transforms.clear();
+    m_parents.clear();
+    m_subtreeEnds.clear();
+    m_dirty.clear();
+    m_valid = false;
+    m_pendingDirty = false;
+}
+
+void TransformHierarchy::AppendRoot(Transform* transform) {
+    if (!m_valid || !transform) {
+        return;
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_transforms.size());
+    transform->m_hierarchy = this;
+    transform->m_hierarchyIndex = index;
+    m_transforms.push_back(transform);
+    m_parents.push_back(-1);
+    m_subtreeEnds.push_back(index + 1);
+    m_dirty.push_back(1);
+    m_pendingDirty = true;
+}
+
+void TransformHierarchy::MarkDirty(uint32_t index) {
+    // 不变式：节点为脏 ⇒ 整棵子树为脏，因此已脏时可直接返回
+    if (m_dirty[index]) {
+        return;
+    }
+    std::fill(m_dirty.begin() + index, m_dirty.begin() + m_subtreeEnds[index], uint8_t(1));
+    m_pendingDirty = true;
+}
+
+void TransformHierarchy::Update() {
+    if (!m_valid) {
+        Rebuild();
+    }
+
+    m_lastUpdatedCount = 0;
+    if (!m_pendingDirty) {
+        return;
+    }
+
+    size_t updated = 0;
+    const size_t count = m_transforms.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (!m_dirty[i]) {
+            continue;
+        }
+
+        Transform* transform = m_transforms[i];
+        if (transform->m_localDirty) {
+            transform->UpdateLocalMatrix();
+            transform->m_localDirty = false;
+        }
+
+        // 先序排列保证父节点已在本次遍历中更新
+        const int32_t parent = m_parents[i];
+        if (parent >= 0) {
+            // 行向量系统：M_world = M_local × M_parent
+            transform->m_worldMatrix = transform->m_localMatrix * m_transforms[parent]->m_worldMatrix;
+        } else {
+            transform->m_worldMatrix = transform->m_localMatrix;
+        }
+        transform->m_worldDirty = false;
+        m_dirty[i] = 0;
+        ++updated;
+    }
+
+    m_lastUpdatedCount = updated;
+    m_pendingDirty = false;
+}
+
+void TransformHierarchy::Rebuild() {
+    m_transforms.clear();
+    m_parents.clear();
+    m_subtreeEnds.clear();
+    m_dirty.clear();
+    m_pendingDirty = true;
+
+    for (SceneNode* root : m_scene->GetRootNodes()) {
+        if (root) {
+            AppendSubtree(root, -1);
+        }
+    }
+
+    m_valid = true;
+}
+
+void TransformHierarchy::AppendSubtree(SceneNode* node, int32_t parentIndex) {
+    Transform* transform = node->GetTransform();
+    const uint32_t index = static_cast<uint32_t>(m_transforms.size());
+    transform->m_hierarchy = this;
+    transform->m_hierarchyIndex = index;
+
+    m_transforms.push_back(transform);
+    m_parents.push_back(parentIndex);
+    m_subtreeEnds.push_back(index + 1);
+
+    // 旧路径下的脏状态带入存储；父节点为脏时子树也必须为脏
+    const bool parentDirty = parentIndex >= 0 && m_dirty[parentIndex];
+    m_dirty.push_back((parentDirty || transform->m_worldDirty || transform->m_localDirty) ? 1 : 0);
+
+    for (size_t i = 0; i < node->GetChildCount(); ++i) {
+        SceneNode* child = node->GetChild(i);
+        if (child) {
+            AppendSubtree(child, static_cast<int32_t>(index));
+        }
+    }
+
+    m_subtreeEnds[index] = static_cast<uint32_t>(m_transforms.size());
+}
+
+} // namespace Moon
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Moon {
+
+// Forward declarations
+class Scene;
+class SceneNode;
+class Transform;
+
+/**
+ * @brief 扁平 Transform 层级 - 场景 Transform 的可选 SoA 存储
+ *
+ * 按“父节点在前、子节点在后”（先序 DFS）排列场景中所有 Transform，
+ * 并以并行数组保存父节点下标、子树范围和世界矩阵脏标记：
+ * - MarkDirty 只需把子树对应的连续区间置脏（无递归、无指针追踪）
+ * - Update 每帧一次线性遍历，只重算脏节点的世界矩阵（父节点此时必然已更新）
+ *
+ * 层级结构变化（SetParent / 删除节点）时存储失效，Transform 退回到
+ * 递归脏标记的旧路径，直到下一次 Update 重新排序。
+ * 矩阵本身仍保存在 Transform 中，GetWorldMatrix() 返回的引用保持稳定。
+ */
+class TransformHierarchy {
+public:
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    explicit TransformHierarchy(Scene* scene);
+
+    /**
+     * @brief 存储是否与当前层级结构一致
+     */
+    bool IsValid() const { return m_valid; }
+
+    /**
+     * @brief 层级结构发生变化，存储失效
+     *
+     * 把尚未解析的脏标记写回各 Transform 并解除句柄，保证旧路径仍能得到正确结果
+     */
+    void Invalidate();
+
+    /**
+     * @brief 自上次 Update 以来是否有节点被置脏（读取世界矩阵的快速路径）
+     */
+    bool HasPendingDirty() const { return m_pendingDirty; }
+
+    /**
+     * @brief 新建的根节点追加到末尾（不破坏先序顺序，无需失效）
+     */
+    void AppendRoot(Transform* transform);
+
+    /**
+     * @brief 标记节点及其整棵子树的世界矩阵为脏
+     * @param index Transform 在存储中的下标
+     */
+    void MarkDirty(uint32_t index);
+
+    /**
+     * @brief 查询节点世界矩阵是否为脏
+     */
+    bool IsDirty(uint32_t index) const { return m_dirty[index] != 0; }
+
+    /**
+     * @brief 清除单个节点的脏标记（节点已按需重算）
+     */
+    void ClearDirty(uint32_t index) { m_dirty[index] = 0; }
+
+    /**
+     * @brief 每帧更新：必要时重建顺序，然后线性重算所有脏的世界矩阵
+     */
+    void Update();
+
+    /**
+     * @brief 存储中的 Transform 数量
+     */
+    size_t GetSize() const { return m_transforms.size(); }
+
+    /**
+     * @brief 上一次 Update 重算的世界矩阵数量
+     */
+    size_t GetLastUpdatedCount() const { return m_lastUpdatedCount; }
+
+private:
+    void Rebuild();
+    void AppendSubtree(SceneNode* node, int32_t parentIndex);
+
+    Scene* m_scene;
+    std::vector<Transform*> m_transforms;  ///< 先序排列的 Transform
+    std::vector<int32_t> m_parents;        ///< 父节点下标（根节点为 -1）
+    std::vector<uint32_t> m_subtreeEnds;   ///< 子树区间 [i, m_subtreeEnds[i])
+    std::vector<uint8_t> m_dirty;          ///< 世界矩阵脏标记
+    bool m_valid;
+    bool m_pendingDirty;
+    size_t m_lastUpdatedCount;
+};
+
+} // namespace Moon
@@ -0,0 +1,122 @@
+// 视锥平面提取、包围球/AABB 测试与 Mesh 包围体缓存测试
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "core/Camera/Frustum.h"
+#include "core/Camera/PerspectiveCamera.h"
+#include "core/Math/Bounds.h"
+#include "core/Mesh/Mesh.h"
+
+using namespace Moon;
+
+class FrustumCullingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // 原点处朝 +Z 看，90° 视角、正方形视口：左右/上下平面与视线成 45°
+        camera.SetFOV(90.0f);
+        camera.SetAspectRatio(1.0f);
+        camera.SetNearFar(0.1f, 100.0f);
+        camera.SetPosition(Vector3(0.0f, 0.0f, 0.0f));
+        camera.SetTarget(Vector3(0.0f, 0.0f, 1.0f));
+        camera.SetUp(Vector3(0.0f, 1.0f, 0.0f));
+        frustum = Frustum::FromViewProjection(camera.GetViewProjectionMatrix());
+    }
+
+    PerspectiveCamera camera;
+    Frustum frustum;
+};
+
+TEST_F(FrustumCullingTest, ExtractsNormalizedInwardPlanes) {
+    const Vector3 nearNormal = frustum.GetPlaneNormal(Frustum::Near);
+    EXPECT_NEAR(nearNormal.z, 1.0f, 1e-4f);
+    EXPECT_NEAR(frustum.GetPlaneDistance(Frustum::Near), -0.1f, 1e-4f);
+
+    const Vector3 farNormal = frustum.GetPlaneNormal(Frustum::Far);
+    EXPECT_NEAR(farNormal.z, -1.0f, 1e-4f);
+    EXPECT_NEAR(frustum.GetPlaneDistance(Frustum::Far), 100.0f, 1e-2f);
+
+    const float invSqrt2 = 1.0f / std::sqrt(2.0f);
+    const Vector3 leftNormal = frustum.GetPlaneNormal(Frustum::Left);
+    EXPECT_NEAR(leftNormal.x, invSqrt2, 1e-4f);
+    EXPECT_NEAR(leftNormal.z, invSqrt2, 1e-4f);
+    const Vector3 topNormal = frustum.GetPlaneNormal(Frustum::Top);
+    EXPECT_NEAR(topNormal.y, -invSqrt2, 1e-4f);
+    EXPECT_NEAR(topNormal.z, invSqrt2, 1e-4f);
+}
+
+TEST_F(FrustumCullingTest, SphereAndAABBVisibility) {
+    EXPECT_TRUE(frustum.IsSphereVisible(Vector3(0.0f, 0.0f, 10.0f), 1.0f));
+    EXPECT_FALSE(frustum.IsSphereVisible(Vector3(0.0f, 0.0f, -10.0f), 1.0f));   // 相机后方
+    EXPECT_FALSE(frustum.IsSphereVisible(Vector3(0.0f, 0.0f, 200.0f), 1.0f));   // 远平面之外
+    EXPECT_FALSE(frustum.IsSphereVisible(Vector3(-30.0f, 0.0f, 10.0f), 1.0f));  // 左侧之外
+    EXPECT_TRUE(frustum.IsSphereVisible(Vector3(-10.5f, 0.0f, 10.0f), 1.0f));   // 跨越左平面
+
+    const Vector3 half(1.0f, 1.0f, 1.0f);
+    EXPECT_TRUE(frustum.IsAABBVisible(AABB(Vector3(0.0f, 0.0f, 10.0f) - half, Vector3(0.0f, 0.0f, 10.0f) + half)));
+    EXPECT_FALSE(frustum.IsAABBVisible(AABB(Vector3(0.0f, 0.0f, -10.0f) - half, Vector3(0.0f, 0.0f, -10.0f) + half)));
+    EXPECT_TRUE(frustum.IsAABBVisible(AABB(Vector3(-10.5f, -1.0f, 9.0f), Vector3(-9.5f, 1.0f, 11.0f))));
+    EXPECT_FALSE(frustum.IsAABBVisible(AABB()));
+
+    // 默认构造的视锥不剔除任何物体
+    Frustum everything;
+    EXPECT_TRUE(everything.IsSphereVisible(Vector3(0.0f, 0.0f, -1000.0f), 1.0f));
+}
+
+TEST_F(FrustumCullingTest, BatchSphereCullMatchesSingleTest) {
+    // 7 个：一组 SSE（4 个）+ 标量尾部（3 个）
+    const std::vector<Vector3> centers = {
+        {0.0f, 0.0f, 10.0f}, {0.0f, 0.0f, -10.0f}, {-10.5f, 0.0f, 10.0f}, {50.0f, 0.0f, 10.0f},
+        {0.0f, 0.0f, 99.0f}, {0.0f, 0.0f, 200.0f}, {0.0f, 5.0f, 6.0f},
+    };
+    std::vector<float> x, y, z, r;
+    for (const Vector3& c : centers) {
+        x.push_back(c.x);
+        y.push_back(c.y);
+        z.push_back(c.z);
+        r.push_back(1.0f);
+    }
+
+    std::vector<uint8_t> visible(centers.size(), 2);
+    const size_t visibleCount = frustum.CullSpheres(x.data(), y.data(), z.data(), r.data(), centers.size(), visible.data());
+
+    size_t expectedCount = 0;
+    for (size_t i = 0; i < centers.size(); ++i) {
+        const bool expected = frustum.IsSphereVisible(centers[i], 1.0f);
+        EXPECT_EQ(visible[i] != 0, expected) << "sphere " << i;
+        expectedCount += expected ? 1 : 0;
+    }
+    EXPECT_EQ(visibleCount, expectedCount);
+    EXPECT_EQ(visibleCount, 4u);
+}
+
+TEST_F(FrustumCullingTest, MeshBoundsCachedAndInvalidatedOnSetVertices) {
+    std::unique_ptr<Mesh> mesh(CreateCubeMesh(2.0f));
+    const AABB& bounds = mesh->GetBounds();
+    EXPECT_FLOAT_EQ(bounds.minPoint.x, -1.0f);
+    EXPECT_FLOAT_EQ(bounds.maxPoint.z, 1.0f);
+    EXPECT_NEAR(mesh->GetBoundingSphere().radius, std::sqrt(3.0f), 1e-5f);
+
+    std::vector<Vertex> vertices = {
+        Vertex(Vector3(2.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)),
+        Vertex(Vector3(6.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)),
+    };
+    mesh->SetVertices(vertices);
+    EXPECT_FLOAT_EQ(mesh->GetBounds().minPoint.x, 2.0f);
+    EXPECT_FLOAT_EQ(mesh->GetBounds().maxPoint.x, 6.0f);
+    EXPECT_FLOAT_EQ(mesh->GetBoundingSphere().center.x, 4.0f);
+    EXPECT_FLOAT_EQ(mesh->GetBoundingSphere().radius, 2.0f);
+
+    // 世界变换：平移 + 缩放 2 倍
+    Matrix4x4 world = Matrix4x4::Translation(0.0f, 0.0f, 10.0f);
+    world.m[0][0] = world.m[1][1] = world.m[2][2] = 2.0f;
+    const AABB worldBounds = mesh->GetBounds().Transformed(world);
+    EXPECT_FLOAT_EQ(worldBounds.minPoint.x, 4.0f);
+    EXPECT_FLOAT_EQ(worldBounds.maxPoint.x, 12.0f);
+    EXPECT_FLOAT_EQ(worldBounds.minPoint.z, 10.0f);
+    EXPECT_FLOAT_EQ(mesh->GetBoundingSphere().Transformed(world).radius, 4.0f);
+
+    mesh->Clear();
+    EXPECT_FALSE(mesh->GetBounds().IsValid());
+    EXPECT_FALSE(mesh->GetBoundingSphere().IsValid());
+}
@@ -0,0 +1,198 @@
+// Scene 按类型组件存储测试 + GetComponent<T> 性能对比
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "core/Scene/Scene.h"
+#include "core/Scene/SceneNode.h"
+#include "core/Scene/MeshRenderer.h"
+#include "core/Scene/Material.h"
+#include "core/Scene/Light.h"
+
+using namespace Moon;
+
+class SceneComponentTest : public ::testing::Test {
+protected:
+    Scene scene;
+};
+
+// ========================================
+// 类型 ID
+// ========================================
+
+TEST_F(SceneComponentTest, TypeId_StablePerType) {
+    EXPECT_EQ(GetComponentTypeId<MeshRenderer>(), GetComponentTypeId<MeshRenderer>());
+    EXPECT_NE(GetComponentTypeId<MeshRenderer>(), GetComponentTypeId<Material>());
+    EXPECT_NE(GetComponentTypeId<Material>(), GetComponentTypeId<Light>());
+}
+
+// ========================================
+// SceneNode::GetComponent<T>
+// ========================================
+
+TEST_F(SceneComponentTest, GetComponent_ReturnsAddedComponent) {
+    SceneNode* node = scene.CreateNode("Node");
+    MeshRenderer* renderer = node->AddComponent<MeshRenderer>();
+    Material* material = node->AddComponent<Material>();
+
+    EXPECT_EQ(node->GetComponent<MeshRenderer>(), renderer);
+    EXPECT_EQ(node->GetComponent<Material>(), material);
+    EXPECT_EQ(node->GetComponent<Light>(), nullptr);
+    EXPECT_EQ(renderer->GetTypeId(), GetComponentTypeId<MeshRenderer>());
+}
+
+TEST_F(SceneComponentTest, RemoveComponent_FallsBackToNextOfSameType) {
+    SceneNode* node = scene.CreateNode("Node");
+    Light* first = node->AddComponent<Light>();
+    Light* second = node->AddComponent<Light>();
+
+    EXPECT_EQ(node->GetComponent<Light>(), first);
+    EXPECT_EQ(scene.GetComponentCount<Light>(), 2u);
+
+    node->RemoveComponent<Light>();
+    EXPECT_EQ(node->GetComponent<Light>(), second);
+    EXPECT_EQ(scene.GetComponentCount<Light>(), 1u);
+
+    node->RemoveComponent<Light>();
+    EXPECT_EQ(node->GetComponent<Light>(), nullptr);
+    EXPECT_EQ(scene.GetComponentCount<Light>(), 0u);
+}
+
+// ========================================
+// Scene 按类型数组
+// ========================================
+
+TEST_F(SceneComponentTest, ForEachComponent_VisitsAllOfType) {
+    std::vector<MeshRenderer*> expected;
+    for (int i = 0; i < 16; ++i) {
+        SceneNode* node = scene.CreateNode("Node");
+        expected.push_back(node->AddComponent<MeshRenderer>());
+        if (i % 4 == 0) {
+            node->AddComponent<Light>();
+        }
+    }
+
+    std::vector<MeshRenderer*> visited;
+    scene.ForEachComponent<MeshRenderer>([&](MeshRenderer* renderer) {
+        visited.push_back(renderer);
+    });
+
+    EXPECT_EQ(visited, expected);
+    EXPECT_EQ(scene.GetComponentCount<Light>(), 4u);
+    EXPECT_EQ(scene.GetComponentCount<Material>(), 0u);
+}
+
+TEST_F(SceneComponentTest, DestroyNode_UnregistersComponentsAndChildren) {
+    SceneNode* parent = scene.CreateNode("Parent");
+    SceneNode* child = scene.CreateNode("Child");
+    SceneNode* other = scene.CreateNode("Other");
+    child->SetParent(parent);
+    parent->AddComponent<MeshRenderer>();
+    child->AddComponent<MeshRenderer>();
+    MeshRenderer* survivor = other->AddComponent<MeshRenderer>();
+
+    scene.DestroyNodeImmediate(parent);
+
+    ASSERT_EQ(scene.GetComponentCount<MeshRenderer>(), 1u);
+    scene.ForEachComponent<MeshRenderer>([&](MeshRenderer* renderer) {
+        EXPECT_EQ(renderer, survivor);
+        EXPECT_EQ(renderer->GetOwner(), other);
+    });
+}
+
+TEST_F(SceneComponentTest, CollectInHierarchyOrder_MatchesTraverseNotRegistrationOrder) {
+    SceneNode* first = scene.CreateNode("First");
+    SceneNode* second = scene.CreateNode("Second");
+    SceneNode* child = scene.CreateNode("Child");
+    SceneNode* grandChild = scene.CreateNode("GrandChild");
+    child->SetParent(first);
+    grandChild->SetParent(child);
+
+    // 注册顺序与层级顺序相反；second 上的第二个 Light 不应被收集（GetComponent 只返回第一个）
+    Light* secondLight = second->AddComponent<Light>();
+    second->AddComponent<Light>();
+    Light* grandChildLight = grandChild->AddComponent<Light>();
+    Light* childLight = child->AddComponent<Light>();
+    Light* firstLight = first->AddComponent<Light>();
+
+    std::vector<Light*> traversed;
+    scene.Traverse([&](SceneNode* node) {
+        if (Light* light = node->GetComponent<Light>()) {
+            traversed.push_back(light);
+        }
+    });
+
+    std::vector<Light*> collected;
+    scene.CollectComponentsInHierarchyOrder(collected);
+    EXPECT_EQ(collected, traversed);
+    EXPECT_EQ(collected, (std::vector<Light*>{firstLight, childLight, grandChildLight, secondLight}));
+}
+
+// ========================================
+// 性能对比：dynamic_cast 扫描 vs 类型 ID 索引（100k 节点）
+// ========================================
+
+TEST_F(SceneComponentTest, Benchmark_GetComponent_100kNodes) {
+    constexpr int kNodeCount = 100000;
+
+    // 复现旧路径需要的每节点组件列表（旧实现：遍历 m_components + dynamic_cast）
+    std::vector<std::vector<Component*>> legacyComponents;
+    legacyComponents.reserve(kNodeCount);
+    for (int i = 0; i < kNodeCount; ++i) {
+        SceneNode* node = scene.CreateNode("Node");
+        std::vector<Component*> components;
+        components.push_back(node->AddComponent<Material>());
+        if (i % 2 == 0) {
+            components.push_back(node->AddComponent<MeshRenderer>());
+        }
+        if (i % 1000 == 0) {
+            components.push_back(node->AddComponent<Light>());
+        }
+        legacyComponents.push_back(std::move(components));
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    // 旧路径：层级遍历 + 每节点 dynamic_cast 扫描（MeshRenderer 和 Light 各查一次，模拟渲染+光源收集）
+    size_t legacyFound = 0;
+    size_t nodeIndex = 0;
+    auto legacyStart = Clock::now();
+    scene.Traverse([&](SceneNode* node) {
+        (void)node;
+        for (Component* comp : legacyComponents[nodeIndex]) {
+            if (dynamic_cast<MeshRenderer*>(comp)) { ++legacyFound; break; }
+        }
+        for (Component* comp : legacyComponents[nodeIndex]) {
+            if (dynamic_cast<Light*>(comp)) { ++legacyFound; break; }
+        }
+        ++nodeIndex;
+    });
+    auto legacyEnd = Clock::now();
+
+    // 新路径 1：层级遍历 + O(1) GetComponent<T>
+    size_t indexedFound = 0;
+    auto indexedStart = Clock::now();
+    scene.Traverse([&](SceneNode* node) {
+        if (node->GetComponent<MeshRenderer>()) ++indexedFound;
+        if (node->GetComponent<Light>()) ++indexedFound;
+    });
+    auto indexedEnd = Clock::now();
+
+    // 新路径 2：直接遍历按类型数组（无层级遍历）
+    size_t poolFound = 0;
+    auto poolStart = Clock::now();
+    scene.ForEachComponent<MeshRenderer>([&](MeshRenderer*) { ++poolFound; });
+    scene.ForEachComponent<Light>([&](Light*) { ++poolFound; });
+    auto poolEnd = Clock::now();
+
+    const size_t expected = kNodeCount / 2 + kNodeCount / 1000;
+    EXPECT_EQ(legacyFound, expected);
+    EXPECT_EQ(indexedFound, expected);
+    EXPECT_EQ(poolFound, expected);
+
+    auto us = [](Clock::time_point a, Clock::time_point b) {
+        return static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(b - a).count());
+    };
+    std::printf("[Benchmark] 100k nodes: dynamic_cast scan %lld us, indexed GetComponent %lld us, per-type pool %lld us\n",
+                us(legacyStart, legacyEnd), us(indexedStart, indexedEnd), us(poolStart, poolEnd));
+}
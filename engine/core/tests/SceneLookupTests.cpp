@@ -0,0 +1,89 @@
+// Scene 哈希索引查找测试（按 ID / 按名称）
+#include <gtest/gtest.h>
+#include <vector>
+#include "core/Scene/Scene.h"
+#include "core/Scene/SceneNode.h"
+
+using namespace Moon;
+
+class SceneLookupTest : public ::testing::Test {
+protected:
+    Scene scene;
+};
+
+TEST_F(SceneLookupTest, FindNodeByID_ReturnsCreatedNodes) {
+    SceneNode* a = scene.CreateNode("A");
+    SceneNode* b = scene.CreateNode("B");
+
+    EXPECT_EQ(scene.FindNodeByID(a->GetID()), a);
+    EXPECT_EQ(scene.FindNodeByID(b->GetID()), b);
+    EXPECT_EQ(scene.FindNodeByID(0), nullptr);
+}
+
+TEST_F(SceneLookupTest, CreateNodeWithID_RejectsDuplicateID) {
+    SceneNode* node = scene.CreateNodeWithID(900000, "Restored");
+    ASSERT_NE(node, nullptr);
+    EXPECT_EQ(scene.FindNodeByID(900000), node);
+    EXPECT_EQ(scene.CreateNodeWithID(900000, "Duplicate"), nullptr);
+}
+
+TEST_F(SceneLookupTest, FindNodeByName_PrefersOldestAndTracksRename) {
+    SceneNode* first = scene.CreateNode("Wall");
+    SceneNode* second = scene.CreateNode("Wall");
+
+    EXPECT_EQ(scene.FindNodeByName("Wall"), first);
+    EXPECT_EQ(scene.FindNodesByName("Wall"), (std::vector<SceneNode*>{first, second}));
+
+    first->SetName("Window");
+    EXPECT_EQ(scene.FindNodeByName("Wall"), second);
+    EXPECT_EQ(scene.FindNodeByName("Window"), first);
+
+    second->SetName("Window");
+    EXPECT_EQ(scene.FindNodeByName("Wall"), nullptr);
+    EXPECT_EQ(scene.FindNodesByName("Window").size(), 2u);
+}
+
+TEST_F(SceneLookupTest, DestroyNodeImmediate_RemovesSubtreeFromIndices) {
+    SceneNode* root = scene.CreateNode("Root");
+    SceneNode* child = scene.CreateNode("Child");
+    SceneNode* keep = scene.CreateNode("Keep");
+    child->SetParent(root);
+    const uint32_t rootID = root->GetID();
+    const uint32_t childID = child->GetID();
+
+    EXPECT_EQ(scene.GetRootNodeCount(), 2u);
+
+    scene.DestroyNodeImmediate(root);
+
+    EXPECT_EQ(scene.FindNodeByID(rootID), nullptr);
+    EXPECT_EQ(scene.FindNodeByID(childID), nullptr);
+    EXPECT_EQ(scene.FindNodeByName("Child"), nullptr);
+    EXPECT_EQ(scene.FindNodeByID(keep->GetID()), keep);
+    EXPECT_EQ(scene.GetNodeCount(), 1u);
+    ASSERT_EQ(scene.GetRootNodeCount(), 1u);
+    EXPECT_EQ(scene.GetRootNode(0), keep);
+}
+
+TEST_F(SceneLookupTest, SwapAndPop_KeepsIndicesConsistent) {
+    std::vector<SceneNode*> nodes;
+    for (int i = 0; i < 64; ++i) {
+        nodes.push_back(scene.CreateNode("Node"));
+    }
+
+    // 删除偶数下标节点，剩余节点必须仍可查找且根列表无重复
+    for (size_t i = 0; i < nodes.size(); i += 2) {
+        scene.DestroyNodeImmediate(nodes[i]);
+    }
+    for (size_t i = 1; i < nodes.size(); i += 2) {
+        EXPECT_EQ(scene.FindNodeByID(nodes[i]->GetID()), nodes[i]);
+    }
+    EXPECT_EQ(scene.GetNodeCount(), 32u);
+    EXPECT_EQ(scene.GetRootNodeCount(), 32u);
+    EXPECT_EQ(scene.FindNodesByName("Node").size(), 32u);
+
+    // 重新挂接后从根列表移除、再解除挂接后回到根列表
+    nodes[3]->SetParent(nodes[1]);
+    EXPECT_EQ(scene.GetRootNodeCount(), 31u);
+    nodes[3]->SetParent(nullptr);
+    EXPECT_EQ(scene.GetRootNodeCount(), 32u);
+}
@@ -0,0 +1,282 @@
+// 场景 BVH 测试：与暴力遍历对比射线/AABB/最近邻结果，增量 refit，以及 CPU 拾取性能
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+#include "core/Camera/PerspectiveCamera.h"
+#include "core/Mesh/Mesh.h"
+#include "core/Scene/MeshRenderer.h"
+#include "core/Scene/Scene.h"
+#include "core/Scene/SceneBVH.h"
+#include "core/Scene/SceneNode.h"
+
+using namespace Moon;
+
+class SceneSpatialIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        cube = std::shared_ptr<Mesh>(CreateCubeMesh(1.0f));
+    }
+
+    SceneNode* CreateCube(const Vector3& position, float scale = 1.0f) {
+        SceneNode* node = scene.CreateNode("Cube");
+        node->GetTransform()->SetLocalPosition(position);
+        node->GetTransform()->SetLocalScale(Vector3(scale, scale, scale));
+        node->AddComponent<MeshRenderer>()->SetMesh(cube);
+        nodes.push_back(node);
+        return node;
+    }
+
+    void CreateRandomCubes(int count, float extent, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(-extent, extent);
+        std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+        for (int i = 0; i < count; ++i) {
+            CreateCube(Vector3(position(rng), position(rng), position(rng)), scale(rng));
+        }
+    }
+
+    AABB WorldBounds(SceneNode* node) {
+        return cube->GetBounds().Transformed(node->GetTransform()->GetWorldMatrix());
+    }
+
+    // 暴力：与每个节点的世界包围盒求交，返回最近进入距离（立方体的包围盒即其几何体）
+    SceneNode* BruteForceRaycast(const Vector3& origin, const Vector3& direction, float& outDistance) {
+        SceneNode* best = nullptr;
+        outDistance = 1e30f;
+        for (SceneNode* node : nodes) {
+            const AABB box = WorldBounds(node);
+            float tMin = 0.0f;
+            float tMax = 1e30f;
+            const float o[3] = {origin.x, origin.y, origin.z};
+            const float d[3] = {direction.x, direction.y, direction.z};
+            const float lo[3] = {box.minPoint.x, box.minPoint.y, box.minPoint.z};
+            const float hi[3] = {box.maxPoint.x, box.maxPoint.y, box.maxPoint.z};
+            bool hit = true;
+            for (int axis = 0; axis < 3 && hit; ++axis) {
+                float t0 = (lo[axis] - o[axis]) / d[axis];
+                float t1 = (hi[axis] - o[axis]) / d[axis];
+                if (t0 > t1) {
+                    std::swap(t0, t1);
+                }
+                tMin = std::max(tMin, t0);
+                tMax = std::min(tMax, t1);
+                hit = tMin <= tMax;
+            }
+            if (hit && tMin < outDistance) {
+                outDistance = tMin;
+                best = node;
+            }
+        }
+        return best;
+    }
+
+    std::vector<SceneNode*> BruteForceOverlap(const AABB& box) {
+        std::vector<SceneNode*> result;
+        for (SceneNode* node : nodes) {
+            if (WorldBounds(node).Overlaps(box)) {
+                result.push_back(node);
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    Scene scene;
+    std::shared_ptr<Mesh> cube;
+    std::vector<SceneNode*> nodes;
+};
+
+TEST_F(SceneSpatialIndexTest, QueriesMatchBruteForce) {
+    CreateRandomCubes(2000, 100.0f, 7);
+    SceneBVH& bvh = scene.GetSpatialIndex();
+    EXPECT_EQ(bvh.GetProxyCount(), 2000u);
+    EXPECT_TRUE(bvh.Validate());
+    EXPECT_LT(bvh.GetHeight(), 40);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (int i = 0; i < 50; ++i) {
+        // 射线
+        const Vector3 origin(unit(rng) * 150.0f, unit(rng) * 150.0f, -150.0f);
+        const Vector3 direction = Vector3(unit(rng) * 0.3f, unit(rng) * 0.3f, 1.0f).Normalized();
+        float expectedDistance = 0.0f;
+        SceneNode* expected = BruteForceRaycast(origin, direction, expectedDistance);
+        SceneRaycastHit hit;
+        const bool found = scene.Raycast(origin, direction, hit);
+        ASSERT_EQ(found, expected != nullptr);
+        if (found) {
+            EXPECT_NEAR(hit.distance, expectedDistance, 1e-2f);  // 局部空间求交，float 精度随距离下降
+        }
+
+        // AABB 重叠
+        const Vector3 center(unit(rng) * 100.0f, unit(rng) * 100.0f, unit(rng) * 100.0f);
+        const AABB box(center - Vector3(10.0f, 10.0f, 10.0f), center + Vector3(10.0f, 10.0f, 10.0f));
+        std::vector<SceneNode*> overlaps;
+        scene.QueryAABB(box, overlaps);
+        std::sort(overlaps.begin(), overlaps.end());
+        EXPECT_EQ(overlaps, BruteForceOverlap(box));
+
+        // k 最近邻
+        std::vector<SceneNode*> nearest;
+        scene.FindNearest(center, 5, nearest);
+        std::vector<float> distances;
+        for (SceneNode* node : nodes) {
+            distances.push_back(WorldBounds(node).DistanceSquared(center));
+        }
+        std::sort(distances.begin(), distances.end());
+        ASSERT_EQ(nearest.size(), 5u);
+        for (size_t k = 0; k < nearest.size(); ++k) {
+            EXPECT_FLOAT_EQ(WorldBounds(nearest[k]).DistanceSquared(center), distances[k]);
+        }
+    }
+}
+
+TEST_F(SceneSpatialIndexTest, RefitsMovedSubtreesAndRemovesDestroyedNodes) {
+    SceneNode* parent = scene.CreateNode("Vehicle");
+    SceneNode* body = CreateCube(Vector3(0.0f, 0.0f, 0.0f));
+    body->SetParent(parent, false);
+    SceneNode* other = CreateCube(Vector3(20.0f, 0.0f, 0.0f));
+
+    std::vector<SceneNode*> nearest;
+    scene.FindNearest(Vector3(0.0f, 0.0f, 0.0f), 1, nearest);
+    ASSERT_EQ(nearest.size(), 1u);
+    EXPECT_EQ(nearest[0], body);
+
+    // 移动父节点：子节点的叶子随之 refit
+    parent->GetTransform()->SetLocalPosition(Vector3(50.0f, 0.0f, 0.0f));
+    nearest.clear();
+    scene.FindNearest(Vector3(0.0f, 0.0f, 0.0f), 1, nearest);
+    ASSERT_EQ(nearest.size(), 1u);
+    EXPECT_EQ(nearest[0], other);
+    EXPECT_TRUE(scene.GetSpatialIndex().Validate());
+
+    // 限定搜索距离
+    nearest.clear();
+    scene.FindNearest(Vector3(0.0f, 0.0f, 0.0f), 1, nearest, nullptr, 5.0f);
+    EXPECT_TRUE(nearest.empty());
+
+    // 过滤回调 + 距离
+    nearest.clear();
+    scene.FindNearest(Vector3(0.0f, 0.0f, 0.0f), 1, nearest, [&](SceneNode* node, float distance) {
+        return node == body && distance > 40.0f;
+    });
+    ASSERT_EQ(nearest.size(), 1u);
+    EXPECT_EQ(nearest[0], body);
+
+    // 销毁节点、移除 Mesh：叶子随之移除
+    scene.DestroyNodeImmediate(other);
+    body->GetComponent<MeshRenderer>()->SetMesh(nullptr);
+    EXPECT_EQ(scene.GetSpatialIndex().GetProxyCount(), 0u);
+
+    // 新增 MeshRenderer 自动加入
+    SceneNode* added = CreateCube(Vector3(1.0f, 2.0f, 3.0f));
+    nearest.clear();
+    scene.FindNearest(Vector3(0.0f, 0.0f, 0.0f), 3, nearest);
+    ASSERT_EQ(nearest.size(), 1u);
+    EXPECT_EQ(nearest[0], added);
+}
+
+TEST_F(SceneSpatialIndexTest, RepeatedMovesWithoutQueriesQueueEachNodeOnce) {
+    SceneNode* moving = CreateCube(Vector3(0.0f, 0.0f, 0.0f));
+    SceneNode* destroyed = CreateCube(Vector3(10.0f, 0.0f, 0.0f));
+    SceneNode* still = CreateCube(Vector3(-10.0f, 0.0f, 0.0f));
+    scene.GetSpatialIndex();
+    EXPECT_EQ(scene.GetPendingSpatialUpdateCount(), 0u);
+
+    // 动画但不查询：列表长度只取决于被移动的节点数
+    for (int frame = 0; frame < 1000; ++frame) {
+        moving->GetTransform()->SetLocalPosition(Vector3(static_cast<float>(frame) * 0.01f, 0.0f, 0.0f));
+        destroyed->GetTransform()->SetLocalPosition(Vector3(10.0f, static_cast<float>(frame) * 0.01f, 0.0f));
+    }
+    EXPECT_EQ(scene.GetPendingSpatialUpdateCount(), 2u);
+
+    scene.DestroyNodeImmediate(destroyed);
+    EXPECT_EQ(scene.GetPendingSpatialUpdateCount(), 1u);
+
+    std::vector<SceneNode*> nearest;
+    scene.FindNearest(Vector3(10.0f, 0.0f, 0.0f), 1, nearest);
+    ASSERT_EQ(nearest.size(), 1u);
+    EXPECT_EQ(nearest[0], moving);
+    EXPECT_EQ(scene.GetPendingSpatialUpdateCount(), 0u);
+
+    // 同步后可再次入列
+    still->GetTransform()->SetLocalPosition(Vector3(-20.0f, 0.0f, 0.0f));
+    EXPECT_EQ(scene.GetPendingSpatialUpdateCount(), 1u);
+    EXPECT_TRUE(scene.GetSpatialIndex().Validate());
+}
+
+TEST_F(SceneSpatialIndexTest, HeadlessPickingThroughCamera) {
+    SceneNode* nearCube = CreateCube(Vector3(0.0f, 0.0f, 5.0f));
+    CreateCube(Vector3(0.0f, 0.0f, 10.0f), 3.0f);  // 被遮挡
+    SceneNode* sideCube = CreateCube(Vector3(4.0f, 0.0f, 10.0f));
+    SceneNode* hidden = CreateCube(Vector3(0.0f, 0.0f, 2.0f));
+    hidden->SetActive(false);
+
+    PerspectiveCamera camera(90.0f, 1.0f, 0.1f, 100.0f);
+    camera.SetPosition(Vector3(0.0f, 0.0f, 0.0f));
+    camera.SetTarget(Vector3(0.0f, 0.0f, 1.0f));
+
+    Vector3 origin;
+    Vector3 direction;
+    camera.ScreenPointToRay(0.0f, 0.0f, origin, direction);
+    SceneRaycastHit hit;
+    ASSERT_TRUE(scene.Raycast(origin, direction, hit));
+    EXPECT_EQ(hit.node, nearCube);
+    EXPECT_NEAR(hit.point.z, 4.5f, 1e-3f);
+
+    // 右侧 x = 4 / z = 10 → ndcX = 0.4
+    camera.ScreenPointToRay(0.4f, 0.0f, origin, direction);
+    ASSERT_TRUE(scene.Raycast(origin, direction, hit));
+    EXPECT_EQ(hit.node, sideCube);
+
+    camera.ScreenPointToRay(0.0f, 0.9f, origin, direction);
+    EXPECT_FALSE(scene.Raycast(origin, direction, hit));
+}
+
+TEST_F(SceneSpatialIndexTest, Benchmark_RaycastVersusSceneWalk) {
+    constexpr int kNodes = 20000;
+    constexpr int kRays = 1000;
+    CreateRandomCubes(kNodes, 500.0f, 3);
+
+    using Clock = std::chrono::high_resolution_clock;
+    auto buildStart = Clock::now();
+    scene.GetSpatialIndex();
+    auto buildEnd = Clock::now();
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<Vector3> origins;
+    std::vector<Vector3> directions;
+    for (int i = 0; i < kRays; ++i) {
+        origins.emplace_back(unit(rng) * 500.0f, unit(rng) * 500.0f, -600.0f);
+        directions.push_back(Vector3(unit(rng) * 0.2f, unit(rng) * 0.2f, 1.0f).Normalized());
+    }
+
+    int bvhHits = 0;
+    auto bvhStart = Clock::now();
+    for (int i = 0; i < kRays; ++i) {
+        SceneRaycastHit hit;
+        bvhHits += scene.Raycast(origins[i], directions[i], hit) ? 1 : 0;
+    }
+    auto bvhEnd = Clock::now();
+
+    int bruteHits = 0;
+    auto bruteStart = Clock::now();
+    for (int i = 0; i < kRays; ++i) {
+        float distance = 0.0f;
+        bruteHits += BruteForceRaycast(origins[i], directions[i], distance) ? 1 : 0;
+    }
+    auto bruteEnd = Clock::now();
+
+    EXPECT_EQ(bvhHits, bruteHits);
+
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+    std::printf("[Benchmark] %d nodes: BVH build %.2f ms; %d rays: BVH %.2f ms, scene walk %.2f ms\n",
+                kNodes, ms(buildStart, buildEnd), kRays, ms(bvhStart, bvhEnd), ms(bruteStart, bruteEnd));
+}
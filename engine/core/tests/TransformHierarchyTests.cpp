@@ -0,0 +1,189 @@
+// 扁平 Transform 层级测试 + 每帧世界矩阵更新性能对比
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "core/Scene/Scene.h"
+#include "core/Scene/SceneNode.h"
+#include "core/Scene/TransformHierarchy.h"
+
+using namespace Moon;
+
+namespace {
+
+// 建筑式层级：根节点 → 楼层 → 墙/窗（叶子）
+std::vector<SceneNode*> BuildBuildingHierarchy(Scene& scene, int nodeCount, int floorCount) {
+    std::vector<SceneNode*> nodes;
+    nodes.reserve(nodeCount);
+
+    SceneNode* root = scene.CreateNode("Building");
+    root->GetTransform()->SetLocalPosition(Vector3(10.0f, 0.0f, -5.0f));
+    nodes.push_back(root);
+
+    std::vector<SceneNode*> floors;
+    for (int f = 0; f < floorCount; ++f) {
+        SceneNode* floor = scene.CreateNode("Floor");
+        floor->SetParent(root, false);
+        floor->GetTransform()->SetLocalPosition(Vector3(0.0f, 3.0f * f, 0.0f));
+        floors.push_back(floor);
+        nodes.push_back(floor);
+    }
+
+    for (int i = static_cast<int>(nodes.size()); i < nodeCount; ++i) {
+        SceneNode* wall = scene.CreateNode("Wall");
+        wall->SetParent(floors[i % floorCount], false);
+        wall->GetTransform()->SetLocalPosition(Vector3(0.25f * (i % 97), 1.5f, 0.5f * (i % 31)));
+        wall->GetTransform()->SetLocalRotation(Vector3(0.0f, static_cast<float>(i % 4) * 90.0f, 0.0f));
+        nodes.push_back(wall);
+    }
+    return nodes;
+}
+
+void ExpectMatrixNear(const Matrix4x4& a, const Matrix4x4& b) {
+    for (int r = 0; r < 4; ++r) {
+        for (int c = 0; c < 4; ++c) {
+            EXPECT_NEAR(a.m[r][c], b.m[r][c], 1e-4f);
+        }
+    }
+}
+
+} // namespace
+
+class TransformHierarchyTest : public ::testing::Test {
+protected:
+    Scene legacyScene{"Legacy"};
+    Scene flatScene{"Flat"};
+};
+
+TEST_F(TransformHierarchyTest, UpdateTransforms_MatchesLegacyPath) {
+    std::vector<SceneNode*> legacy = BuildBuildingHierarchy(legacyScene, 500, 5);
+    flatScene.SetFlatTransformsEnabled(true);
+    std::vector<SceneNode*> flat = BuildBuildingHierarchy(flatScene, 500, 5);
+    flatScene.UpdateTransforms();
+
+    // 修改根节点、一个楼层和若干叶子
+    for (std::vector<SceneNode*>* nodes : {&legacy, &flat}) {
+        (*nodes)[0]->GetTransform()->SetLocalRotation(Vector3(0.0f, 30.0f, 0.0f));
+        (*nodes)[2]->GetTransform()->SetLocalScale(Vector3(1.0f, 2.0f, 1.0f));
+        for (size_t i = 10; i < nodes->size(); i += 37) {
+            (*nodes)[i]->GetTransform()->Translate(Vector3(1.0f, 0.0f, 0.0f), true);
+        }
+    }
+    flatScene.UpdateTransforms();
+
+    for (size_t i = 0; i < legacy.size(); ++i) {
+        ExpectMatrixNear(flat[i]->GetTransform()->GetWorldMatrix(),
+                         legacy[i]->GetTransform()->GetWorldMatrix());
+    }
+}
+
+TEST_F(TransformHierarchyTest, LazyAccessBetweenUpdates_SeesParentChanges) {
+    flatScene.SetFlatTransformsEnabled(true);
+    SceneNode* parent = flatScene.CreateNode("Parent");
+    SceneNode* child = flatScene.CreateNode("Child");
+    child->SetParent(parent, false);
+    child->GetTransform()->SetLocalPosition(Vector3(1.0f, 0.0f, 0.0f));
+    flatScene.UpdateTransforms();
+    ASSERT_TRUE(flatScene.GetTransformHierarchy()->IsValid());
+
+    parent->GetTransform()->SetLocalPosition(Vector3(0.0f, 5.0f, 0.0f));
+
+    Vector3 world = child->GetTransform()->GetWorldPosition();
+    EXPECT_NEAR(world.x, 1.0f, 1e-5f);
+    EXPECT_NEAR(world.y, 5.0f, 1e-5f);
+}
+
+TEST_F(TransformHierarchyTest, Reparent_InvalidatesAndRebuilds) {
+    flatScene.SetFlatTransformsEnabled(true);
+    SceneNode* a = flatScene.CreateNode("A");
+    SceneNode* b = flatScene.CreateNode("B");
+    SceneNode* child = flatScene.CreateNode("Child");
+    a->GetTransform()->SetLocalPosition(Vector3(1.0f, 0.0f, 0.0f));
+    b->GetTransform()->SetLocalPosition(Vector3(0.0f, 0.0f, 7.0f));
+    child->SetParent(a, false);
+    flatScene.UpdateTransforms();
+
+    child->SetParent(b, false);
+    EXPECT_FALSE(flatScene.GetTransformHierarchy()->IsValid());
+
+    flatScene.UpdateTransforms();
+    EXPECT_TRUE(flatScene.GetTransformHierarchy()->IsValid());
+    Vector3 world = child->GetTransform()->GetWorldPosition();
+    EXPECT_NEAR(world.x, 0.0f, 1e-5f);
+    EXPECT_NEAR(world.z, 7.0f, 1e-5f);
+}
+
+TEST_F(TransformHierarchyTest, UpdateTransforms_OnlyRecomputesDirtySubtree) {
+    flatScene.SetFlatTransformsEnabled(true);
+    std::vector<SceneNode*> nodes = BuildBuildingHierarchy(flatScene, 1000, 10);
+    flatScene.UpdateTransforms();
+    flatScene.UpdateTransforms();
+    EXPECT_EQ(flatScene.GetTransformHierarchy()->GetLastUpdatedCount(), 0u);
+
+    // 只重算楼层节点（nodes[1]）的子树：楼层本身 + 它的叶子
+    nodes[1]->GetTransform()->SetLocalPosition(Vector3(0.0f, 1.0f, 0.0f));
+    flatScene.UpdateTransforms();
+    EXPECT_EQ(flatScene.GetTransformHierarchy()->GetLastUpdatedCount(), nodes[1]->GetChildCount() + 1);
+}
+
+// ========================================
+// 性能对比：每帧 1% 节点变化 + 读取所有世界矩阵（模拟渲染）
+// ========================================
+
+namespace {
+
+double RunFrames(Scene& scene, std::vector<SceneNode*>& nodes, int frames, bool moveRoot) {
+    using Clock = std::chrono::high_resolution_clock;
+    float checksum = 0.0f;
+
+    // 预热：首帧的全量计算（以及扁平存储的首次排序）不计入稳态耗时
+    scene.UpdateTransforms();
+    for (SceneNode* node : nodes) {
+        checksum += node->GetTransform()->GetWorldMatrix().m[3][1];
+    }
+
+    auto start = Clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        if (moveRoot) {
+            nodes[0]->GetTransform()->Translate(Vector3(0.01f, 0.0f, 0.0f), true);
+        }
+        for (size_t i = static_cast<size_t>(frame) % 100; i < nodes.size(); i += 100) {
+            nodes[i]->GetTransform()->Translate(Vector3(0.0f, 0.001f, 0.0f), true);
+        }
+        scene.UpdateTransforms();
+        for (SceneNode* node : nodes) {
+            checksum += node->GetTransform()->GetWorldMatrix().m[3][1];
+        }
+    }
+    auto end = Clock::now();
+    EXPECT_TRUE(std::isfinite(checksum));
+    return std::chrono::duration<double, std::milli>(end - start).count() / frames;
+}
+
+void RunBenchmark(int nodeCount) {
+    constexpr int kFrames = 20;
+    for (bool moveRoot : {false, true}) {
+        Scene legacyScene("Legacy");
+        std::vector<SceneNode*> legacy = BuildBuildingHierarchy(legacyScene, nodeCount, 40);
+        double legacyMs = RunFrames(legacyScene, legacy, kFrames, moveRoot);
+
+        Scene flatScene("Flat");
+        flatScene.SetFlatTransformsEnabled(true);
+        std::vector<SceneNode*> flat = BuildBuildingHierarchy(flatScene, nodeCount, 40);
+        double flatMs = RunFrames(flatScene, flat, kFrames, moveRoot);
+
+        std::printf("[Benchmark] %d nodes%s: legacy %.3f ms/frame, flat %.3f ms/frame\n",
+                    nodeCount, moveRoot ? " (root moves)" : "", legacyMs, flatMs);
+    }
+}
+
+} // namespace
+
+TEST_F(TransformHierarchyTest, Benchmark_PerFrameUpdate_10kNodes) {
+    RunBenchmark(10000);
+}
+
+TEST_F(TransformHierarchyTest, Benchmark_PerFrameUpdate_100kNodes) {
+    RunBenchmark(100000);
+}
@@ -1,7 +1,9 @@
 #include "MassMeshBuilder.h"
 
+#include "MassMeshKernels.h"
+#include "MassReferenceCache.h"
+#include "MassRuleCompiler.h"
 #include "MassRuleParser.h"
-#include "../core/Assets/AssetPaths.h"
 #include "../core/CSG/CSGOperations.h"
 #include "../core/Geometry/MeshGenerator.h"
 #include <algorithm>
@@ -18,18 +20,17 @@ namespace {
 
 struct BuildContext {
     std::vector<std::string> referenceStack;
+    MassReferenceCache* referenceCache = nullptr;
+    // Collects the assets read while building the innermost cached reference
+    std::vector<MassReferenceCache::Dependency>* dependencies = nullptr;
+    bool balancedBooleans = true;
+    size_t threadCount = 0;                 // MassBuildOptions::threadCount
 };
 
 constexpr float kPi = 3.14159265358979323846f;
 constexpr float kTwoPi = 2.0f * kPi;
 constexpr float kEpsilon = 1e-4f;
 constexpr float kDefaultCreaseAngleDegrees = 75.0f;
-constexpr int kDefaultLoftSegmentsPerSpan = 4;
-
-struct Bounds {
-    Vector3 min;
-    Vector3 max;
-};
 
 float ToRadians(float degrees) {
     return degrees * kPi / 180.0f;
@@ -101,25 +102,6 @@ std::string ReadUtf8TextFile(const std::string& path) {
     return contents;
 }
 
-std::string NormalizeReferencePath(const std::string& reference) {
-    if (reference.empty()) {
-        return {};
-    }
-
-    const bool isAbsoluteWindowsPath =
-        reference.size() > 2 &&
-        ((reference[1] == ':') &&
-         (reference[2] == '/' || reference[2] == '\\'));
-    if (isAbsoluteWindowsPath) {
-        return Moon::Assets::NormalizeSlashes(reference);
-    }
-
-    const std::string assetRelative = reference.rfind("massing/", 0) == 0
-        ? reference
-        : std::string("massing/") + reference;
-    return Moon::Assets::NormalizeSlashes(Moon::Assets::BuildAssetPath(assetRelative));
-}
-
 Vector3 SafeNormalize(const Vector3& value, const Vector3& fallback = Vector3(0.0f, 1.0f, 0.0f)) {
     const float length = value.Length();
     if (length <= kEpsilon) {
@@ -128,6 +110,14 @@ Vector3 SafeNormalize(const Vector3& value, const Vector3& fallback = Vector3(0.
     return value * (1.0f / length);
 }
 
+MassBuildItem MakeMeshItem(const std::string& name, const std::string& material, std::shared_ptr<Mesh> mesh) {
+    MassBuildItem item;
+    item.name = name;
+    item.material = material;
+    item.mesh = std::move(mesh);
+    return item;
+}
+
 std::shared_ptr<Mesh> CloneMesh(const std::shared_ptr<Mesh>& mesh) {
     if (!mesh) {
         return nullptr;
@@ -140,28 +130,7 @@ std::shared_ptr<Mesh> CloneMesh(const std::shared_ptr<Mesh>& mesh) {
 
 void RecomputeNormals(Mesh& mesh) {
     std::vector<Vertex> vertices = mesh.GetVertices();
-    const std::vector<uint32_t>& indices = mesh.GetIndices();
-
-    for (Vertex& vertex : vertices) {
-        vertex.normal = Vector3(0.0f, 0.0f, 0.0f);
-    }
-
-    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
-        Vertex& a = vertices[indices[i + 0]];
-        Vertex& b = vertices[indices[i + 1]];
-        Vertex& c = vertices[indices[i + 2]];
-        const Vector3 ab = b.position - a.position;
-        const Vector3 ac = c.position - a.position;
-        const Vector3 faceNormal = SafeNormalize(Vector3::Cross(ab, ac), Vector3(0.0f, 1.0f, 0.0f));
-        a.normal = a.normal + faceNormal;
-        b.normal = b.normal + faceNormal;
-        c.normal = c.normal + faceNormal;
-    }
-
-    for (Vertex& vertex : vertices) {
-        vertex.normal = SafeNormalize(vertex.normal);
-    }
-
+    RecomputeVertexNormals(vertices, mesh.GetIndices());
     mesh.SetVertices(std::move(vertices));
 }
 
@@ -264,21 +233,179 @@ void ApplyTransformToMesh(Mesh& mesh, const RuleTransform& transform) {
     mesh.SetVertices(std::move(vertices));
 }
 
-Bounds ComputeBounds(const Mesh& mesh) {
-    Bounds bounds;
-    bounds.min = Vector3(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
-    bounds.max = Vector3(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+void ApplyTransformsToMesh(Mesh& mesh, const std::vector<RuleTransform>& transforms) {
+    if (transforms.empty()) {
+        return;
+    }
+    std::vector<Vertex> vertices = mesh.GetVertices();
+    for (Vertex& vertex : vertices) {
+        for (const RuleTransform& transform : transforms) {
+            vertex.position = ApplyPointTransform(vertex.position, transform);
+            vertex.normal = ApplyNormalTransform(vertex.normal, transform);
+        }
+    }
+    mesh.SetVertices(std::move(vertices));
+}
 
-    for (const Vertex& vertex : mesh.GetVertices()) {
-        bounds.min.x = std::min(bounds.min.x, vertex.position.x);
-        bounds.min.y = std::min(bounds.min.y, vertex.position.y);
-        bounds.min.z = std::min(bounds.min.z, vertex.position.z);
-        bounds.max.x = std::max(bounds.max.x, vertex.position.x);
-        bounds.max.y = std::max(bounds.max.y, vertex.position.y);
-        bounds.max.z = std::max(bounds.max.z, vertex.position.z);
+// Instanced items defer per-copy work: transforms are queued on the instances,
+// materials and names on the prototypes, until the copies are expanded.
+void ApplyTransformToItem(MassBuildItem& item, const RuleTransform& transform) {
+    if (item.IsInstanced()) {
+        for (MassInstance& instance : item.instances) {
+            instance.transforms.push_back(transform);
+        }
+    } else if (item.mesh) {
+        ApplyTransformToMesh(*item.mesh, transform);
     }
+}
 
-    return bounds;
+void FillEmptyMaterial(MassBuildItem& item, const std::string& material) {
+    if (item.IsInstanced()) {
+        for (MassBuildItem& prototype : item.prototypes) {
+            FillEmptyMaterial(prototype, material);
+        }
+    } else if (item.material.empty()) {
+        item.material = material;
+    }
+}
+
+void OverrideMaterial(MassBuildItem& item, const std::string& material) {
+    if (item.IsInstanced()) {
+        for (MassBuildItem& prototype : item.prototypes) {
+            OverrideMaterial(prototype, material);
+        }
+    }
+    item.material = material;
+}
+
+void PrefixItemName(MassBuildItem& item, const std::string& prefix) {
+    // Expanded copies take the name of the outermost instance
+    for (MassInstance& instance : item.instances) {
+        instance.name = prefix + instance.name;
+    }
+    item.name = prefix + item.name;
+}
+
+void AppendInstanceCopies(const MassBuildItem& prototype,
+                          const std::vector<RuleTransform>& outerTransforms,
+                          const std::string& name,
+                          std::vector<MassBuildItem>& outItems) {
+    if (prototype.IsInstanced()) {
+        for (const MassInstance& instance : prototype.instances) {
+            std::vector<RuleTransform> transforms = instance.transforms;
+            transforms.insert(transforms.end(), outerTransforms.begin(), outerTransforms.end());
+            for (const MassBuildItem& part : prototype.prototypes) {
+                AppendInstanceCopies(part, transforms, name, outItems);
+            }
+        }
+        return;
+    }
+
+    MassBuildItem copy;
+    copy.name = name;
+    copy.material = prototype.material;
+    copy.mesh = CloneMesh(prototype.mesh);
+    if (copy.mesh) {
+        ApplyTransformsToMesh(*copy.mesh, outerTransforms);
+    }
+    outItems.push_back(std::move(copy));
+}
+
+Quaternion AxisRotation(const Vector3& axis, float degrees) {
+    const float halfAngle = ToRadians(degrees) * 0.5f;
+    const float s = std::sin(halfAngle);
+    return Quaternion(axis.x * s, axis.y * s, axis.z * s, std::cos(halfAngle));
+}
+
+// Same rotation as ApplyRotation: about X, then Y, then Z
+Quaternion ToQuaternion(const Vec3& rotationDegrees) {
+    return AxisRotation(Vector3(0.0f, 0.0f, 1.0f), rotationDegrees[2]) *
+           AxisRotation(Vector3(0.0f, 1.0f, 0.0f), rotationDegrees[1]) *
+           AxisRotation(Vector3(1.0f, 0.0f, 0.0f), rotationDegrees[0]);
+}
+
+// Apply transform after the placement's TRS; false when the result is not a TRS
+bool FoldTransform(MassMeshPlacement& placement, const RuleTransform& transform) {
+    const Vector3 scale(transform.scale[0], transform.scale[1], transform.scale[2]);
+    const bool uniformScale = std::abs(scale.x - scale.y) <= kEpsilon && std::abs(scale.x - scale.z) <= kEpsilon;
+    const Quaternion& current = placement.rotation;
+    const bool rotated = std::sqrt(current.x * current.x + current.y * current.y + current.z * current.z) > 1e-6f;
+    if (!uniformScale && rotated) {
+        return false;
+    }
+
+    const Quaternion rotation = ToQuaternion(transform.rotation);
+    const Vector3 scaledPosition(placement.position.x * scale.x, placement.position.y * scale.y, placement.position.z * scale.z);
+    placement.position = rotation * scaledPosition + Vector3(transform.position[0], transform.position[1], transform.position[2]);
+    placement.rotation = (rotation * placement.rotation).Normalized();
+    placement.scale = Vector3(placement.scale.x * scale.x, placement.scale.y * scale.y, placement.scale.z * scale.z);
+    return true;
+}
+
+void AppendInstancePlacements(const MassBuildItem& prototype,
+                              const std::vector<RuleTransform>& outerTransforms,
+                              const std::string& name,
+                              std::vector<MassMeshPlacement>& outPlacements) {
+    if (prototype.IsInstanced()) {
+        for (const MassInstance& instance : prototype.instances) {
+            std::vector<RuleTransform> transforms = instance.transforms;
+            transforms.insert(transforms.end(), outerTransforms.begin(), outerTransforms.end());
+            for (const MassBuildItem& part : prototype.prototypes) {
+                AppendInstancePlacements(part, transforms, name, outPlacements);
+            }
+        }
+        return;
+    }
+
+    MassMeshPlacement placement;
+    placement.name = name;
+    placement.material = prototype.material;
+    placement.mesh = prototype.mesh;
+    for (const RuleTransform& transform : outerTransforms) {
+        if (!FoldTransform(placement, transform)) {
+            placement = MassMeshPlacement();
+            placement.name = name;
+            placement.material = prototype.material;
+            placement.mesh = CloneMesh(prototype.mesh);
+            if (placement.mesh) {
+                ApplyTransformsToMesh(*placement.mesh, outerTransforms);
+            }
+            break;
+        }
+    }
+    outPlacements.push_back(std::move(placement));
+}
+
+void ExpandInstancedItems(std::vector<MassBuildItem>& ioItems) {
+    if (std::none_of(ioItems.begin(), ioItems.end(), [](const MassBuildItem& item) { return item.IsInstanced(); })) {
+        return;
+    }
+
+    std::vector<MassBuildItem> expanded;
+    for (MassBuildItem& item : ioItems) {
+        if (!item.IsInstanced()) {
+            expanded.push_back(std::move(item));
+            continue;
+        }
+        for (const MassInstance& instance : item.instances) {
+            for (const MassBuildItem& prototype : item.prototypes) {
+                AppendInstanceCopies(prototype, instance.transforms, instance.name, expanded);
+            }
+        }
+    }
+    ioItems = std::move(expanded);
+}
+
+void SplitItemVerticesByCrease(MassBuildItem& item) {
+    if (item.IsInstanced()) {
+        for (MassBuildItem& prototype : item.prototypes) {
+            SplitItemVerticesByCrease(prototype);
+        }
+        return;
+    }
+    if (item.mesh && item.mesh->IsValid()) {
+        SplitVerticesByCrease(*item.mesh);
+    }
 }
 
 float SignedArea(const std::vector<Vec2>& points) {
@@ -713,48 +840,25 @@ std::shared_ptr<Mesh> CreateSweepMesh(const Curve2D& profile, const Curve3D& pat
     return MakeMesh(std::move(vertices), std::move(indices));
 }
 
-std::vector<float> BuildLoftLevels(const RuleNode& node, size_t profileCount) {
-    std::vector<float> levels;
-    if (node.params.contains("levels") && node.params["levels"].is_array() && node.params["levels"].size() == profileCount) {
-        for (const auto& value : node.params["levels"]) {
-            levels.push_back(value.get<float>());
-        }
-        return levels;
-    }
-
-    const float height = node.params.value("height", 10.0f);
-    const float step = profileCount > 1 ? height / static_cast<float>(profileCount - 1) : 0.0f;
-    for (size_t i = 0; i < profileCount; ++i) {
-        levels.push_back(step * static_cast<float>(i));
-    }
-    return levels;
-}
-
-int GetLoftSegmentsPerSpan(const RuleNode& node) {
-    return std::max(1, node.params.value("segments_per_span", kDefaultLoftSegmentsPerSpan));
-}
-
-std::shared_ptr<Mesh> CreateLoftMesh(const RuleNode& node) {
-    if (node.profiles.size() < 2) {
+std::shared_ptr<Mesh> CreateLoftMesh(const Curve2D* profiles, size_t profileCount, const float* levels, int segmentsPerSpan) {
+    if (profileCount < 2) {
         return nullptr;
     }
 
     size_t sampleCount = 0;
-    for (const Curve2D& profile : node.profiles) {
-        sampleCount = std::max(sampleCount, GetClosedProfilePoints(profile).size());
+    for (size_t i = 0; i < profileCount; ++i) {
+        sampleCount = std::max(sampleCount, GetClosedProfilePoints(profiles[i]).size());
     }
     sampleCount = std::max<size_t>(sampleCount, 8);
 
     std::vector<std::vector<Vec2>> sampledProfiles;
-    for (const Curve2D& profile : node.profiles) {
-        sampledProfiles.push_back(NormalizeClosedProfileOrientation(ResampleClosedCurve(profile, sampleCount)));
+    for (size_t i = 0; i < profileCount; ++i) {
+        sampledProfiles.push_back(NormalizeClosedProfileOrientation(ResampleClosedCurve(profiles[i], sampleCount)));
     }
     for (size_t i = 1; i < sampledProfiles.size(); ++i) {
         sampledProfiles[i] = AlignProfileToReference(sampledProfiles[i - 1], sampledProfiles[i]);
     }
 
-    const std::vector<float> levels = BuildLoftLevels(node, node.profiles.size());
-    const int segmentsPerSpan = GetLoftSegmentsPerSpan(node);
     std::vector<std::vector<Vec2>> loftProfiles;
     std::vector<float> loftLevels;
     loftProfiles.reserve((sampledProfiles.size() - 1) * static_cast<size_t>(segmentsPerSpan) + 1);
@@ -787,7 +891,7 @@ std::shared_ptr<Mesh> CreateLoftMesh(const RuleNode& node) {
         }
     }
     loftProfiles.push_back(sampledProfiles.back());
-    loftLevels.push_back(levels.back());
+    loftLevels.push_back(levels[profileCount - 1]);
 
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
@@ -833,19 +937,6 @@ std::shared_ptr<Mesh> CreateLoftMesh(const RuleNode& node) {
 
     return MakeMesh(std::move(vertices), std::move(indices));
 }
-void ApplyTaper(Mesh& mesh, float bottomScale, float topScale) {
-    const Bounds bounds = ComputeBounds(mesh);
-    const float height = std::max(bounds.max.y - bounds.min.y, kEpsilon);
-    std::vector<Vertex> vertices = mesh.GetVertices();
-    for (Vertex& vertex : vertices) {
-        const float t = (vertex.position.y - bounds.min.y) / height;
-        const float scale = bottomScale + (topScale - bottomScale) * t;
-        vertex.position.x *= scale;
-        vertex.position.z *= scale;
-    }
-    mesh.SetVertices(std::move(vertices));
-    RecomputeNormals(mesh);
-}
 
 void SubdivideMesh(Mesh& mesh, int iterations) {
     if (iterations <= 0) {
@@ -927,106 +1018,109 @@ void SubdivideMesh(Mesh& mesh, int iterations) {
     RecomputeNormals(mesh);
 }
 
-void ApplyTwist(Mesh& mesh, float totalDegrees) {
-    const Bounds bounds = ComputeBounds(mesh);
-    const float height = std::max(bounds.max.y - bounds.min.y, kEpsilon);
+void ApplyDeform(Mesh& mesh, const MassDeformParams& params, size_t threadCount) {
+    MassKernelOptions options;
+    options.threadCount = threadCount;
     std::vector<Vertex> vertices = mesh.GetVertices();
-    for (Vertex& vertex : vertices) {
-        const float t = (vertex.position.y - bounds.min.y) / height;
-        const float angle = ToRadians(totalDegrees * t);
-        vertex.position = RotateY(vertex.position, angle);
-    }
+    DeformVertices(vertices, params, options);
+    RecomputeVertexNormals(vertices, mesh.GetIndices(), options);
     mesh.SetVertices(std::move(vertices));
-    RecomputeNormals(mesh);
 }
 
-void ApplyShear(Mesh& mesh, float shearX, float shearZ) {
-    std::vector<Vertex> vertices = mesh.GetVertices();
-    for (Vertex& vertex : vertices) {
-        vertex.position.x += vertex.position.y * shearX;
-        vertex.position.z += vertex.position.y * shearZ;
+std::shared_ptr<Mesh> FoldToSingleMesh(const std::vector<std::shared_ptr<Mesh>>& meshes, CSG::Operation op) {
+    std::shared_ptr<Mesh> current = CloneMesh(meshes.front());
+    for (size_t i = 1; i < meshes.size(); ++i) {
+        current = CSG::PerformBoolean(current.get(), meshes[i].get(), op);
+        if (!current) {
+            return nullptr;
+        }
     }
-    mesh.SetVertices(std::move(vertices));
-    RecomputeNormals(mesh);
+    return current;
 }
 
-void ApplyBend(Mesh& mesh, float angleDegrees, const std::string& axis) {
-    const Bounds bounds = ComputeBounds(mesh);
-    const float height = std::max(bounds.max.y - bounds.min.y, kEpsilon);
-    const float angleRadians = ToRadians(angleDegrees);
-    std::vector<Vertex> vertices = mesh.GetVertices();
-    for (Vertex& vertex : vertices) {
-        const float t = (vertex.position.y - bounds.min.y) / height;
-        const float localAngle = angleRadians * t;
-        vertex.position = (axis == "x") ? RotateX(vertex.position, localAngle) : RotateZ(vertex.position, localAngle);
+// Pairs operands level by level, so both inputs of a boolean stay about the same size
+// and the pairs of one level are independent of each other
+CSG::Solid ReduceSolids(std::vector<CSG::Solid> solids, CSG::Operation op, size_t threadCount) {
+    while (solids.size() > 1) {
+        std::vector<CSG::Solid> reduced((solids.size() + 1) / 2);
+        ParallelFor(solids.size() / 2, threadCount, [&](size_t pair) {
+            reduced[pair] = solids[2 * pair].Boolean(solids[2 * pair + 1], op);
+        });
+        if (solids.size() % 2 == 1) {
+            reduced.back() = solids.back();
+        }
+        solids = std::move(reduced);
     }
-    mesh.SetVertices(std::move(vertices));
-    RecomputeNormals(mesh);
+    return solids.front();
 }
 
-void ApplyBulge(Mesh& mesh, float amplitude) {
-    const Bounds bounds = ComputeBounds(mesh);
-    const float height = std::max(bounds.max.y - bounds.min.y, kEpsilon);
-    std::vector<Vertex> vertices = mesh.GetVertices();
-    for (Vertex& vertex : vertices) {
-        const float t = (vertex.position.y - bounds.min.y) / height;
-        const float scale = 1.0f + std::sin(t * kPi) * amplitude;
-        vertex.position.x *= scale;
-        vertex.position.z *= scale;
+// Only valid for associative operations (union, intersect)
+std::shared_ptr<Mesh> ReduceToSingleMesh(const std::vector<std::shared_ptr<Mesh>>& meshes,
+                                         CSG::Operation op,
+                                         size_t threadCount) {
+    // Convert once, then stay in solid form until the root of the reduction
+    std::vector<CSG::Solid> solids(meshes.size());
+    ParallelFor(meshes.size(), threadCount, [&](size_t i) {
+        solids[i] = CSG::Solid::FromMesh(meshes[i].get());
+    });
+    if (std::any_of(solids.begin(), solids.end(), [](const CSG::Solid& solid) { return solid.IsEmpty(); })) {
+        return nullptr;
     }
-    mesh.SetVertices(std::move(vertices));
-    RecomputeNormals(mesh);
+    return ReduceSolids(std::move(solids), op, threadCount).ToMesh(false);
 }
 
-std::shared_ptr<Mesh> CollapseToSingleMesh(const std::vector<MassBuildItem>& items, CSG::Operation op) {
-    std::shared_ptr<Mesh> current;
+std::shared_ptr<Mesh> CollapseToSingleMesh(const std::vector<MassBuildItem>& items,
+                                           CSG::Operation op,
+                                           const BuildContext& context) {
+    std::vector<std::shared_ptr<Mesh>> meshes;
+    meshes.reserve(items.size());
     for (const MassBuildItem& item : items) {
-        if (!item.mesh || !item.mesh->IsValid()) {
-            continue;
-        }
-        if (!current) {
-            current = CloneMesh(item.mesh);
-            continue;
-        }
-        current = CSG::PerformBoolean(current.get(), item.mesh.get(), op);
-        if (!current) {
-            return nullptr;
+        if (item.mesh && item.mesh->IsValid()) {
+            meshes.push_back(item.mesh);
         }
     }
-    return current;
+
+    if (meshes.empty()) {
+        return nullptr;
+    }
+    if (meshes.size() == 1) {
+        return CloneMesh(meshes.front());
+    }
+    return context.balancedBooleans ? ReduceToSingleMesh(meshes, op, context.threadCount) : FoldToSingleMesh(meshes, op);
 }
 
-bool BuildNode(const RuleNode& node,
-               std::vector<MassBuildItem>& outItems,
-               std::vector<std::string>& warnings,
-               std::string& outError,
-               BuildContext& context);
+bool RunProgram(const MassProgram& program,
+                std::vector<MassBuildItem>& outItems,
+                std::vector<std::string>& warnings,
+                std::string& outError,
+                BuildContext& context);
 
-bool BuildPrimitive(const RuleNode& node, std::vector<MassBuildItem>& outItems, std::string& outError) {
+bool BuildPrimitive(const MassInstruction& instruction, std::vector<MassBuildItem>& outItems, std::string& outError) {
+    const MassPrimitiveParams& params = instruction.primitiveParams;
     std::shared_ptr<Mesh> mesh;
-    RuleTransform transform = node.transform;
+    RuleTransform transform = instruction.transform;
 
-    switch (node.primitive) {
+    switch (instruction.primitive) {
         case PrimitiveType::Cube:
             mesh.reset(MeshGenerator::CreateCube(1.0f, Vector3(1, 1, 1)));
-            transform.scale[0] *= node.params.value("size_x", 1.0f);
-            transform.scale[1] *= node.params.value("size_y", 1.0f);
-            transform.scale[2] *= node.params.value("size_z", 1.0f);
+            transform.scale[0] *= params.sizeX;
+            transform.scale[1] *= params.sizeY;
+            transform.scale[2] *= params.sizeZ;
             break;
         case PrimitiveType::Sphere:
-            mesh.reset(MeshGenerator::CreateSphere(node.params.value("radius", 0.5f), node.params.value("segments", 24), node.params.value("rings", 16), Vector3(1, 1, 1)));
+            mesh.reset(MeshGenerator::CreateSphere(params.radius, params.segments, params.rings, Vector3(1, 1, 1)));
             break;
         case PrimitiveType::Cylinder:
-            mesh.reset(MeshGenerator::CreateCylinder(node.params.value("radius", 0.5f), node.params.value("radius", 0.5f), node.params.value("height", 1.0f), node.params.value("segments", 24), Vector3(1, 1, 1)));
+            mesh.reset(MeshGenerator::CreateCylinder(params.radius, params.radius, params.height, params.segments, Vector3(1, 1, 1)));
             break;
         case PrimitiveType::Capsule:
-            mesh.reset(MeshGenerator::CreateCapsule(node.params.value("radius", 0.5f), node.params.value("height", 2.0f), node.params.value("segments", 16), node.params.value("rings", 8), Vector3(1, 1, 1)));
+            mesh.reset(MeshGenerator::CreateCapsule(params.radius, params.height, params.segments, params.rings, Vector3(1, 1, 1)));
             break;
         case PrimitiveType::Cone:
-            mesh.reset(MeshGenerator::CreateCone(node.params.value("radius", 0.5f), node.params.value("height", 1.0f), node.params.value("segments", 24), Vector3(1, 1, 1)));
+            mesh.reset(MeshGenerator::CreateCone(params.radius, params.height, params.segments, Vector3(1, 1, 1)));
             break;
         case PrimitiveType::Torus:
-            mesh.reset(MeshGenerator::CreateTorus(node.params.value("radius_outer", node.params.value("major_radius", 0.75f)), node.params.value("radius_inner", node.params.value("minor_radius", 0.25f)), node.params.value("segments_major", 24), node.params.value("segments_minor", 12), Vector3(1, 1, 1)));
+            mesh.reset(MeshGenerator::CreateTorus(params.radiusOuter, params.radiusInner, params.segmentsMajor, params.segmentsMinor, Vector3(1, 1, 1)));
             break;
     }
 
@@ -1036,164 +1130,138 @@ bool BuildPrimitive(const RuleNode& node, std::vector<MassBuildItem>& outItems,
     }
 
     ApplyTransformToMesh(*mesh, transform);
-    outItems.push_back({node.name.empty() ? node.id : node.name, node.material, mesh});
+    outItems.push_back(MakeMeshItem(instruction.itemName, instruction.material, mesh));
     return true;
 }
 
-bool BuildExtrude(const RuleNode& node, std::vector<MassBuildItem>& outItems, std::string& outError) {
-    if (node.profiles.empty()) {
+bool BuildExtrude(const MassProgram& program, const MassInstruction& instruction, std::vector<MassBuildItem>& outItems, std::string& outError) {
+    if (instruction.profileCount == 0) {
         outError = "Extrude node requires one closed 2D profile";
         return false;
     }
-    std::shared_ptr<Mesh> mesh = CreateExtrudeMesh(node.profiles.front(), node.params.value("height", 10.0f));
+    std::shared_ptr<Mesh> mesh = CreateExtrudeMesh(program.profiles[instruction.firstProfile], instruction.height);
     if (!mesh) {
         outError = "Failed to create extrude mesh";
         return false;
     }
-    ApplyTransformToMesh(*mesh, node.transform);
-    outItems.push_back({node.name.empty() ? node.id : node.name, node.material, mesh});
+    ApplyTransformToMesh(*mesh, instruction.transform);
+    outItems.push_back(MakeMeshItem(instruction.itemName, instruction.material, mesh));
     return true;
 }
 
-bool BuildRevolve(const RuleNode& node, std::vector<MassBuildItem>& outItems, std::string& outError) {
-    if (node.profiles.empty()) {
+bool BuildRevolve(const MassProgram& program, const MassInstruction& instruction, std::vector<MassBuildItem>& outItems, std::string& outError) {
+    if (instruction.profileCount == 0) {
         outError = "Revolve node requires one 2D profile";
         return false;
     }
-    std::shared_ptr<Mesh> mesh = CreateRevolveMesh(node.profiles.front(), node.params.value("segments", 32));
+    std::shared_ptr<Mesh> mesh = CreateRevolveMesh(program.profiles[instruction.firstProfile], instruction.segments);
     if (!mesh) {
         outError = "Failed to create revolve mesh";
         return false;
     }
-    ApplyTransformToMesh(*mesh, node.transform);
-    outItems.push_back({node.name.empty() ? node.id : node.name, node.material, mesh});
+    ApplyTransformToMesh(*mesh, instruction.transform);
+    outItems.push_back(MakeMeshItem(instruction.itemName, instruction.material, mesh));
     return true;
 }
 
-bool BuildSweep(const RuleNode& node, std::vector<MassBuildItem>& outItems, std::string& outError) {
-    if (node.profiles.empty() || node.paths.empty()) {
+bool BuildSweep(const MassProgram& program, const MassInstruction& instruction, std::vector<MassBuildItem>& outItems, std::string& outError) {
+    if (instruction.profileCount == 0 || instruction.pathCount == 0) {
         outError = "Sweep node requires one 2D profile and one 3D path";
         return false;
     }
-    std::shared_ptr<Mesh> mesh = CreateSweepMesh(node.profiles.front(), node.paths.front());
+    std::shared_ptr<Mesh> mesh = CreateSweepMesh(program.profiles[instruction.firstProfile], program.paths[instruction.firstPath]);
     if (!mesh) {
         outError = "Failed to create sweep mesh";
         return false;
     }
-    ApplyTransformToMesh(*mesh, node.transform);
-    outItems.push_back({node.name.empty() ? node.id : node.name, node.material, mesh});
+    ApplyTransformToMesh(*mesh, instruction.transform);
+    outItems.push_back(MakeMeshItem(instruction.itemName, instruction.material, mesh));
     return true;
 }
 
-bool BuildLoft(const RuleNode& node, std::vector<MassBuildItem>& outItems, std::string& outError) {
-    std::shared_ptr<Mesh> mesh = CreateLoftMesh(node);
+bool BuildLoft(const MassProgram& program, const MassInstruction& instruction, std::vector<MassBuildItem>& outItems, std::string& outError) {
+    std::shared_ptr<Mesh> mesh;
+    if (instruction.profileCount > 0) {
+        mesh = CreateLoftMesh(program.profiles.data() + instruction.firstProfile, instruction.profileCount,
+            program.levels.data() + instruction.firstLevel, instruction.segmentsPerSpan);
+    }
     if (!mesh) {
         outError = "Failed to create loft mesh";
         return false;
     }
-    ApplyTransformToMesh(*mesh, node.transform);
-    outItems.push_back({node.name.empty() ? node.id : node.name, node.material, mesh});
+    ApplyTransformToMesh(*mesh, instruction.transform);
+    outItems.push_back(MakeMeshItem(instruction.itemName, instruction.material, mesh));
     return true;
 }
-bool BuildGroup(const RuleNode& node,
-                std::vector<MassBuildItem>& outItems,
-                std::vector<std::string>& warnings,
-                std::string& outError,
-                BuildContext& context) {
-    std::vector<MassBuildItem> localItems;
-    for (const RuleNode& child : node.children) {
-        if (!BuildNode(child, localItems, warnings, outError, context)) {
-            return false;
-        }
-    }
-    for (MassBuildItem& item : localItems) {
-        if (item.mesh) {
-            ApplyTransformToMesh(*item.mesh, node.transform);
-        }
-        if (item.material.empty() && !node.material.empty()) {
-            item.material = node.material;
+
+void BuildGroup(const MassInstruction& instruction,
+                std::vector<std::vector<MassBuildItem>>& operands,
+                std::vector<MassBuildItem>& outItems) {
+    for (std::vector<MassBuildItem>& childItems : operands) {
+        for (MassBuildItem& item : childItems) {
+            ApplyTransformToItem(item, instruction.transform);
+            if (!instruction.material.empty()) {
+                FillEmptyMaterial(item, instruction.material);
+            }
+            outItems.push_back(std::move(item));
         }
-        outItems.push_back(std::move(item));
     }
-    return true;
 }
 
-bool BuildArray(const RuleNode& node,
-                std::vector<MassBuildItem>& outItems,
-                std::vector<std::string>& warnings,
-                std::string& outError,
-                BuildContext& context) {
-    if (node.children.size() != 1) {
-        outError = "Array node must have exactly one child";
-        return false;
-    }
-
-    std::vector<MassBuildItem> sourceItems;
-    if (!BuildNode(node.children.front(), sourceItems, warnings, outError, context)) {
-        return false;
+void BuildArray(const MassInstruction& instruction,
+                std::vector<MassBuildItem>& sourceItems,
+                std::vector<MassBuildItem>& outItems) {
+    if (sourceItems.empty()) {
+        return;
     }
 
-    const int countX = std::max(1, node.params.value("count_x", 1));
-    const int countY = std::max(1, node.params.value("count_y", 1));
-    const int countZ = std::max(1, node.params.value("count_z", 1));
-    const float spacingX = node.params.value("spacing_x", 0.0f);
-    const float spacingY = node.params.value("spacing_y", 0.0f);
-    const float spacingZ = node.params.value("spacing_z", 0.0f);
-    const float rotateY = node.params.value("rotate_step_y", 0.0f);
-
-    for (int ix = 0; ix < countX; ++ix) {
-        for (int iy = 0; iy < countY; ++iy) {
-            for (int iz = 0; iz < countZ; ++iz) {
-                RuleTransform instanceTransform = node.transform;
-                instanceTransform.position[0] += spacingX * static_cast<float>(ix);
-                instanceTransform.position[1] += spacingY * static_cast<float>(iy);
-                instanceTransform.position[2] += spacingZ * static_cast<float>(iz);
-                instanceTransform.rotation[1] += rotateY * static_cast<float>(ix + iy + iz);
-
-                for (const MassBuildItem& sourceItem : sourceItems) {
-                    MassBuildItem item;
-                    item.name = (node.name.empty() ? node.id : node.name) + "_" + std::to_string(ix) + "_" + std::to_string(iy) + "_" + std::to_string(iz);
-                    item.material = sourceItem.material.empty() ? node.material : sourceItem.material;
-                    item.mesh = CloneMesh(sourceItem.mesh);
-                    if (item.mesh) {
-                        ApplyTransformToMesh(*item.mesh, instanceTransform);
-                    }
-                    outItems.push_back(std::move(item));
-                }
+    // One instanced item replaces countX * countY * countZ mesh copies of every source item
+    const MassArrayParams& array = instruction.array;
+    MassBuildItem instanced;
+    instanced.name = instruction.itemName;
+    instanced.material = instruction.material;
+    instanced.prototypes = std::move(sourceItems);
+    for (MassBuildItem& prototype : instanced.prototypes) {
+        FillEmptyMaterial(prototype, instruction.material);
+    }
+    instanced.instances.reserve(static_cast<size_t>(array.countX) * static_cast<size_t>(array.countY) * static_cast<size_t>(array.countZ));
+
+    for (int ix = 0; ix < array.countX; ++ix) {
+        for (int iy = 0; iy < array.countY; ++iy) {
+            for (int iz = 0; iz < array.countZ; ++iz) {
+                RuleTransform instanceTransform = instruction.transform;
+                instanceTransform.position[0] += array.spacingX * static_cast<float>(ix);
+                instanceTransform.position[1] += array.spacingY * static_cast<float>(iy);
+                instanceTransform.position[2] += array.spacingZ * static_cast<float>(iz);
+                instanceTransform.rotation[1] += array.rotateStepY * static_cast<float>(ix + iy + iz);
+
+                MassInstance instance;
+                instance.name = instruction.itemName + "_" + std::to_string(ix) + "_" + std::to_string(iy) + "_" + std::to_string(iz);
+                instance.transforms.push_back(instanceTransform);
+                instanced.instances.push_back(std::move(instance));
             }
         }
     }
-    return true;
+    outItems.push_back(std::move(instanced));
 }
 
-bool BuildCsg(const RuleNode& node,
+bool BuildCsg(const MassInstruction& instruction,
+              std::vector<MassBuildItem>& leftItems,
+              std::vector<MassBuildItem>& rightItems,
               std::vector<MassBuildItem>& outItems,
-              std::vector<std::string>& warnings,
               std::string& outError,
-              BuildContext& context) {
-    if (node.children.size() != 2) {
-        outError = "CSG node must have exactly two children";
-        return false;
-    }
-
-    std::vector<MassBuildItem> leftItems;
-    std::vector<MassBuildItem> rightItems;
-    if (!BuildNode(node.children[0], leftItems, warnings, outError, context)) {
-        return false;
-    }
-    if (!BuildNode(node.children[1], rightItems, warnings, outError, context)) {
-        return false;
-    }
-
-    std::shared_ptr<Mesh> leftMesh = CollapseToSingleMesh(leftItems, CSG::Operation::Union);
-    std::shared_ptr<Mesh> rightMesh = CollapseToSingleMesh(rightItems, CSG::Operation::Union);
+              const BuildContext& context) {
+    ExpandInstancedItems(leftItems);
+    ExpandInstancedItems(rightItems);
+    std::shared_ptr<Mesh> leftMesh = CollapseToSingleMesh(leftItems, CSG::Operation::Union, context);
+    std::shared_ptr<Mesh> rightMesh = CollapseToSingleMesh(rightItems, CSG::Operation::Union, context);
     if (!leftMesh || !rightMesh) {
         outError = "Failed to collapse CSG children into meshes";
         return false;
     }
 
     CSG::Operation op = CSG::Operation::Union;
-    switch (node.csgOperation) {
+    switch (instruction.csgOperation) {
         case CsgOperation::Union: op = CSG::Operation::Union; break;
         case CsgOperation::Subtract: op = CSG::Operation::Subtract; break;
         case CsgOperation::Intersect: op = CSG::Operation::Intersect; break;
@@ -1205,157 +1273,255 @@ bool BuildCsg(const RuleNode& node,
         return false;
     }
 
-    ApplyTransformToMesh(*result, node.transform);
-    outItems.push_back({node.name.empty() ? node.id : node.name, node.material.empty() ? leftItems.front().material : node.material, result});
+    ApplyTransformToMesh(*result, instruction.transform);
+    outItems.push_back(MakeMeshItem(instruction.itemName, instruction.material.empty() ? leftItems.front().material : instruction.material, result));
     return true;
 }
 
-bool BuildDeform(const RuleNode& node,
+void BuildDeform(const MassInstruction& instruction,
+                 std::vector<MassBuildItem>& localItems,
                  std::vector<MassBuildItem>& outItems,
                  std::vector<std::string>& warnings,
-                 std::string& outError,
-                 BuildContext& context) {
-    if (node.children.size() != 1) {
-        outError = "Deform node must have exactly one child";
-        return false;
-    }
-
-    std::vector<MassBuildItem> localItems;
-    if (!BuildNode(node.children[0], localItems, warnings, outError, context)) {
-        return false;
-    }
+                 const BuildContext& context) {
+    ExpandInstancedItems(localItems);
 
-    const std::string mode = node.params.value("mode", std::string("twist"));
-    const int subdivideIterations = std::max(0, node.params.value("subdivide", mode == "twist" ? 2 : 1));
     for (MassBuildItem& item : localItems) {
         if (!item.mesh) {
             continue;
         }
-        if (subdivideIterations > 0) {
-            SubdivideMesh(*item.mesh, subdivideIterations);
+        if (instruction.subdivideIterations > 0) {
+            SubdivideMesh(*item.mesh, instruction.subdivideIterations);
         }
-        if (mode == "taper") {
-            ApplyTaper(*item.mesh, node.params.value("bottom_scale", 1.0f), node.params.value("top_scale", 0.6f));
-        } else if (mode == "twist") {
-            ApplyTwist(*item.mesh, node.params.value("angle", 20.0f));
-        } else if (mode == "bend") {
-            ApplyBend(*item.mesh, node.params.value("angle", 15.0f), node.params.value("axis", std::string("z")));
-        } else if (mode == "shear") {
-            ApplyShear(*item.mesh, node.params.value("shear_x", 0.1f), node.params.value("shear_z", 0.0f));
-        } else if (mode == "bulge") {
-            ApplyBulge(*item.mesh, node.params.value("amount", 0.2f));
+        if (instruction.deformModeKnown) {
+            ApplyDeform(*item.mesh, instruction.deform, context.threadCount);
         } else {
-            warnings.push_back("Unknown deform mode '" + mode + "', keeping child mesh unchanged");
+            warnings.push_back("Unknown deform mode '" + instruction.deformMode + "', keeping child mesh unchanged");
         }
 
-        ApplyTransformToMesh(*item.mesh, node.transform);
-        if (!node.material.empty()) {
-            item.material = node.material;
+        ApplyTransformToMesh(*item.mesh, instruction.transform);
+        if (!instruction.material.empty()) {
+            item.material = instruction.material;
         }
         outItems.push_back(std::move(item));
     }
+}
+
+bool BuildReferencedRuleSet(const RuleSet& ruleSet,
+                            const std::string& resolvedPath,
+                            std::vector<MassBuildItem>& outItems,
+                            std::vector<std::string>& warnings,
+                            std::string& outError,
+                            BuildContext& context) {
+    MassProgram program;
+    if (!MassRuleCompiler::CompileToProgram(ruleSet, program, outError)) {
+        return false;
+    }
 
-    return true;
+    context.referenceStack.push_back(resolvedPath);
+    const bool built = RunProgram(program, outItems, warnings, outError, context);
+    context.referenceStack.pop_back();
+    return built;
 }
 
-bool BuildReference(const RuleNode& node,
+bool BuildReference(const MassProgram& program,
+                    const MassInstruction& instruction,
                     std::vector<MassBuildItem>& outItems,
                     std::vector<std::string>& warnings,
                     std::string& outError,
                     BuildContext& context) {
-    const std::string resolvedPath = NormalizeReferencePath(node.reference);
-    if (resolvedPath.empty()) {
-        outError = "Reference node must specify a non-empty ref";
-        return false;
-    }
-
+    const MassProgramReference& reference = program.references[instruction.reference];
+    const std::string& resolvedPath = reference.path;
     if (std::find(context.referenceStack.begin(), context.referenceStack.end(), resolvedPath) != context.referenceStack.end()) {
         outError = "Reference cycle detected: " + resolvedPath;
         return false;
     }
 
-    const std::string jsonString = ReadUtf8TextFile(resolvedPath);
-    if (jsonString.empty()) {
-        outError = "Failed to read referenced massing asset: " + resolvedPath;
-        return false;
-    }
-
-    RuleSet referencedRuleSet;
-    if (!MassRuleParser::ParseFromString(jsonString, referencedRuleSet, outError)) {
-        outError = "Failed to parse referenced massing asset '" + resolvedPath + "': " + outError;
-        return false;
-    }
+    std::vector<MassBuildItem> localItems;
+    if (context.referenceCache) {
+        std::shared_ptr<const RuleSet> referencedRuleSet;
+        MassReferenceCache::Dependency dependency;
+        if (!context.referenceCache->LoadRuleSet(resolvedPath, referencedRuleSet, outError, &dependency)) {
+            return false;
+        }
 
-    context.referenceStack.push_back(resolvedPath);
+        // The referenced root builds the same items wherever it is referenced, as long as
+        // none of the assets it references in turn has changed
+        std::vector<MassReferenceCache::Dependency> nestedDependencies;
+        if (!context.referenceCache->LookupBuild(resolvedPath, referencedRuleSet, localItems, warnings, &nestedDependencies)) {
+            std::vector<std::string> referencedWarnings;
+            std::vector<MassReferenceCache::Dependency>* outerDependencies = context.dependencies;
+            context.dependencies = &nestedDependencies;
+            const bool built = BuildReferencedRuleSet(*referencedRuleSet, resolvedPath, localItems, referencedWarnings, outError, context);
+            context.dependencies = outerDependencies;
+            if (!built) {
+                return false;
+            }
+            context.referenceCache->StoreBuild(resolvedPath, referencedRuleSet, localItems, referencedWarnings, nestedDependencies);
+            warnings.insert(warnings.end(), referencedWarnings.begin(), referencedWarnings.end());
+        }
 
-    std::vector<MassBuildItem> localItems;
-    const bool built = BuildNode(referencedRuleSet.root, localItems, warnings, outError, context);
+        if (context.dependencies) {
+            context.dependencies->push_back(std::move(dependency));
+            context.dependencies->insert(context.dependencies->end(), nestedDependencies.begin(), nestedDependencies.end());
+        }
+    } else {
+        const std::string jsonString = ReadUtf8TextFile(resolvedPath);
+        if (jsonString.empty()) {
+            outError = "Failed to read referenced massing asset: " + resolvedPath;
+            return false;
+        }
 
-    context.referenceStack.pop_back();
+        RuleSet referencedRuleSet;
+        if (!MassRuleParser::ParseFromString(jsonString, referencedRuleSet, outError)) {
+            outError = "Failed to parse referenced massing asset '" + resolvedPath + "': " + outError;
+            return false;
+        }
 
-    if (!built) {
-        return false;
+        if (!BuildReferencedRuleSet(referencedRuleSet, resolvedPath, localItems, warnings, outError, context)) {
+            return false;
+        }
     }
 
     for (MassBuildItem& item : localItems) {
-        if (item.mesh) {
-            ApplyTransformToMesh(*item.mesh, node.transform);
+        ApplyTransformToItem(item, instruction.transform);
+        if (!instruction.material.empty()) {
+            OverrideMaterial(item, instruction.material);
         }
-        if (!node.material.empty()) {
-            item.material = node.material;
-        }
-        if (!node.name.empty()) {
-            item.name = node.name + "/" + item.name;
+        if (!instruction.name.empty()) {
+            PrefixItemName(item, instruction.name + "/");
         }
         outItems.push_back(std::move(item));
     }
 
-    warnings.push_back("Expanded massing reference: " + node.reference);
+    warnings.push_back("Expanded massing reference: " + reference.ref);
     return true;
 }
 
-bool BuildNode(const RuleNode& node,
-               std::vector<MassBuildItem>& outItems,
-               std::vector<std::string>& warnings,
-               std::string& outError,
-               BuildContext& context) {
-    switch (node.type) {
-        case RuleNodeType::Primitive: return BuildPrimitive(node, outItems, outError);
-        case RuleNodeType::Extrude: return BuildExtrude(node, outItems, outError);
-        case RuleNodeType::Revolve: return BuildRevolve(node, outItems, outError);
-        case RuleNodeType::Sweep: return BuildSweep(node, outItems, outError);
-        case RuleNodeType::Loft: return BuildLoft(node, outItems, outError);
-        case RuleNodeType::Csg: return BuildCsg(node, outItems, warnings, outError, context);
-        case RuleNodeType::Deform: return BuildDeform(node, outItems, warnings, outError, context);
-        case RuleNodeType::Array: return BuildArray(node, outItems, warnings, outError, context);
-        case RuleNodeType::Group: return BuildGroup(node, outItems, warnings, outError, context);
-        case RuleNodeType::Reference: return BuildReference(node, outItems, warnings, outError, context);
+bool RunInstruction(const MassProgram& program,
+                    const MassInstruction& instruction,
+                    std::vector<std::vector<MassBuildItem>>& operands,
+                    std::vector<MassBuildItem>& outItems,
+                    std::vector<std::string>& warnings,
+                    std::string& outError,
+                    BuildContext& context) {
+    switch (instruction.type) {
+        case RuleNodeType::Primitive: return BuildPrimitive(instruction, outItems, outError);
+        case RuleNodeType::Extrude: return BuildExtrude(program, instruction, outItems, outError);
+        case RuleNodeType::Revolve: return BuildRevolve(program, instruction, outItems, outError);
+        case RuleNodeType::Sweep: return BuildSweep(program, instruction, outItems, outError);
+        case RuleNodeType::Loft: return BuildLoft(program, instruction, outItems, outError);
+        case RuleNodeType::Csg: return BuildCsg(instruction, operands[0], operands[1], outItems, outError, context);
+        case RuleNodeType::Deform: BuildDeform(instruction, operands[0], outItems, warnings, context); return true;
+        case RuleNodeType::Array: BuildArray(instruction, operands[0], outItems); return true;
+        case RuleNodeType::Group: BuildGroup(instruction, operands, outItems); return true;
+        case RuleNodeType::Reference: return BuildReference(program, instruction, outItems, warnings, outError, context);
         default:
             outError = "Unsupported massing node type";
             return false;
     }
 }
 
+bool RunProgram(const MassProgram& program,
+                std::vector<MassBuildItem>& outItems,
+                std::vector<std::string>& warnings,
+                std::string& outError,
+                BuildContext& context) {
+    // Results of finished instructions; an instruction pops its operands and pushes its own result
+    std::vector<std::vector<MassBuildItem>> results;
+    std::vector<std::vector<MassBuildItem>> operands;
+    for (const MassInstruction& instruction : program.instructions) {
+        if (instruction.operandCount > results.size()) {
+            outError = "Massing program instruction consumes more results than were produced";
+            return false;
+        }
+
+        const auto firstOperand = results.end() - static_cast<std::ptrdiff_t>(instruction.operandCount);
+        operands.assign(std::make_move_iterator(firstOperand), std::make_move_iterator(results.end()));
+        results.erase(firstOperand, results.end());
+
+        std::vector<MassBuildItem> produced;
+        if (!RunInstruction(program, instruction, operands, produced, warnings, outError, context)) {
+            return false;
+        }
+        results.push_back(std::move(produced));
+    }
+
+    if (results.size() != 1) {
+        outError = "Massing program must leave exactly one result";
+        return false;
+    }
+    for (MassBuildItem& item : results.front()) {
+        outItems.push_back(std::move(item));
+    }
+    return true;
+}
+
 } // namespace
 
 bool MassMeshBuilder::Build(const RuleSet& ruleSet, MassBuildResult& outResult, std::string& outError) {
+    return Build(ruleSet, MassBuildOptions(), outResult, outError);
+}
+
+bool MassMeshBuilder::Build(const RuleSet& ruleSet,
+                            const MassBuildOptions& options,
+                            MassBuildResult& outResult,
+                            std::string& outError) {
+    outResult.items.clear();
+    outResult.warnings.clear();
+    MassProgram program;
+    if (!MassRuleCompiler::CompileToProgram(ruleSet, program, outError)) {
+        return false;
+    }
+    return Build(program, options, outResult, outError);
+}
+
+bool MassMeshBuilder::Build(const MassProgram& program,
+                            const MassBuildOptions& options,
+                            MassBuildResult& outResult,
+                            std::string& outError) {
     outResult.items.clear();
     outResult.warnings.clear();
     BuildContext context;
-    if (!BuildNode(ruleSet.root, outResult.items, outResult.warnings, outError, context)) {
+    context.referenceCache = options.cacheReferences ? &MassReferenceCache::GetShared() : nullptr;
+    context.balancedBooleans = options.balancedBooleans;
+    context.threadCount = options.threadCount;
+    if (!RunProgram(program, outResult.items, outResult.warnings, outError, context)) {
         return false;
     }
 
+    if (!options.instancedArrays) {
+        ExpandInstancedItems(outResult.items);
+    }
     for (MassBuildItem& item : outResult.items) {
-        if (!item.mesh || !item.mesh->IsValid()) {
-            continue;
-        }
-        SplitVerticesByCrease(*item.mesh);
+        SplitItemVerticesByCrease(item);
     }
 
     return true;
 }
 
+void MassMeshBuilder::ExpandInstances(std::vector<MassBuildItem>& ioItems) {
+    ExpandInstancedItems(ioItems);
+}
+
+void MassMeshBuilder::CollectPlacements(const std::vector<MassBuildItem>& items,
+                                        std::vector<MassMeshPlacement>& outPlacements) {
+    for (const MassBuildItem& item : items) {
+        if (!item.IsInstanced()) {
+            MassMeshPlacement placement;
+            placement.name = item.name;
+            placement.material = item.material;
+            placement.mesh = item.mesh;
+            outPlacements.push_back(std::move(placement));
+            continue;
+        }
+        for (const MassInstance& instance : item.instances) {
+            for (const MassBuildItem& prototype : item.prototypes) {
+                AppendInstancePlacements(prototype, instance.transforms, instance.name, outPlacements);
+            }
+        }
+    }
+}
+
 } // namespace Massing
 } // namespace Moon
 
@@ -1,7 +1,10 @@
 ﻿#pragma once
 
+#include "MassProgram.h"
 #include "MassRules.h"
+#include "../core/Math/Quaternion.h"
 #include "../core/Mesh/Mesh.h"
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -9,10 +12,28 @@
 namespace Moon {
 namespace Massing {
 
+struct MassBuildItem;
+
+/**
+ * @brief One copy of an instanced item
+ */
+struct MassInstance {
+    std::string name;                       // Name the expanded copy carries
+    std::vector<RuleTransform> transforms;  // Applied in order to a copy of each prototype
+};
+
 struct MassBuildItem {
     std::string name;
     std::string material;
     std::shared_ptr<Mesh> mesh;
+
+    // Instanced item (Array output): mesh is null and the item stands for one copy
+    // of every prototype per instance, in instance-major order. Prototypes may be
+    // instanced themselves; their meshes are shared and never modified.
+    std::vector<MassBuildItem> prototypes;
+    std::vector<MassInstance> instances;
+
+    bool IsInstanced() const { return !instances.empty(); }
 };
 
 struct MassBuildResult {
@@ -20,9 +41,70 @@ struct MassBuildResult {
     std::vector<std::string> warnings;
 };
 
+/**
+ * @brief One mesh copy placed by scale, then rotation, then position
+ * Matches the TRS order of a scene node's local transform.
+ */
+struct MassMeshPlacement {
+    std::string name;
+    std::string material;
+    std::shared_ptr<Mesh> mesh;             // Shared with the build result's prototypes; do not modify
+    Vector3 position {0.0f, 0.0f, 0.0f};
+    Quaternion rotation;
+    Vector3 scale {1.0f, 1.0f, 1.0f};
+};
+
+struct MassBuildOptions {
+    // Keep Array copies as shared prototype meshes plus transform lists. Copies are
+    // only turned into geometry where a Csg or Deform node needs them. Crease
+    // splitting then runs on the prototypes instead of on every transformed copy.
+    // The editor preview places the copies with CollectPlacements; building
+    // envelopes and floor-plate slicing need flat world-space meshes and leave it off.
+    bool instancedArrays = false;
+
+    // Reuse parsed and built Reference assets from MassReferenceCache::GetShared()
+    bool cacheReferences = true;
+
+    // Reduce the operands of each Csg child as a balanced tree of pairwise booleans,
+    // evaluating independent pairs in parallel. false folds them left to right.
+    bool balancedBooleans = true;
+
+    // Threads for the parallel parts of a build (Csg reductions and Deform kernels),
+    // the caller included. 0 = hardware concurrency, 1 = calling thread only. Callers
+    // that run several builds at once should split their own workers between them.
+    size_t threadCount = 0;
+};
+
 class MassMeshBuilder {
 public:
     static bool Build(const RuleSet& ruleSet, MassBuildResult& outResult, std::string& outError);
+    static bool Build(const RuleSet& ruleSet,
+                      const MassBuildOptions& options,
+                      MassBuildResult& outResult,
+                      std::string& outError);
+
+    /**
+     * @brief Build a program from MassRuleCompiler::CompileToProgram
+     * Build(ruleSet) compiles and runs the same program.
+     */
+    static bool Build(const MassProgram& program,
+                      const MassBuildOptions& options,
+                      MassBuildResult& outResult,
+                      std::string& outError);
+
+    /**
+     * @brief Replace instanced items with one transformed mesh copy per instance
+     */
+    static void ExpandInstances(std::vector<MassBuildItem>& ioItems);
+
+    /**
+     * @brief List the mesh copies that ExpandInstances would create, in the same order
+     * Each copy shares its prototype mesh and carries the instance transforms folded into
+     * one TRS. A copy gets its own transformed mesh when that is not exact, i.e. a
+     * non-uniform scale follows a rotation. Plain items keep their mesh and an identity TRS.
+     */
+    static void CollectPlacements(const std::vector<MassBuildItem>& items,
+                                  std::vector<MassMeshPlacement>& outPlacements);
 };
 
 } // namespace Massing
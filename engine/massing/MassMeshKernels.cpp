@@ -0,0 +1,373 @@
+#include "MassMeshKernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <thread>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define MOON_MASS_KERNELS_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace Moon {
+namespace Massing {
+
+namespace {
+
+constexpr float kPi = 3.14159265358979323846f;
+constexpr float kEpsilon = 1e-4f;
+
+// Chunk boundaries are multiples of the SSE width, so every vertex takes the same path for any thread count
+constexpr size_t kVerticesPerTask = 16384;
+constexpr size_t kFacesPerTask = 16384;
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vertex kernels load position and normal.x as four floats");
+static_assert(offsetof(Vertex, normal) == sizeof(Vector3), "Vertex kernels load position and normal.x as four floats");
+
+struct DeformFrame {
+    float minY = 0.0f;
+    float height = kEpsilon;
+};
+
+size_t ResolveThreadCount(size_t threadCount) {
+    return threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+}
+
+size_t TaskCount(size_t itemCount, size_t itemsPerTask) {
+    return (itemCount + itemsPerTask - 1) / itemsPerTask;
+}
+
+Vector3 SafeNormalize(const Vector3& value) {
+    const float length = value.Length();
+    if (length <= kEpsilon) {
+        return Vector3(0.0f, 1.0f, 0.0f);
+    }
+    return value * (1.0f / length);
+}
+
+DeformFrame ComputeDeformFrame(const std::vector<Vertex>& vertices, const MassKernelOptions& options) {
+    const size_t taskCount = TaskCount(vertices.size(), kVerticesPerTask);
+    std::vector<float> minY(taskCount, std::numeric_limits<float>::max());
+    std::vector<float> maxY(taskCount, -std::numeric_limits<float>::max());
+    ParallelFor(taskCount, options.threadCount, [&](size_t task) {
+        const size_t end = std::min(vertices.size(), (task + 1) * kVerticesPerTask);
+        for (size_t i = task * kVerticesPerTask; i < end; ++i) {
+            minY[task] = std::min(minY[task], vertices[i].position.y);
+            maxY[task] = std::max(maxY[task], vertices[i].position.y);
+        }
+    });
+
+    float boundsMin = std::numeric_limits<float>::max();
+    float boundsMax = -std::numeric_limits<float>::max();
+    for (size_t task = 0; task < taskCount; ++task) {
+        boundsMin = std::min(boundsMin, minY[task]);
+        boundsMax = std::max(boundsMax, maxY[task]);
+    }
+
+    DeformFrame frame;
+    frame.minY = boundsMin;
+    frame.height = std::max(boundsMax - boundsMin, kEpsilon);
+    return frame;
+}
+
+void DeformVertex(Vertex& vertex, const MassDeformParams& params, const DeformFrame& frame) {
+    Vector3& p = vertex.position;
+    const float t = (p.y - frame.minY) / frame.height;
+    switch (params.mode) {
+        case MassDeformMode::Taper: {
+            const float scale = params.bottomScale + (params.topScale - params.bottomScale) * t;
+            p.x *= scale;
+            p.z *= scale;
+            break;
+        }
+        case MassDeformMode::Twist: {
+            const float angle = params.angleDegrees * t * kPi / 180.0f;
+            const float c = std::cos(angle);
+            const float s = std::sin(angle);
+            p = Vector3(p.x * c + p.z * s, p.y, -p.x * s + p.z * c);
+            break;
+        }
+        case MassDeformMode::Shear:
+            p.x += p.y * params.shearX;
+            p.z += p.y * params.shearZ;
+            break;
+        case MassDeformMode::Bend: {
+            const float angle = params.angleDegrees * kPi / 180.0f * t;
+            const float c = std::cos(angle);
+            const float s = std::sin(angle);
+            p = params.bendAboutX
+                ? Vector3(p.x, p.y * c - p.z * s, p.y * s + p.z * c)
+                : Vector3(p.x * c - p.y * s, p.x * s + p.y * c, p.z);
+            break;
+        }
+        case MassDeformMode::Bulge: {
+            const float scale = 1.0f + std::sin(t * kPi) * params.amount;
+            p.x *= scale;
+            p.z *= scale;
+            break;
+        }
+    }
+}
+
+#ifdef MOON_MASS_KERNELS_SSE
+__m128 Select(__m128 mask, __m128 whenTrue, __m128 whenFalse) {
+    return _mm_or_ps(_mm_and_ps(mask, whenTrue), _mm_andnot_ps(mask, whenFalse));
+}
+
+// Cephes-style sin/cos: quadrant reduction by pi/2 in three parts, minimax polynomials on [-pi/4, pi/4]
+void SinCos(__m128 x, __m128& outSin, __m128& outCos) {
+    const __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(0.63661977236758134f)));
+    const __m128 q = _mm_cvtepi32_ps(quadrant);
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(1.5703125f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(4.837512969970703125e-4f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(7.54978995489188216e-8f)));
+    const __m128 r2 = _mm_mul_ps(r, r);
+
+    __m128 sinPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), r2), _mm_set1_ps(8.3321608736e-3f));
+    sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, r2), _mm_set1_ps(-1.6666654611e-1f));
+    sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, r2), r), r);
+
+    __m128 cosPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), r2), _mm_set1_ps(-1.388731625493765e-3f));
+    cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, r2), _mm_set1_ps(4.166664568298827e-2f));
+    cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, r2), r2);
+    cosPoly = _mm_add_ps(_mm_sub_ps(cosPoly, _mm_mul_ps(r2, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+    // Quadrant n: sin = (s, c, -s, -c)[n], cos = (c, -s, -c, s)[n]
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i two = _mm_set1_epi32(2);
+    const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+    const __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30));
+    const __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30));
+    outSin = _mm_xor_ps(Select(swap, cosPoly, sinPoly), sinSign);
+    outCos = _mm_xor_ps(Select(swap, sinPoly, cosPoly), cosSign);
+}
+
+void DeformLanes(__m128& x, __m128& y, __m128& z, const MassDeformParams& params, const DeformFrame& frame) {
+    const __m128 t = _mm_div_ps(_mm_sub_ps(y, _mm_set1_ps(frame.minY)), _mm_set1_ps(frame.height));
+    __m128 s;
+    __m128 c;
+    switch (params.mode) {
+        case MassDeformMode::Taper: {
+            const __m128 scale = _mm_add_ps(_mm_set1_ps(params.bottomScale),
+                _mm_mul_ps(_mm_set1_ps(params.topScale - params.bottomScale), t));
+            x = _mm_mul_ps(x, scale);
+            z = _mm_mul_ps(z, scale);
+            break;
+        }
+        case MassDeformMode::Twist: {
+            const __m128 degrees = _mm_mul_ps(_mm_set1_ps(params.angleDegrees), t);
+            SinCos(_mm_div_ps(_mm_mul_ps(degrees, _mm_set1_ps(kPi)), _mm_set1_ps(180.0f)), s, c);
+            const __m128 rotatedX = _mm_add_ps(_mm_mul_ps(x, c), _mm_mul_ps(z, s));
+            z = _mm_sub_ps(_mm_mul_ps(z, c), _mm_mul_ps(x, s));
+            x = rotatedX;
+            break;
+        }
+        case MassDeformMode::Shear:
+            x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(params.shearX)));
+            z = _mm_add_ps(z, _mm_mul_ps(y, _mm_set1_ps(params.shearZ)));
+            break;
+        case MassDeformMode::Bend: {
+            SinCos(_mm_mul_ps(_mm_set1_ps(params.angleDegrees * kPi / 180.0f), t), s, c);
+            if (params.bendAboutX) {
+                const __m128 bentY = _mm_sub_ps(_mm_mul_ps(y, c), _mm_mul_ps(z, s));
+                z = _mm_add_ps(_mm_mul_ps(y, s), _mm_mul_ps(z, c));
+                y = bentY;
+            } else {
+                const __m128 bentX = _mm_sub_ps(_mm_mul_ps(x, c), _mm_mul_ps(y, s));
+                y = _mm_add_ps(_mm_mul_ps(x, s), _mm_mul_ps(y, c));
+                x = bentX;
+            }
+            break;
+        }
+        case MassDeformMode::Bulge: {
+            SinCos(_mm_mul_ps(t, _mm_set1_ps(kPi)), s, c);
+            const __m128 scale = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(s, _mm_set1_ps(params.amount)));
+            x = _mm_mul_ps(x, scale);
+            z = _mm_mul_ps(z, scale);
+            break;
+        }
+    }
+}
+#endif
+
+void DeformRange(Vertex* vertices, size_t count, const MassDeformParams& params, const DeformFrame& frame, bool vectorized) {
+    size_t i = 0;
+#ifdef MOON_MASS_KERNELS_SSE
+    if (vectorized) {
+        // Transpose four (x, y, z, normal.x) rows into lanes; normal.x passes through unchanged
+        for (; i + 4 <= count; i += 4) {
+            float* row0 = &vertices[i + 0].position.x;
+            float* row1 = &vertices[i + 1].position.x;
+            float* row2 = &vertices[i + 2].position.x;
+            float* row3 = &vertices[i + 3].position.x;
+            __m128 x = _mm_loadu_ps(row0);
+            __m128 y = _mm_loadu_ps(row1);
+            __m128 z = _mm_loadu_ps(row2);
+            __m128 w = _mm_loadu_ps(row3);
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            DeformLanes(x, y, z, params, frame);
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            _mm_storeu_ps(row0, x);
+            _mm_storeu_ps(row1, y);
+            _mm_storeu_ps(row2, z);
+            _mm_storeu_ps(row3, w);
+        }
+    }
+#else
+    (void)vectorized;
+#endif
+    for (; i < count; ++i) {
+        DeformVertex(vertices[i], params, frame);
+    }
+}
+
+void ComputeFaceNormals(const std::vector<Vertex>& vertices,
+                        const std::vector<uint32_t>& indices,
+                        size_t beginFace,
+                        size_t endFace,
+                        bool vectorized,
+                        std::vector<Vector3>& outFaceNormals) {
+    size_t face = beginFace;
+#ifdef MOON_MASS_KERNELS_SSE
+    if (vectorized) {
+        // Same operation order as the scalar path, so both produce identical normals
+        alignas(16) float corner[9][4];
+        alignas(16) float normal[3][4];
+        for (; face + 4 <= endFace; face += 4) {
+            for (size_t lane = 0; lane < 4; ++lane) {
+                for (size_t k = 0; k < 3; ++k) {
+                    const Vector3& p = vertices[indices[(face + lane) * 3 + k]].position;
+                    corner[k * 3 + 0][lane] = p.x;
+                    corner[k * 3 + 1][lane] = p.y;
+                    corner[k * 3 + 2][lane] = p.z;
+                }
+            }
+            const __m128 ax = _mm_load_ps(corner[0]);
+            const __m128 ay = _mm_load_ps(corner[1]);
+            const __m128 az = _mm_load_ps(corner[2]);
+            const __m128 abx = _mm_sub_ps(_mm_load_ps(corner[3]), ax);
+            const __m128 aby = _mm_sub_ps(_mm_load_ps(corner[4]), ay);
+            const __m128 abz = _mm_sub_ps(_mm_load_ps(corner[5]), az);
+            const __m128 acx = _mm_sub_ps(_mm_load_ps(corner[6]), ax);
+            const __m128 acy = _mm_sub_ps(_mm_load_ps(corner[7]), ay);
+            const __m128 acz = _mm_sub_ps(_mm_load_ps(corner[8]), az);
+            const __m128 nx = _mm_sub_ps(_mm_mul_ps(aby, acz), _mm_mul_ps(abz, acy));
+            const __m128 ny = _mm_sub_ps(_mm_mul_ps(abz, acx), _mm_mul_ps(abx, acz));
+            const __m128 nz = _mm_sub_ps(_mm_mul_ps(abx, acy), _mm_mul_ps(aby, acx));
+            const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(nz, nz)));
+            const __m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), length);
+            const __m128 valid = _mm_cmpgt_ps(length, _mm_set1_ps(kEpsilon));
+            _mm_store_ps(normal[0], _mm_and_ps(valid, _mm_mul_ps(nx, inverse)));
+            _mm_store_ps(normal[1], Select(valid, _mm_mul_ps(ny, inverse), _mm_set1_ps(1.0f)));
+            _mm_store_ps(normal[2], _mm_and_ps(valid, _mm_mul_ps(nz, inverse)));
+            for (size_t lane = 0; lane < 4; ++lane) {
+                outFaceNormals[face + lane] = Vector3(normal[0][lane], normal[1][lane], normal[2][lane]);
+            }
+        }
+    }
+#else
+    (void)vectorized;
+#endif
+    for (; face < endFace; ++face) {
+        const Vector3& a = vertices[indices[face * 3 + 0]].position;
+        const Vector3& b = vertices[indices[face * 3 + 1]].position;
+        const Vector3& c = vertices[indices[face * 3 + 2]].position;
+        outFaceNormals[face] = SafeNormalize(Vector3::Cross(b - a, c - a));
+    }
+}
+
+} // namespace
+
+void ParallelFor(size_t taskCount, size_t threadCount, const std::function<void(size_t)>& task) {
+    const size_t workerCount = std::min(taskCount, ResolveThreadCount(threadCount));
+    if (workerCount <= 1) {
+        for (size_t i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    const auto worker = [&]() {
+        for (size_t i = next++; i < taskCount; i = next++) {
+            task(i);
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(workerCount - 1);
+    for (size_t i = 1; i < workerCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void DeformVertices(std::vector<Vertex>& vertices, const MassDeformParams& params, const MassKernelOptions& options) {
+    const DeformFrame frame = params.mode == MassDeformMode::Shear ? DeformFrame() : ComputeDeformFrame(vertices, options);
+    ParallelFor(TaskCount(vertices.size(), kVerticesPerTask), options.threadCount, [&](size_t task) {
+        const size_t begin = task * kVerticesPerTask;
+        const size_t count = std::min(kVerticesPerTask, vertices.size() - begin);
+        DeformRange(vertices.data() + begin, count, params, frame, options.vectorized);
+    });
+}
+
+void RecomputeVertexNormals(std::vector<Vertex>& vertices,
+                            const std::vector<uint32_t>& indices,
+                            const MassKernelOptions& options) {
+    const size_t faceCount = indices.size() / 3;
+    std::vector<Vector3> faceNormals(faceCount);
+    ParallelFor(TaskCount(faceCount, kFacesPerTask), options.threadCount, [&](size_t task) {
+        const size_t begin = task * kFacesPerTask;
+        ComputeFaceNormals(vertices, indices, begin, std::min(faceCount, begin + kFacesPerTask), options.vectorized, faceNormals);
+    });
+
+    const size_t vertexTaskCount = TaskCount(vertices.size(), kVerticesPerTask);
+    if (vertexTaskCount <= 1 || ResolveThreadCount(options.threadCount) <= 1) {
+        for (Vertex& vertex : vertices) {
+            vertex.normal = Vector3(0.0f, 0.0f, 0.0f);
+        }
+        for (size_t face = 0; face < faceCount; ++face) {
+            for (size_t k = 0; k < 3; ++k) {
+                Vector3& normal = vertices[indices[face * 3 + k]].normal;
+                normal = normal + faceNormals[face];
+            }
+        }
+        for (Vertex& vertex : vertices) {
+            vertex.normal = SafeNormalize(vertex.normal);
+        }
+        return;
+    }
+
+    // Vertex -> face lists in face order, so each vertex gathers its sum without sharing writes
+    std::vector<uint32_t> faceStart(vertices.size() + 1, 0);
+    for (size_t i = 0; i < faceCount * 3; ++i) {
+        ++faceStart[indices[i] + 1];
+    }
+    for (size_t v = 0; v < vertices.size(); ++v) {
+        faceStart[v + 1] += faceStart[v];
+    }
+    std::vector<uint32_t> cursor(faceStart.begin(), faceStart.end() - 1);
+    std::vector<uint32_t> vertexFaces(faceCount * 3);
+    for (size_t i = 0; i < faceCount * 3; ++i) {
+        vertexFaces[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+
+    ParallelFor(vertexTaskCount, options.threadCount, [&](size_t task) {
+        const size_t end = std::min(vertices.size(), (task + 1) * kVerticesPerTask);
+        for (size_t v = task * kVerticesPerTask; v < end; ++v) {
+            Vector3 sum(0.0f, 0.0f, 0.0f);
+            for (uint32_t k = faceStart[v]; k < faceStart[v + 1]; ++k) {
+                sum = sum + faceNormals[vertexFaces[k]];
+            }
+            vertices[v].normal = SafeNormalize(sum);
+        }
+    });
+}
+
+} // namespace Massing
+} // namespace Moon
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../core/Mesh/Mesh.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Moon {
+namespace Massing {
+
+enum class MassDeformMode {
+    Taper,
+    Twist,
+    Shear,
+    Bend,
+    Bulge
+};
+
+/**
+ * @brief Parameters of one Deform node, interpreted by mode
+ * Taper, twist, bend and bulge are driven by t = (y - minY) / height over the
+ * vertex set's vertical extent.
+ */
+struct MassDeformParams {
+    MassDeformMode mode = MassDeformMode::Twist;
+    float bottomScale = 1.0f;       // Taper
+    float topScale = 0.6f;          // Taper
+    float angleDegrees = 20.0f;     // Twist (about Y) and Bend (about X or Z)
+    bool bendAboutX = false;        // Bend
+    float shearX = 0.1f;            // Shear
+    float shearZ = 0.0f;            // Shear
+    float amount = 0.2f;            // Bulge
+};
+
+/**
+ * @brief Execution settings for the per-vertex kernels
+ * Vertices are processed in fixed-size chunks, so the result does not depend
+ * on threadCount. The SSE path evaluates sin/cos with a polynomial and matches
+ * the scalar path within float tolerance; the other kernels match exactly.
+ */
+struct MassKernelOptions {
+    bool vectorized = true;         // SSE2 where the target has it, scalar otherwise
+    size_t threadCount = 0;         // 0 = hardware concurrency, 1 = calling thread only
+};
+
+/**
+ * @brief Run task(0..taskCount-1) on up to threadCount threads, the caller included
+ * @param threadCount 0 = hardware concurrency
+ */
+void ParallelFor(size_t taskCount, size_t threadCount, const std::function<void(size_t)>& task);
+
+void DeformVertices(std::vector<Vertex>& vertices,
+                    const MassDeformParams& params,
+                    const MassKernelOptions& options = MassKernelOptions());
+
+/**
+ * @brief Smooth vertex normals: normalized sum of the unit normals of adjacent faces
+ * Faces are summed in index order on every path.
+ */
+void RecomputeVertexNormals(std::vector<Vertex>& vertices,
+                            const std::vector<uint32_t>& indices,
+                            const MassKernelOptions& options = MassKernelOptions());
+
+} // namespace Massing
+} // namespace Moon
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "MassMeshKernels.h"
+#include "MassRules.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Moon {
+namespace Massing {
+
+/**
+ * @brief Primitive parameters with the per-primitive defaults already applied
+ */
+struct MassPrimitiveParams {
+    float sizeX = 1.0f;             // Cube
+    float sizeY = 1.0f;
+    float sizeZ = 1.0f;
+    float radius = 0.5f;            // Sphere, cylinder, capsule, cone
+    float height = 1.0f;            // Cylinder, capsule, cone
+    int segments = 24;              // Sphere, cylinder, capsule, cone
+    int rings = 16;                 // Sphere, capsule
+    float radiusOuter = 0.75f;      // Torus
+    float radiusInner = 0.25f;
+    int segmentsMajor = 24;
+    int segmentsMinor = 12;
+};
+
+struct MassArrayParams {
+    int countX = 1;                 // Clamped to at least 1
+    int countY = 1;
+    int countZ = 1;
+    float spacingX = 0.0f;
+    float spacingY = 0.0f;
+    float spacingZ = 0.0f;
+    float rotateStepY = 0.0f;       // Degrees added per (ix + iy + iz)
+};
+
+struct MassProgramReference {
+    std::string ref;                // As authored, for warnings
+    std::string path;               // Normalized asset path
+};
+
+/**
+ * @brief One RuleNode lowered to typed fields
+ * Only the fields of the instruction's type are meaningful.
+ */
+struct MassInstruction {
+    RuleNodeType type = RuleNodeType::Group;
+    std::string nodeId;
+    std::string name;
+    std::string itemName;           // name, or nodeId when the name is empty
+    std::string material;
+    RuleTransform transform;
+    uint32_t operandCount = 0;      // Results of earlier instructions consumed, in child order
+
+    PrimitiveType primitive = PrimitiveType::Cube;
+    MassPrimitiveParams primitiveParams;
+
+    float height = 10.0f;           // Extrude
+    int segments = 32;              // Revolve
+    uint32_t firstProfile = 0;      // Extrude, revolve, sweep, loft: range in MassProgram::profiles
+    uint32_t profileCount = 0;
+    uint32_t firstPath = 0;         // Sweep: range in MassProgram::paths
+    uint32_t pathCount = 0;
+    uint32_t firstLevel = 0;        // Loft: profileCount levels in MassProgram::levels
+    int segmentsPerSpan = 4;        // Loft
+
+    MassArrayParams array;
+    CsgOperation csgOperation = CsgOperation::Union;
+
+    std::string deformMode;         // As authored; an unknown mode warns and keeps the mesh
+    bool deformModeKnown = false;
+    MassDeformParams deform;
+    int subdivideIterations = 0;
+
+    uint32_t reference = 0;         // Reference: index in MassProgram::references
+};
+
+/**
+ * @brief A RuleSet lowered by MassRuleCompiler::CompileToProgram
+ *
+ * Instructions are in post-order: each consumes the results of the
+ * operandCount instructions before it and leaves one result, so the last
+ * instruction yields the rule set's items. Parameters, curves, loft levels and
+ * reference paths are resolved at compile time and the builder never reads
+ * JSON. An instruction found by node id can be patched and the program rebuilt
+ * without going back to the rule set; mesh generation dominates a rebuild, so
+ * this saves little over Build(ruleSet).
+ */
+struct MassProgram {
+    std::vector<MassInstruction> instructions;
+    std::vector<Curve2D> profiles;
+    std::vector<Curve3D> paths;
+    std::vector<float> levels;
+    std::vector<MassProgramReference> references;
+
+    MassInstruction* FindInstruction(const std::string& nodeId) {
+        for (MassInstruction& instruction : instructions) {
+            if (instruction.nodeId == nodeId) {
+                return &instruction;
+            }
+        }
+        return nullptr;
+    }
+};
+
+} // namespace Massing
+} // namespace Moon
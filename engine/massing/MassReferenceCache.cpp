@@ -0,0 +1,198 @@
+#include "MassReferenceCache.h"
+
+#include "MassRuleParser.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace Moon {
+namespace Massing {
+
+namespace {
+
+std::string ReadUtf8TextFile(const std::string& path) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input.is_open()) {
+        return {};
+    }
+
+    std::string contents((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    if (contents.size() >= 3 &&
+        static_cast<unsigned char>(contents[0]) == 0xEF &&
+        static_cast<unsigned char>(contents[1]) == 0xBB &&
+        static_cast<unsigned char>(contents[2]) == 0xBF) {
+        contents.erase(0, 3);
+    }
+    return contents;
+}
+
+MassBuildItem CloneItem(const MassBuildItem& source) {
+    MassBuildItem copy;
+    copy.name = source.name;
+    copy.material = source.material;
+    if (source.mesh) {
+        copy.mesh = std::make_shared<Mesh>();
+        copy.mesh->SetVertices(source.mesh->GetVertices());
+        copy.mesh->SetIndices(source.mesh->GetIndices());
+    }
+    copy.prototypes.reserve(source.prototypes.size());
+    for (const MassBuildItem& prototype : source.prototypes) {
+        copy.prototypes.push_back(CloneItem(prototype));
+    }
+    copy.instances = source.instances;
+    return copy;
+}
+
+bool IsCurrent(const MassReferenceCache::Dependency& dependency) {
+    std::error_code writeTimeError;
+    const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(dependency.path, writeTimeError);
+    return !writeTimeError && writeTime == dependency.writeTime;
+}
+
+} // namespace
+
+MassReferenceCache& MassReferenceCache::GetShared() {
+    static MassReferenceCache cache;
+    return cache;
+}
+
+bool MassReferenceCache::LoadRuleSet(const std::string& path,
+                                     std::shared_ptr<const RuleSet>& outRuleSet,
+                                     std::string& outError,
+                                     Dependency* outDependency) {
+    std::error_code writeTimeError;
+    const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, writeTimeError);
+    if (outDependency) {
+        // An unreadable write time never matches again, so builds that read this file are not reused
+        outDependency->path = path;
+        outDependency->writeTime = writeTimeError ? std::filesystem::file_time_type::min() : writeTime;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.lookups;
+        auto it = m_entries.find(path);
+        if (!writeTimeError && it != m_entries.end() && it->second.writeTime == writeTime) {
+            ++m_stats.ruleSetHits;
+            outRuleSet = it->second.ruleSet;
+            return true;
+        }
+    }
+
+    // Read and parse outside the lock; concurrent misses on one path parse the same file
+    const std::string jsonString = ReadUtf8TextFile(path);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.fileReads;
+    }
+    if (jsonString.empty()) {
+        outError = "Failed to read referenced massing asset: " + path;
+        return false;
+    }
+
+    auto ruleSet = std::make_shared<RuleSet>();
+    std::string parseError;
+    const bool parsed = MassRuleParser::ParseFromString(jsonString, *ruleSet, parseError);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.parses;
+    }
+    if (!parsed) {
+        outError = "Failed to parse referenced massing asset '" + path + "': " + parseError;
+        return false;
+    }
+
+    outRuleSet = ruleSet;
+    if (writeTimeError) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry& entry = m_entries[path];
+    entry.writeTime = writeTime;
+    entry.ruleSet = outRuleSet;
+    entry.built.reset();
+    return true;
+}
+
+bool MassReferenceCache::LookupBuild(const std::string& path,
+                                     const std::shared_ptr<const RuleSet>& ruleSet,
+                                     std::vector<MassBuildItem>& outItems,
+                                     std::vector<std::string>& outWarnings,
+                                     std::vector<Dependency>* outDependencies) {
+    std::shared_ptr<const BuiltItems> built;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(path);
+        if (it == m_entries.end() || it->second.ruleSet != ruleSet || !it->second.built) {
+            return false;
+        }
+        built = it->second.built;
+    }
+
+    // path itself is current (ruleSet came from LoadRuleSet); check the assets it referenced
+    const bool current = std::all_of(built->dependencies.begin(), built->dependencies.end(), IsCurrent);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!current) {
+            ++m_stats.staleBuilds;
+            auto it = m_entries.find(path);
+            if (it != m_entries.end() && it->second.built == built) {
+                it->second.built.reset();
+            }
+            return false;
+        }
+        ++m_stats.buildHits;
+    }
+
+    outItems.reserve(outItems.size() + built->items.size());
+    for (const MassBuildItem& item : built->items) {
+        outItems.push_back(CloneItem(item));
+    }
+    outWarnings.insert(outWarnings.end(), built->warnings.begin(), built->warnings.end());
+    if (outDependencies) {
+        outDependencies->insert(outDependencies->end(), built->dependencies.begin(), built->dependencies.end());
+    }
+    return true;
+}
+
+void MassReferenceCache::StoreBuild(const std::string& path,
+                                    const std::shared_ptr<const RuleSet>& ruleSet,
+                                    const std::vector<MassBuildItem>& items,
+                                    const std::vector<std::string>& warnings,
+                                    const std::vector<Dependency>& dependencies) {
+    auto built = std::make_shared<BuiltItems>();
+    built->items.reserve(items.size());
+    for (const MassBuildItem& item : items) {
+        built->items.push_back(CloneItem(item));
+    }
+    built->warnings = warnings;
+    built->dependencies = dependencies;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(path);
+    if (it == m_entries.end() || it->second.ruleSet != ruleSet) {
+        return;
+    }
+    it->second.built = std::move(built);
+    ++m_stats.buildStores;
+}
+
+void MassReferenceCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
+
+MassReferenceCache::Stats MassReferenceCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats = m_stats;
+    stats.entryCount = m_entries.size();
+    return stats;
+}
+
+void MassReferenceCache::ResetStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats = Stats();
+}
+
+} // namespace Massing
+} // namespace Moon
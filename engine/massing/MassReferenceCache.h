@@ -0,0 +1,113 @@
+#pragma once
+
+#include "MassMeshBuilder.h"
+#include "MassRules.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Moon {
+namespace Massing {
+
+/**
+ * @brief Parse-once cache for massing assets loaded by Reference nodes
+ *
+ * Entries are keyed by the normalized asset path and the file's last write
+ * time: a lookup only checks the timestamp, and the file is read and parsed
+ * again once it changes. Each entry can also hold the items built from its
+ * root node, which do not depend on the referencing node, so repeated
+ * references skip the rebuild as well. A stored build records every asset the
+ * build read through nested references, and a lookup only hits while none of
+ * them has changed. Items are deep-copied in and out because builders
+ * transform meshes in place.
+ *
+ * Thread safe; MassMeshBuilder uses the shared instance by default.
+ */
+class MassReferenceCache {
+public:
+    struct Stats {
+        uint64_t lookups = 0;
+        uint64_t ruleSetHits = 0;
+        uint64_t fileReads = 0;
+        uint64_t parses = 0;
+        uint64_t buildHits = 0;
+        uint64_t buildStores = 0;
+        uint64_t staleBuilds = 0;           // Stored builds dropped because a nested asset changed
+        size_t entryCount = 0;
+    };
+
+    /**
+     * @brief One asset file a build read, with the write time it had then
+     */
+    struct Dependency {
+        std::string path;
+        std::filesystem::file_time_type writeTime;
+    };
+
+    MassReferenceCache() = default;
+    MassReferenceCache(const MassReferenceCache&) = delete;
+    MassReferenceCache& operator=(const MassReferenceCache&) = delete;
+
+    static MassReferenceCache& GetShared();
+
+    /**
+     * @brief Get the parsed rule set for a normalized asset path
+     * @param outDependency Optional; receives the path and the write time the rule set was read at
+     * @return false when the file cannot be read or parsed (nothing is cached)
+     */
+    bool LoadRuleSet(const std::string& path,
+                     std::shared_ptr<const RuleSet>& outRuleSet,
+                     std::string& outError,
+                     Dependency* outDependency = nullptr);
+
+    /**
+     * @brief Copy the items built from ruleSet's root, if they were stored and are still current
+     * @param ruleSet Rule set returned by LoadRuleSet; a reloaded file never matches older builds
+     * @param outDependencies Optional; receives the nested assets the stored build read
+     * @return false when nothing was stored or a nested asset changed since the build
+     */
+    bool LookupBuild(const std::string& path,
+                     const std::shared_ptr<const RuleSet>& ruleSet,
+                     std::vector<MassBuildItem>& outItems,
+                     std::vector<std::string>& outWarnings,
+                     std::vector<Dependency>* outDependencies = nullptr);
+
+    /**
+     * @param dependencies Every asset read through nested references while building, with the
+     *        write times returned by LoadRuleSet; path itself is covered by ruleSet
+     */
+    void StoreBuild(const std::string& path,
+                    const std::shared_ptr<const RuleSet>& ruleSet,
+                    const std::vector<MassBuildItem>& items,
+                    const std::vector<std::string>& warnings,
+                    const std::vector<Dependency>& dependencies = {});
+
+    void Clear();
+    Stats GetStats() const;
+    void ResetStats();
+
+private:
+    struct BuiltItems {
+        std::vector<MassBuildItem> items;
+        std::vector<std::string> warnings;
+        std::vector<Dependency> dependencies;
+    };
+
+    struct Entry {
+        std::filesystem::file_time_type writeTime;
+        std::shared_ptr<const RuleSet> ruleSet;
+        std::shared_ptr<const BuiltItems> built;
+    };
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;
+    Stats m_stats;
+};
+
+} // namespace Massing
+} // namespace Moon
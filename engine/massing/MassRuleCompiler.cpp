@@ -1,5 +1,8 @@
 ﻿#include "MassRuleCompiler.h"
 
+#include "../core/Assets/AssetPaths.h"
+#include <algorithm>
+
 namespace Moon {
 namespace Massing {
 
@@ -81,6 +84,100 @@ json OffsetArrayTransform(const json& sourceTransform, float offsetX, float offs
     return transform;
 }
 
+MassPrimitiveParams ResolvePrimitiveParams(const RuleNode& node) {
+    MassPrimitiveParams params;
+    switch (node.primitive) {
+        case PrimitiveType::Cube:
+            params.sizeX = node.params.value("size_x", 1.0f);
+            params.sizeY = node.params.value("size_y", 1.0f);
+            params.sizeZ = node.params.value("size_z", 1.0f);
+            break;
+        case PrimitiveType::Sphere:
+            params.radius = node.params.value("radius", 0.5f);
+            params.segments = node.params.value("segments", 24);
+            params.rings = node.params.value("rings", 16);
+            break;
+        case PrimitiveType::Cylinder:
+        case PrimitiveType::Cone:
+            params.radius = node.params.value("radius", 0.5f);
+            params.height = node.params.value("height", 1.0f);
+            params.segments = node.params.value("segments", 24);
+            break;
+        case PrimitiveType::Capsule:
+            params.radius = node.params.value("radius", 0.5f);
+            params.height = node.params.value("height", 2.0f);
+            params.segments = node.params.value("segments", 16);
+            params.rings = node.params.value("rings", 8);
+            break;
+        case PrimitiveType::Torus:
+            params.radiusOuter = node.params.value("radius_outer", node.params.value("major_radius", 0.75f));
+            params.radiusInner = node.params.value("radius_inner", node.params.value("minor_radius", 0.25f));
+            params.segmentsMajor = node.params.value("segments_major", 24);
+            params.segmentsMinor = node.params.value("segments_minor", 12);
+            break;
+    }
+    return params;
+}
+
+// Explicit "levels" when there is one per profile, otherwise profiles spread evenly over "height"
+void AppendLoftLevels(const RuleNode& node, std::vector<float>& ioLevels) {
+    const size_t profileCount = node.profiles.size();
+    if (node.params.contains("levels") && node.params["levels"].is_array() && node.params["levels"].size() == profileCount) {
+        for (const auto& value : node.params["levels"]) {
+            ioLevels.push_back(value.get<float>());
+        }
+        return;
+    }
+
+    const float height = node.params.value("height", 10.0f);
+    const float step = profileCount > 1 ? height / static_cast<float>(profileCount - 1) : 0.0f;
+    for (size_t i = 0; i < profileCount; ++i) {
+        ioLevels.push_back(step * static_cast<float>(i));
+    }
+}
+
+void ResolveDeform(const RuleNode& node, MassInstruction& ioInstruction) {
+    const std::string mode = node.params.value("mode", std::string("twist"));
+    ioInstruction.deformMode = mode;
+    ioInstruction.subdivideIterations = std::max(0, node.params.value("subdivide", mode == "twist" ? 2 : 1));
+    ioInstruction.deformModeKnown = true;
+
+    MassDeformParams& params = ioInstruction.deform;
+    if (mode == "taper") {
+        params.mode = MassDeformMode::Taper;
+        params.bottomScale = node.params.value("bottom_scale", 1.0f);
+        params.topScale = node.params.value("top_scale", 0.6f);
+    } else if (mode == "twist") {
+        params.mode = MassDeformMode::Twist;
+        params.angleDegrees = node.params.value("angle", 20.0f);
+    } else if (mode == "bend") {
+        params.mode = MassDeformMode::Bend;
+        params.angleDegrees = node.params.value("angle", 15.0f);
+        params.bendAboutX = node.params.value("axis", std::string("z")) == "x";
+    } else if (mode == "shear") {
+        params.mode = MassDeformMode::Shear;
+        params.shearX = node.params.value("shear_x", 0.1f);
+        params.shearZ = node.params.value("shear_z", 0.0f);
+    } else if (mode == "bulge") {
+        params.mode = MassDeformMode::Bulge;
+        params.amount = node.params.value("amount", 0.2f);
+    } else {
+        ioInstruction.deformModeKnown = false;
+    }
+}
+
+MassArrayParams ResolveArray(const RuleNode& node) {
+    MassArrayParams array;
+    array.countX = std::max(1, node.params.value("count_x", 1));
+    array.countY = std::max(1, node.params.value("count_y", 1));
+    array.countZ = std::max(1, node.params.value("count_z", 1));
+    array.spacingX = node.params.value("spacing_x", 0.0f);
+    array.spacingY = node.params.value("spacing_y", 0.0f);
+    array.spacingZ = node.params.value("spacing_z", 0.0f);
+    array.rotateStepY = node.params.value("rotate_step_y", 0.0f);
+    return array;
+}
+
 } // namespace
 
 bool MassRuleCompiler::CompileToBlueprint(const RuleSet& ruleSet, std::string& outBlueprintJson, std::string& outError) {
@@ -102,6 +199,107 @@ bool MassRuleCompiler::CompileToBlueprint(const RuleSet& ruleSet, std::string& o
     return true;
 }
 
+bool MassRuleCompiler::CompileToProgram(const RuleSet& ruleSet, MassProgram& outProgram, std::string& outError) {
+    outProgram = MassProgram();
+    return CompileProgramNode(ruleSet.root, outProgram, outError);
+}
+
+bool MassRuleCompiler::CompileProgramNode(const RuleNode& node, MassProgram& ioProgram, std::string& outError) {
+    MassInstruction instruction;
+    instruction.type = node.type;
+    instruction.nodeId = node.id;
+    instruction.name = node.name;
+    instruction.itemName = node.name.empty() ? node.id : node.name;
+    instruction.material = node.material;
+    instruction.transform = node.transform;
+
+    const auto appendCurves = [&]() {
+        instruction.firstProfile = static_cast<uint32_t>(ioProgram.profiles.size());
+        instruction.profileCount = static_cast<uint32_t>(node.profiles.size());
+        ioProgram.profiles.insert(ioProgram.profiles.end(), node.profiles.begin(), node.profiles.end());
+        instruction.firstPath = static_cast<uint32_t>(ioProgram.paths.size());
+        instruction.pathCount = static_cast<uint32_t>(node.paths.size());
+        ioProgram.paths.insert(ioProgram.paths.end(), node.paths.begin(), node.paths.end());
+    };
+
+    size_t operandCount = 0;
+    switch (node.type) {
+        case RuleNodeType::Primitive:
+            instruction.primitive = node.primitive;
+            instruction.primitiveParams = ResolvePrimitiveParams(node);
+            break;
+        case RuleNodeType::Extrude:
+            instruction.height = node.params.value("height", 10.0f);
+            appendCurves();
+            break;
+        case RuleNodeType::Revolve:
+            instruction.segments = node.params.value("segments", 32);
+            appendCurves();
+            break;
+        case RuleNodeType::Sweep:
+            appendCurves();
+            break;
+        case RuleNodeType::Loft:
+            appendCurves();
+            instruction.firstLevel = static_cast<uint32_t>(ioProgram.levels.size());
+            AppendLoftLevels(node, ioProgram.levels);
+            instruction.segmentsPerSpan = std::max(1, node.params.value("segments_per_span", 4));
+            break;
+        case RuleNodeType::Csg:
+            if (node.children.size() != 2) {
+                outError = "CSG node must have exactly two children";
+                return false;
+            }
+            instruction.csgOperation = node.csgOperation;
+            operandCount = 2;
+            break;
+        case RuleNodeType::Deform:
+            if (node.children.size() != 1) {
+                outError = "Deform node must have exactly one child";
+                return false;
+            }
+            ResolveDeform(node, instruction);
+            operandCount = 1;
+            break;
+        case RuleNodeType::Array:
+            if (node.children.size() != 1) {
+                outError = "Array node must have exactly one child";
+                return false;
+            }
+            instruction.array = ResolveArray(node);
+            operandCount = 1;
+            break;
+        case RuleNodeType::Group:
+            operandCount = node.children.size();
+            break;
+        case RuleNodeType::Reference: {
+            if (node.reference.empty()) {
+                outError = "Reference node must specify a non-empty ref";
+                return false;
+            }
+            MassProgramReference reference;
+            reference.ref = node.reference;
+            reference.path = Moon::Assets::BuildMassingPath(node.reference);
+            instruction.reference = static_cast<uint32_t>(ioProgram.references.size());
+            ioProgram.references.push_back(std::move(reference));
+            break;
+        }
+        default:
+            outError = "Unsupported massing node type";
+            return false;
+    }
+
+    // Operands first, so they sit right below this instruction's result at run time
+    for (size_t i = 0; i < operandCount; ++i) {
+        if (!CompileProgramNode(node.children[i], ioProgram, outError)) {
+            return false;
+        }
+    }
+    instruction.operandCount = static_cast<uint32_t>(operandCount);
+    ioProgram.instructions.push_back(std::move(instruction));
+    return true;
+}
+
 bool MassRuleCompiler::CompileNode(const RuleNode& node, json& outNode, std::string& outError) {
     const std::string nodeName = !node.name.empty() ? node.name : node.id;
 
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "MassProgram.h"
 #include "MassRules.h"
 #include <string>
 
@@ -10,8 +11,16 @@ class MassRuleCompiler {
 public:
     static bool CompileToBlueprint(const RuleSet& ruleSet, std::string& outBlueprintJson, std::string& outError);
 
+    /**
+     * @brief Lower a rule set into the flat program MassMeshBuilder executes
+     * Reads every node parameter once; fails on the structural errors the builder
+     * would report (child counts, empty references, unknown node types).
+     */
+    static bool CompileToProgram(const RuleSet& ruleSet, MassProgram& outProgram, std::string& outError);
+
 private:
     static bool CompileNode(const RuleNode& node, json& outNode, std::string& outError);
+    static bool CompileProgramNode(const RuleNode& node, MassProgram& ioProgram, std::string& outError);
 };
 
 } // namespace Massing
@@ -1,10 +1,12 @@
 #pragma once
 #include <cstdint>
+#include <string>
+#include "../core/Math/Matrix4x4.h"
 
 // Forward declarations
 namespace Moon {
-    struct Matrix4x4;
     class Mesh;
+    class Material;
 }
 
 struct RenderInitParams {
@@ -75,6 +77,25 @@ public:
      */
     virtual void SetViewProjectionMatrix(const float* viewProj16) = 0;
     
+    // === 材质和纹理状态 ===
+    // 默认空实现：不支持材质的后端（NullRenderer 等）无需重写
+    
+    /**
+     * @brief 设置后续绘制使用的材质参数
+     * @param material 材质组件（nullptr 表示默认材质）
+     */
+    virtual void SetMaterialParameters(Moon::Material* material) { (void)material; }
+    
+    /**
+     * @brief 绑定 PBR 贴图（空路径表示使用默认贴图）
+     * @param texturePath 贴图文件路径
+     */
+    virtual void BindAlbedoTexture(const std::string& texturePath) { (void)texturePath; }
+    virtual void BindAOTexture(const std::string& texturePath) { (void)texturePath; }
+    virtual void BindRoughnessTexture(const std::string& texturePath) { (void)texturePath; }
+    virtual void BindMetalnessTexture(const std::string& texturePath) { (void)texturePath; }
+    virtual void BindNormalTexture(const std::string& texturePath) { (void)texturePath; }
+    
     // === 绘制接口 ===
     
     /**
@@ -89,6 +110,20 @@ public:
      */
     virtual void DrawMesh(Moon::Mesh* mesh, const Moon::Matrix4x4& worldMatrix) = 0;
     
+    /**
+     * @brief 实例化绘制：同一 Mesh、同一材质状态的多个实例
+     * @param mesh 要绘制的 Mesh 数据
+     * @param worldMatrices 连续存放的世界变换矩阵
+     * @param instanceCount 实例数量
+     * 
+     * 默认实现逐个调用 DrawMesh；后端可重写以合并绘制调用
+     */
+    virtual void DrawMeshInstanced(Moon::Mesh* mesh, const Moon::Matrix4x4* worldMatrices, uint32_t instanceCount) {
+        for (uint32_t i = 0; i < instanceCount; ++i) {
+            DrawMesh(mesh, worldMatrices[i]);
+        }
+    }
+    
     /**
      * @brief 绘制立方体（便捷方法，已废弃）
      * @param worldMatrix 世界变换矩阵
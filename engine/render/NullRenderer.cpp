@@ -44,7 +44,7 @@ void NullRenderer::Shutdown() {
 }
 
 void NullRenderer::BeginFrame() {
-    // No-op for null renderer
+    stats_ = DrawStats();
 }
 
 void NullRenderer::EndFrame()
@@ -61,7 +61,25 @@ void NullRenderer::DrawMesh(Moon::Mesh* mesh, const Moon::Matrix4x4& worldMatrix
 {
     (void)mesh;
     (void)worldMatrix;
-    // No-op for null renderer
+    ++stats_.drawCalls;
+    ++stats_.instanceCount;
+    if (stats_.maxInstancesPerBatch < 1) {
+        stats_.maxInstancesPerBatch = 1;
+    }
+}
+
+void NullRenderer::DrawMeshInstanced(Moon::Mesh* mesh, const Moon::Matrix4x4* worldMatrices, uint32_t instanceCount)
+{
+    (void)mesh;
+    (void)worldMatrices;
+    if (instanceCount == 0) {
+        return;
+    }
+    ++stats_.instancedDrawCalls;
+    stats_.instanceCount += instanceCount;
+    if (stats_.maxInstancesPerBatch < instanceCount) {
+        stats_.maxInstancesPerBatch = instanceCount;
+    }
 }
 
 void NullRenderer::DrawCube(const Moon::Matrix4x4& worldMatrix)
@@ -6,10 +6,22 @@
 /**
  * @brief 空渲染器 - 用于无图形环境或测试
  * 
- * 不执行任何实际渲染，但实现了完整的 IRenderer 接口
+ * 不执行任何实际渲染，但实现了完整的 IRenderer 接口，
+ * 并记录绘制调用统计，用于在无 GPU 的测试中断言批处理效果
  */
 class NullRenderer : public IRenderer {
 public:
+    /**
+     * @brief 绘制调用统计（BeginFrame 时重置）
+     */
+    struct DrawStats {
+        uint32_t drawCalls = 0;           ///< DrawMesh 调用次数
+        uint32_t instancedDrawCalls = 0;  ///< DrawMeshInstanced 调用次数
+        uint32_t instanceCount = 0;       ///< 绘制的物体总数（含实例）
+        uint32_t maxInstancesPerBatch = 0;
+    };
+    
+
     bool Initialize(const RenderInitParams& params) override;
     void Shutdown() override;
     void Resize(uint32_t w, uint32_t h) override;
@@ -20,7 +32,11 @@ public:
     
     void SetViewProjectionMatrix(const float* viewProj16) override;
     void DrawMesh(Moon::Mesh* mesh, const Moon::Matrix4x4& worldMatrix) override;
+    void DrawMeshInstanced(Moon::Mesh* mesh, const Moon::Matrix4x4* worldMatrices, uint32_t instanceCount) override;
     void DrawCube(const Moon::Matrix4x4& worldMatrix) override;
+    
+    const DrawStats& GetDrawStats() const { return stats_; }
+    void ResetDrawStats() { stats_ = DrawStats(); }
 
 private:
 #ifdef _WIN32
@@ -29,4 +45,5 @@ private:
     unsigned tick_ = 0;
     uint32_t width_ = 0;
     uint32_t height_ = 0;
+    DrawStats stats_;
 };
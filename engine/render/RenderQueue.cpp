@@ -0,0 +1,462 @@
+#include "RenderQueue.h"
+#include "IRenderer.h"
+#include "../core/Scene/Scene.h"
+#include "../core/Scene/SceneNode.h"
+#include "../core/Scene/MeshRenderer.h"
+#include "../core/Scene/Material.h"
+#include "../core/Mesh/Mesh.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Moon {
+
+namespace {
+
+const std::string kNoTexture;
+
+// FNV-1a（64 位），结果再折叠到所需位宽
+constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+template<typename T>
+uint64_t HashValue(uint64_t hash, const T& value)
+{
+    return HashBytes(hash, &value, sizeof(T));
+}
+
+uint32_t Fold(uint64_t hash)
+{
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+// Bind*Texture 按槽位分发
+using BindTextureFn = void (IRenderer::*)(const std::string&);
+constexpr BindTextureFn kBindTexture[] = {
+    &IRenderer::BindAlbedoTexture,
+    &IRenderer::BindAOTexture,
+    &IRenderer::BindRoughnessTexture,
+    &IRenderer::BindMetalnessTexture,
+    &IRenderer::BindNormalTexture,
+};
+
+} // namespace
+
+void SortBackToFront(const float* viewDepths, size_t count, std::vector<uint32_t>& outOrder)
+{
+    outOrder.resize(count);
+    if (count == 0) {
+        return;
+    }
+
+    // 浮点数映射为同序的无符号整数（负数取反、正数置符号位），再取反得到降序
+    thread_local std::vector<uint32_t> keys;
+    thread_local std::vector<uint32_t> tempKeys;
+    thread_local std::vector<uint32_t> tempOrder;
+    keys.resize(count);
+    tempKeys.resize(count);
+    tempOrder.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &viewDepths[i], sizeof(bits));
+        const uint32_t ascending = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+        keys[i] = ~ascending;
+        outOrder[i] = static_cast<uint32_t>(i);
+    }
+
+    uint32_t* srcKeys = keys.data();
+    uint32_t* dstKeys = tempKeys.data();
+    uint32_t* srcOrder = outOrder.data();
+    uint32_t* dstOrder = tempOrder.data();
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        size_t offsets[256] = {};
+        for (size_t i = 0; i < count; ++i) {
+            ++offsets[(srcKeys[i] >> shift) & 0xFFu];
+        }
+        size_t sum = 0;
+        for (size_t& offset : offsets) {
+            const size_t bucket = offset;
+            offset = sum;
+            sum += bucket;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const size_t dst = offsets[(srcKeys[i] >> shift) & 0xFFu]++;
+            dstKeys[dst] = srcKeys[i];
+            dstOrder[dst] = srcOrder[i];
+        }
+        std::swap(srcKeys, dstKeys);
+        std::swap(srcOrder, dstOrder);
+    }
+    // 趟数为偶数，最终结果已回到 outOrder
+}
+
+void RenderQueue::Clear()
+{
+    m_items.clear();
+    m_sortEntries.clear();
+    m_viewDepths.clear();
+    m_backToFront = false;
+    m_stats = Stats();
+}
+
+void RenderQueue::CollectOpaque(Scene* scene, const Vector3& cameraPosition)
+{
+    if (!scene) {
+        return;
+    }
+
+    const size_t firstItem = m_items.size();
+    scene->ForEachComponent<MeshRenderer>([&](MeshRenderer* meshRenderer) {
+        Item item;
+        if (!BuildItem(meshRenderer, false, item)) {
+            return;
+        }
+
+        // 行向量系统：平移位于第 4 行
+        const Matrix4x4& world = *item.worldMatrix;
+        const float dx = world.m[3][0] - cameraPosition.x;
+        const float dy = world.m[3][1] - cameraPosition.y;
+        const float dz = world.m[3][2] - cameraPosition.z;
+        const float depth = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+        PushItem(item, MakeSortKey(item.state.pipeline, HashMaterialState(item.state),
+                                   HashTextures(item.textures), item.mesh->GetRuntimeId(), depth));
+    });
+    ApplyCulling(firstItem);
+}
+
+void RenderQueue::CollectTransparent(Scene* scene, const Vector3& cameraPosition, const Vector3& cameraForward)
+{
+    if (!scene) {
+        return;
+    }
+
+    m_backToFront = true;
+    const size_t firstItem = m_items.size();
+    scene->ForEachComponent<MeshRenderer>([&](MeshRenderer* meshRenderer) {
+        Item item;
+        if (!BuildItem(meshRenderer, true, item)) {
+            return;
+        }
+
+        // 视空间深度：物体原点到相机的向量在视线方向上的投影
+        const Matrix4x4& world = *item.worldMatrix;
+        const float viewDepth = (world.m[3][0] - cameraPosition.x) * cameraForward.x +
+                                (world.m[3][1] - cameraPosition.y) * cameraForward.y +
+                                (world.m[3][2] - cameraPosition.z) * cameraForward.z;
+
+        m_viewDepths.push_back(viewDepth);
+        PushItem(item, 0);
+    });
+    ApplyCulling(firstItem);
+}
+
+void RenderQueue::Sort()
+{
+    if (m_backToFront) {
+        SortBackToFront(m_viewDepths.data(), m_viewDepths.size(), m_order);
+        for (size_t i = 0; i < m_order.size(); ++i) {
+            m_sortEntries[i].index = m_order[i];
+        }
+        return;
+    }
+
+    std::sort(m_sortEntries.begin(), m_sortEntries.end(), [](const SortEntry& a, const SortEntry& b) {
+        return a.key < b.key;
+    });
+}
+
+void RenderQueue::Submit(IRenderer* renderer)
+{
+    const uint32_t culledCount = m_stats.culledCount;
+    const uint32_t visibleCount = m_stats.visibleCount;
+    m_stats = Stats();
+    m_stats.culledCount = culledCount;
+    m_stats.visibleCount = visibleCount;
+    m_stats.itemCount = static_cast<uint32_t>(m_items.size());
+    if (!renderer) {
+        return;
+    }
+
+    // 每次提交都从未知状态开始：两次提交之间渲染器状态可能被其他 Pass 修改
+    const MaterialState* boundState = nullptr;
+    const std::string* boundTextures[kTextureSlotCount] = {};
+
+    const size_t count = m_sortEntries.size();
+    size_t next = 0;
+    while (next < count) {
+        const Item& item = m_items[m_sortEntries[next].index];
+        const uint32_t bindsBefore = m_stats.materialBinds + m_stats.textureBinds;
+
+        if (!boundState || !SameMaterialState(*boundState, item.state)) {
+            // 切换管线会切换贴图所在的 SRB，已绑定的贴图不再有效
+            if (!boundState || boundState->pipeline != item.state.pipeline) {
+                std::fill(std::begin(boundTextures), std::end(boundTextures), nullptr);
+            }
+            renderer->SetMaterialParameters(item.material);
+            boundState = &item.state;
+            ++m_stats.materialBinds;
+        }
+
+        for (int slot = 0; slot < kTextureSlotCount; ++slot) {
+            const std::string* texture = item.textures[slot];
+            if (boundTextures[slot] && *boundTextures[slot] == *texture) {
+                continue;
+            }
+            (renderer->*kBindTexture[slot])(*texture);
+            boundTextures[slot] = texture;
+            ++m_stats.textureBinds;
+        }
+
+        if (m_stats.materialBinds + m_stats.textureBinds != bindsBefore) {
+            ++m_stats.batchCount;
+        }
+
+        // 向后合并同 Mesh、同状态的相邻绘制项
+        size_t end = next + 1;
+        if (m_instancingEnabled) {
+            while (end < count && CanInstance(item, m_items[m_sortEntries[end].index])) {
+                ++end;
+            }
+        }
+
+        const uint32_t instanceCount = static_cast<uint32_t>(end - next);
+        if (instanceCount == 1) {
+            renderer->DrawMesh(item.mesh, *item.worldMatrix);
+        } else {
+            m_instanceWorlds.clear();
+            for (size_t i = next; i < end; ++i) {
+                m_instanceWorlds.push_back(*m_items[m_sortEntries[i].index].worldMatrix);
+            }
+            renderer->DrawMeshInstanced(item.mesh, m_instanceWorlds.data(), instanceCount);
+            ++m_stats.instancedDrawCalls;
+            m_stats.instancedItems += instanceCount;
+        }
+        ++m_stats.drawCalls;
+        next = end;
+    }
+}
+
+uint64_t RenderQueue::MakeSortKey(uint32_t pipeline, uint32_t materialHash, uint32_t textureHash,
+                                  uint64_t meshId, float depth)
+{
+    // 非负浮点数的位模式与数值同序：取符号位 + 指数 + 3 位尾数作为 12 位深度
+    uint32_t depthBits = 0;
+    const float clampedDepth = depth > 0.0f ? depth : 0.0f;
+    std::memcpy(&depthBits, &clampedDepth, sizeof(depthBits));
+
+    uint64_t key = 0;
+    key |= (static_cast<uint64_t>(pipeline) & 0x3ull) << 62;
+    key |= (static_cast<uint64_t>(materialHash) & 0xFFFFFull) << 42;
+    key |= (static_cast<uint64_t>(textureHash) & 0xFFFFull) << 26;
+    key |= (meshId & 0x3FFFull) << 12;
+    key |= static_cast<uint64_t>(depthBits >> 20) & 0xFFFull;
+    return key;
+}
+
+bool RenderQueue::BuildItem(MeshRenderer* meshRenderer, bool transparent, Item& outItem) const
+{
+    if (!meshRenderer->IsEnabled() || !meshRenderer->IsVisible()) {
+        return false;
+    }
+    Mesh* mesh = meshRenderer->GetMesh().get();
+    if (!mesh || !mesh->IsValid()) {
+        return false;
+    }
+
+    Material* material = meshRenderer->GetOwner()->GetComponent<Material>();
+    if (material && !material->IsEnabled()) {
+        material = nullptr;
+    }
+    // 无材质（或材质被禁用）按不透明处理
+    const bool isTransparent = material && material->GetOpacity() < kOpacityThreshold;
+    if (isTransparent != transparent) {
+        return false;
+    }
+
+    outItem.mesh = mesh;
+    outItem.worldMatrix = &meshRenderer->GetOwner()->GetTransform()->GetWorldMatrix();
+    outItem.material = material;
+    outItem.state = CaptureMaterialState(material);
+    outItem.textures[kAlbedo] = material ? &material->GetAlbedoMap() : &kNoTexture;
+    outItem.textures[kAO] = material ? &material->GetAOMap() : &kNoTexture;
+    outItem.textures[kRoughness] = material ? &material->GetRoughnessMap() : &kNoTexture;
+    outItem.textures[kMetalness] = material ? &material->GetMetalnessMap() : &kNoTexture;
+    outItem.textures[kNormal] = material ? &material->GetNormalMap() : &kNoTexture;
+    return true;
+}
+
+void RenderQueue::PushItem(const Item& item, uint64_t key)
+{
+    SortEntry entry;
+    entry.key = key;
+    entry.index = static_cast<uint32_t>(m_items.size());
+    m_items.push_back(item);
+    m_sortEntries.push_back(entry);
+
+    if (m_frustum) {
+        const BoundingSphere sphere = item.mesh->GetBoundingSphere().Transformed(*item.worldMatrix);
+        m_cullX.push_back(sphere.center.x);
+        m_cullY.push_back(sphere.center.y);
+        m_cullZ.push_back(sphere.center.z);
+        m_cullRadius.push_back(sphere.radius);
+    }
+}
+
+void RenderQueue::ApplyCulling(size_t firstItem)
+{
+    const size_t collected = m_items.size() - firstItem;
+    if (!m_frustum || collected == 0) {
+        m_stats.visibleCount += static_cast<uint32_t>(collected);
+        return;
+    }
+
+    // 粗测：包围球批量测试；细测：通过的物体再用世界空间 AABB 测试
+    m_cullVisible.resize(collected);
+    m_frustum->CullSpheres(m_cullX.data(), m_cullY.data(), m_cullZ.data(), m_cullRadius.data(),
+                           collected, m_cullVisible.data());
+
+    // 原地压缩新增的绘制项；PushItem 保证 m_items 与 m_sortEntries（以及透明时的
+    // m_viewDepths）一一对应，压缩后重写 SortEntry::index
+    const bool hasViewDepths = m_viewDepths.size() == m_items.size();
+    size_t write = firstItem;
+    for (size_t i = 0; i < collected; ++i) {
+        const size_t read = firstItem + i;
+        const Item& item = m_items[read];
+        if (!m_cullVisible[i] ||
+            !m_frustum->IsAABBVisible(item.mesh->GetBounds().Transformed(*item.worldMatrix))) {
+            continue;
+        }
+        if (write != read) {
+            m_items[write] = m_items[read];
+            m_sortEntries[write] = m_sortEntries[read];
+            if (hasViewDepths) {
+                m_viewDepths[write] = m_viewDepths[read];
+            }
+        }
+        m_sortEntries[write].index = static_cast<uint32_t>(write);
+        ++write;
+    }
+
+    const size_t visible = write - firstItem;
+    m_stats.visibleCount += static_cast<uint32_t>(visible);
+    m_stats.culledCount += static_cast<uint32_t>(collected - visible);
+
+    m_items.resize(write);
+    m_sortEntries.resize(write);
+    if (hasViewDepths) {
+        m_viewDepths.resize(write);
+    }
+    m_cullX.clear();
+    m_cullY.clear();
+    m_cullZ.clear();
+    m_cullRadius.clear();
+}
+
+RenderQueue::MaterialState RenderQueue::CaptureMaterialState(Material* material)
+{
+    MaterialState state;
+    if (!material) {
+        return state;
+    }
+
+    state.isDefault = false;
+    state.pipeline = static_cast<uint32_t>(material->GetShadingModel());
+    state.metallic = material->GetMetallic();
+    state.roughness = material->GetRoughness();
+    state.baseColor = material->GetBaseColor();
+    state.opacity = material->GetOpacity();
+    state.transmissionColor = material->GetTransmissionColor();
+    state.mappingMode = static_cast<uint32_t>(material->GetMappingMode());
+    state.triplanarTiling = material->GetTriplanarTiling();
+    state.triplanarBlend = material->GetTriplanarBlend();
+    state.hasNormalMap = material->HasNormalMap();
+    state.useVertexColorTint = material->GetUseVertexColorTint();
+    state.alphaCutoff = material->GetAlphaCutoff();
+    return state;
+}
+
+bool RenderQueue::SameMaterialState(const MaterialState& a, const MaterialState& b)
+{
+    if (a.isDefault || b.isDefault) {
+        return a.isDefault == b.isDefault;
+    }
+    return a.pipeline == b.pipeline &&
+           a.metallic == b.metallic &&
+           a.roughness == b.roughness &&
+           a.baseColor.x == b.baseColor.x && a.baseColor.y == b.baseColor.y && a.baseColor.z == b.baseColor.z &&
+           a.opacity == b.opacity &&
+           a.transmissionColor.x == b.transmissionColor.x &&
+           a.transmissionColor.y == b.transmissionColor.y &&
+           a.transmissionColor.z == b.transmissionColor.z &&
+           a.mappingMode == b.mappingMode &&
+           a.triplanarTiling == b.triplanarTiling &&
+           a.triplanarBlend == b.triplanarBlend &&
+           a.hasNormalMap == b.hasNormalMap &&
+           a.useVertexColorTint == b.useVertexColorTint &&
+           a.alphaCutoff == b.alphaCutoff;
+}
+
+bool RenderQueue::CanInstance(const Item& a, const Item& b)
+{
+    if (a.mesh != b.mesh || !SameMaterialState(a.state, b.state)) {
+        return false;
+    }
+    for (int slot = 0; slot < kTextureSlotCount; ++slot) {
+        if (a.textures[slot] != b.textures[slot] && *a.textures[slot] != *b.textures[slot]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t RenderQueue::HashMaterialState(const MaterialState& state)
+{
+    if (state.isDefault) {
+        return 0;
+    }
+
+    // 逐字段哈希，避免结构体填充字节参与计算
+    uint64_t hash = kFnvOffset;
+    hash = HashValue(hash, state.pipeline);
+    hash = HashValue(hash, state.metallic);
+    hash = HashValue(hash, state.roughness);
+    hash = HashValue(hash, state.baseColor.x);
+    hash = HashValue(hash, state.baseColor.y);
+    hash = HashValue(hash, state.baseColor.z);
+    hash = HashValue(hash, state.opacity);
+    hash = HashValue(hash, state.transmissionColor.x);
+    hash = HashValue(hash, state.transmissionColor.y);
+    hash = HashValue(hash, state.transmissionColor.z);
+    hash = HashValue(hash, state.mappingMode);
+    hash = HashValue(hash, state.triplanarTiling);
+    hash = HashValue(hash, state.triplanarBlend);
+    hash = HashValue(hash, state.hasNormalMap);
+    hash = HashValue(hash, state.useVertexColorTint);
+    hash = HashValue(hash, state.alphaCutoff);
+    return Fold(hash);
+}
+
+uint32_t RenderQueue::HashTextures(const std::string* const* textures)
+{
+    uint64_t hash = kFnvOffset;
+    for (int slot = 0; slot < kTextureSlotCount; ++slot) {
+        hash = HashBytes(hash, textures[slot]->data(), textures[slot]->size());
+        hash = HashValue(hash, slot);  // 分隔符：避免不同槽位的路径拼接后相同
+    }
+    return Fold(hash);
+}
+
+} // namespace Moon
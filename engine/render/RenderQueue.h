@@ -0,0 +1,192 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../core/Camera/Camera.h"
+#include "../core/Camera/Frustum.h"
+
+// Forward declarations
+class IRenderer;
+
+namespace Moon {
+
+class Scene;
+class Mesh;
+class Material;
+class MeshRenderer;
+
+/**
+ * @brief 按视空间深度从远到近排序（稳定的 LSD 基数排序，4 趟 × 8 位）
+ * @param viewDepths 每个物体的视空间深度（越大越远，可为负）
+ * @param count 物体数量
+ * @param outOrder 输出：从远到近的物体下标；深度相同的物体保持输入顺序
+ */
+void SortBackToFront(const float* viewDepths, size_t count, std::vector<uint32_t>& outOrder);
+
+/**
+ * @brief 渲染队列 - 收集可见 MeshRenderer，按 64 位排序键排序后提交
+ *
+ * 不透明排序键布局（高位优先）：
+ *   [63..62] 管线（着色模型）
+ *   [61..42] 材质参数哈希
+ *   [41..26] 纹理组合哈希
+ *   [25..12] Mesh 运行时 ID
+ *   [11..0]  深度（由近到远，减少不透明物体的 overdraw）
+ *
+ * 排序后相同材质/纹理的绘制相邻，Submit 只在状态真正变化时调用
+ * SetMaterialParameters / Bind*Texture。哈希只决定顺序，是否跳过绑定
+ * 以实际参数和贴图路径比较为准，哈希冲突不会导致错误的材质。
+ *
+ * 透明物体必须从远到近混合，不能按材质重排：CollectTransparent 之后 Sort
+ * 使用 SortBackToFront，Submit 只合并相邻且状态相同的绘制。
+ *
+ * 实例化（默认开启）：排序后相邻、Mesh 相同且材质/贴图完全相同的绘制
+ * 合并为一次 DrawMeshInstanced。
+ *
+ * 视锥剔除（SetFrustum 后生效）：Collect* 先用世界空间包围球批量（SSE，每次 4 个）
+ * 测试，通过的再用世界空间 AABB 精测，被剔除的物体不进入排序与提交。
+ */
+class RenderQueue {
+public:
+    /**
+     * @brief 统计（剔除计数在 Clear 时重置，提交计数在每次 Submit 时重置）
+     */
+    struct Stats {
+        uint32_t culledCount = 0;    ///< 被视锥剔除的物体
+        uint32_t visibleCount = 0;   ///< 通过视锥测试的物体（未设置视锥时为全部收集的物体）
+        uint32_t itemCount = 0;      ///< 队列中的绘制项
+        uint32_t drawCalls = 0;      ///< DrawMesh + DrawMeshInstanced 调用次数
+        uint32_t materialBinds = 0;  ///< SetMaterialParameters 调用次数
+        uint32_t textureBinds = 0;   ///< Bind*Texture 调用次数
+        uint32_t batchCount = 0;     ///< 相邻且材质/贴图完全相同的绘制段数
+        uint32_t instancedDrawCalls = 0;  ///< 其中 DrawMeshInstanced 的调用次数
+        uint32_t instancedItems = 0;      ///< 通过实例化绘制的绘制项
+    };
+
+    /// 透明度阈值：大于等于此值认为是不透明物体
+    static constexpr float kOpacityThreshold = 0.99f;
+
+    /**
+     * @brief 清空队列（保留已分配的容量，供下一帧复用）
+     */
+    void Clear();
+
+    /**
+     * @brief 收集场景中所有可见的不透明 MeshRenderer
+     * @param scene 场景
+     * @param cameraPosition 相机位置（用于深度排序）
+     */
+    void CollectOpaque(Scene* scene, const Vector3& cameraPosition);
+
+    /**
+     * @brief 收集场景中所有可见的透明 MeshRenderer
+     * @param scene 场景
+     * @param cameraPosition 相机位置
+     * @param cameraForward 相机朝向（单位向量，用于计算视空间深度）
+     */
+    void CollectTransparent(Scene* scene, const Vector3& cameraPosition, const Vector3& cameraForward);
+
+    /**
+     * @brief 排序：不透明按排序键，透明按深度从远到近
+     */
+    void Sort();
+
+    /**
+     * @brief 按排序顺序提交绘制，跳过冗余的材质/纹理绑定
+     * @param renderer 渲染器
+     */
+    void Submit(IRenderer* renderer);
+
+    /**
+     * @brief 设置剔除用的视锥（nullptr 关闭剔除）；只影响之后的 Collect* 调用
+     * @param frustum 视锥（由调用方持有，需在 Collect* 期间保持有效）
+     */
+    void SetFrustum(const Frustum* frustum) { m_frustum = frustum; }
+
+    /**
+     * @brief 启用/禁用实例化合并（禁用时每个绘制项单独 DrawMesh）
+     */
+    void SetInstancingEnabled(bool enabled) { m_instancingEnabled = enabled; }
+    bool IsInstancingEnabled() const { return m_instancingEnabled; }
+
+    size_t GetItemCount() const { return m_items.size(); }
+    const Stats& GetStats() const { return m_stats; }
+
+    /**
+     * @brief 组装排序键（各字段截断到对应位宽）
+     * @param depth 到相机的距离（>= 0）
+     */
+    static uint64_t MakeSortKey(uint32_t pipeline, uint32_t materialHash, uint32_t textureHash,
+                                uint64_t meshId, float depth);
+
+private:
+    enum TextureSlot {
+        kAlbedo,
+        kAO,
+        kRoughness,
+        kMetalness,
+        kNormal,
+        kTextureSlotCount
+    };
+
+    /**
+     * @brief SetMaterialParameters 实际上传的参数快照
+     */
+    struct MaterialState {
+        bool isDefault = true;  ///< 无材质或材质被禁用
+        uint32_t pipeline = 0;
+        float metallic = 0.0f;
+        float roughness = 0.0f;
+        Vector3 baseColor;
+        float opacity = 1.0f;
+        Vector3 transmissionColor;
+        uint32_t mappingMode = 0;
+        float triplanarTiling = 0.0f;
+        float triplanarBlend = 0.0f;
+        bool hasNormalMap = false;
+        bool useVertexColorTint = false;
+        float alphaCutoff = 0.0f;
+    };
+
+    struct Item {
+        Mesh* mesh;
+        const Matrix4x4* worldMatrix;
+        Material* material;  ///< 传给 SetMaterialParameters（默认材质为 nullptr）
+        MaterialState state;
+        const std::string* textures[kTextureSlotCount];
+    };
+
+    struct SortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    bool BuildItem(MeshRenderer* meshRenderer, bool transparent, Item& outItem) const;
+    void PushItem(const Item& item, uint64_t key);
+    void ApplyCulling(size_t firstItem);
+
+    static MaterialState CaptureMaterialState(Material* material);
+    static bool SameMaterialState(const MaterialState& a, const MaterialState& b);
+    static bool CanInstance(const Item& a, const Item& b);
+    static uint32_t HashMaterialState(const MaterialState& state);
+    static uint32_t HashTextures(const std::string* const* textures);
+
+    std::vector<Item> m_items;
+    std::vector<SortEntry> m_sortEntries;
+    std::vector<float> m_viewDepths;  ///< 透明物体的视空间深度（与 m_items 对应）
+    std::vector<uint32_t> m_order;
+    std::vector<Matrix4x4> m_instanceWorlds;  ///< 实例化批次的连续世界矩阵
+    // 剔除用的世界空间包围球（SoA，与本次 Collect 新增的绘制项对应）
+    std::vector<float> m_cullX;
+    std::vector<float> m_cullY;
+    std::vector<float> m_cullZ;
+    std::vector<float> m_cullRadius;
+    std::vector<uint8_t> m_cullVisible;
+    const Frustum* m_frustum = nullptr;
+    bool m_backToFront = false;
+    bool m_instancingEnabled = true;
+    Stats m_stats;
+};
+
+} // namespace Moon
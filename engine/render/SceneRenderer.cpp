@@ -1,9 +1,11 @@
 #include "SceneRenderer.h"
+#include "RenderQueue.h"
 #include "../core/Scene/Scene.h"
 #include "../core/Scene/SceneNode.h"
 #include "../core/Scene/MeshRenderer.h"
 #include "../core/Scene/Material.h"
 #include "../core/Camera/Camera.h"
+#include "../core/Camera/Frustum.h"
 #include "../core/Logging/Logger.h"
 #include "../environment/EnvironmentComponent.h"
 #include "diligent/DiligentRenderer.h"
@@ -15,9 +17,6 @@ class DiligentRenderer;
 namespace Moon {
 namespace SceneRendererUtils {
 
-// 透明度阈值常量：大于等于此值认为是不透明物体
-constexpr float OPACITY_THRESHOLD = 0.99f;
-
 namespace {
 
 const EnvironmentState* FindEnvironmentState(Scene* scene)
@@ -26,19 +25,27 @@ const EnvironmentState* FindEnvironmentState(Scene* scene)
         return nullptr;
     }
 
-    const EnvironmentState* environmentState = nullptr;
-    scene->Traverse([&](SceneNode* node) {
-        if (environmentState) {
-            return;
+    // 按层级顺序取第一个启用的环境组件
+    std::vector<EnvironmentComponent*> environments;
+    scene->CollectComponentsInHierarchyOrder(environments);
+    for (EnvironmentComponent* environment : environments) {
+        if (environment->IsEnabled()) {
+            return &environment->GetState();
         }
+    }
 
-        EnvironmentComponent* environment = node->GetComponent<EnvironmentComponent>();
-        if (environment && environment->IsEnabled()) {
-            environmentState = &environment->GetState();
-        }
-    });
+    return nullptr;
+}
+
+FrameStats g_lastFrameStats;
 
-    return environmentState;
+void AccumulateFrameStats(const RenderQueue::Stats& stats)
+{
+    g_lastFrameStats.visibleCount += stats.visibleCount;
+    g_lastFrameStats.culledCount += stats.culledCount;
+    g_lastFrameStats.drawCalls += stats.drawCalls;
+    g_lastFrameStats.materialBinds += stats.materialBinds;
+    g_lastFrameStats.textureBinds += stats.textureBinds;
 }
 
 } // namespace
@@ -73,12 +80,12 @@ void RenderMeshes(DiligentRenderer* renderer, Scene* scene)
         return;
     }
     
-    // 遍历场景渲染所有启用的 MeshRenderer
-    scene->Traverse([&](SceneNode* node) {
-        MeshRenderer* meshRenderer = node->GetComponent<MeshRenderer>();
-        if (!meshRenderer || !meshRenderer->IsEnabled() || !meshRenderer->IsVisible()) {
+    // 直接遍历场景中所有启用的 MeshRenderer（按类型数组，无需层级遍历）
+    scene->ForEachComponent<MeshRenderer>([&](MeshRenderer* meshRenderer) {
+        if (!meshRenderer->IsEnabled() || !meshRenderer->IsVisible()) {
             return;
         }
+        SceneNode* node = meshRenderer->GetOwner();
         
         // 从 Material 组件获取材质参数和纹理
         Material* material = node->GetComponent<Material>();
@@ -136,91 +143,40 @@ void RenderMeshes(DiligentRenderer* renderer, Scene* scene)
     });
 }
 
-// 辅助函数：绑定材质纹理（统一处理）
-static void BindMaterialTextures(DiligentRenderer* renderer, Material* material)
+// 渲染不透明物体（opacity >= RenderQueue::kOpacityThreshold）
+// 经渲染队列视锥剔除后按材质/纹理排序，相同状态的绘制只绑定一次
+void RenderOpaqueMeshes(DiligentRenderer* renderer, Scene* scene, Camera* camera, const Frustum& frustum)
 {
-    if (!material || !material->IsEnabled()) {
-        renderer->SetMaterialParameters(nullptr);
-        renderer->BindAlbedoTexture("");
-        renderer->BindAOTexture("");
-        renderer->BindRoughnessTexture("");
-        renderer->BindMetalnessTexture("");
-        renderer->BindNormalTexture("");
+    if (!renderer || !scene || !camera) {
         return;
     }
     
-    renderer->SetMaterialParameters(material);
-    
-    renderer->BindAlbedoTexture(material->HasAlbedoMap() ? material->GetAlbedoMap() : "");
-    renderer->BindAOTexture(material->HasAOMap() ? material->GetAOMap() : "");
-    renderer->BindRoughnessTexture(material->HasRoughnessMap() ? material->GetRoughnessMap() : "");
-    renderer->BindMetalnessTexture(material->HasMetalnessMap() ? material->GetMetalnessMap() : "");
-    renderer->BindNormalTexture(material->HasNormalMap() ? material->GetNormalMap() : "");
+    static RenderQueue s_opaqueQueue;  // 跨帧复用容量
+    s_opaqueQueue.Clear();
+    s_opaqueQueue.SetFrustum(&frustum);
+    s_opaqueQueue.CollectOpaque(scene, camera->GetPosition());
+    s_opaqueQueue.Sort();
+    s_opaqueQueue.Submit(renderer);
+    s_opaqueQueue.SetFrustum(nullptr);
+    AccumulateFrameStats(s_opaqueQueue.GetStats());
 }
 
-// 渲染不透明物体（opacity >= OPACITY_THRESHOLD）
-void RenderOpaqueMeshes(DiligentRenderer* renderer, Scene* scene)
+// 渲染透明物体（opacity < RenderQueue::kOpacityThreshold）
+// 视锥剔除后按视空间深度从远到近排序，相邻且材质相同的绘制只绑定一次
+void RenderTransparentMeshes(DiligentRenderer* renderer, Scene* scene, Camera* camera, const Frustum& frustum)
 {
-    if (!renderer || !scene) {
-        return;
-    }
-    
-    scene->Traverse([&](SceneNode* node) {
-        MeshRenderer* meshRenderer = node->GetComponent<MeshRenderer>();
-        if (!meshRenderer || !meshRenderer->IsEnabled() || !meshRenderer->IsVisible()) {
-            return;
-        }
-        
-        Material* material = node->GetComponent<Material>();
-        
-        // 检查是否为不透明材质（opacity >= OPACITY_THRESHOLD 认为是不透明）
-        bool isOpaque = true;
-        if (material && material->IsEnabled()) {
-            isOpaque = (material->GetOpacity() >= OPACITY_THRESHOLD);
-        }
-        
-        if (!isOpaque) {
-            return;  // 跳过透明物体
-        }
-        
-        // 设置材质和纹理
-        BindMaterialTextures(renderer, material);
-        
-        meshRenderer->Render(renderer);
-    });
-}
-
-// 渲染透明物体（opacity < OPACITY_THRESHOLD）
-void RenderTransparentMeshes(DiligentRenderer* renderer, Scene* scene)
-{
-    if (!renderer || !scene) {
+    if (!renderer || !scene || !camera) {
         return;
     }
     
-    // TODO: 后续优化可以按深度排序（从后往前渲染）
-    scene->Traverse([&](SceneNode* node) {
-        MeshRenderer* meshRenderer = node->GetComponent<MeshRenderer>();
-        if (!meshRenderer || !meshRenderer->IsEnabled() || !meshRenderer->IsVisible()) {
-            return;
-        }
-        
-        Material* material = node->GetComponent<Material>();
-        
-        // 检查是否为透明材质（opacity < OPACITY_THRESHOLD）
-        bool isTransparent = false;
-        if (material && material->IsEnabled()) {
-            isTransparent = (material->GetOpacity() < OPACITY_THRESHOLD);
-        }
-        
-        if (!isTransparent) {
-            return;  // 跳过不透明物体
-        }
-        
-        // 设置材质和纹理
-        BindMaterialTextures(renderer, material);
-        
-        meshRenderer->Render(renderer);
-    });
+    static RenderQueue s_transparentQueue;  // 跨帧复用容量
+    s_transparentQueue.Clear();
+    s_transparentQueue.SetFrustum(&frustum);
+    s_transparentQueue.CollectTransparent(scene, camera->GetPosition(), camera->GetForward());
+    s_transparentQueue.Sort();
+    s_transparentQueue.Submit(renderer);
+    s_transparentQueue.SetFrustum(nullptr);
+    AccumulateFrameStats(s_transparentQueue.GetStats());
 }
 
 void RenderScene(DiligentRenderer* renderer, Scene* scene, Camera* camera, const EnvironmentState* environmentState)
@@ -232,6 +188,10 @@ void RenderScene(DiligentRenderer* renderer, Scene* scene, Camera* camera, const
     // 1. 准备渲染（相机、光源、天空盒）
     PrepareRender(renderer, scene, camera, environmentState);
 
+    // 主相机视锥：不透明/透明 Pass 共用（Shadow Map 有各自的视锥，不在此剔除）
+    const Frustum frustum = Frustum::FromViewProjection(camera->GetViewProjectionMatrix());
+    g_lastFrameStats = FrameStats();
+
     // 1.5 渲染 Shadow Map（在主渲染之前）
     renderer->RenderShadowMap(scene, camera);
 
@@ -240,16 +200,21 @@ void RenderScene(DiligentRenderer* renderer, Scene* scene, Camera* camera, const
     
     // 2. 渲染所有不透明物体（Pass 1）
     renderer->SetRenderingTransparent(false);
-    RenderOpaqueMeshes(renderer, scene);
+    RenderOpaqueMeshes(renderer, scene, camera, frustum);
     
     // 3. 渲染天空盒（在不透明物体之后，透明物体之前）
     renderer->RenderSkybox();
     
     // 4. 渲染所有透明物体（Pass 2）
     renderer->SetRenderingTransparent(true);
-    RenderTransparentMeshes(renderer, scene);
+    RenderTransparentMeshes(renderer, scene, camera, frustum);
     renderer->RenderPrecipitationVolume();
 }
 
+const FrameStats& GetLastFrameStats()
+{
+    return g_lastFrameStats;
+}
+
 } // namespace SceneRendererUtils
 } // namespace Moon
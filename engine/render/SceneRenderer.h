@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 // Forward declarations
 class DiligentRenderer;
 
@@ -15,6 +17,17 @@ namespace Moon {
  */
 namespace Moon {
 namespace SceneRendererUtils {
+
+    /**
+     * 单帧渲染统计（不透明 + 透明 Pass 合计）
+     */
+    struct FrameStats {
+        uint32_t visibleCount = 0;   ///< 通过视锥剔除的物体
+        uint32_t culledCount = 0;    ///< 被视锥剔除的物体
+        uint32_t drawCalls = 0;
+        uint32_t materialBinds = 0;
+        uint32_t textureBinds = 0;
+    };
     
     /**
      * 准备渲染（设置相机、光源、天空盒）
@@ -38,6 +51,11 @@ namespace SceneRendererUtils {
      * @param camera 相机
      */
     void RenderScene(DiligentRenderer* renderer, Scene* scene, Camera* camera, const EnvironmentState* environmentState = nullptr);
+
+    /**
+     * 最近一次 RenderScene 的统计
+     */
+    const FrameStats& GetLastFrameStats();
     
 } // namespace SceneRendererUtils
 } // namespace Moon
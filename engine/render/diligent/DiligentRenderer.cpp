@@ -83,7 +83,8 @@ DiligentRenderer::~DiligentRenderer()
 RefCntAutoPtr<IShader> DiligentRenderer::CreateShaderFromFile(
     const char* filename,
     SHADER_TYPE shaderType,
-    const char* debugName)
+    const char* debugName,
+    const char* defines)
 {
     MOON_LOG_INFO(
         "DiligentRenderer",
@@ -110,6 +111,9 @@ RefCntAutoPtr<IShader> DiligentRenderer::CreateShaderFromFile(
             filename ? filename : "<null>");
         return {};
     }
+    if (defines) {
+        shaderCode.insert(0, defines);
+    }
 
     RefCntAutoPtr<IShader> shader;
     ShaderCreateInfo ci{};
@@ -246,7 +250,8 @@ bool DiligentRenderer::CreateSurfacePass(
     bool enableBlending,
     bool bindMaterialToVS,
     RefCntAutoPtr<IPipelineState>& outPSO,
-    RefCntAutoPtr<IShaderResourceBinding>& outSRB)
+    RefCntAutoPtr<IShaderResourceBinding>& outSRB,
+    RefCntAutoPtr<IPipelineState>& outInstancedPSO)
 {
     const std::string vsDebugName = std::string(passName) + " VS";
     const std::string psDebugName = std::string(passName) + " PS";
@@ -314,6 +319,30 @@ bool DiligentRenderer::CreateSurfacePass(
         return false;
     }
 
+    // 实例化变体：只换 VS 与输入布局，资源布局不变，因此可以直接提交上面的 SRB
+    const std::string instancedName = std::string(passName) + " (Instanced)";
+    const std::string instancedVSName = instancedName + " VS";
+    outInstancedPSO.Release();
+    RefCntAutoPtr<IShader> instancedVS = CreateShaderFromFile(
+        vsFile, SHADER_TYPE_VERTEX, instancedVSName.c_str(), "#define MOON_INSTANCED 1\n");
+    if (instancedVS) {
+        LayoutElement instancedLayout[8];
+        Uint32 numInstancedElements = 0;
+        DiligentRendererUtils::GetInstancedVertexLayout(instancedLayout, numInstancedElements);
+        pci.PSODesc.Name = instancedName.c_str();
+        pci.GraphicsPipeline.InputLayout.LayoutElements = instancedLayout;
+        pci.GraphicsPipeline.InputLayout.NumElements = numInstancedElements;
+        pci.pVS = instancedVS;
+        m_pDevice->CreateGraphicsPipelineState(pci, &outInstancedPSO);
+    }
+    if (outInstancedPSO && outInstancedPSO->IsCompatibleWith(outPSO)) {
+        BindSharedSurfaceBuffers(outInstancedPSO, instancedName.c_str(), bindMaterialToVS);
+    } else {
+        // 不影响主管线：DrawMeshInstanced 退回逐实例绘制
+        MOON_LOG_ERROR("DiligentRenderer", "[%s] Failed to create instanced PSO", passName);
+        outInstancedPSO.Release();
+    }
+
     MOON_LOG_INFO("DiligentRenderer", "%s created", passName);
     return true;
 }
@@ -390,12 +419,20 @@ bool DiligentRenderer::Initialize(const RenderInitParams& params)
 
 void DiligentRenderer::CreateMainPass()
 {
-    CreateSurfacePass("Main PSO", "PBR.vs.hlsl", "PBR.ps.hlsl", false, true, m_pPSO, m_pSRB);
+    CreateSurfacePass("Main PSO", "PBR.vs.hlsl", "PBR.ps.hlsl", false, true, m_pPSO, m_pSRB, m_pInstancedPSO);
 }
 
 void DiligentRenderer::CreateTransparentPass()
 {
-    CreateSurfacePass("Transparent PSO", "PBR.vs.hlsl", "PBR.ps.hlsl", true, true, m_pTransparentPSO, m_pTransparentSRB);
+    CreateSurfacePass(
+        "Transparent PSO",
+        "PBR.vs.hlsl",
+        "PBR.ps.hlsl",
+        true,
+        true,
+        m_pTransparentPSO,
+        m_pTransparentSRB,
+        m_pTransparentInstancedPSO);
 }
 
 void DiligentRenderer::CreateWaterTransparentPass()
@@ -407,7 +444,8 @@ void DiligentRenderer::CreateWaterTransparentPass()
         true,
         false,
         m_pWaterTransparentPSO,
-        m_pWaterTransparentSRB);
+        m_pWaterTransparentSRB,
+        m_pWaterTransparentInstancedPSO);
 }
 
 void DiligentRenderer::CreateShadowPass()
@@ -982,14 +1020,16 @@ void DiligentRenderer::UpdateSceneLights(Moon::Scene* scene)
     bool foundDirectional = false;
     bool foundPoint = false;
 
-    // 查找第一个启用的方向光 + 点光源
-    scene->Traverse([&](Moon::SceneNode* node) {
-        if (foundDirectional && foundPoint) return;
+    // 按层级顺序查找第一个启用的方向光 + 点光源（只访问持有 Light 的节点）
+    std::vector<Moon::Light*> lights;
+    scene->CollectComponentsInHierarchyOrder(lights);
+    for (Moon::Light* light : lights) {
+        if (foundDirectional && foundPoint) break;
 
-        Moon::Light* light = node->GetComponent<Moon::Light>();
-        if (!light || !light->IsEnabled()) {
-            return;
+        if (!light->IsEnabled()) {
+            continue;
         }
+        Moon::SceneNode* node = light->GetOwner();
 
         if (!foundDirectional && light->GetType() == Moon::Light::Type::Directional) {
             m_SceneDataCache.lightDirection = light->GetDirection();
@@ -1009,7 +1049,7 @@ void DiligentRenderer::UpdateSceneLights(Moon::Scene* scene)
             m_PointLightCastsShadows = light->GetCastShadows();
             foundPoint = (m_SceneDataCache.pointLightIntensity > 0.0f);
         }
-    });
+    }
     
     // 上传到 GPU（保留了 cameraPosition）
     UpdateCB(m_pPSSceneConstants, m_SceneDataCache);
@@ -1021,16 +1061,16 @@ void DiligentRenderer::UpdateSceneSkybox(Moon::Scene* scene)
     if (!scene) return;
     m_RenderProceduralSky = m_HasEnvironmentState;
     
-    // 查找第一个启用的 Skybox 组件
+    // 按层级顺序查找第一个启用的 Skybox 组件
     Moon::Skybox* activeSkybox = nullptr;
-    scene->Traverse([&](Moon::SceneNode* node) {
-        if (activeSkybox) return;  // 已找到
-        
-        Moon::Skybox* skybox = node->GetComponent<Moon::Skybox>();
-        if (skybox && skybox->IsEnabled()) {
+    std::vector<Moon::Skybox*> skyboxes;
+    scene->CollectComponentsInHierarchyOrder(skyboxes);
+    for (Moon::Skybox* skybox : skyboxes) {
+        if (skybox->IsEnabled()) {
             activeSkybox = skybox;
+            break;
         }
-    });
+    }
     
     // 如果找到 Skybox 且需要重新加载
     if (activeSkybox && activeSkybox->NeedsReload()) {
@@ -1135,6 +1175,91 @@ void DiligentRenderer::DrawMesh(Moon::Mesh* mesh, const Moon::Matrix4x4& world)
     m_pImmediateContext->DrawIndexed(da);
 }
 
+void DiligentRenderer::DrawMeshInstanced(Moon::Mesh* mesh, const Moon::Matrix4x4* worlds, uint32_t instanceCount)
+{
+    if (!mesh || !mesh->IsValid() || !worlds || instanceCount == 0) return;
+
+    auto* instancedPso = m_pInstancedPSO.RawPtr();
+    auto* srb = m_pSRB.RawPtr();
+    if (m_IsRenderingTransparent) {
+        if (m_ActiveMaterialPipeline == MaterialPipeline::Water) {
+            instancedPso = m_pWaterTransparentInstancedPSO.RawPtr();
+            srb = m_pWaterTransparentSRB.RawPtr();
+        } else {
+            instancedPso = m_pTransparentInstancedPSO.RawPtr();
+            srb = m_pTransparentSRB.RawPtr();
+        }
+    }
+
+    // 阴影 Pass、单实例或实例化管线不可用时走逐个绘制路径
+    if (m_IsRenderingShadow || m_IsRenderingPointShadow || instanceCount == 1 ||
+        !instancedPso || !EnsureInstanceBuffer(instanceCount)) {
+        for (uint32_t i = 0; i < instanceCount; ++i) {
+            DrawMesh(mesh, worlds[i]);
+        }
+        return;
+    }
+
+    auto* gpu = GetOrCreateMeshResources(mesh);
+
+    // 世界矩阵整批写入逐实例顶点缓冲；常量缓冲只放 ViewProj（World 置单位阵）
+    void* instanceData = nullptr;
+    m_pImmediateContext->MapBuffer(m_pInstanceVB, MAP_WRITE, MAP_FLAG_DISCARD, instanceData);
+    std::memcpy(instanceData, worlds, sizeof(Moon::Matrix4x4) * instanceCount);
+    m_pImmediateContext->UnmapBuffer(m_pInstanceVB, MAP_WRITE);
+
+    VSConstantsCPU cbuf{};
+    cbuf.WorldViewProjT = DiligentRendererUtils::Transpose(m_ViewProj);
+    cbuf.WorldT = Moon::Matrix4x4();
+    UpdateCB(m_pVSConstants, cbuf);
+
+    m_pImmediateContext->SetPipelineState(instancedPso);
+    m_pImmediateContext->CommitShaderResources(srb, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    Uint64 offsets[] = { 0, 0 };
+    IBuffer* vbs[] = { gpu->VB, m_pInstanceVB };
+    m_pImmediateContext->SetVertexBuffers(0, 2, vbs, offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    m_pImmediateContext->SetIndexBuffer(gpu->IB, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DrawIndexedAttribs da{};
+    da.IndexType = VT_UINT32;
+    da.NumIndices = static_cast<Uint32>(gpu->IndexCount);
+    da.NumInstances = instanceCount;
+    da.Flags = DRAW_FLAG_VERIFY_ALL;
+    m_pImmediateContext->DrawIndexed(da);
+}
+
+bool DiligentRenderer::EnsureInstanceBuffer(uint32_t instanceCount)
+{
+    if (m_pInstanceVB && m_InstanceVBCapacity >= instanceCount) {
+        return true;
+    }
+
+    // 按 2 的幂增长，避免批次大小抖动时反复重建
+    uint32_t capacity = m_InstanceVBCapacity > 0 ? m_InstanceVBCapacity : 64;
+    while (capacity < instanceCount) {
+        capacity *= 2;
+    }
+
+    BufferDesc desc{};
+    desc.Name = "Instance World Matrices";
+    desc.BindFlags = BIND_VERTEX_BUFFER;
+    desc.Usage = USAGE_DYNAMIC;
+    desc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    desc.Size = static_cast<Uint64>(capacity) * sizeof(Moon::Matrix4x4);
+
+    m_pInstanceVB.Release();
+    m_InstanceVBCapacity = 0;
+    m_pDevice->CreateBuffer(desc, nullptr, &m_pInstanceVB);
+    if (!m_pInstanceVB) {
+        MOON_LOG_ERROR("DiligentRenderer", "Failed to create instance buffer (%u instances)", capacity);
+        return false;
+    }
+
+    m_InstanceVBCapacity = capacity;
+    return true;
+}
+
 void DiligentRenderer::CreatePointShadowPass()
 {
     std::string vsCode = DiligentRendererUtils::LoadShaderSource("PointShadowDepth.vs.hlsl");
@@ -1539,6 +1664,11 @@ void DiligentRenderer::Shutdown()
     m_pTransparentPSO.Release();
     m_pWaterTransparentSRB.Release();
     m_pWaterTransparentPSO.Release();
+    m_pInstancedPSO.Release();
+    m_pTransparentInstancedPSO.Release();
+    m_pWaterTransparentInstancedPSO.Release();
+    m_pInstanceVB.Release();
+    m_InstanceVBCapacity = 0;
     m_pPrecipitationVolumeSRB.Release();
     m_pPrecipitationVolumePSO.Release();
     m_pPrecipitationVB.Release();
@@ -53,20 +53,21 @@ public:
     Diligent::ITextureView* GetPreviewSRV() const;
 
     void SetViewProjectionMatrix(const float* viewProj16) override;
-    void SetMaterialParameters(Moon::Material* material);
+    void SetMaterialParameters(Moon::Material* material) override;
     void SetCameraPosition(const Moon::Vector3& position);
     void SetCameraBasis(const Moon::Vector3& right, const Moon::Vector3& up);
     void UpdateSceneLights(Moon::Scene* scene);
     void SetEnvironmentState(const Moon::EnvironmentState* environmentState);
     void SetRenderingTransparent(bool transparent);
     void DrawMesh(Moon::Mesh* mesh, const Moon::Matrix4x4& worldMatrix) override;
+    void DrawMeshInstanced(Moon::Mesh* mesh, const Moon::Matrix4x4* worldMatrices, uint32_t instanceCount) override;
     void DrawCube(const Moon::Matrix4x4& worldMatrix) override;
 
-    void BindAlbedoTexture(const std::string& texturePath);
-    void BindAOTexture(const std::string& texturePath);
-    void BindRoughnessTexture(const std::string& texturePath);
-    void BindMetalnessTexture(const std::string& texturePath);
-    void BindNormalTexture(const std::string& texturePath);
+    void BindAlbedoTexture(const std::string& texturePath) override;
+    void BindAOTexture(const std::string& texturePath) override;
+    void BindRoughnessTexture(const std::string& texturePath) override;
+    void BindMetalnessTexture(const std::string& texturePath) override;
+    void BindNormalTexture(const std::string& texturePath) override;
 
     void UpdateSceneSkybox(Moon::Scene* scene);
     void RenderSkybox();
@@ -219,6 +220,13 @@ private:
     Diligent::RefCntAutoPtr<Diligent::IPipelineState> m_pWaterTransparentPSO;
     Diligent::RefCntAutoPtr<Diligent::IShaderResourceBinding> m_pWaterTransparentSRB;
 
+    // 实例化变体：世界矩阵来自逐实例顶点缓冲，与对应的非实例化 PSO 共用 SRB
+    Diligent::RefCntAutoPtr<Diligent::IPipelineState> m_pInstancedPSO;
+    Diligent::RefCntAutoPtr<Diligent::IPipelineState> m_pTransparentInstancedPSO;
+    Diligent::RefCntAutoPtr<Diligent::IPipelineState> m_pWaterTransparentInstancedPSO;
+    Diligent::RefCntAutoPtr<Diligent::IBuffer> m_pInstanceVB;
+    uint32_t m_InstanceVBCapacity = 0;  ///< m_pInstanceVB 可容纳的实例数
+
     Diligent::RefCntAutoPtr<Diligent::IBuffer> m_pShadowVSConstants;
     Diligent::RefCntAutoPtr<Diligent::IPipelineState> m_pShadowPSO;
     Diligent::RefCntAutoPtr<Diligent::IShaderResourceBinding> m_pShadowSRB;
@@ -328,7 +336,8 @@ private:
     Diligent::RefCntAutoPtr<Diligent::IShader> CreateShaderFromFile(
         const char* filename,
         Diligent::SHADER_TYPE shaderType,
-        const char* debugName);
+        const char* debugName,
+        const char* defines = nullptr);
     bool BindStaticBuffer(
         Diligent::IPipelineState* pso,
         Diligent::SHADER_TYPE shaderType,
@@ -350,7 +359,9 @@ private:
         bool enableBlending,
         bool bindMaterialToVS,
         Diligent::RefCntAutoPtr<Diligent::IPipelineState>& outPSO,
-        Diligent::RefCntAutoPtr<Diligent::IShaderResourceBinding>& outSRB);
+        Diligent::RefCntAutoPtr<Diligent::IShaderResourceBinding>& outSRB,
+        Diligent::RefCntAutoPtr<Diligent::IPipelineState>& outInstancedPSO);
+    bool EnsureInstanceBuffer(uint32_t instanceCount);
     void BindSharedSurfaceBuffers(
         Diligent::IPipelineState* pso,
         const char* passName,
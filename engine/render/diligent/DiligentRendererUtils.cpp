@@ -161,6 +161,26 @@ void GetVertexLayout(Diligent::LayoutElement* outLayout, Diligent::Uint32& outNu
     outNumElements = static_cast<Diligent::Uint32>(attrCount);
 }
 
+void GetInstancedVertexLayout(Diligent::LayoutElement* outLayout, Diligent::Uint32& outNumElements)
+{
+    GetVertexLayout(outLayout, outNumElements);
+
+    // Moon::Matrix4x4 按行存储，每行一个 float4，着色器中重建为 float4x4
+    for (Diligent::Uint32 row = 0; row < 4; ++row) {
+        auto& element = outLayout[outNumElements + row];
+        element.InputIndex = outNumElements + row;
+        element.BufferSlot = 1;
+        element.NumComponents = 4;
+        element.ValueType = Diligent::VT_FLOAT32;
+        element.IsNormalized = Diligent::False;
+        element.RelativeOffset = row * sizeof(float) * 4;
+        element.Stride = sizeof(Moon::Matrix4x4);
+        element.Frequency = Diligent::INPUT_ELEMENT_FREQUENCY_PER_INSTANCE;
+        element.InstanceDataStepRate = 1;
+    }
+    outNumElements += 4;
+}
+
 void UpdateConstantBuffer(Diligent::IBuffer* buf, Diligent::IDeviceContext* context, const void* data, size_t size)
 {
     void* p = nullptr;
@@ -27,6 +27,9 @@ Moon::Matrix4x4 Transpose(const Moon::Matrix4x4& a);
 // 获取顶点布局
 void GetVertexLayout(Diligent::LayoutElement* outLayout, Diligent::Uint32& outNumElements);
 
+// 获取实例化顶点布局：顶点属性之后追加 slot 1 上逐实例的世界矩阵四行（outLayout 至少 8 个元素）
+void GetInstancedVertexLayout(Diligent::LayoutElement* outLayout, Diligent::Uint32& outNumElements);
+
 // 更新常量缓冲区（非模板版本，用于跨编译单元）
 void UpdateConstantBuffer(Diligent::IBuffer* buf, Diligent::IDeviceContext* context, const void* data, size_t size);
 
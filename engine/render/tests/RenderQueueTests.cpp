@@ -0,0 +1,327 @@
+// 渲染队列测试：排序键、状态切换消除、透明物体从远到近排序、视锥剔除（通过计数渲染器无头验证）
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "render/IRenderer.h"
+#include "render/NullRenderer.h"
+#include "render/RenderQueue.h"
+#include "core/Scene/Scene.h"
+#include "core/Scene/SceneNode.h"
+#include "core/Scene/MeshRenderer.h"
+#include "core/Scene/Material.h"
+#include "core/Mesh/Mesh.h"
+#include "core/Camera/Frustum.h"
+#include "core/Camera/PerspectiveCamera.h"
+
+using namespace Moon;
+
+namespace {
+
+// 记录绑定/绘制次数，并在每次绘制时记下当前绑定的状态
+class CountingRenderer : public IRenderer {
+public:
+    struct DrawRecord {
+        const Matrix4x4* worldMatrix;
+        Material* material;
+        std::string albedo;
+        std::string normal;
+    };
+
+    bool Initialize(const RenderInitParams&) override { return true; }
+    void Shutdown() override {}
+    void Resize(uint32_t, uint32_t) override {}
+    void BeginFrame() override {}
+    void EndFrame() override {}
+    void RenderFrame() override {}
+    void SetViewProjectionMatrix(const float*) override {}
+    void DrawCube(const Matrix4x4&) override {}
+
+    void SetMaterialParameters(Material* material) override {
+        m_material = material;
+        ++materialBinds;
+    }
+    void BindAlbedoTexture(const std::string& path) override { m_albedo = path; ++textureBinds; }
+    void BindAOTexture(const std::string&) override { ++textureBinds; }
+    void BindRoughnessTexture(const std::string&) override { ++textureBinds; }
+    void BindMetalnessTexture(const std::string&) override { ++textureBinds; }
+    void BindNormalTexture(const std::string& path) override { m_normal = path; ++textureBinds; }
+
+    void DrawMesh(Mesh*, const Matrix4x4& worldMatrix) override {
+        draws.push_back({&worldMatrix, m_material, m_albedo, m_normal});
+    }
+
+    uint32_t materialBinds = 0;
+    uint32_t textureBinds = 0;
+    std::vector<DrawRecord> draws;
+
+private:
+    Material* m_material = nullptr;
+    std::string m_albedo;
+    std::string m_normal;
+};
+
+std::shared_ptr<Mesh> MakeCube() {
+    return std::shared_ptr<Mesh>(CreateCubeMesh(1.0f));
+}
+
+} // namespace
+
+class RenderQueueTest : public ::testing::Test {
+protected:
+    SceneNode* CreateMeshNode(const std::shared_ptr<Mesh>& mesh, MaterialPreset preset, const Vector3& position) {
+        SceneNode* node = scene.CreateNode("Mesh");
+        node->GetTransform()->SetLocalPosition(position);
+        node->AddComponent<MeshRenderer>()->SetMesh(mesh);
+        node->AddComponent<Material>()->SetMaterialPreset(preset);
+        return node;
+    }
+
+    Scene scene;
+    RenderQueue queue;
+    CountingRenderer renderer;
+};
+
+TEST_F(RenderQueueTest, Submit_ElidesRedundantMaterialAndTextureBinds) {
+    std::shared_ptr<Mesh> cube = MakeCube();
+    const MaterialPreset presets[] = {MaterialPreset::Concrete, MaterialPreset::Wood, MaterialPreset::Metal};
+
+    // 预设交错排列：按层级顺序绘制时每个节点都要切换材质
+    std::unordered_map<const Matrix4x4*, Material*> expected;
+    for (int i = 0; i < 120; ++i) {
+        SceneNode* node = CreateMeshNode(cube, presets[i % 3], Vector3(static_cast<float>(i), 0.0f, 0.0f));
+        expected[&node->GetTransform()->GetWorldMatrix()] = node->GetComponent<Material>();
+    }
+
+    // 逐项绘制，便于按世界矩阵地址核对每次绘制的状态
+    queue.SetInstancingEnabled(false);
+    queue.CollectOpaque(&scene, Vector3(0.0f, 0.0f, -10.0f));
+    queue.Sort();
+    queue.Submit(&renderer);
+
+    const RenderQueue::Stats& stats = queue.GetStats();
+    EXPECT_EQ(stats.itemCount, 120u);
+    EXPECT_EQ(stats.drawCalls, 120u);
+    // Concrete 和 Metal 上传的材质参数完全相同（只有贴图不同），只需 2 次参数绑定
+    EXPECT_EQ(stats.materialBinds, 2u);
+    EXPECT_LE(stats.textureBinds, 15u);
+    EXPECT_EQ(stats.materialBinds, renderer.materialBinds);
+    EXPECT_EQ(stats.textureBinds, renderer.textureBinds);
+    std::printf("[RenderQueue] 120 draws: %u material binds, %u texture binds (per-node binding: 120 / 600)\n",
+                stats.materialBinds, stats.textureBinds);
+
+    // 跳过绑定后每次绘制看到的仍是自己的材质参数和贴图
+    ASSERT_EQ(renderer.draws.size(), 120u);
+    for (const CountingRenderer::DrawRecord& draw : renderer.draws) {
+        Material* material = expected.at(draw.worldMatrix);
+        ASSERT_NE(draw.material, nullptr);
+        EXPECT_EQ(draw.material->GetMetallic(), material->GetMetallic());
+        EXPECT_EQ(draw.material->GetRoughness(), material->GetRoughness());
+        EXPECT_EQ(draw.albedo, material->GetAlbedoMap());
+        EXPECT_EQ(draw.normal, material->GetNormalMap());
+    }
+}
+
+TEST_F(RenderQueueTest, CollectOpaque_SkipsTransparentHiddenAndEmpty) {
+    std::shared_ptr<Mesh> cube = MakeCube();
+    CreateMeshNode(cube, MaterialPreset::Concrete, Vector3(0.0f, 0.0f, 0.0f));
+    CreateMeshNode(cube, MaterialPreset::Glass, Vector3(1.0f, 0.0f, 0.0f));
+    CreateMeshNode(cube, MaterialPreset::Wood, Vector3(2.0f, 0.0f, 0.0f))
+        ->GetComponent<MeshRenderer>()->SetVisible(false);
+    CreateMeshNode(std::make_shared<Mesh>(), MaterialPreset::Wood, Vector3(3.0f, 0.0f, 0.0f));
+
+    // 无 Material 组件：使用默认材质
+    SceneNode* plain = scene.CreateNode("Plain");
+    plain->AddComponent<MeshRenderer>()->SetMesh(cube);
+
+    queue.CollectOpaque(&scene, Vector3(0.0f, 0.0f, 0.0f));
+    EXPECT_EQ(queue.GetItemCount(), 2u);
+
+    queue.Sort();
+    queue.Submit(&renderer);
+    EXPECT_EQ(queue.GetStats().drawCalls, 2u);
+    EXPECT_EQ(queue.GetStats().materialBinds, 2u);
+}
+
+TEST_F(RenderQueueTest, MakeSortKey_FieldPriorityAndFrontToBackDepth) {
+    // 管线优先于所有其他字段
+    EXPECT_LT(RenderQueue::MakeSortKey(0, 0xFFFFF, 0xFFFF, 0x3FFF, 1000.0f),
+              RenderQueue::MakeSortKey(1, 0, 0, 0, 0.0f));
+    // 材质优先于纹理和 Mesh
+    EXPECT_LT(RenderQueue::MakeSortKey(0, 1, 0xFFFF, 0x3FFF, 1000.0f),
+              RenderQueue::MakeSortKey(0, 2, 0, 0, 0.0f));
+    // 其余字段相同时由近到远
+    EXPECT_LT(RenderQueue::MakeSortKey(0, 7, 7, 7, 1.0f),
+              RenderQueue::MakeSortKey(0, 7, 7, 7, 10.0f));
+    EXPECT_LT(RenderQueue::MakeSortKey(0, 7, 7, 7, 10.0f),
+              RenderQueue::MakeSortKey(0, 7, 7, 7, 100.0f));
+}
+
+// ========================================
+// 实例化合并
+// ========================================
+
+TEST_F(RenderQueueTest, Instancing_GroupsSharedMeshAndMaterial) {
+    std::shared_ptr<Mesh> chair = MakeCube();
+    std::shared_ptr<Mesh> frame = MakeCube();
+    for (int i = 0; i < 500; ++i) {
+        CreateMeshNode(chair, MaterialPreset::Wood, Vector3(static_cast<float>(i % 25), 0.0f, static_cast<float>(i / 25)));
+    }
+    for (int i = 0; i < 100; ++i) {
+        CreateMeshNode(frame, (i % 2) ? MaterialPreset::Aluminum : MaterialPreset::Steel, Vector3(static_cast<float>(i), 3.0f, 0.0f));
+    }
+
+    NullRenderer nullRenderer;
+    nullRenderer.BeginFrame();
+    queue.CollectOpaque(&scene, Vector3(0.0f, 1.0f, -5.0f));
+    queue.Sort();
+    queue.Submit(&nullRenderer);
+
+    // 椅子 1 批；窗框按两种材质各 1 批
+    const NullRenderer::DrawStats& drawStats = nullRenderer.GetDrawStats();
+    EXPECT_EQ(drawStats.drawCalls, 0u);
+    EXPECT_EQ(drawStats.instancedDrawCalls, 3u);
+    EXPECT_EQ(drawStats.instanceCount, 600u);
+    EXPECT_EQ(drawStats.maxInstancesPerBatch, 500u);
+    EXPECT_EQ(queue.GetStats().drawCalls, 3u);
+    EXPECT_EQ(queue.GetStats().instancedItems, 600u);
+}
+
+TEST_F(RenderQueueTest, Instancing_DefaultFallbackDrawsEveryInstance) {
+    std::shared_ptr<Mesh> cube = MakeCube();
+    for (int i = 0; i < 10; ++i) {
+        CreateMeshNode(cube, MaterialPreset::Brick, Vector3(static_cast<float>(i), 0.0f, 0.0f));
+    }
+
+    // CountingRenderer 未重写 DrawMeshInstanced：走 IRenderer 的逐个 DrawMesh 默认实现
+    queue.CollectOpaque(&scene, Vector3(0.0f, 0.0f, 0.0f));
+    queue.Sort();
+    queue.Submit(&renderer);
+
+    EXPECT_EQ(queue.GetStats().instancedDrawCalls, 1u);
+    EXPECT_EQ(renderer.draws.size(), 10u);
+    EXPECT_EQ(renderer.materialBinds, 1u);
+}
+
+// ========================================
+// 透明物体：从远到近
+// ========================================
+
+TEST_F(RenderQueueTest, SortBackToFront_FarToNearAndStable) {
+    const std::vector<float> depths = {3.0f, -2.0f, 10.0f, 3.0f, 0.0f, -0.5f, 7.25f};
+    std::vector<uint32_t> order;
+    SortBackToFront(depths.data(), depths.size(), order);
+
+    // 深度相同的 0 和 3 保持输入顺序
+    EXPECT_EQ(order, (std::vector<uint32_t>{2, 6, 0, 3, 4, 5, 1}));
+
+    SortBackToFront(depths.data(), 0, order);
+    EXPECT_TRUE(order.empty());
+}
+
+TEST_F(RenderQueueTest, CollectTransparent_BackToFrontAndBatchesAdjacentState) {
+    std::shared_ptr<Mesh> cube = MakeCube();
+    // 相机在原点看向 +Z；玻璃幕墙沿 Z 排列，前 4 块透明玻璃、后 4 块有色玻璃
+    std::vector<SceneNode*> panes;
+    for (int i = 0; i < 8; ++i) {
+        MaterialPreset preset = (i < 4) ? MaterialPreset::Glass : MaterialPreset::GlassTinted;
+        panes.push_back(CreateMeshNode(cube, preset, Vector3(0.5f * i, 0.0f, 2.0f + i)));
+    }
+    CreateMeshNode(cube, MaterialPreset::Concrete, Vector3(0.0f, 0.0f, 50.0f));
+
+    queue.SetInstancingEnabled(false);
+    queue.CollectTransparent(&scene, Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f));
+    queue.Sort();
+    queue.Submit(&renderer);
+
+    ASSERT_EQ(renderer.draws.size(), 8u);
+    for (size_t i = 0; i < renderer.draws.size(); ++i) {
+        EXPECT_EQ(renderer.draws[i].worldMatrix, &panes[7 - i]->GetTransform()->GetWorldMatrix());
+    }
+    // 两段相邻的相同材质：各绑定一次
+    EXPECT_EQ(queue.GetStats().batchCount, 2u);
+    EXPECT_EQ(queue.GetStats().materialBinds, 2u);
+}
+
+// ========================================
+// 性能对比：基数排序 vs std::sort（100k 透明物体）
+// ========================================
+
+TEST_F(RenderQueueTest, Benchmark_SortBackToFront_100k) {
+    constexpr size_t kCount = 100000;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-50.0f, 500.0f);
+    std::vector<float> depths(kCount);
+    for (float& depth : depths) {
+        depth = dist(rng);
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    std::vector<uint32_t> radixOrder;
+    SortBackToFront(depths.data(), kCount, radixOrder);  // 预热 scratch 缓冲
+    auto radixStart = Clock::now();
+    SortBackToFront(depths.data(), kCount, radixOrder);
+    auto radixEnd = Clock::now();
+
+    std::vector<uint32_t> stdOrder(kCount);
+    std::iota(stdOrder.begin(), stdOrder.end(), 0u);
+    auto stdStart = Clock::now();
+    std::stable_sort(stdOrder.begin(), stdOrder.end(), [&](uint32_t a, uint32_t b) {
+        return depths[a] > depths[b];
+    });
+    auto stdEnd = Clock::now();
+
+    EXPECT_EQ(radixOrder, stdOrder);
+
+    auto us = [](Clock::time_point a, Clock::time_point b) {
+        return static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(b - a).count());
+    };
+    std::printf("[Benchmark] back-to-front 100k: radix %lld us, std::stable_sort %lld us\n",
+                us(radixStart, radixEnd), us(stdStart, stdEnd));
+}
+
+TEST_F(RenderQueueTest, FrustumCulling_SkipsMeshesOutsideView) {
+    PerspectiveCamera camera(90.0f, 1.0f, 0.1f, 100.0f);
+    camera.SetPosition(Vector3(0.0f, 0.0f, 0.0f));
+    camera.SetTarget(Vector3(0.0f, 0.0f, 1.0f));
+    const Frustum frustum = Frustum::FromViewProjection(camera.GetViewProjectionMatrix());
+
+    auto cube = MakeCube();
+    SceneNode* front = CreateMeshNode(cube, MaterialPreset::Concrete, Vector3(0.0f, 0.0f, 10.0f));
+    CreateMeshNode(cube, MaterialPreset::Concrete, Vector3(0.0f, 0.0f, -10.0f));  // 相机后方
+    CreateMeshNode(cube, MaterialPreset::Concrete, Vector3(0.0f, 0.0f, 150.0f));  // 远平面之外
+    SceneNode* edge = CreateMeshNode(cube, MaterialPreset::Concrete, Vector3(-10.4f, 0.0f, 10.0f));  // 跨越左平面
+    CreateMeshNode(cube, MaterialPreset::Glass, Vector3(40.0f, 0.0f, 10.0f));  // 右侧之外（透明）
+
+    queue.SetInstancingEnabled(false);
+    queue.SetFrustum(&frustum);
+    queue.CollectOpaque(&scene, camera.GetPosition());
+    queue.Sort();
+    queue.Submit(&renderer);
+
+    EXPECT_EQ(queue.GetStats().visibleCount, 2u);
+    EXPECT_EQ(queue.GetStats().culledCount, 2u);
+    ASSERT_EQ(renderer.draws.size(), 2u);
+    std::vector<const Matrix4x4*> drawn = {renderer.draws[0].worldMatrix, renderer.draws[1].worldMatrix};
+    EXPECT_NE(std::find(drawn.begin(), drawn.end(), &front->GetTransform()->GetWorldMatrix()), drawn.end());
+    EXPECT_NE(std::find(drawn.begin(), drawn.end(), &edge->GetTransform()->GetWorldMatrix()), drawn.end());
+
+    queue.Clear();
+    queue.CollectTransparent(&scene, camera.GetPosition(), camera.GetForward());
+    EXPECT_EQ(queue.GetItemCount(), 0u);
+    EXPECT_EQ(queue.GetStats().culledCount, 1u);
+
+    // 关闭剔除后全部提交
+    queue.Clear();
+    queue.SetFrustum(nullptr);
+    queue.CollectOpaque(&scene, camera.GetPosition());
+    EXPECT_EQ(queue.GetItemCount(), 4u);
+    EXPECT_EQ(queue.GetStats().visibleCount, 4u);
+    EXPECT_EQ(queue.GetStats().culledCount, 0u);
+}
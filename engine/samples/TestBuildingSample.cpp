@@ -10,7 +10,6 @@
 #include <Assets/AssetPaths.h>
 #include <Building.h>
 #include <Object/Blueprint.h>
-#include <Object/BlueprintLoader.h>
 #include <CSG/CSGBuilder.h>
 #include <fstream>
 #include <unordered_map>
@@ -81,11 +80,8 @@ void TestBuildingSample(EngineCore* engine)
         return;
     }
 
-    auto generatedBlueprint = Moon::Object::BlueprintLoader::ParseFromString(blueprintJsonStr, loadError);
-    if (!generatedBlueprint) {
-        MOON_LOG_ERROR("BuildingSample", "Failed to parse generated blueprint: %s", loadError.c_str());
-        return;
-    }
+    // The saved JSON is an export; the scene is built from the blueprint tree directly
+    auto generatedBlueprint = Moon::Building::BuildingToObjectBlueprintConverter::ConvertToBlueprint(result);
 
     Moon::CSG::CSGBuilder builder;
     builder.SetBlueprintDatabase(&database);
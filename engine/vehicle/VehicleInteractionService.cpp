@@ -63,17 +63,14 @@ VehicleComponent* VehicleInteractionService::FindClosestEnterableVehicle(bool ig
         return nullptr;
     }
 
+    // 车辆数量很少：直接遍历车辆组件数组，按根节点位置取进入半径内最近的车辆
     VehicleComponent* bestVehicle = nullptr;
     float bestDistanceSq = std::numeric_limits<float>::max();
     const Vector3 observerPosition = m_camera->GetPosition();
 
-    m_scene->TraverseActive([&](SceneNode* node) {
-        if (!node) {
-            return;
-        }
-
-        VehicleComponent* vehicle = node->GetComponent<VehicleComponent>();
-        if (!vehicle || vehicle->HasDriver()) {
+    m_scene->ForEachComponent<VehicleComponent>([&](VehicleComponent* vehicle) {
+        SceneNode* node = vehicle->GetOwner();
+        if (!node->IsActive() || vehicle->HasDriver()) {
             return;
         }
 